@@ -31,6 +31,36 @@ macro(phylanx_setup_blaze)
     endif()
   endif()
 
+  # Allow for large matrix products to be handed to an external CBLAS
+  if(PHYLANX_WITH_CBLAS)
+    find_path(CBLAS_INCLUDE_DIR cblas.h HINTS ${BLAS_INCLUDE_DIR})
+    find_library(CBLAS_LIBRARY NAMES cblas openblas mkl_rt
+      HINTS ${BLAS_LIBRARY_DIR})
+    if(CBLAS_INCLUDE_DIR AND CBLAS_LIBRARY)
+      include_directories(${CBLAS_INCLUDE_DIR})
+      phylanx_add_config_define(PHYLANX_HAVE_CBLAS)
+      phylanx_info("CBLAS library: " "${CBLAS_LIBRARY}")
+
+      # Phylanx runs the matrix products on its own worker threads, the
+      # threading of the library has to be disabled for those calls
+      include(CheckFunctionExists)
+      set(CMAKE_REQUIRED_LIBRARIES ${CBLAS_LIBRARY})
+      check_function_exists(mkl_set_num_threads_local
+        PHYLANX_CBLAS_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+      check_function_exists(openblas_set_num_threads
+        PHYLANX_CBLAS_HAVE_OPENBLAS_SET_NUM_THREADS)
+      unset(CMAKE_REQUIRED_LIBRARIES)
+
+      if(PHYLANX_CBLAS_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+        phylanx_add_config_define(PHYLANX_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+      elseif(PHYLANX_CBLAS_HAVE_OPENBLAS_SET_NUM_THREADS)
+        phylanx_add_config_define(PHYLANX_HAVE_OPENBLAS_SET_NUM_THREADS)
+      endif()
+    else()
+      phylanx_warn("CBLAS could not be found, CBLAS support is disabled")
+    endif()
+  endif()
+
   # Add tensors from BlazeTensors
   find_package(BlazeTensor)
   if(NOT BlazeTensor_FOUND)
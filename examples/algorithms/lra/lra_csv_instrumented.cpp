@@ -274,7 +274,8 @@ void print_performance_counter_data_csv(
     std::cout << std::endl << "Primitive Performance Counter Data in CSV:";
 
     // CSV Header
-    std::cout << "\nprimitive_instance,display_name,count,time,eval_direct\n";
+    std::cout << "\nprimitive_instance,display_name,count,time,eval_direct,"
+                 "result_bytes,live_bytes\n";
 
     // Print performance data
     for (auto const& entry :
@@ -479,7 +479,8 @@ phylanx::execution_tree::compiler::result_type compile_and_run(
 void print_performance_counter_data_csv(std::ostream& os)
 {
     // CSV Header
-    os << "primitive_instance,display_name,count,time,eval_direct\n";
+    os << "primitive_instance,display_name,count,time,eval_direct,"
+          "result_bytes,live_bytes\n";
 
     // Print performance data
     for (auto const& entry : phylanx::util::retrieve_counter_data())
@@ -495,6 +496,11 @@ void print_performance_counter_data_csv(std::ostream& os)
         os << "\n";
     }
 
+    // Print the memory held by all node_data instances
+    os << "\nnode_data_live_bytes,node_data_high_water_mark\n"
+       << phylanx::util::memory_tracker::live_bytes(false) << ","
+       << phylanx::util::memory_tracker::high_water_mark(false) << "\n";
+
     os << "\n";
 }
 
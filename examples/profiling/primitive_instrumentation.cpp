@@ -66,7 +66,8 @@ int hpx_main(hpx::program_options::variables_map& vm)
     fibonacci(num_iterations);
 
     // CSV Header
-    std::cout << "primitive_instance,display_name,count,time,eval_directs\n";
+    std::cout << "primitive_instance,display_name,count,time,eval_directs,"
+                 "result_bytes,live_bytes\n";
 
     // Print performance data
     for (auto const& entry :
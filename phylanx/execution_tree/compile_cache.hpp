@@ -0,0 +1,48 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILE_CACHE_OCT_18_2020_0300PM)
+#define PHYLANX_EXECUTION_TREE_COMPILE_CACHE_OCT_18_2020_0300PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return the key used to identify the given PhySL source in the on-disk
+    /// compilation cache. The key combines a hash of the source with its
+    /// length. The parsed expressions depend on the source only, neither on
+    /// the known primitives nor on the number of localities.
+    PHYLANX_EXPORT std::string compile_cache_key(std::string const& expr);
+
+    /// Return the directory used for the on-disk compilation cache, this is
+    /// the value of the configuration entry phylanx.compile_cache_directory.
+    /// The cache is disabled if this is empty (the default).
+    PHYLANX_EXPORT std::string const& compile_cache_directory();
+
+    /// Parse the given PhySL source into a list of expressions. The result is
+    /// looked up in (and, if not found, stored into) the compilation cache
+    /// located in the given directory. If \a cache_directory is empty, this
+    /// is equivalent to \a ast::generate_ast.
+    ///
+    /// Only the parsed expressions are cached, the pattern matching still
+    /// runs for every compilation. Its result depends on more than the
+    /// source: it resolves names against the functions and variables the
+    /// environment already holds (for instance, from previously compiled
+    /// snippets) and creates the primitive components on the target
+    /// localities.
+    PHYLANX_EXPORT std::vector<ast::expression> generate_ast_cached(
+        std::string const& expr, std::string const& cache_directory);
+
+    /// Parse the given PhySL source using the configured cache directory
+    PHYLANX_EXPORT std::vector<ast::expression> generate_ast_cached(
+        std::string const& expr);
+}}
+
+#endif
@@ -0,0 +1,51 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILE_STATISTICS_OCT_18_2020_0500PM)
+#define PHYLANX_EXECUTION_TREE_COMPILE_STATISTICS_OCT_18_2020_0500PM
+
+#include <phylanx/config.hpp>
+
+#include <cstdint>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Process-wide statistics about the compilation of PhySL code, broken
+    /// down by compilation phase. All times are in nanoseconds. The values
+    /// are exposed as performance counters as well (/phylanx/compiler/...).
+    struct PHYLANX_EXPORT compile_statistics
+    {
+        enum phase
+        {
+            parse,          // parsing PhySL source into ASTs
+            index,          // building the pattern index
+            match,          // matching expressions against patterns
+            generate        // generating execution trees (includes match)
+        };
+
+        static void add(phase p, std::int64_t time);
+
+        // Record a lookup of an expression in the pattern index, where
+        // \a candidates is the number of patterns it was matched against
+        static void add_lookup(std::int64_t candidates);
+
+        /// Time spent in the given phase
+        static std::int64_t time(phase p, bool reset);
+
+        static std::int64_t parse_time(bool reset);
+        static std::int64_t index_time(bool reset);
+        static std::int64_t match_time(bool reset);
+        static std::int64_t generate_time(bool reset);
+
+        /// Number of expressions looked up in the pattern index
+        static std::int64_t lookups(bool reset);
+
+        /// Number of patterns expressions were matched against
+        static std::int64_t candidates(bool reset);
+    };
+}}
+
+#endif
@@ -19,11 +19,14 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -85,10 +88,56 @@ namespace phylanx { namespace execution_tree { namespace compiler
         factory_function_type creator_;     // creator function for the primitive
         std::vector<std::string> args_;     // argument names
         std::vector<std::string> defaults_; // default values
+        std::vector<ast::expression> defaults_ast_; // pre-parsed defaults
     };
 
-    using expression_pattern_list =
-        std::multimap<std::string, expression_pattern>;
+    ///////////////////////////////////////////////////////////////////////////
+    class pattern_index;
+
+    // The patterns known to the compiler, keyed by primitive name. The index
+    // used to look up the patterns an expression could match is built on
+    // first use and is rebuilt if patterns were added since.
+    class expression_pattern_list
+      : public std::multimap<std::string, expression_pattern>
+    {
+        using base_type = std::multimap<std::string, expression_pattern>;
+
+    public:
+        expression_pattern_list() = default;
+
+        expression_pattern_list(expression_pattern_list const& rhs)
+          : base_type(rhs)
+        {}
+        expression_pattern_list(expression_pattern_list&& rhs)
+          : base_type(std::move(rhs))
+        {}
+
+        expression_pattern_list& operator=(expression_pattern_list const& rhs)
+        {
+            base_type::operator=(rhs);
+            reset_index();
+            return *this;
+        }
+        expression_pattern_list& operator=(expression_pattern_list&& rhs)
+        {
+            base_type::operator=(std::move(rhs));
+            reset_index();
+            return *this;
+        }
+
+        // Return the index for the current set of patterns
+        PHYLANX_EXPORT std::shared_ptr<pattern_index const> index() const;
+
+    private:
+        void reset_index()
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+            index_.reset();
+        }
+
+        mutable hpx::lcos::local::spinlock mtx_;
+        mutable std::shared_ptr<pattern_index const> index_;
+    };
 
     PHYLANX_EXPORT expression_pattern_list const& generate_patterns();
 
@@ -0,0 +1,81 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_PATTERN_INDEX_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_PATTERN_INDEX_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Index over a list of patterns, used by the compiler to find the
+    // patterns an expression could match without trying all of them.
+    //
+    // Patterns that represent function calls are grouped by function name
+    // and, for each name, by the number of arguments a call must have to
+    // match (variadic patterns are listed for every arity they accept).
+    // All other patterns (operators) are kept in a separate list. The
+    // candidates are listed in the same order as in the pattern list, which
+    // preserves the first-match semantics of the compiler.
+    class pattern_index
+    {
+    public:
+        using const_iterator = expression_pattern_list::const_iterator;
+        using candidate_list = std::vector<const_iterator>;
+
+        PHYLANX_EXPORT explicit pattern_index(
+            expression_pattern_list const& patterns);
+
+        // Return the candidate patterns for a function call with the given
+        // name and number of arguments, nullptr if the name is not known
+        PHYLANX_EXPORT candidate_list const* function_call_candidates(
+            std::string const& name, std::size_t arity) const;
+
+        // Return the candidate patterns for any expression that is not a
+        // function call
+        candidate_list const& expression_candidates() const
+        {
+            return expressions_;
+        }
+
+        // Return the (pre-parsed) AST of the __arg(_1, _2) pattern used to
+        // match keyword arguments, nullptr if it is not available
+        ast::expression const* argument_pattern() const
+        {
+            return argument_pattern_;
+        }
+
+        // Number of patterns the index was built from
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        struct function_call_node
+        {
+            // candidates for calls with up to max_arity arguments
+            std::vector<candidate_list> arities_;
+
+            // candidates for calls with more than max_arity arguments
+            candidate_list variadics_;
+        };
+
+        std::map<std::string, function_call_node> function_calls_;
+        candidate_list expressions_;
+        ast::expression const* argument_pattern_;
+        std::size_t size_;
+    };
+}}}
+
+#endif
@@ -136,6 +136,14 @@ namespace phylanx { namespace execution_tree
         std::string const& name = "",
         std::string const& codename = "<unknown>");
 
+    // Extract a value type from a given primitive_argument_type, moving the
+    // storage of all contained arrays into shared (copy on write) storage.
+    // Copies of the returned value don't duplicate the array data.
+    PHYLANX_EXPORT primitive_argument_type extract_shared_value(
+        primitive_argument_type && val,
+        std::string const& name = "",
+        std::string const& codename = "<unknown>");
+
     PHYLANX_EXPORT ir::dictionary extract_dictionary_value(
         primitive_argument_type const& val,
         std::string const& name = "",
@@ -208,6 +216,16 @@ namespace phylanx { namespace execution_tree
         std::string const& name = "",
         std::string const& codename = "<unknown>");
 
+    // return the number of bytes of memory owned by the data in the argument
+    // (data referring to other instances doesn't count)
+    PHYLANX_EXPORT std::size_t allocated_bytes(
+        primitive_argument_type const& val);
+
+    // return the address of the array data owned by the argument (nullptr
+    // for scalars and for data referring to other instances)
+    PHYLANX_EXPORT void const* owned_array_data(
+        primitive_argument_type const& val);
+
     ///////////////////////////////////////////////////////////////////////////
     // Extract a literal type from a given primitive_argument_type, throw
     // if it doesn't hold one.
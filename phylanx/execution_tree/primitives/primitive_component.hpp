@@ -101,6 +101,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
         PHYLANX_EXPORT std::int64_t get_eval_count(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_eval_duration(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_direct_execution(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_direct_eval_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_async_eval_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_predicted_eval_duration(
+            bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_result_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_live_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_donated_results(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_fresh_results(bool reset) const;
 
         PHYLANX_EXPORT void enable_measurements();
 
@@ -9,6 +9,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/eval_cost_model.hpp>
 
 #include <hpx/allocator_support/internal_allocator.hpp>
 #include <hpx/include/lcos.hpp>
@@ -98,6 +99,16 @@ namespace phylanx { namespace execution_tree
             std::int64_t get_eval_count(bool reset) const;
             std::int64_t get_eval_duration(bool reset) const;
             std::int64_t get_direct_execution(bool reset) const;
+            std::int64_t get_direct_eval_count(bool reset) const;
+            std::int64_t get_async_eval_count(bool reset) const;
+            std::int64_t get_predicted_eval_duration(bool reset) const;
+            std::int64_t get_result_bytes(bool reset) const;
+            std::int64_t get_donated_results(bool reset) const;
+            std::int64_t get_fresh_results(bool reset) const;
+
+            // number of bytes of memory held by this primitive (for instance
+            // the value bound to a variable)
+            virtual std::int64_t get_live_bytes(bool reset) const;
 
             void enable_measurements();
 
@@ -121,7 +132,31 @@ namespace phylanx { namespace execution_tree
 
             std::string extract_function_name(std::string const& name);
 
+        private:
+            // measure the evaluation, if needed
+            template <typename F>
+            hpx::future<primitive_argument_type> measure_eval(
+                std::size_t arg_size, F&& eval_f) const;
+
+            hpx::launch count_eval_execution(hpx::launch policy) const;
+
+            // account for the memory allocated for the result of an
+            // evaluation, if needed
+            hpx::future<primitive_argument_type> account_result_bytes(
+                hpx::future<primitive_argument_type>&& f) const;
+
         protected:
+            // record whether the result of an element-wise operation was
+            // written into the storage of one of its operands (donated) or
+            // into newly allocated storage (fresh)
+            void count_result_storage(bool donated) const;
+
+            // record whether the given result took over the array storage
+            // one of the operands owned (see owned_array_data), results that
+            // are not arrays are not counted
+            void count_result_storage(primitive_argument_type const& result,
+                std::vector<void const*> const& operands) const;
+
             std::string generate_error_message(std::string const& msg) const;
             std::string generate_error_message(
                 std::string const& msg, eval_context const& ctx) const;
@@ -144,6 +179,21 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t execute_directly_;
             bool measurements_enabled_;
 
+            // online model of the eval duration, drives the decision whether
+            // to execute eval directly
+            mutable util::eval_cost_model cost_model_;
+            mutable std::int64_t direct_eval_count_ = 0;
+            mutable std::int64_t async_eval_count_ = 0;
+
+            // overall number of bytes owned by the results of all measured
+            // evaluations
+            mutable std::int64_t result_bytes_ = 0;
+
+            // number of results that reused the storage of an operand and
+            // number of results that required a new allocation
+            mutable std::int64_t donated_results_ = 0;
+            mutable std::int64_t fresh_results_ = 0;
+
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
 #ifdef PHYLANX_HAVE_TASK_INLINING_POLICY
@@ -397,6 +397,9 @@ namespace phylanx { namespace execution_tree
         case 0: HPX_FALLTHROUGH;
         case 1:
             {
+                // shared data must not be modified in place
+                data.unshare();
+
                 auto v = data.vector();
 
                 std::size_t result_size = detail::slicing_size(
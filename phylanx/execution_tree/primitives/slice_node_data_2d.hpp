@@ -1033,16 +1033,16 @@ namespace phylanx { namespace execution_tree
     namespace detail
     {
         template <typename T>
-        blaze::CustomMatrix<T, blaze::aligned, blaze::padded>
+        blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>
         create_ref(blaze::DynamicMatrix<T>& m)
         {
-            return blaze::CustomMatrix<T, blaze::aligned, blaze::padded>(
+            return blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>(
                 m.data(), m.rows(), m.columns(), m.spacing());
         }
 
         template <typename T>
-        blaze::CustomMatrix<T, blaze::aligned, blaze::padded> create_ref(
-            blaze::CustomMatrix<T, blaze::aligned, blaze::padded> const& m)
+        blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded> create_ref(
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded> const& m)
         {
             return m;
         }
@@ -1377,6 +1377,9 @@ namespace phylanx { namespace execution_tree
         case 1: HPX_FALLTHROUGH;
         case 2:
             {
+                // shared data must not be modified in place
+                data.unshare();
+
                 auto m = data.matrix();
                 std::size_t numrows = m.rows();
                 std::size_t numcols = m.columns();
@@ -1428,6 +1431,9 @@ namespace phylanx { namespace execution_tree
         case 1: HPX_FALLTHROUGH;
         case 2:
             {
+                // shared data must not be modified in place
+                data.unshare();
+
                 auto m = data.matrix();
                 std::size_t columns = m.columns();
 
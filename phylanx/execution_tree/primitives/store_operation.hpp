@@ -12,6 +12,7 @@
 
 #include <hpx/futures/future.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,6 +37,15 @@ namespace phylanx {namespace execution_tree { namespace primitives
 
         hpx::future<primitive_argument_type> eval(
             primitive_argument_type&& arg, eval_context ctx) const override;
+
+        // number of bytes owned by the value most recently stored
+        std::int64_t get_live_bytes(bool reset) const override;
+
+    private:
+        void store_value(primitive&& target, primitive_argument_type&& value,
+            primitive_arguments_type&& args, eval_context ctx) const;
+
+        mutable std::int64_t live_bytes_ = 0;
     };
 
     PHYLANX_EXPORT primitive create_store_operation(
@@ -13,6 +13,7 @@
 #include <hpx/futures/future.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -50,6 +51,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         topology expression_topology(std::set<std::string>&& functions,
             std::set<std::string>&& resolve_children) const override;
 
+        std::int64_t get_live_bytes(bool reset) const override;
+
     protected:
         void store1dslice(primitive_arguments_type&& data,
             primitive_arguments_type&& params, eval_context ctx);
@@ -59,8 +62,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_arguments_type&& params, eval_context ctx);
 
     private:
+        // recalculate the memory held by this variable
+        void update_live_bytes() const;
+
         mutable primitive_argument_type bound_value_;
         bool value_set_;
+        mutable std::int64_t live_bytes_ = 0;
     };
 
     PHYLANX_EXPORT primitive create_variable(hpx::id_type const& locality,
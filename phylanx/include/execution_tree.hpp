@@ -8,6 +8,8 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compile_cache.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
@@ -9,13 +9,17 @@
 #include <phylanx/config.hpp>
 #include <phylanx/util/distributed_object.hpp>
 #include <phylanx/util/hashed_string.hpp>
+#include <phylanx/util/memory_tracker.hpp>
 #include <phylanx/util/none_manip.hpp>
 #include <phylanx/util/performance_data.hpp>
+#include <phylanx/util/philox_engine.hpp>
 #include <phylanx/util/random.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/serialization/ast.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 #include <phylanx/util/serialization/variant.hpp>
+#include <phylanx/util/storage_pool.hpp>
+#include <phylanx/util/summa_statistics.hpp>
 #include <phylanx/util/truncated_normal_distribution.hpp>
 #include <phylanx/util/variant.hpp>
 
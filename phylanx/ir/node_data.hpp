@@ -8,6 +8,7 @@
 #define PHYLANX_IR_NODE_DATA_AUG_26_2017_0924AM
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/memory_tracker.hpp>
 #include <phylanx/util/variant.hpp>
 
 #include <hpx/include/util.hpp>
@@ -19,6 +20,7 @@
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -124,22 +126,25 @@ namespace phylanx { namespace ir
         using storage1d_type = blaze::DynamicVector<T>;
         using storage2d_type = blaze::DynamicMatrix<T>;
 
+        // The custom types reference data owned elsewhere (the dynamic types
+        // above, memory mapped files, or numpy arrays), which is neither
+        // guaranteed to be aligned nor to have padded rows.
         using custom_storage0d_type = std::reference_wrapper<T>;
         using custom_storage1d_type =
-            blaze::CustomVector<T, blaze::aligned, blaze::padded>;
+            blaze::CustomVector<T, blaze::unaligned, blaze::unpadded>;
         using custom_storage2d_type =
-            blaze::CustomMatrix<T, blaze::aligned, blaze::padded>;
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>;
 
         constexpr static std::size_t const max_dimensions =
             PHYLANX_MAX_DIMENSIONS;
 
         using storage3d_type = blaze::DynamicTensor<T>;
         using custom_storage3d_type =
-            blaze::CustomTensor<T, blaze::aligned, blaze::padded>;
+            blaze::CustomTensor<T, blaze::unaligned, blaze::unpadded>;
 
         using storage4d_type = blaze::DynamicArray<4UL, T>;
         using custom_storage4d_type =
-            blaze::CustomArray<4UL, T, blaze::aligned, blaze::padded>;
+            blaze::CustomArray<4UL, T, blaze::unaligned, blaze::unpadded>;
 
         using storage_type = util::variant<storage0d_type, storage1d_type,
             storage2d_type, storage3d_type, storage4d_type,
@@ -202,6 +207,12 @@ namespace phylanx { namespace ir
         explicit node_data(custom_storage4d_type const& values);
         explicit node_data(custom_storage4d_type && values);
 
+        /// Create node data referring to the given shared storage (see
+        /// share()). The shared instance may itself refer to external
+        /// memory (e.g. a memory mapped file) that is released only when
+        /// the last instance referring to it goes away.
+        explicit node_data(std::shared_ptr<node_data> shared);
+
         // conversion helpers for Python bindings and AST parsing
         explicit node_data(std::vector<T> const& values);
         explicit node_data(std::vector<std::vector<T>> const& values);
@@ -275,6 +286,8 @@ namespace phylanx { namespace ir
         node_data(node_data const& d);
         node_data(node_data && d);
 
+        ~node_data();
+
         template <typename U, typename U1 =
             typename std::enable_if<!std::is_same<T, U>::value>::type>
         explicit node_data(node_data<U> const& d)
@@ -333,6 +346,8 @@ namespace phylanx { namespace ir
         node_data& operator=(node_data<U> const& d)
         {
             data_ = init_data_from_type(d);
+            shared_.reset();
+            tracked_.update(storage_bytes(data_));
             return *this;
         }
 
@@ -429,12 +444,51 @@ namespace phylanx { namespace ir
         node_data<T> ref() const&&;
 
         /// Return a new instance of node_data holding a copy of this instance.
+        /// Shared storage is immutable, thus it is not copied but the new
+        /// instance refers to the same storage.
         node_data<T> copy() const;
 
         /// Return whether the internal representation is referring to another
         /// instance of node_data
         bool is_ref() const;
 
+        /// Move the storage owned by this instance into shared (reference
+        /// counted) storage this instance refers to afterwards. Copies of
+        /// the instance will refer to the same storage instead of
+        /// duplicating the data. This has no effect on scalars and on
+        /// instances that are referring to other data.
+        void share();
+
+        /// Return whether the internal representation is referring to shared
+        /// storage
+        bool is_shared() const
+        {
+            return bool(shared_);
+        }
+
+        /// Make this instance the sole owner of its data before modifying it
+        /// (copy on write). Shared storage that is referred to by other
+        /// instances is copied, otherwise this instance takes over the
+        /// storage.
+        void unshare();
+
+        /// Return the number of bytes of memory owned by this instance (zero
+        /// if the internal representation is referring to other data). Shared
+        /// storage is split evenly between the instances referring to it,
+        /// such that summing up all of them counts it only once.
+        std::size_t allocated_bytes() const
+        {
+            // not taken from tracked_, the storage may have been resized
+            // since it was last synchronized
+            std::size_t bytes = storage_bytes(data_);
+            if (shared_)
+            {
+                bytes += shared_->allocated_bytes() /
+                    std::size_t(shared_.use_count());
+            }
+            return bytes;
+        }
+
         explicit operator bool() const;
 
         bool operator!() const
@@ -466,7 +520,26 @@ namespace phylanx { namespace ir
         void serialize(hpx::serialization::input_archive& ar, unsigned);
         void serialize(hpx::serialization::output_archive& ar, unsigned);
 
+        // memory owned by the given storage (used for memory accounting)
+        static std::size_t storage_bytes(storage_type const& data);
+
+        // update the accounted memory after the storage may have been resized
+        // through a reference returned by one of the mutable accessors
+        void sync_tracked()
+        {
+            tracked_.update(storage_bytes(data_));
+        }
+
+        // take over shared storage if this is the only instance referring
+        // to it
+        bool reclaim_shared();
+
         storage_type data_;
+
+        // shared storage data_ is referring to (if any)
+        std::shared_ptr<node_data> shared_;
+
+        util::tracked_memory tracked_{storage_bytes(data_)};
         /// \endcond
     };
 
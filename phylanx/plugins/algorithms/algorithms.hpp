@@ -7,6 +7,7 @@
 #define PHYLANX_PLUGINS_ALGORITHMS_MAY_02_2108_1251PM
 
 #include <phylanx/plugins/algorithms/als.hpp>
+#include <phylanx/plugins/algorithms/dist_als.hpp>
 #include <phylanx/plugins/algorithms/kmeans.hpp>
 #include <phylanx/plugins/algorithms/lra.hpp>
 #include <phylanx/plugins/algorithms/lda.hpp>
@@ -0,0 +1,125 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_ALGORITHMS_ALS_ENGINE_OCT_18_2020_0700PM)
+#define PHYLANX_ALGORITHMS_ALS_ENGINE_OCT_18_2020_0700PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Ratings of implicit feedback ALS stored in compressed sparse row
+    // format, row r has the entries offsets_[r] to offsets_[r + 1].
+    struct als_ratings
+    {
+        als_ratings() = default;
+
+        als_ratings(std::size_t rows, std::size_t columns)
+          : offsets_(rows + 1, 0)
+          , columns_(columns)
+        {
+        }
+
+        std::size_t rows() const
+        {
+            return offsets_.empty() ? 0 : offsets_.size() - 1;
+        }
+        std::size_t columns() const
+        {
+            return columns_;
+        }
+        std::size_t nonzeros() const
+        {
+            return values_.size();
+        }
+
+        std::vector<std::size_t> offsets_;
+        std::vector<std::size_t> indices_;
+        std::vector<double> values_;
+        std::size_t columns_ = 0;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            // clang-format off
+            ar & offsets_ & indices_ & values_ & columns_;
+            // clang-format on
+        }
+    };
+
+    // Extract the non-zero entries of a dense matrix
+    als_ratings als_ratings_from_matrix(
+        ir::node_data<double>::storage2d_type const& ratings);
+
+    // Create the ratings from coordinates (duplicate entries are summed up)
+    als_ratings als_ratings_from_coo(std::vector<std::int64_t> const& rows,
+        std::vector<std::int64_t> const& columns,
+        std::vector<double> const& values, std::size_t num_rows,
+        std::size_t num_columns, std::string const& name,
+        std::string const& codename);
+
+    // Create the ratings from the compressed row representation
+    als_ratings als_ratings_from_csr(std::vector<std::int64_t> const& offsets,
+        std::vector<std::int64_t> const& indices,
+        std::vector<double> const& values, std::size_t num_columns,
+        std::string const& name, std::string const& codename);
+
+    // Create the ratings from a list(rows, columns, values[, shape]) (format
+    // 'coo') or list(offsets, indices, values[, shape]) (format 'csr')
+    als_ratings als_ratings_from_list(primitive_argument_type&& ratings,
+        std::string const& format, std::string const& name,
+        std::string const& codename);
+
+    // Return the ratings with rows and columns swapped
+    als_ratings als_transpose(als_ratings const& ratings);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Number of conjugate gradient steps used if none were specified for
+    // sparse ratings (phylanx.als.cg_steps, defaults to 3)
+    std::size_t als_default_cg_steps();
+
+    // Solve the least squares problems of all rows of the ratings for the
+    // rows first to first + ratings.rows() of the given factors, using the
+    // other side's factors. Each row solves
+    //
+    //      (YtY + Yt (C_u - I) Y) x_u = Yt C_u p_u
+    //
+    // where C_u = I + alpha * diag(r_u) and YtY = Yt Y + reg * I was
+    // precomputed, such that only the non-zero entries of the row are
+    // visited. If cg_steps is zero the system is solved directly, otherwise
+    // the given number of conjugate gradient steps are performed, starting
+    // off the current factors. The rows are solved concurrently.
+    void als_update_factors(als_ratings const& ratings,
+        blaze::DynamicMatrix<double> const& other,
+        blaze::DynamicMatrix<double> const& YtY,
+        blaze::DynamicMatrix<double>& factors, std::size_t first,
+        double alpha, std::size_t cg_steps);
+
+    // Return the initial factors used by als() and als_d(): all localities
+    // draw them from the normal distribution using seed zero and the counter
+    // based stream that is associated with the given name (see
+    // util::random_stream), which makes them independent of any other random
+    // numbers generated before.
+    blaze::DynamicMatrix<double> als_initial_factors(
+        std::size_t rows, std::size_t columns, std::string const& stream);
+
+    // Return Yt Y + reg * I
+    blaze::DynamicMatrix<double> als_gramian(
+        blaze::DynamicMatrix<double> const& factors, double regularization);
+}}}}
+
+#endif
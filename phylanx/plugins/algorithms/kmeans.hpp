@@ -11,6 +11,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
 
 #include <hpx/futures/future.hpp>
 
@@ -43,23 +44,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         kmeans() = default;
 
-
         kmeans(primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename);
 
     protected:
+        using points_type = ir::node_data<double>::custom_storage2d_type;
+
         blaze::DynamicMatrix<double> initialize_centroids(
-            blaze::DynamicMatrix<double> const& points, std::size_t num_points,
+            points_type const& points, std::size_t num_centroids) const;
+        blaze::DynamicMatrix<double> initialize_centroids_kmeans_pp(
+            points_type const& points,
+            blaze::DynamicVector<double> const& squared_norms,
             std::size_t num_centroids) const;
-        blaze::DynamicVector<std::size_t> closest_centroids(
-            blaze::DynamicMatrix<double> const& points,
+        void closest_centroids(points_type const& points,
             blaze::DynamicMatrix<double> const& centroids,
-            std::size_t num_points, std::size_t num_centroids) const;
-        blaze::DynamicMatrix<double> move_centroids(
-            blaze::DynamicMatrix<double> const& points,
-            blaze::DynamicVector<std::size_t>&& closest,
-            blaze::DynamicMatrix<double>&& centroids, std::size_t num_points,
-            std::size_t num_centroids) const;
+            blaze::DynamicVector<std::size_t>& closest) const;
+        blaze::DynamicMatrix<double> move_centroids(points_type const& points,
+            blaze::DynamicVector<std::size_t> const& closest,
+            blaze::DynamicMatrix<double> const& centroids) const;
 
         primitive_argument_type calculate_kmeans(
             primitive_arguments_type&& args) const;
@@ -28,7 +28,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     protected:
         hpx::future<primitive_argument_type> eval(
             primitive_arguments_type const& operands,
-            primitive_arguments_type const& args) const;
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
 
     public:
         static match_pattern_type const match_data;
@@ -36,18 +37,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         lda_trainer() = default;
 
         ///
-        /// Creates a primitive executing the ALS algorithm on the given
-        /// input data
-        ///
-        /// \param args Is a (possibly empty) list of any values to be
-        ///             concatenated into a PhySL list in order.
+        /// Creates a primitive executing the LDA algorithm (collapsed Gibbs
+        /// sampling) on the given word-document histogram
         ///
         lda_trainer(primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename);
 
-//        hpx::future<primitive_argument_type> eval(
-//            primitive_arguments_type const& params) const override;
-
     protected:
         primitive_argument_type calculate_lda_trainer(
             primitive_arguments_type&& args) const;
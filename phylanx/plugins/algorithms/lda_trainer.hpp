@@ -8,35 +8,32 @@
 #define __PHYLANX_LDA_TRAINER_IMPL_HPP__
 
 #include <phylanx/config.hpp>
-#include <phylanx/execution_tree/annotation.hpp>
-#include <phylanx/execution_tree/localities_annotation.hpp>
-#include <phylanx/execution_tree/locality_annotation.hpp>
-#include <phylanx/execution_tree/meta_annotation.hpp>
-#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
-#include <phylanx/ir/node_data.hpp>
-#include <phylanx/plugins/common/dot_operation_nd.hpp>
-#include <phylanx/plugins/dist_matrixops/dist_cannon_product.hpp>
-#include <phylanx/util/distributed_matrix.hpp>
-
-#include <hpx/assert.hpp>
-#include <hpx/errors/throw_exception.hpp>
-#include <hpx/include/lcos.hpp>
-#include <hpx/include/naming.hpp>
-#include <hpx/include/util.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
 
 #include <cstdint>
-#include <cmath>
-#include <cstdlib>
 #include <tuple>
-#include <numeric>
-#include <algorithm>
-#include <iostream>
 
-#include <blaze/Blaze.h>
+#include <blaze/Math.h>
 
 /////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives {
 
+// The corpus is a sparse document-word matrix in compressed sparse row
+// format, row d holds the (word, count) pairs of document d.
+using lda_corpus = detail::als_ratings;
+
+// Collapsed Gibbs sampler for latent Dirichlet allocation.
+//
+// The documents are split into shards of roughly the same number of
+// tokens (the configuration entry phylanx.lda.shard_tokens, 16384 by
+// default) that are sampled concurrently, each using the word-topic counts
+// as of the beginning of the sweep (approximate distributed LDA). The
+// changes of the word-topic counts are collected per shard and merged
+// after every sweep. The topic of each token is drawn using the bucket
+// decomposition of SparseLDA (Yao et al., KDD'09), which visits only the
+// topics of the current document and word. Every shard draws from its
+// own counter based engine, the results depend on the seed and the shard
+// size only.
 class lda_trainer_impl {
 
     private:
@@ -49,23 +46,23 @@ class lda_trainer_impl {
         alpha(alpha_), beta(beta_) {
     }
 
-    static void gibbs(
-        const blaze::DynamicMatrix<double> & word_doc_mat,
-        const double alpha,
-        const double beta,
-        blaze::DynamicVector<std::int64_t> & z,
-        blaze::DynamicMatrix<double> & wp0,
-        blaze::DynamicMatrix<double> & dp,
-        blaze::DynamicVector<double, blaze::rowVector> & ztot);
-
     using dmatrix_t = blaze::DynamicMatrix<double>;
-    using dvector_t = blaze::DynamicVector<double>;
-    using i64vector_t = blaze::DynamicVector<std::int64_t>;
 
+    // returns the word-topic (W x T) and document-topic (D x T) counts
+    std::tuple<dmatrix_t, dmatrix_t> operator()(
+        const lda_corpus & corpus,
+        const std::int64_t T,
+        const std::int64_t iter,
+        const std::uint32_t seed,
+        const std::uint64_t stream);
+
+    // the documents are the rows of the dense word_doc_mat
     std::tuple<dmatrix_t, dmatrix_t> operator()(
         const dmatrix_t & word_doc_mat,
         const std::int64_t T,
-        const std::int64_t iter=500);
+        const std::int64_t iter,
+        const std::uint32_t seed,
+        const std::uint64_t stream);
 };
 
 } } } // end namespaces
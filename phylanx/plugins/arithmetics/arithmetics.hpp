@@ -10,12 +10,14 @@
 #include <phylanx/plugins/arithmetics/cumprod.hpp>
 #include <phylanx/plugins/arithmetics/cumsum.hpp>
 #include <phylanx/plugins/arithmetics/div_operation.hpp>
+#include <phylanx/plugins/arithmetics/fused_elementwise.hpp>
 #include <phylanx/plugins/arithmetics/generic_operation.hpp>
 #include <phylanx/plugins/arithmetics/generic_operation_bool.hpp>
 #include <phylanx/plugins/arithmetics/maximum.hpp>
 #include <phylanx/plugins/arithmetics/minimum.hpp>
 #include <phylanx/plugins/arithmetics/mod_operation.hpp>
 #include <phylanx/plugins/arithmetics/mul_operation.hpp>
+#include <phylanx/plugins/arithmetics/scan.hpp>
 #include <phylanx/plugins/arithmetics/sub_operation.hpp>
 #include <phylanx/plugins/arithmetics/unary_minus_operation.hpp>
 
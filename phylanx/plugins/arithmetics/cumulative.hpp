@@ -43,46 +43,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         template <typename T>
         primitive_argument_type cumulative_helper(
             primitive_arguments_type&& ops,
-            hpx::util::optional<std::int64_t>&& axis) const;
-
-        template <typename T>
-        primitive_argument_type cumulative0d(primitive_arguments_type&& ops,
-            hpx::util::optional<std::int64_t>&& axis) const;
-
-        template <typename T>
-        primitive_argument_type cumulative1d(primitive_arguments_type&& ops,
-            hpx::util::optional<std::int64_t>&& axis) const;
-
-        template <typename T>
-        primitive_argument_type cumulative2d(primitive_arguments_type&& ops,
-            hpx::util::optional<std::int64_t>&& axis) const;
-
-        template <typename T>
-        primitive_argument_type cumulative2d_noaxis(
-            primitive_arguments_type&& ops) const;
-        template <typename T>
-        primitive_argument_type cumulative2d_columns(
-            primitive_arguments_type&& ops) const;
-        template <typename T>
-        primitive_argument_type cumulative2d_rows(
-            primitive_arguments_type&& ops) const;
-
-        template <typename T>
-        primitive_argument_type cumulative3d(primitive_arguments_type&& ops,
-            hpx::util::optional<std::int64_t>&& axis) const;
-
-        template <typename T>
-        primitive_argument_type cumulative3d_noaxis(
-            primitive_arguments_type&& ops) const;
-        template <typename T>
-        primitive_argument_type cumulative3d_pages(
-            primitive_arguments_type&& ops) const;
-        template <typename T>
-        primitive_argument_type cumulative3d_columns(
-            primitive_arguments_type&& ops) const;
-        template <typename T>
-        primitive_argument_type cumulative3d_rows(
-            primitive_arguments_type&& ops) const;
+            hpx::util::optional<std::int64_t>&& axis, bool compensated) const;
     };
 }}}
 
@@ -8,22 +8,26 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/arithmetics/cumulative.hpp>
+#include <phylanx/util/generate_error_message.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/modules/format.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
-#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
 
-#include <array>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -41,308 +45,621 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {}
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative0d(
-        primitive_arguments_type&& ops,
-        hpx::util::optional<std::int64_t>&& axis) const
+    namespace detail
     {
-        if (axis)
-        {
-            // make sure that axis, if given is equal to zero
-            if (*axis != 0)
-            {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "cumulative<Op, Derived>::cumulative0d<T>",
-                    generate_error_message(hpx::util::format(
-                        "axis {:d} is out of bounds for scalar", *axis)));
-            }
-        }
+        // Scans touching fewer elements are performed sequentially
+        constexpr std::size_t scan_parallel_threshold = 65536;
 
-        ir::node_data<T> value =
-            extract_node_data<T>(std::move(ops[0]), name_, codename_);
+        // Scans along the columns of a matrix process this many columns at
+        // a time
+        constexpr std::size_t scan_block_columns = 256;
 
-        blaze::DynamicVector<T> result(1, value.scalar());
-        return primitive_argument_type{std::move(result)};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative1d(
-        primitive_arguments_type&& ops,
-        hpx::util::optional<std::int64_t>&& axis) const
-    {
-        if (axis)
+        ///////////////////////////////////////////////////////////////////////
+        // Running result of applying Op to a sequence of values
+        template <typename Op, typename T>
+        class scan_accumulator
         {
-            // make sure that axis, if given is equal to zero
-            if (*axis != 0)
+        public:
+            void add(T value)
             {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "cumulative<Op, Derived>::cumulative1d<T>",
-                    generate_error_message(hpx::util::format(
-                        "axis {:d} is out of bounds for vector", *axis)));
+                value_ = Op{}(value_, value);
             }
-        }
 
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+            // append the values accumulated by the given accumulator
+            void add(scan_accumulator const& rhs)
+            {
+                add(rhs.value_);
+            }
 
-        auto v = value.vector();
-        blaze::DynamicVector<T> result(v.size());
+            T get() const
+            {
+                return value_;
+            }
 
-        Op{}(v.begin(), v.end(), result.begin(), Op::template initial<T>());
+        private:
+            T value_ = Op::template initial<T>();
+        };
 
-        return primitive_argument_type{std::move(result)};
-    }
+        // Running sum of a sequence of values using compensated
+        // (Kahan-Babuska-Neumaier) summation, which keeps the rounding error
+        // independent of the length of the sequence
+        template <typename T>
+        class compensated_accumulator
+        {
+        public:
+            void add(T value)
+            {
+                T const sum = sum_ + value;
+                if (std::abs(sum_) >= std::abs(value))
+                {
+                    compensation_ += (sum_ - sum) + value;
+                }
+                else
+                {
+                    compensation_ += (value - sum) + sum_;
+                }
+                sum_ = sum;
+            }
 
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative2d_noaxis(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+            // append the values accumulated by the given accumulator
+            void add(compensated_accumulator const& rhs)
+            {
+                add(rhs.sum_);
+                add(rhs.compensation_);
+            }
 
-        auto m = value.matrix();
-        blaze::DynamicVector<T> result(m.rows() * m.columns());
+            T get() const
+            {
+                return sum_ + compensation_;
+            }
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
+        private:
+            T sum_ = T(0);
+            T compensation_ = T(0);
+        };
 
-        for (std::size_t row = 0; row != m.rows(); ++row)
+        ///////////////////////////////////////////////////////////////////////
+        // Invoke f(i) for all i in [0, count), concurrently if the scan
+        // touches at least scan_parallel_threshold elements
+        template <typename F>
+        void scan_for_each(std::size_t size, std::size_t count, F&& f)
         {
-            last = Op{}(m.begin(row), m.end(row), last, init);
-            init = *(last - 1);
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative2d_columns(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+            if (count > 1 && size >= scan_parallel_threshold)
+            {
+                hpx::for_loop(hpx::execution::par, std::size_t(0), count, f);
+                return;
+            }
 
-        auto m = value.matrix();
-        blaze::DynamicMatrix<T> result(m.rows(), m.columns());
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                f(i);
+            }
+        }
 
-        T init = Op::template initial<T>();
-        for (std::size_t col = 0; col != m.columns(); ++col)
+        // Number of chunks a scan touching size elements that can be split
+        // at count places is split into
+        inline std::size_t scan_chunks(std::size_t size, std::size_t count)
         {
-            auto column = blaze::column(m, col);
-            auto result_column = blaze::column(result, col);
+            if (size < scan_parallel_threshold)
+            {
+                return 1;
+            }
 
-            Op{}(column.begin(), column.end(), result_column.begin(), init);
+            return (std::min)({count, 4 * hpx::get_os_thread_count(),
+                size / (scan_parallel_threshold / 4)});
         }
 
-        return primitive_argument_type{std::move(result)};
-    }
+        ///////////////////////////////////////////////////////////////////////
+        // Inclusive scan of the items [0, count) touching size elements
+        // overall. reduce(acc, begin, end) adds the elements of the items
+        // [begin, end) to acc, scan(acc, begin, end) does the same but also
+        // writes the intermediate results.
+        //
+        // Large inputs are scanned in two passes: the first pass reduces all
+        // chunks of items concurrently, the second pass scans the chunks
+        // concurrently, each starting off the combined results of all
+        // preceding chunks.
+        template <typename Acc, typename Reduce, typename Scan>
+        void scan_items(std::size_t count, std::size_t size, Reduce&& reduce,
+            Scan&& scan)
+        {
+            std::size_t const chunks = scan_chunks(size, count);
+            if (chunks < 2)
+            {
+                Acc acc;
+                scan(acc, std::size_t(0), count);
+                return;
+            }
 
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative2d_rows(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+            // the first chunk does not contribute to any offset
+            std::vector<Acc> offsets(chunks);
+            hpx::for_loop(hpx::execution::par, std::size_t(1), chunks,
+                [&](std::size_t c) {
+                    reduce(offsets[c], c * count / chunks,
+                        (c + 1) * count / chunks);
+                });
 
-        auto m = value.matrix();
-        blaze::DynamicMatrix<T> result(m.rows(), m.columns());
+            Acc acc;
+            for (auto& offset : offsets)
+            {
+                Acc total = offset;
+                offset = acc;
+                acc.add(total);
+            }
 
-        T init = Op::template initial<T>();
-        for (std::size_t row = 0; row != m.rows(); ++row)
-        {
-            Op{}(m.begin(row), m.end(row), result.begin(row), init);
+            hpx::for_loop(hpx::execution::par, std::size_t(0), chunks,
+                [&](std::size_t c) {
+                    scan(offsets[c], c * count / chunks,
+                        (c + 1) * count / chunks);
+                });
         }
 
-        return primitive_argument_type{std::move(result)};
-    }
-
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative2d(
-        primitive_arguments_type&& ops,
-        hpx::util::optional<std::int64_t>&& axis) const
-    {
-        if (axis)
+        // Running results of the scans of all columns of an array
+        template <typename Acc>
+        struct scan_columns_accumulator
         {
-            // make sure that axis, if given, is in valid range
-            if (*axis < -2 || *axis > 1)
+            void add(scan_columns_accumulator const& rhs)
             {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "cumulative<Op, Derived>::cumulative2d<T>",
-                    generate_error_message(hpx::util::format(
-                        "axis {:d} is out of bounds for matrix", *axis)));
+                if (accs_.size() < rhs.accs_.size())
+                {
+                    accs_.resize(rhs.accs_.size());
+                }
+                for (std::size_t j = 0; j != rhs.accs_.size(); ++j)
+                {
+                    accs_[j].add(rhs.accs_[j]);
+                }
             }
 
-            switch (*axis)
-            {
-            case -2:
-            case 0:         // cumulative sum over columns
-                return cumulative2d_columns<T>(std::move(ops));
+            std::vector<Acc> accs_;
+        };
+
+        // Inclusive scans along the first index of a rows x columns array,
+        // get(i, j) returns element (i, j), set(i, j, value) stores element
+        // (i, j) of the result. The array is traversed row by row, processing
+        // blocks of columns concurrently. Arrays with few columns are split
+        // into chunks of rows that are scanned in two passes (see scan_items)
+        template <typename Acc, typename Get, typename Set>
+        void scan_columns(std::size_t rows, std::size_t columns, Get&& get,
+            Set&& set)
+        {
+            std::size_t const size = rows * columns;
+            std::size_t const blocks =
+                (columns + scan_block_columns - 1) / scan_block_columns;
+
+            auto scan = [&](std::vector<Acc>& accs, std::size_t row_begin,
+                            std::size_t row_end, std::size_t column_begin,
+                            std::size_t column_end, bool write) {
+                for (std::size_t i = row_begin; i != row_end; ++i)
+                {
+                    for (std::size_t j = column_begin; j != column_end; ++j)
+                    {
+                        Acc& acc = accs[j - column_begin];
+                        acc.add(get(i, j));
+                        if (write)
+                        {
+                            set(i, j, acc.get());
+                        }
+                    }
+                }
+            };
 
-            case -1:
-            case 1:         // cumulative sum over rows
-                return cumulative2d_rows<T>(std::move(ops));
+            if (blocks >= hpx::get_os_thread_count() ||
+                scan_chunks(size, rows) < 2)
+            {
+                scan_for_each(size, blocks, [&](std::size_t b) {
+                    std::size_t const begin = b * scan_block_columns;
+                    std::size_t const end =
+                        (std::min)(begin + scan_block_columns, columns);
+
+                    std::vector<Acc> accs(end - begin);
+                    scan(accs, 0, rows, begin, end, true);
+                });
+                return;
             }
-        }
 
-        // no axis specified
-        return cumulative2d_noaxis<T>(std::move(ops));
+            scan_items<scan_columns_accumulator<Acc>>(rows, size,
+                [&](scan_columns_accumulator<Acc>& acc, std::size_t begin,
+                    std::size_t end) {
+                    acc.accs_.resize(columns);
+                    scan(acc.accs_, begin, end, 0, columns, false);
+                },
+                [&](scan_columns_accumulator<Acc>& acc, std::size_t begin,
+                    std::size_t end) {
+                    acc.accs_.resize(columns);
+                    scan(acc.accs_, begin, end, 0, columns, true);
+                });
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative3d_noaxis(
-        primitive_arguments_type&& ops) const
+    namespace detail
     {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
-
-        auto t = value.tensor();
-        blaze::DynamicVector<T> result(t.pages() * t.rows() * t.columns());
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative0d(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis,
+            std::string const& name, std::string const& codename)
+        {
+            if (axis)
+            {
+                // make sure that axis, if given is equal to zero
+                if (*axis != 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cumulative<Op, Derived>::cumulative0d<T>",
+                        util::generate_error_message(
+                            hpx::util::format(
+                                "axis {:d} is out of bounds for scalar",
+                                *axis),
+                            name, codename));
+                }
+            }
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
+            blaze::DynamicVector<T> result(1, value.scalar());
+            return primitive_argument_type{std::move(result)};
+        }
 
-        for (std::size_t page = 0; page != t.pages(); ++page)
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative1d(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis,
+            std::string const& name, std::string const& codename)
         {
-            auto ps = blaze::pageslice(t, page);
-            for (std::size_t row = 0; row != t.rows(); ++row)
+            if (axis)
             {
-                last = Op{}(ps.begin(row), ps.end(row), last, init);
-                init = *(last - 1);
+                // make sure that axis, if given is equal to zero
+                if (*axis != 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cumulative<Op, Derived>::cumulative1d<T>",
+                        util::generate_error_message(
+                            hpx::util::format(
+                                "axis {:d} is out of bounds for vector",
+                                *axis),
+                            name, codename));
+                }
             }
+
+            auto v = value.vector();
+            blaze::DynamicVector<T> result(v.size());
+
+            scan_items<Acc>(v.size(), v.size(),
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        acc.add(v[i]);
+                    }
+                },
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        acc.add(v[i]);
+                        result[i] = acc.get();
+                    }
+                });
+
+            return primitive_argument_type{std::move(result)};
         }
 
-        return primitive_argument_type{std::move(result)};
-    }
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative2d_noaxis(ir::node_data<T>&& value)
+        {
+            auto m = value.matrix();
+
+            std::size_t const columns = m.columns();
+            blaze::DynamicVector<T> result(m.rows() * columns);
+
+            // the rows of the matrix are scanned as one sequence
+            scan_items<Acc>(m.rows(), m.rows() * columns,
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            acc.add(m(i, j));
+                        }
+                    }
+                },
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            acc.add(m(i, j));
+                            result[i * columns + j] = acc.get();
+                        }
+                    }
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
 
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative3d_pages(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative2d_columns(ir::node_data<T>&& value)
+        {
+            auto m = value.matrix();
+            blaze::DynamicMatrix<T> result(m.rows(), m.columns());
+
+            scan_columns<Acc>(m.rows(), m.columns(),
+                [&](std::size_t i, std::size_t j) { return m(i, j); },
+                [&](std::size_t i, std::size_t j, T val) {
+                    result(i, j) = val;
+                });
 
-        auto t = value.tensor();
+            return primitive_argument_type{std::move(result)};
+        }
 
-        blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t i = 0; i != t.rows(); ++i)
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative2d_rows(ir::node_data<T>&& value)
         {
-            auto slice = blaze::rowslice(t, i);
-            auto result_slice = blaze::rowslice(result, i);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+            auto m = value.matrix();
+            blaze::DynamicMatrix<T> result(m.rows(), m.columns());
+
+            std::size_t const columns = m.columns();
+            scan_for_each(
+                m.rows() * columns, m.rows(), [&](std::size_t i) {
+                    Acc acc;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        acc.add(m(i, j));
+                        result(i, j) = acc.get();
+                    }
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative2d(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis,
+            std::string const& name, std::string const& codename)
+        {
+            if (axis)
             {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
+                // make sure that axis, if given, is in valid range
+                if (*axis < -2 || *axis > 1)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cumulative<Op, Derived>::cumulative2d<T>",
+                        util::generate_error_message(
+                            hpx::util::format(
+                                "axis {:d} is out of bounds for matrix",
+                                *axis),
+                            name, codename));
+                }
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
+                switch (*axis)
+                {
+                case -2:
+                case 0:         // cumulative operation over columns
+                    return cumulative2d_columns<Acc>(std::move(value));
+
+                case -1:
+                case 1:         // cumulative operation over rows
+                    return cumulative2d_rows<Acc>(std::move(value));
+                }
             }
+
+            // no axis specified
+            return cumulative2d_noaxis<Acc>(std::move(value));
         }
 
-        return primitive_argument_type{std::move(result)};
-    }
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative3d_noaxis(ir::node_data<T>&& value)
+        {
+            auto t = value.tensor();
+
+            std::size_t const rows = t.rows();
+            std::size_t const columns = t.columns();
+            std::size_t const size = t.pages() * rows * columns;
+            blaze::DynamicVector<T> result(size);
+
+            // the rows of all pages are scanned as one sequence
+            scan_items<Acc>(t.pages() * rows, size,
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t r = begin; r != end; ++r)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            acc.add(t(r / rows, r % rows, j));
+                        }
+                    }
+                },
+                [&](Acc& acc, std::size_t begin, std::size_t end) {
+                    for (std::size_t r = begin; r != end; ++r)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            acc.add(t(r / rows, r % rows, j));
+                            result[r * columns + j] = acc.get();
+                        }
+                    }
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
 
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative3d_columns(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative3d_pages(ir::node_data<T>&& value)
+        {
+            auto t = value.tensor();
+
+            blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
+
+            // every row of the pages is scanned along the pages
+            scan_for_each(t.pages() * t.rows() * t.columns(), t.rows(),
+                [&](std::size_t i) {
+                    scan_columns<Acc>(t.pages(), t.columns(),
+                        [&](std::size_t k, std::size_t j) {
+                            return t(k, i, j);
+                        },
+                        [&](std::size_t k, std::size_t j, T val) {
+                            result(k, i, j) = val;
+                        });
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
 
-        auto t = value.tensor();
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative3d_columns(ir::node_data<T>&& value)
+        {
+            auto t = value.tensor();
+
+            blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
+
+            scan_for_each(t.pages() * t.rows() * t.columns(), t.pages(),
+                [&](std::size_t k) {
+                    scan_columns<Acc>(t.rows(), t.columns(),
+                        [&](std::size_t i, std::size_t j) {
+                            return t(k, i, j);
+                        },
+                        [&](std::size_t i, std::size_t j, T val) {
+                            result(k, i, j) = val;
+                        });
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative3d_rows(ir::node_data<T>&& value)
+        {
+            auto t = value.tensor();
+
+            std::size_t const rows = t.rows();
+            std::size_t const columns = t.columns();
+            blaze::DynamicTensor<T> result(t.pages(), rows, columns);
+
+            scan_for_each(t.pages() * rows * columns, t.pages() * rows,
+                [&](std::size_t r) {
+                    std::size_t const k = r / rows;
+                    std::size_t const i = r % rows;
+
+                    Acc acc;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        acc.add(t(k, i, j));
+                        result(k, i, j) = acc.get();
+                    }
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
 
-        blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative3d(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis,
+            std::string const& name, std::string const& codename)
         {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::columns(slice); ++j)
+            if (axis)
             {
-                auto col = blaze::column(slice, j);
-                auto result_col = blaze::column(result_slice, j);
+                // make sure that axis, if given, is in valid range
+                if (*axis < -3 || *axis > 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "cumulative<Op, Derived>::cumulative3d<T>",
+                        util::generate_error_message(
+                            hpx::util::format(
+                                "axis {:d} is out of bounds for tensor",
+                                *axis),
+                            name, codename));
+                }
 
-                Op{}(col.begin(), col.end(), result_col.begin(), init);
-            }
-        }
+                switch (*axis)
+                {
+                case -3:
+                case 0:         // cumulative operation over pages
+                    return cumulative3d_pages<Acc>(std::move(value));
 
-        return primitive_argument_type{std::move(result)};
-    }
+                case -2:
+                case 1:         // cumulative operation over columns
+                    return cumulative3d_columns<Acc>(std::move(value));
 
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative3d_rows(
-        primitive_arguments_type&& ops) const
-    {
-        ir::node_data<T> value = extract_node_data<T>(
-            std::move(ops[0]), name_, codename_);
+                case -1:
+                case 2:         // cumulative operation over rows
+                    return cumulative3d_rows<Acc>(std::move(value));
+                }
+            }
 
-        auto t = value.tensor();
+            // no axis specified
+            return cumulative3d_noaxis<Acc>(std::move(value));
+        }
 
-        blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Acc, typename T>
+        primitive_argument_type cumulative_dims(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis,
+            std::string const& name, std::string const& codename)
         {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+            switch (value.num_dimensions())
             {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
+            case 0:
+                return cumulative0d<Acc>(
+                    std::move(value), axis, name, codename);
+
+            case 1:
+                return cumulative1d<Acc>(
+                    std::move(value), axis, name, codename);
+
+            case 2:
+                return cumulative2d<Acc>(
+                    std::move(value), axis, name, codename);
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
+            case 3:
+                return cumulative3d<Acc>(
+                    std::move(value), axis, name, codename);
+
+            default:
+                break;
             }
-        }
 
-        return primitive_argument_type{std::move(result)};
-    }
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "cumulative<Op, Derived>::cumulative_helper<T>",
+                util::generate_error_message(
+                    "target operand has unsupported number of dimensions",
+                    name, codename));
+        }
 
-    template <typename Op, typename Derived>
-    template <typename T>
-    primitive_argument_type cumulative<Op, Derived>::cumulative3d(
-        primitive_arguments_type&& ops,
-        hpx::util::optional<std::int64_t>&& axis) const
-    {
-        if (axis)
+        template <typename Op, typename T>
+        primitive_argument_type cumulativend(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis, bool compensated,
+            std::string const& name, std::string const& codename,
+            std::true_type)
         {
-            // make sure that axis, if given, is in valid range
-            if (*axis < -3 || *axis > 2)
+            if (compensated)
             {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "cumulative<Op, Derived>::cumulative3d<T>",
-                    generate_error_message(hpx::util::format(
-                        "axis {:d} is out of bounds for tensor", *axis)));
+                return cumulative_dims<compensated_accumulator<T>>(
+                    std::move(value), axis, name, codename);
             }
+            return cumulative_dims<scan_accumulator<Op, T>>(
+                std::move(value), axis, name, codename);
+        }
 
-            switch (*axis)
-            {
-            case -3:
-            case 0:         // cumulative sum over pages
-                return cumulative3d_pages<T>(std::move(ops));
+        template <typename Op, typename T>
+        primitive_argument_type cumulativend(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis, bool compensated,
+            std::string const& name, std::string const& codename,
+            std::false_type)
+        {
+            return cumulative_dims<scan_accumulator<Op, T>>(
+                std::move(value), axis, name, codename);
+        }
 
-            case -2:
-            case 1:         // cumulative sum over columns
-                return cumulative3d_columns<T>(std::move(ops));
+        // Apply the inclusive scan defined by Op to the given data, the
+        // compensated summation is used only for floating point sums
+        template <typename Op, typename T>
+        primitive_argument_type cumulativend(ir::node_data<T>&& value,
+            hpx::util::optional<std::int64_t> const& axis, bool compensated,
+            std::string const& name, std::string const& codename)
+        {
+            using use_compensation = std::integral_constant<bool,
+                Op::compensable && std::is_floating_point<T>::value>;
 
-            case -1:
-            case 2:         // cumulative sum over rows
-                return cumulative3d_rows<T>(std::move(ops));
-            }
+            return cumulativend<Op>(std::move(value), axis, compensated,
+                name, codename, use_compensation{});
         }
-
-        // no axis specified
-        return cumulative3d_noaxis<T>(std::move(ops));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -350,31 +667,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
     template <typename T>
     primitive_argument_type cumulative<Op, Derived>::cumulative_helper(
         primitive_arguments_type&& ops,
-        hpx::util::optional<std::int64_t>&& axis) const
+        hpx::util::optional<std::int64_t>&& axis, bool compensated) const
     {
-        std::size_t dims =
-            extract_numeric_value_dimension(ops[0], name_, codename_);
-
-        switch (dims)
-        {
-        case 0:
-            return cumulative0d<T>(std::move(ops), std::move(axis));
-
-        case 1:
-            return cumulative1d<T>(std::move(ops), std::move(axis));
-
-        case 2:
-            return cumulative2d<T>(std::move(ops), std::move(axis));
-
-        case 3:
-            return cumulative3d<T>(std::move(ops), std::move(axis));
-
-        default:
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "cumulative<Op, Derived>::cumulative_helper<T>",
-                generate_error_message(
-                    "target operand has unsupported number of dimensions"));
-        }
+        return detail::cumulativend<Op>(
+            extract_node_data<T>(std::move(ops[0]), name_, codename_), axis,
+            compensated, name_, codename_);
     }
 
     template <typename Op, typename Derived>
@@ -382,12 +679,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 3)
+        if (operands.empty() || operands.size() > 4)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "cumulative<Op, Derived>::eval",
                 generate_error_message(
-                    "the cumulative primitive requires one, two, or three "
+                    "the cumulative primitive requires between one and four "
                     "operands"));
         }
 
@@ -424,20 +721,27 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     t = extract_common_type(ops[0]);
                 }
 
+                bool compensated = false;
+                if (ops.size() >= 4 && valid(ops[3]))
+                {
+                    compensated = extract_scalar_boolean_value(
+                        std::move(ops[3]), this_->name_, this_->codename_);
+                }
+
                 switch (t)
                 {
                 case node_data_type_bool:
                     return this_->template cumulative_helper<std::uint8_t>(
-                        std::move(ops), std::move(axis));
+                        std::move(ops), std::move(axis), compensated);
 
                 case node_data_type_int64:
                     return this_->template cumulative_helper<std::int64_t>(
-                        std::move(ops), std::move(axis));
+                        std::move(ops), std::move(axis), compensated);
 
                 case node_data_type_unknown: HPX_FALLTHROUGH;
                 case node_data_type_double:
                     return this_->template cumulative_helper<double>(
-                        std::move(ops), std::move(axis));
+                        std::move(ops), std::move(axis), compensated);
 
                 default:
                     break;
@@ -0,0 +1,105 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FUSED_ELEMENTWISE_OCT_18_2020_1022AM)
+#define PHYLANX_PRIMITIVES_FUSED_ELEMENTWISE_OCT_18_2020_1022AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The __fused primitive is not meant to be used directly. It is created
+    // by the compiler whenever it finds a chain of (at least two) nested
+    // element-wise operations (__add, __sub, __mul, __div, __minus, maximum,
+    // minimum, and the unary functions implemented by __gen). All of those
+    // are evaluated in a single pass over the data without materializing
+    // any intermediate arrays.
+    //
+    // The operands are:
+    //
+    //   - the fused expression in postfix notation, where '$<n>' refers to
+    //     the n-th leaf operand (for instance "$0 $1 __mul $2 __add exp"),
+    //   - the unfused expression tree (referring to the leaf values through
+    //     access-argument primitives) that is used whenever the leaf values
+    //     can't be handled by the fused kernel (non-float data, broadcasting,
+    //     annotated or list operands, etc.),
+    //   - the leaf operands.
+    //
+    class fused_elementwise
+      : public primitive_component_base
+      , public std::enable_shared_from_this<fused_elementwise>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        fused_elementwise() = default;
+
+        fused_elementwise(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        using unary_function_ptr =
+            void (*)(double* dest, double const* src, std::size_t count);
+
+        struct instruction
+        {
+            enum opcode_type
+            {
+                load,
+                add,
+                sub,
+                mul,
+                div,
+                maximum,
+                minimum,
+                unary
+            };
+
+            opcode_type opcode_;
+            std::size_t leaf_;              // leaf operand to load
+            unary_function_ptr func_;       // unary function to apply
+            bool retains_type_;             // unary function keeps dtype
+        };
+
+    private:
+        bool supports_fused_evaluation(
+            primitive_arguments_type const& leaves) const;
+
+        primitive_argument_type fused_evaluation(
+            primitive_arguments_type&& leaves) const;
+
+    private:
+        std::vector<instruction> program_;
+        std::size_t stack_depth_;
+        primitive_argument_type fallback_;
+    };
+
+    inline primitive create_fused_elementwise(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__fused", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
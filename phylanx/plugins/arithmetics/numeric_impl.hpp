@@ -14,11 +14,13 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/ir/ranges.hpp>
 #include <phylanx/plugins/arithmetics/numeric.hpp>
+#include <phylanx/util/storage_pool.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -33,6 +35,22 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    namespace detail
+    {
+        // Operands that already have the shape of the result don't need to
+        // be broadcast. Handing them through unchanged avoids copying the
+        // data of operands referring to values held elsewhere.
+        inline bool has_result_shape(primitive_argument_type const& op,
+            std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& sizes,
+            std::size_t numdims, std::string const& name,
+            std::string const& codename)
+        {
+            return extract_numeric_value_dimension(op, name, codename) ==
+                    numdims &&
+                extract_numeric_value_dimensions(op, name, codename) == sizes;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Op, typename Derived>
     numeric<Op, Derived>::numeric(primitive_arguments_type&& operands,
@@ -106,7 +124,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // Cannot reuse the memory if an operand is a reference
             if (rhs.is_ref())
             {
-                rhs = Op{}(lhs.vector(), rhs.vector());
+                auto v = util::storage_pool<T>::vector(lhs.size());
+                v = Op{}(lhs.vector(), rhs.vector());
+                rhs = std::move(v);
             }
             else
             {
@@ -133,7 +153,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 if (result.is_ref())
                 {
-                    result = Op{}(result.vector(), curr.vector());
+                    auto v = util::storage_pool<T>::vector(result.size());
+                    v = Op{}(result.vector(), curr.vector());
+                    result = std::move(v);
                     return std::move(result);
                 }
                 else
@@ -157,7 +179,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // Cannot reuse the memory if an operand is a reference
             if (rhs.is_ref())
             {
-                rhs = Op{}(lhs.matrix(), rhs.matrix());
+                auto m = util::storage_pool<T>::matrix(
+                    lhs.dimension(0), lhs.dimension(1));
+                m = Op{}(lhs.matrix(), rhs.matrix());
+                rhs = std::move(m);
             }
             else
             {
@@ -184,7 +209,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 if (result.is_ref())
                 {
-                    result = Op{}(result.matrix(), curr.matrix());
+                    auto m = util::storage_pool<T>::matrix(
+                        result.dimension(0), result.dimension(1));
+                    m = Op{}(result.matrix(), curr.matrix());
+                    result = std::move(m);
                 }
                 else
                 {
@@ -207,7 +235,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // Cannot reuse the memory if an operand is a reference
             if (rhs.is_ref())
             {
-                rhs = Op{}(lhs.tensor(), rhs.tensor());
+                auto t = util::storage_pool<T>::tensor(lhs.dimension(0),
+                    lhs.dimension(1), lhs.dimension(2));
+                t = Op{}(lhs.tensor(), rhs.tensor());
+                rhs = std::move(t);
             }
             else
             {
@@ -235,7 +266,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 if (result.is_ref())
                 {
-                    result = Op{}(result.tensor(), curr.tensor());
+                    auto t = util::storage_pool<T>::tensor(
+                        result.dimension(0), result.dimension(1),
+                        result.dimension(2));
+                    t = Op{}(result.tensor(), curr.tensor());
+                    result = std::move(t);
                 }
                 else
                 {
@@ -269,10 +304,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     auto sizes =
                         extract_largest_dimensions(name_, codename_, op1, op2);
 
-                    auto lhs = extract_value_vector<T>(
-                        std::move(op1), sizes[0], name_, codename_);
-                    auto rhs = extract_value_vector<T>(
-                        std::move(op2), sizes[0], name_, codename_);
+                    auto lhs = detail::has_result_shape(
+                                   op1, sizes, 1, name_, codename_) ?
+                        extract_node_data<T>(std::move(op1), name_, codename_) :
+                        extract_value_vector<T>(
+                            std::move(op1), sizes[0], name_, codename_);
+                    auto rhs = detail::has_result_shape(
+                                   op2, sizes, 1, name_, codename_) ?
+                        extract_node_data<T>(std::move(op2), name_, codename_) :
+                        extract_value_vector<T>(
+                            std::move(op2), sizes[0], name_, codename_);
 
                     return numeric1d1d<T>(std::move(lhs), std::move(rhs));
                 }
@@ -290,10 +331,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     auto sizes =
                         extract_largest_dimensions(name_, codename_, op1, op2);
 
-                    auto lhs = extract_value_matrix<T>(
-                        std::move(op1), sizes[0], sizes[1], name_, codename_);
-                    auto rhs = extract_value_matrix<T>(
-                        std::move(op2), sizes[0], sizes[1], name_, codename_);
+                    auto lhs = detail::has_result_shape(
+                                   op1, sizes, 2, name_, codename_) ?
+                        extract_node_data<T>(std::move(op1), name_, codename_) :
+                        extract_value_matrix<T>(std::move(op1), sizes[0],
+                            sizes[1], name_, codename_);
+                    auto rhs = detail::has_result_shape(
+                                   op2, sizes, 2, name_, codename_) ?
+                        extract_node_data<T>(std::move(op2), name_, codename_) :
+                        extract_value_matrix<T>(std::move(op2), sizes[0],
+                            sizes[1], name_, codename_);
 
                     return numeric2d2d<T>(std::move(lhs), std::move(rhs));
                 }
@@ -311,10 +358,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     auto sizes =
                         extract_largest_dimensions(name_, codename_, op1, op2);
 
-                    auto lhs = extract_value_tensor<T>(std::move(op1), sizes[0],
-                        sizes[1], sizes[2], name_, codename_);
-                    auto rhs = extract_value_tensor<T>(std::move(op2), sizes[0],
-                        sizes[1], sizes[2], name_, codename_);
+                    auto lhs = detail::has_result_shape(
+                                   op1, sizes, 3, name_, codename_) ?
+                        extract_node_data<T>(std::move(op1), name_, codename_) :
+                        extract_value_tensor<T>(std::move(op1), sizes[0],
+                            sizes[1], sizes[2], name_, codename_);
+                    auto rhs = detail::has_result_shape(
+                                   op2, sizes, 3, name_, codename_) ?
+                        extract_node_data<T>(std::move(op2), name_, codename_) :
+                        extract_value_tensor<T>(std::move(op2), sizes[0],
+                            sizes[1], sizes[2], name_, codename_);
 
                     return numeric3d3d<T>(std::move(lhs), std::move(rhs));
                 }
@@ -345,30 +398,38 @@ namespace phylanx { namespace execution_tree { namespace primitives
             t = extract_common_type(op1, op2);
         }
 
+        std::vector<void const*> const operands = {
+            owned_array_data(op1), owned_array_data(op2)};
+
+        primitive_argument_type result;
         switch (t)
         {
         case node_data_type_bool:
-            return derived()
+            result = derived()
                 .template handle_numeric_operands_helper<std::uint8_t>(
                     std::move(op1), std::move(op2));
+            break;
 
         case node_data_type_int64:
-            return derived()
+            result = derived()
                 .template handle_numeric_operands_helper<std::int64_t>(
                     std::move(op1), std::move(op2));
+            break;
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
-            return derived().template handle_numeric_operands_helper<double>(
+            result = derived().template handle_numeric_operands_helper<double>(
                 std::move(op1), std::move(op2));
+            break;
 
         default:
-            break;
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "numeric::handle_numeric_operands",
+                generate_error_message("operand has unsupported type"));
         }
 
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "numeric::handle_numeric_operands",
-            generate_error_message("operand has unsupported type"));
+        count_result_storage(result, operands);
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -402,6 +463,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 for (auto && op : std::move(ops))
                 {
+                    if (detail::has_result_shape(
+                            op, sizes, 1, name_, codename_))
+                    {
+                        args.emplace_back(extract_node_data<T>(
+                            std::move(op), name_, codename_));
+                        continue;
+                    }
                     args.emplace_back(extract_value_vector<T>(
                         std::move(op), sizes[0], name_, codename_));
                 }
@@ -416,6 +484,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 for (auto && op : std::move(ops))
                 {
+                    if (detail::has_result_shape(
+                            op, sizes, 2, name_, codename_))
+                    {
+                        args.emplace_back(extract_node_data<T>(
+                            std::move(op), name_, codename_));
+                        continue;
+                    }
                     args.emplace_back(extract_value_matrix<T>(
                         std::move(op), sizes[0], sizes[1], name_, codename_));
                 }
@@ -430,6 +505,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 for (auto && op : std::move(ops))
                 {
+                    if (detail::has_result_shape(
+                            op, sizes, 3, name_, codename_))
+                    {
+                        args.emplace_back(extract_node_data<T>(
+                            std::move(op), name_, codename_));
+                        continue;
+                    }
                     args.emplace_back(extract_value_tensor<T>(std::move(op),
                         sizes[0], sizes[1], sizes[2], name_, codename_));
                 }
@@ -457,30 +539,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
             t = extract_common_type(ops);
         }
 
+        std::vector<void const*> operands;
+        operands.reserve(ops.size());
+        for (auto const& op : ops)
+        {
+            operands.push_back(owned_array_data(op));
+        }
+
+        primitive_argument_type result;
         switch (t)
         {
         case node_data_type_bool:
-            return derived()
+            result = derived()
                 .template handle_numeric_operands_helper<std::uint8_t>(
                     std::move(ops));
+            break;
 
         case node_data_type_int64:
-            return derived()
+            result = derived()
                 .template handle_numeric_operands_helper<std::int64_t>(
                     std::move(ops));
+            break;
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
-            return derived().template handle_numeric_operands_helper<double>(
+            result = derived().template handle_numeric_operands_helper<double>(
                 std::move(ops));
+            break;
 
         default:
-            break;
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "numeric::handle_numeric_operands",
+                generate_error_message("operand has unsupported type"));
         }
 
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "numeric::handle_numeric_operands",
-            generate_error_message("operand has unsupported type"));
+        count_result_storage(result, operands);
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
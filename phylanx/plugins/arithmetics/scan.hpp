@@ -0,0 +1,62 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_SCAN_OCT_18_2020_1120AM)
+#define PHYLANX_PRIMITIVES_SCAN_OCT_18_2020_1120AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/futures/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Inclusive scan of an array using one of the associative operations
+    // 'add', 'multiply', 'maximum', or 'minimum' (the equivalent of
+    // numpy.<op>.accumulate)
+    class scan_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<scan_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        scan_operation() = default;
+
+        scan_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        template <typename T>
+        primitive_argument_type scan(std::string const& op,
+            primitive_argument_type&& arg,
+            hpx::util::optional<std::int64_t> const& axis) const;
+    };
+
+    inline primitive create_scan_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "scan", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
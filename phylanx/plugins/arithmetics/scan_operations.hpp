@@ -0,0 +1,94 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_SCAN_OPERATIONS_OCT_18_2020_1105AM)
+#define PHYLANX_PRIMITIVES_SCAN_OPERATIONS_OCT_18_2020_1105AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/detail/numeric_limits_min.hpp>
+
+#include <algorithm>
+#include <limits>
+
+///////////////////////////////////////////////////////////////////////////////
+// The associative operations the cumulative primitives (cumsum, cumprod, and
+// scan) can be applied with.
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct cumsum_op
+        {
+            // the results may be computed using compensated summation
+            static constexpr bool compensable = true;
+
+            template <typename T>
+            static constexpr T initial()
+            {
+                return T(0);
+            }
+
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return T(lhs + rhs);
+            }
+        };
+
+        struct cumprod_op
+        {
+            static constexpr bool compensable = false;
+
+            template <typename T>
+            static constexpr T initial()
+            {
+                return T(1);
+            }
+
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return T(lhs * rhs);
+            }
+        };
+
+        struct cummax_op
+        {
+            static constexpr bool compensable = false;
+
+            template <typename T>
+            static constexpr T initial()
+            {
+                return phylanx::util::detail::numeric_limits_min<T>();
+            }
+
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::max)(lhs, rhs);
+            }
+        };
+
+        struct cummin_op
+        {
+            static constexpr bool compensable = false;
+
+            template <typename T>
+            static constexpr T initial()
+            {
+                return (std::numeric_limits<T>::max)();
+            }
+
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::min)(lhs, rhs);
+            }
+        };
+    }
+}}}
+
+#endif
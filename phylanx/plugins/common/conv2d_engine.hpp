@@ -0,0 +1,81 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_COMMON_CONV2D_ENGINE)
+#define PHYLANX_COMMON_CONV2D_ENGINE
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/common/export_definitions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+namespace phylanx { namespace common {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The algorithms available for computing 2D convolutions
+    enum class conv2d_backend
+    {
+        automatic,    // select based on the shapes involved
+        direct,       // straightforward nested loops (reference)
+        im2col,       // lower the convolution onto a matrix product
+        winograd      // Winograd F(2x2,3x3), 3x3 kernels with unit strides
+    };
+
+    PHYLANX_COMMON_EXPORT char const* conv2d_backend_name(
+        conv2d_backend backend);
+
+    // Return the backend as specified in the configuration
+    // (phylanx.conv2d_backend, one of 'auto', 'direct', 'im2col', or
+    // 'winograd'), defaults to 'auto'
+    PHYLANX_COMMON_EXPORT conv2d_backend conv2d_configured_backend();
+
+    // Geometry of a 2D convolution. The input is accessed at
+    // (i * stride - pad + a * dilation) for output element i and kernel
+    // element a, elements outside of the input are treated as zeros.
+    struct conv2d_parameters
+    {
+        std::int64_t stride_height = 1;
+        std::int64_t stride_width = 1;
+        std::int64_t dilation_height = 1;
+        std::int64_t dilation_width = 1;
+        std::int64_t pad_top = 0;
+        std::int64_t pad_left = 0;
+        std::size_t out_height = 0;
+        std::size_t out_width = 0;
+    };
+
+    // Select the backend to use for a convolution with the given kernel size
+    // and geometry, never returns conv2d_backend::automatic.
+    PHYLANX_COMMON_EXPORT conv2d_backend select_conv2d_backend(
+        std::size_t filter_height, std::size_t filter_width,
+        conv2d_parameters const& params,
+        conv2d_backend backend = conv2d_backend::automatic);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // 2D convolution (cross-correlation) of x (batch, in_height, in_width,
+    // in_channels) with kernel (filter_height, filter_width, in_channels,
+    // out_channels).
+    PHYLANX_COMMON_EXPORT blaze::DynamicArray<4UL, double> conv2d_compute(
+        ir::node_data<double> const& x, ir::node_data<double> const& kernel,
+        conv2d_parameters const& params,
+        conv2d_backend backend = conv2d_backend::automatic);
+
+    // 2D transposed convolution of x (batch, in_height, in_width,
+    // in_channels) with kernel (filter_height, filter_width, out_channels,
+    // in_channels). The padding refers to the equivalent convolution of the
+    // (stride-dilated) input with the flipped kernel.
+    PHYLANX_COMMON_EXPORT blaze::DynamicArray<4UL, double>
+    conv2d_transpose_compute(ir::node_data<double> const& x,
+        ir::node_data<double> const& kernel, conv2d_parameters const& params,
+        conv2d_backend backend = conv2d_backend::automatic);
+}}
+
+#endif
@@ -12,6 +12,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/export_definitions.hpp>
 #include <phylanx/plugins/common/dot_operation_nd.hpp>
+#include <phylanx/plugins/common/gemm_engine.hpp>
 #include <phylanx/util/generate_error_message.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
@@ -167,7 +168,7 @@ namespace phylanx { namespace common
                     name, codename));
         }
         // lhs = blaze::trans(rhs.matrix()) * lhs.vector();
-        lhs = blaze::trans(blaze::trans(lhs.vector()) * rhs.matrix());
+        lhs = gemv_trans(lhs.vector(), rhs.matrix());
         return execution_tree::primitive_argument_type{std::move(lhs)};
     }
 
@@ -275,9 +276,7 @@ namespace phylanx { namespace common
                     "the operands have incompatible number of dimensions",
                     name, codename));
         }
-        using T = blaze::ElementType_t<typename std::decay<Matrix1>::type>;
-        blaze::DynamicMatrix<T> result = lhs * rhs;
-        return execution_tree::primitive_argument_type{std::move(result)};
+        return execution_tree::primitive_argument_type{gemm(lhs, rhs)};
     }
 
     template <typename T>
@@ -460,10 +459,11 @@ namespace phylanx { namespace common
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), m.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.rows(), m.columns()),
-                0) = blaze::pageslice(t, i) * m;
+        gemm_for_each(t.pages(), t.rows(), t.columns(), m.columns(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                gemm_assign(blaze::pageslice(t, i), m, page, nested);
+            });
 
         return execution_tree::primitive_argument_type{std::move(result)};
     }
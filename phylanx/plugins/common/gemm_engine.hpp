@@ -0,0 +1,458 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_COMMON_GEMM_ENGINE)
+#define PHYLANX_COMMON_GEMM_ENGINE
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/common/export_definitions.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace common {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The backends available for computing matrix products
+    enum class gemm_backend
+    {
+        automatic,    // select based on the shapes and the element type
+        blaze,        // Blaze expression templates (SMP on the HPX pool)
+        cblas,        // external CBLAS (double only, if available)
+        packed        // built-in packed micro-kernel GEMM
+    };
+
+    PHYLANX_COMMON_EXPORT char const* gemm_backend_name(gemm_backend backend);
+
+    // Return the backend as specified in the configuration
+    // (phylanx.gemm_backend, one of 'auto', 'blaze', 'cblas', or 'packed'),
+    // defaults to 'auto'
+    PHYLANX_COMMON_EXPORT gemm_backend gemm_configured_backend();
+
+    // Return whether Phylanx was built with support for an external CBLAS
+    PHYLANX_COMMON_EXPORT bool gemm_cblas_available();
+
+    // Select the backend to use for a (rows x inner) * (inner x columns)
+    // product, never returns gemm_backend::automatic. Products that are
+    // part of a batch (nested == true) are computed concurrently with each
+    // other, they are never given to the external CBLAS as it manages its own
+    // threads.
+    PHYLANX_COMMON_EXPORT gemm_backend select_gemm_backend(std::size_t rows,
+        std::size_t inner, std::size_t columns, bool is_double, bool nested,
+        gemm_backend backend = gemm_backend::automatic);
+
+    // Return the number of HPX worker threads a single product of the given
+    // shape should be partitioned over (1 if it is too small to benefit)
+    PHYLANX_COMMON_EXPORT std::size_t gemm_partitions(
+        std::size_t rows, std::size_t inner, std::size_t columns);
+
+    // Row-major C (m x n) = A (m x k) * B (k x n) using the external CBLAS,
+    // throws if Phylanx was built without CBLAS support. The library is
+    // restricted to a single thread for the call.
+    PHYLANX_COMMON_EXPORT void gemm_cblas(std::size_t m, std::size_t n,
+        std::size_t k, double const* a, std::size_t lda, double const* b,
+        std::size_t ldb, double* c, std::size_t ldc);
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Register block of the micro-kernel and cache blocks of the packed
+        // operands (the packed rhs panel is sized to stay in L2, the lhs
+        // micro-panels in L1)
+        constexpr std::size_t gemm_micro_rows = 4;
+        constexpr std::size_t gemm_micro_columns = 8;
+        constexpr std::size_t gemm_block_rows = 96;
+        constexpr std::size_t gemm_block_depth = 256;
+        constexpr std::size_t gemm_block_columns = 512;
+
+        // c(i, j) += sum_p a(p, i) * b(p, j) for one micro tile, where a and
+        // b are the packed micro-panels
+        template <typename T>
+        void gemm_micro_kernel(std::size_t depth, T const* a, T const* b,
+            T (&c)[gemm_micro_rows][gemm_micro_columns])
+        {
+            for (std::size_t p = 0; p != depth; ++p)
+            {
+                T const* bp = b + p * gemm_micro_columns;
+                for (std::size_t i = 0; i != gemm_micro_rows; ++i)
+                {
+                    T const ai = a[p * gemm_micro_rows + i];
+                    for (std::size_t j = 0; j != gemm_micro_columns; ++j)
+                    {
+                        c[i][j] += ai * bp[j];
+                    }
+                }
+            }
+        }
+
+        // Pack lhs(row .. row + rows, k .. k + depth) into micro-panels of
+        // gemm_micro_rows rows, each stored depth-major, padded with zeros
+        template <typename T, typename Matrix>
+        void gemm_pack_lhs(Matrix const& lhs, std::size_t row,
+            std::size_t rows, std::size_t k, std::size_t depth,
+            std::vector<T>& packed)
+        {
+            std::size_t const panels =
+                (rows + gemm_micro_rows - 1) / gemm_micro_rows;
+            packed.resize(panels * gemm_micro_rows * depth);
+
+            T* dest = packed.data();
+            for (std::size_t ir = 0; ir < rows; ir += gemm_micro_rows)
+            {
+                std::size_t const mr = (std::min)(gemm_micro_rows, rows - ir);
+                for (std::size_t p = 0; p != depth; ++p)
+                {
+                    for (std::size_t i = 0; i != mr; ++i)
+                        *dest++ = lhs(row + ir + i, k + p);
+                    for (std::size_t i = mr; i != gemm_micro_rows; ++i)
+                        *dest++ = T(0);
+                }
+            }
+        }
+
+        // Pack rhs(k .. k + depth, column .. column + columns) into
+        // micro-panels of gemm_micro_columns columns, padded with zeros
+        template <typename T, typename Matrix>
+        void gemm_pack_rhs(Matrix const& rhs, std::size_t k, std::size_t depth,
+            std::size_t column, std::size_t columns, std::vector<T>& packed)
+        {
+            std::size_t const panels =
+                (columns + gemm_micro_columns - 1) / gemm_micro_columns;
+            packed.resize(panels * gemm_micro_columns * depth);
+
+            T* dest = packed.data();
+            for (std::size_t jr = 0; jr < columns; jr += gemm_micro_columns)
+            {
+                std::size_t const nr =
+                    (std::min)(gemm_micro_columns, columns - jr);
+                for (std::size_t p = 0; p != depth; ++p)
+                {
+                    for (std::size_t j = 0; j != nr; ++j)
+                        *dest++ = rhs(k + p, column + jr + j);
+                    for (std::size_t j = nr; j != gemm_micro_columns; ++j)
+                        *dest++ = T(0);
+                }
+            }
+        }
+
+        // Compute result(row .. row + rows, column .. column + columns) =
+        // lhs(row .. , :) * rhs(:, column .. ) for a panel of at most
+        // gemm_block_columns columns, sequentially
+        template <typename T, typename Matrix1, typename Matrix2,
+            typename Result>
+        void gemm_packed_panel(Matrix1 const& lhs, Matrix2 const& rhs,
+            Result& result, std::size_t row, std::size_t rows,
+            std::size_t column, std::size_t columns)
+        {
+            std::size_t const inner = lhs.columns();
+
+            for (std::size_t i = 0; i != rows; ++i)
+                for (std::size_t j = 0; j != columns; ++j)
+                    result(row + i, column + j) = T(0);
+
+            std::vector<T> packed_lhs;
+            std::vector<T> packed_rhs;
+
+            for (std::size_t k = 0; k < inner; k += gemm_block_depth)
+            {
+                std::size_t const depth =
+                    (std::min)(gemm_block_depth, inner - k);
+
+                gemm_pack_rhs<T>(rhs, k, depth, column, columns, packed_rhs);
+
+                for (std::size_t ic = 0; ic < rows; ic += gemm_block_rows)
+                {
+                    std::size_t const mc =
+                        (std::min)(gemm_block_rows, rows - ic);
+
+                    gemm_pack_lhs<T>(lhs, row + ic, mc, k, depth, packed_lhs);
+
+                    for (std::size_t jr = 0; jr < columns;
+                         jr += gemm_micro_columns)
+                    {
+                        std::size_t const nr =
+                            (std::min)(gemm_micro_columns, columns - jr);
+                        T const* b = packed_rhs.data() + jr * depth;
+
+                        for (std::size_t ir = 0; ir < mc;
+                             ir += gemm_micro_rows)
+                        {
+                            std::size_t const mr =
+                                (std::min)(gemm_micro_rows, mc - ir);
+                            T const* a = packed_lhs.data() + ir * depth;
+
+                            T c[gemm_micro_rows][gemm_micro_columns] = {};
+                            gemm_micro_kernel(depth, a, b, c);
+
+                            for (std::size_t i = 0; i != mr; ++i)
+                                for (std::size_t j = 0; j != nr; ++j)
+                                    result(row + ic + ir + i,
+                                        column + jr + j) += c[i][j];
+                        }
+                    }
+                }
+            }
+        }
+
+        template <typename T, typename Matrix1, typename Matrix2,
+            typename Result>
+        void gemm_packed_block(Matrix1 const& lhs, Matrix2 const& rhs,
+            Result& result, std::size_t row, std::size_t rows,
+            std::size_t column, std::size_t columns)
+        {
+            for (std::size_t jc = 0; jc < columns; jc += gemm_block_columns)
+            {
+                gemm_packed_panel<T>(lhs, rhs, result, row, rows,
+                    column + jc, (std::min)(gemm_block_columns, columns - jc));
+            }
+        }
+
+        // Partition the result into row and column blocks and compute those
+        // concurrently on the HPX pool
+        template <typename Matrix1, typename Matrix2, typename Result>
+        void gemm_packed(Matrix1 const& lhs, Matrix2 const& rhs,
+            Result& result, std::size_t partitions)
+        {
+            using T = blaze::ElementType_t<Result>;
+
+            std::size_t const rows = lhs.rows();
+            std::size_t const columns = rhs.columns();
+            if (rows == 0 || columns == 0)
+                return;
+
+            if (partitions <= 1)
+            {
+                gemm_packed_block<T>(lhs, rhs, result, 0, rows, 0, columns);
+                return;
+            }
+
+            // split the rows first, the columns only if there are not enough
+            // row blocks to keep all partitions busy
+            std::size_t const row_blocks = (std::min)(partitions,
+                (rows + gemm_micro_rows - 1) / gemm_micro_rows);
+            std::size_t const column_blocks = (std::min)(
+                (partitions + row_blocks - 1) / row_blocks,
+                (columns + gemm_micro_columns - 1) / gemm_micro_columns);
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0),
+                row_blocks * column_blocks, [&](std::size_t index) {
+                    std::size_t const rb = index / column_blocks;
+                    std::size_t const cb = index % column_blocks;
+
+                    std::size_t const row = rb * rows / row_blocks;
+                    std::size_t const column = cb * columns / column_blocks;
+
+                    gemm_packed_block<T>(lhs, rhs, result, row,
+                        (rb + 1) * rows / row_blocks - row, column,
+                        (cb + 1) * columns / column_blocks - column);
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Access the row-major storage of a CBLAS operand, the operand is
+        // copied if it does not expose such storage
+        template <typename Matrix>
+        double const* gemm_cblas_operand(Matrix const& m,
+            blaze::DynamicMatrix<double>& storage, std::size_t& spacing)
+        {
+            storage = m;
+            spacing = storage.spacing();
+            return storage.data();
+        }
+
+        template <bool AF, bool PF>
+        double const* gemm_cblas_operand(
+            blaze::CustomMatrix<double, AF, PF, blaze::rowMajor> const& m,
+            blaze::DynamicMatrix<double>&, std::size_t& spacing)
+        {
+            spacing = m.spacing();
+            return m.data();
+        }
+
+        inline double const* gemm_cblas_operand(
+            blaze::DynamicMatrix<double, blaze::rowMajor> const& m,
+            blaze::DynamicMatrix<double>&, std::size_t& spacing)
+        {
+            spacing = m.spacing();
+            return m.data();
+        }
+
+        // The library runs single threaded (see gemm_cblas), large products
+        // are split into row blocks that are computed concurrently instead
+        template <typename Matrix1, typename Matrix2, typename Result>
+        void gemm_cblas_assign(Matrix1 const& lhs, Matrix2 const& rhs,
+            Result& result, std::size_t partitions, std::true_type)
+        {
+            blaze::DynamicMatrix<double> lhs_storage, rhs_storage;
+            std::size_t lda = 0, ldb = 0;
+
+            double const* a = gemm_cblas_operand(lhs, lhs_storage, lda);
+            double const* b = gemm_cblas_operand(rhs, rhs_storage, ldb);
+
+            std::size_t const rows = lhs.rows();
+            std::size_t const inner = lhs.columns();
+            std::size_t const columns = rhs.columns();
+
+            blaze::DynamicMatrix<double> c(rows, columns);
+            if (partitions <= 1 || rows < 2)
+            {
+                gemm_cblas(rows, columns, inner, a, lda, b, ldb, c.data(),
+                    c.spacing());
+            }
+            else
+            {
+                std::size_t const row_blocks = (std::min)(partitions, rows);
+                std::size_t const ldc = c.spacing();
+                double* data = c.data();
+
+                hpx::for_loop(hpx::execution::par, std::size_t(0),
+                    row_blocks, [&](std::size_t rb) {
+                        std::size_t const row = rb * rows / row_blocks;
+                        gemm_cblas((rb + 1) * rows / row_blocks - row,
+                            columns, inner, a + row * lda, lda, b, ldb,
+                            data + row * ldc, ldc);
+                    });
+            }
+
+            result = c;
+        }
+
+        template <typename Matrix1, typename Matrix2, typename Result>
+        void gemm_cblas_assign(Matrix1 const& lhs, Matrix2 const& rhs,
+            Result& result, std::size_t, std::false_type)
+        {
+            // never selected for non-double element types
+            result = blaze::serial(lhs * rhs);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Assign the product lhs * rhs to the (correctly sized) result. The
+    // operands and the result can be arbitrary dense Blaze matrices or
+    // views. Set nested to true if the product is computed concurrently with
+    // other products (e.g. for the pages of a tensor), in which case the
+    // product itself is computed sequentially.
+    template <typename Matrix1, typename Matrix2, typename Result>
+    void gemm_assign(Matrix1 const& lhs, Matrix2 const& rhs, Result& result,
+        bool nested = false, gemm_backend backend = gemm_backend::automatic)
+    {
+        using T = blaze::ElementType_t<Result>;
+        using is_double = std::is_same<T, double>;
+
+        std::size_t const rows = lhs.rows();
+        std::size_t const inner = lhs.columns();
+        std::size_t const columns = rhs.columns();
+
+        std::size_t const partitions =
+            nested ? 1 : gemm_partitions(rows, inner, columns);
+
+        switch (select_gemm_backend(
+            rows, inner, columns, is_double::value, nested, backend))
+        {
+        case gemm_backend::cblas:
+            detail::gemm_cblas_assign(
+                lhs, rhs, result, partitions, is_double{});
+            break;
+
+        case gemm_backend::packed:
+            detail::gemm_packed(lhs, rhs, result, partitions);
+            break;
+
+        default:
+            // Blaze parallelizes on the HPX pool, restrict it to products
+            // that are large enough and not already run concurrently
+            if (partitions > 1)
+            {
+                result = lhs * rhs;
+            }
+            else
+            {
+                result = blaze::serial(lhs * rhs);
+            }
+            break;
+        }
+    }
+
+    // Return the product lhs * rhs
+    template <typename Matrix1, typename Matrix2>
+    blaze::DynamicMatrix<blaze::ElementType_t<Matrix1>> gemm(
+        Matrix1 const& lhs, Matrix2 const& rhs, bool nested = false,
+        gemm_backend backend = gemm_backend::automatic)
+    {
+        blaze::DynamicMatrix<blaze::ElementType_t<Matrix1>> result(
+            lhs.rows(), rhs.columns());
+        gemm_assign(lhs, rhs, result, nested, backend);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(i) for each of the given number of products of the given
+    // shape. The products are run concurrently if there is enough work
+    // overall, f is expected to compute its product with nested == true in
+    // that case (it is passed as the second argument).
+    template <typename F>
+    void gemm_for_each(std::size_t batch, std::size_t rows, std::size_t inner,
+        std::size_t columns, F&& f)
+    {
+        if (batch > 1 && gemm_partitions(rows * batch, inner, columns) > 1)
+        {
+            hpx::for_loop(hpx::execution::par, std::size_t(0), batch,
+                [&](std::size_t i) { f(i, true); });
+        }
+        else
+        {
+            for (std::size_t i = 0; i != batch; ++i)
+                f(i, false);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return trans(vector) * matrix, the product of a vector with a row-major
+    // matrix (the transposed matrix-vector product). The columns of the
+    // matrix are split into blocks that are computed concurrently, each
+    // block sweeps the matrix rows with unit stride.
+    template <typename Vector, typename Matrix>
+    blaze::DynamicVector<blaze::ElementType_t<Matrix>> gemv_trans(
+        Vector const& vector, Matrix const& matrix)
+    {
+        using T = blaze::ElementType_t<Matrix>;
+
+        std::size_t const rows = matrix.rows();
+        std::size_t const columns = matrix.columns();
+        std::size_t const partitions = gemm_partitions(1, rows, columns);
+
+        if (partitions <= 1)
+        {
+            blaze::DynamicVector<T> result =
+                blaze::serial(blaze::trans(matrix) * vector);
+            return result;
+        }
+
+        blaze::DynamicVector<T> result(columns, T(0));
+        hpx::for_loop(hpx::execution::par, std::size_t(0), partitions,
+            [&](std::size_t part) {
+                std::size_t const begin = part * columns / partitions;
+                std::size_t const size =
+                    (part + 1) * columns / partitions - begin;
+
+                auto r = blaze::subvector(result, begin, size);
+                for (std::size_t i = 0; i != rows; ++i)
+                {
+                    r += vector[i] *
+                        blaze::trans(blaze::subvector(
+                            blaze::row(matrix, i), begin, size));
+                }
+            });
+        return result;
+    }
+}}
+
+#endif
@@ -11,6 +11,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/statistics_nd.hpp>
+#include <phylanx/plugins/common/statistics_reduction.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
 
 #include <hpx/assert.hpp>
@@ -85,7 +86,13 @@ namespace phylanx { namespace common {
             }
 
             auto v = arg.vector();
-            T result = op(v, initial_value);
+            Init result = statistics_reduce(op, initial_value, v.size(),
+                v.size(),
+                [&](Op<T>& chunk_op, Init value, std::size_t begin,
+                    std::size_t end) -> Init {
+                    auto part = blaze::subvector(v, begin, end - begin);
+                    return chunk_op(part, value);
+                });
 
             if (keepdims)
             {
@@ -191,7 +198,14 @@ namespace phylanx { namespace common {
             }
 
             auto v = arg.vector();
-            T result = op(v, initial_value);
+            Init result = statistics_reduce(op, initial_value, v.size(),
+                v.size(),
+                [&](Op<T>& chunk_op, Init value, std::size_t begin,
+                    std::size_t end) -> Init {
+                    auto part = blaze::subvector(v, begin, end - begin);
+                    return chunk_op(part, value);
+                });
+
             if (keepdims)
             {
                 using result_type = typename Op<T>::result_type;
@@ -215,7 +229,6 @@ namespace phylanx { namespace common {
             auto m = arg.matrix();
 
             Op<T> op{name, codename};
-            std::size_t size = 0;
 
             Init result = Op<T>::initial();
             if (initial)
@@ -223,12 +236,17 @@ namespace phylanx { namespace common {
                 result = *initial;
             }
 
-            for (std::size_t i = 0; i != m.rows(); ++i)
-            {
-                auto row = blaze::row(m, i);
-                result = op(row, result);
-                size += row.size();
-            }
+            std::size_t const size = m.rows() * m.columns();
+            result = statistics_reduce(op, result, m.rows(), size,
+                [&](Op<T>& chunk_op, Init value, std::size_t begin,
+                    std::size_t end) -> Init {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        auto row = blaze::row(m, i);
+                        value = chunk_op(row, value);
+                    }
+                    return value;
+                });
 
             if (keepdims)
             {
@@ -259,15 +277,16 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                m.columns(), initial_value, name, codename);
+            reduction.columns(m, 0);
+
             if (keepdims)
             {
                 blaze::DynamicMatrix<result_type> result(1, m.columns());
                 for (std::size_t i = 0; i != m.columns(); ++i)
                 {
-                    Op<T> op{name, codename};
-                    auto col = blaze::column(m, i);
-                    result(0, i) =
-                        op.finalize(op(col, initial_value), col.size());
+                    result(0, i) = reduction.finalize(i, m.rows());
                 }
 
                 return execution_tree::primitive_argument_type{
@@ -277,9 +296,7 @@ namespace phylanx { namespace common {
             blaze::DynamicVector<result_type> result(m.columns());
             for (std::size_t i = 0; i != m.columns(); ++i)
             {
-                Op<T> op{name, codename};
-                auto col = blaze::column(m, i);
-                result[i] = op.finalize(op(col, initial_value), col.size());
+                result[i] = reduction.finalize(i, m.rows());
             }
 
             return execution_tree::primitive_argument_type{std::move(result)};
@@ -301,15 +318,16 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                m.rows(), initial_value, name, codename);
+            reduction.rows(m, 0);
+
             if (keepdims)
             {
                 blaze::DynamicMatrix<result_type> result(m.rows(), 1);
                 for (std::size_t i = 0; i != m.rows(); ++i)
                 {
-                    Op<T> op{name, codename};
-                    auto row = blaze::row(m, i);
-                    result(i, 0) =
-                        op.finalize(op(row, initial_value), row.size());
+                    result(i, 0) = reduction.finalize(i, m.columns());
                 }
 
                 return execution_tree::primitive_argument_type{
@@ -319,9 +337,7 @@ namespace phylanx { namespace common {
             blaze::DynamicVector<result_type> result(m.rows());
             for (std::size_t i = 0; i != m.rows(); ++i)
             {
-                Op<T> op{name, codename};
-                auto row = blaze::row(m, i);
-                result[i] = op.finalize(op(row, initial_value), row.size());
+                result[i] = reduction.finalize(i, m.columns());
             }
 
             return execution_tree::primitive_argument_type{std::move(result)};
@@ -424,27 +440,27 @@ namespace phylanx { namespace common {
             std::string const& codename, execution_tree::eval_context ctx)
         {
             auto t = arg.tensor();
+            auto rows = statistics_tensor_rows(t);
 
             Op<T> op{name, codename};
 
-            std::size_t size = 0;
-
             Init result = Op<T>::initial();
             if (initial)
             {
                 result = *initial;
             }
 
-            for (std::size_t k = 0; k != t.pages(); ++k)
-            {
-                auto page = blaze::pageslice(t, k);
-                for (std::size_t i = 0; i != t.rows(); ++i)
-                {
-                    auto row = blaze::row(page, i);
-                    result = op(row, result);
-                    size += row.size();
-                }
-            }
+            std::size_t const size = t.pages() * t.rows() * t.columns();
+            result = statistics_reduce(op, result, rows.rows(), size,
+                [&](Op<T>& chunk_op, Init value, std::size_t begin,
+                    std::size_t end) -> Init {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        auto row = blaze::row(rows, i);
+                        value = chunk_op(row, value);
+                    }
+                    return value;
+                });
 
             if (keepdims)
             {
@@ -475,19 +491,25 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            // element (i, j) of the result is the reduction of column
+            // i * spacing + j of the pages viewed as rows of a matrix
+            auto pages = statistics_tensor_pages(t);
+            std::size_t const spacing = t.spacing();
+
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                pages.columns(), initial_value, name, codename);
+            reduction.columns(pages, 0);
+
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(
                     1, t.rows(), t.columns());
                 for (std::size_t i = 0; i != t.rows(); ++i)
                 {
-                    auto slice = blaze::rowslice(t, i);
                     for (std::size_t j = 0; j != t.columns(); ++j)
                     {
-                        Op<T> op{name, codename};
-                        auto row = blaze::row(slice, j);
                         result(0, i, j) =
-                            op.finalize(op(row, initial_value), row.size());
+                            reduction.finalize(i * spacing + j, t.pages());
                     }
                 }
 
@@ -498,13 +520,10 @@ namespace phylanx { namespace common {
             blaze::DynamicMatrix<result_type> result(t.rows(), t.columns());
             for (std::size_t i = 0; i != t.rows(); ++i)
             {
-                auto slice = blaze::rowslice(t, i);
                 for (std::size_t j = 0; j != t.columns(); ++j)
                 {
-                    Op<T> op{name, codename};
-                    auto row = blaze::row(slice, j);
                     result(i, j) =
-                        op.finalize(op(row, initial_value), row.size());
+                        reduction.finalize(i * spacing + j, t.pages());
                 }
             }
 
@@ -527,19 +546,24 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                t.pages() * t.columns(), initial_value, name, codename);
+            statistics_for_each(t.pages() * t.rows() * t.columns(), t.pages(),
+                [&](std::size_t k) {
+                    auto slice = blaze::pageslice(t, k);
+                    reduction.columns(slice, k * t.columns());
+                });
+
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(
                     t.pages(), 1, t.columns());
                 for (std::size_t k = 0; k != t.pages(); ++k)
                 {
-                    auto slice = blaze::pageslice(t, k);
                     for (std::size_t j = 0; j != t.columns(); ++j)
                     {
-                        Op<T> op{name, codename};
-                        auto col = blaze::column(slice, j);
-                        result(k, 0, j) =
-                            op.finalize(op(col, initial_value), col.size());
+                        result(k, 0, j) = reduction.finalize(
+                            k * t.columns() + j, t.rows());
                     }
                 }
 
@@ -550,13 +574,10 @@ namespace phylanx { namespace common {
             blaze::DynamicMatrix<result_type> result(t.pages(), t.columns());
             for (std::size_t k = 0; k != t.pages(); ++k)
             {
-                auto slice = blaze::pageslice(t, k);
                 for (std::size_t j = 0; j != t.columns(); ++j)
                 {
-                    Op<T> op{name, codename};
-                    auto col = blaze::column(slice, j);
                     result(k, j) =
-                        op.finalize(op(col, initial_value), col.size());
+                        reduction.finalize(k * t.columns() + j, t.rows());
                 }
             }
 
@@ -579,19 +600,23 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            // the rows of all pages are reduced independently
+            auto rows = statistics_tensor_rows(t);
+
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                rows.rows(), initial_value, name, codename);
+            reduction.rows(rows, 0);
+
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(
                     t.pages(), t.rows(), 1);
                 for (std::size_t k = 0; k != t.pages(); ++k)
                 {
-                    auto slice = blaze::pageslice(t, k);
                     for (std::size_t i = 0; i != t.rows(); ++i)
                     {
-                        Op<T> op{name, codename};
-                        auto row = blaze::row(slice, i);
-                        result(k, i, 0) =
-                            op.finalize(op(row, initial_value), row.size());
+                        result(k, i, 0) = reduction.finalize(
+                            k * t.rows() + i, t.columns());
                     }
                 }
 
@@ -602,13 +627,10 @@ namespace phylanx { namespace common {
             blaze::DynamicMatrix<result_type> result(t.pages(), t.rows());
             for (std::size_t k = 0; k != t.pages(); ++k)
             {
-                auto slice = blaze::pageslice(t, k);
                 for (std::size_t i = 0; i != t.rows(); ++i)
                 {
-                    Op<T> op{name, codename};
-                    auto row = blaze::row(slice, i);
                     result(k, i) =
-                        op.finalize(op(row, initial_value), row.size());
+                        reduction.finalize(k * t.rows() + i, t.columns());
                 }
             }
 
@@ -734,15 +756,21 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            // reduce axes 0 and 1 in one pass over the columns of the rows of
+            // all pages
+            auto rows = statistics_tensor_rows(t);
+
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                t.columns(), initial_value, name, codename);
+            reduction.columns(rows, 0);
+
+            std::size_t const size = t.pages() * t.rows();
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(1, 1, t.columns());
                 for (std::size_t k = 0; k != t.columns(); ++k)
                 {
-                    Op<T> op{name, codename};
-                    auto slice = blaze::ravel(blaze::columnslice(t, k));
-                    result(0, 0, k) =
-                        op.finalize(op(slice, initial_value), slice.size());
+                    result(0, 0, k) = reduction.finalize(k, size);
                 }
 
                 return execution_tree::primitive_argument_type{
@@ -752,9 +780,7 @@ namespace phylanx { namespace common {
             blaze::DynamicVector<result_type> result(t.columns());
             for (std::size_t k = 0; k != t.columns(); ++k)
             {
-                Op<T> op{name, codename};
-                auto slice = blaze::ravel(blaze::columnslice(t, k));
-                result[k] = op.finalize(op(slice, initial_value), slice.size());
+                result[k] = reduction.finalize(k, size);
             }
 
             return execution_tree::primitive_argument_type{std::move(result)};
@@ -776,15 +802,22 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            // reduce axes 0 and 2 in one pass, page by page
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                t.rows(), initial_value, name, codename);
+            for (std::size_t k = 0; k != t.pages(); ++k)
+            {
+                auto slice = blaze::pageslice(t, k);
+                reduction.rows(slice, 0);
+            }
+
+            std::size_t const size = t.pages() * t.columns();
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(1, t.rows(), 1);
                 for (std::size_t k = 0; k != t.rows(); ++k)
                 {
-                    Op<T> op{name, codename};
-                    auto slice = blaze::ravel(blaze::rowslice(t, k));
-                    result(0, k, 0) =
-                        op.finalize(op(slice, initial_value), slice.size());
+                    result(0, k, 0) = reduction.finalize(k, size);
                 }
 
                 return execution_tree::primitive_argument_type{
@@ -794,9 +827,7 @@ namespace phylanx { namespace common {
             blaze::DynamicVector<result_type> result(t.rows());
             for (std::size_t k = 0; k != t.rows(); ++k)
             {
-                Op<T> op{name, codename};
-                auto slice = blaze::ravel(blaze::rowslice(t, k));
-                result[k] = op.finalize(op(slice, initial_value), slice.size());
+                result[k] = reduction.finalize(k, size);
             }
 
             return execution_tree::primitive_argument_type{std::move(result)};
@@ -818,15 +849,25 @@ namespace phylanx { namespace common {
 
             using result_type = typename Op<T>::result_type;
 
+            // reduce axes 1 and 2 in one pass over the rows of each page
+            statistics_axis_reduction<Op<T>, Init> reduction(
+                t.pages(), initial_value, name, codename);
+            statistics_for_each(t.pages() * t.rows() * t.columns(), t.pages(),
+                [&](std::size_t k) {
+                    auto slice = blaze::pageslice(t, k);
+                    for (std::size_t i = 0; i != t.rows(); ++i)
+                    {
+                        reduction.reduce(k, blaze::row(slice, i));
+                    }
+                });
+
+            std::size_t const size = t.rows() * t.columns();
             if (keepdims)
             {
                 blaze::DynamicTensor<result_type> result(t.pages(), 1, 1);
                 for (std::size_t k = 0; k != t.pages(); ++k)
                 {
-                    Op<T> op{name, codename};
-                    auto slice = blaze::ravel(blaze::pageslice(t, k));
-                    result(k, 0, 0) =
-                        op.finalize(op(slice, initial_value), slice.size());
+                    result(k, 0, 0) = reduction.finalize(k, size);
                 }
 
                 return execution_tree::primitive_argument_type{
@@ -836,9 +877,7 @@ namespace phylanx { namespace common {
             blaze::DynamicVector<result_type> result(t.pages());
             for (std::size_t k = 0; k != t.pages(); ++k)
             {
-                Op<T> op{name, codename};
-                auto slice = blaze::ravel(blaze::pageslice(t, k));
-                result[k] = op.finalize(op(slice, initial_value), slice.size());
+                result[k] = reduction.finalize(k, size);
             }
 
             return execution_tree::primitive_argument_type{std::move(result)};
@@ -14,6 +14,7 @@
 #include <hpx/assert.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -66,6 +67,13 @@ namespace phylanx { namespace common {
         {
             return value ? 1 : 0;
         }
+
+        // combine the results of two disjoint parts of the data
+        static constexpr std::uint8_t combine(std::uint8_t lhs,
+            statistics_all_op const&, std::uint8_t rhs)
+        {
+            return (lhs && rhs) ? 1 : 0;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -103,6 +111,13 @@ namespace phylanx { namespace common {
         {
             return value;
         }
+
+        // combine the results of two disjoint parts of the data
+        static constexpr bool combine(
+            bool lhs, statistics_any_op const&, bool rhs)
+        {
+            return lhs || rhs;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -138,6 +153,12 @@ namespace phylanx { namespace common {
         {
             return value;
         }
+
+        // combine the results of two disjoint parts of the data
+        static T combine(T lhs, statistics_min_op const&, T rhs)
+        {
+            return (std::min)(lhs, rhs);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -173,6 +194,12 @@ namespace phylanx { namespace common {
         {
             return value;
         }
+
+        // combine the results of two disjoint parts of the data
+        static T combine(T lhs, statistics_max_op const&, T rhs)
+        {
+            return (std::max)(lhs, rhs);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -208,6 +235,12 @@ namespace phylanx { namespace common {
         {
             return value;
         }
+
+        // combine the results of two disjoint parts of the data
+        static T combine(T lhs, statistics_sum_op const&, T rhs)
+        {
+            return lhs + rhs;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -244,6 +277,13 @@ namespace phylanx { namespace common {
         {
             return blaze::log(value);
         }
+
+        // combine the results of two disjoint parts of the data
+        static double combine(
+            double lhs, statistics_logsumexp_op const&, double rhs)
+        {
+            return lhs + rhs;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -279,6 +319,12 @@ namespace phylanx { namespace common {
         {
             return value;
         }
+
+        // combine the results of two disjoint parts of the data
+        static T combine(T lhs, statistics_prod_op const&, T rhs)
+        {
+            return lhs * rhs;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -325,13 +371,99 @@ namespace phylanx { namespace common {
             return value / size;
         }
 
+        // combine the results of two disjoint parts of the data
+        static double combine(
+            double lhs, statistics_mean_op const&, double rhs)
+        {
+            return lhs + rhs;
+        }
+
         std::string const& name_;
         std::string const& codename_;
     };
 
+    namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // Running count, mean, and sum of squared differences from the mean
+        // of a sequence of values, see
+        // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+        struct statistics_moments
+        {
+            // Use Welford's online algorithm for single values
+            void process_value(double val)
+            {
+                ++count_;
+                double delta = val - mean_;
+                mean_ += delta / count_;
+                double delta2 = val - mean_;
+                m2_ += delta * delta2;
+            }
+
+            // Sequences are processed in blocks, the moments of each block
+            // are computed in two passes over the (cached) block and merged
+            // into the running moments. This is as accurate as Welford's
+            // algorithm but avoids the division for every element, which
+            // allows for the inner loops to be vectorized.
+            template <typename Vector>
+            void process_values(Vector const& v)
+            {
+                constexpr std::size_t block_size = 256;
+
+                auto it = v.begin();
+                auto const end = v.end();
+                while (it != end)
+                {
+                    auto block_begin = it;
+
+                    std::size_t count = 0;
+                    double sum = 0.0;
+                    for (/**/; it != end && count != block_size; ++it, ++count)
+                    {
+                        sum += double(*it);
+                    }
+
+                    double const mean = sum / count;
+                    double m2 = 0.0;
+                    for (/**/; block_begin != it; ++block_begin)
+                    {
+                        double const delta = double(*block_begin) - mean;
+                        m2 += delta * delta;
+                    }
+
+                    merge(count, mean, m2);
+                }
+            }
+
+            // Combine with the moments of a disjoint sequence (Chan et.al.)
+            void merge(std::size_t count, double mean, double m2)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                std::size_t const total = count_ + count;
+                double const delta = mean - mean_;
+                mean_ += delta * (double(count) / total);
+                m2_ += m2 + delta * delta * (double(count_) * count / total);
+                count_ = total;
+            }
+
+            void merge(statistics_moments const& rhs)
+            {
+                merge(rhs.count_, rhs.mean_, rhs.m2_);
+            }
+
+            std::size_t count_ = 0;
+            double mean_ = 0;
+            double m2_ = 0;
+        };
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
-    struct statistics_stddev_op
+    struct statistics_stddev_op : detail::statistics_moments
     {
         using result_type = double;
 
@@ -339,9 +471,6 @@ namespace phylanx { namespace common {
             std::string const& name, std::string const& codename)
           : name_(name)
           , codename_(codename)
-          , count_(0)
-          , mean_(0)
-          , m2_(0)
         {
         }
 
@@ -350,17 +479,6 @@ namespace phylanx { namespace common {
             return 0.0;
         }
 
-        // Use Welford's online algorithm, see
-        // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-        void process_value(double val)
-        {
-            ++count_;
-            double delta = val - mean_;
-            mean_ += delta / count_;
-            double delta2 = val - mean_;
-            m2_ += delta * delta2;
-        }
-
         template <typename Scalar>
         typename std::enable_if<traits::is_scalar<Scalar>::value, double>::type
         operator()(Scalar s, double initial)
@@ -373,10 +491,7 @@ namespace phylanx { namespace common {
         typename std::enable_if<!traits::is_scalar<Vector>::value, double>::type
         operator()(Vector& v, double initial)
         {
-            for (auto&& elem : v)
-            {
-                process_value(elem);
-            }
+            process_values(v);
             return initial;
         }
 
@@ -398,26 +513,27 @@ namespace phylanx { namespace common {
             return std::sqrt(m2_ / size);
         }
 
+        // combine the results of two disjoint parts of the data
+        double combine(
+            double lhs, statistics_stddev_op const& rhs_op, double rhs)
+        {
+            merge(rhs_op);
+            return lhs;
+        }
+
         std::string const& name_;
         std::string const& codename_;
-
-        std::size_t count_;
-        double mean_;
-        double m2_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
-    struct statistics_var_op
+    struct statistics_var_op : detail::statistics_moments
     {
         using result_type = double;
 
         statistics_var_op(std::string const& name, std::string const& codename)
           : name_(name)
           , codename_(codename)
-          , count_(0)
-          , mean_(0)
-          , m2_(0)
         {
         }
 
@@ -426,17 +542,6 @@ namespace phylanx { namespace common {
             return 0.0;
         }
 
-        // Use Welford's online algorithm, see
-        // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-        void process_value(double val)
-        {
-            ++count_;
-            double delta = val - mean_;
-            mean_ += delta / count_;
-            double delta2 = val - mean_;
-            m2_ += delta * delta2;
-        }
-
         template <typename Scalar>
         typename std::enable_if<traits::is_scalar<Scalar>::value, double>::type
         operator()(Scalar s, double initial)
@@ -449,10 +554,7 @@ namespace phylanx { namespace common {
         typename std::enable_if<!traits::is_scalar<Vector>::value, double>::type
         operator()(Vector& v, double initial)
         {
-            for (auto&& elem : v)
-            {
-                process_value(elem);
-            }
+            process_values(v);
             return initial;
         }
 
@@ -474,12 +576,15 @@ namespace phylanx { namespace common {
             return m2_ / size;
         }
 
+        // combine the results of two disjoint parts of the data
+        double combine(double lhs, statistics_var_op const& rhs_op, double rhs)
+        {
+            merge(rhs_op);
+            return lhs;
+        }
+
         std::string const& name_;
         std::string const& codename_;
-
-        std::size_t count_;
-        double mean_;
-        double m2_;
     };
 
 }}    // namespace phylanx::common
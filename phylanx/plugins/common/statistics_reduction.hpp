@@ -0,0 +1,282 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_COMMON_STATISTICS_REDUCTION_2020_OCT_18_0912AM)
+#define PHYLANX_COMMON_STATISTICS_REDUCTION_2020_OCT_18_0912AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Building blocks of the reductions performed by the statistics primitives.
+// All functions expect an operation as defined in statistics_operations.hpp.
+namespace phylanx { namespace common { namespace detail {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reductions touching fewer elements are performed sequentially
+    constexpr std::size_t statistics_parallel_threshold = 65536;
+
+    // Column reductions copy tiles of at most this many elements (and at
+    // most statistics_block_columns columns) into a column-major temporary
+    constexpr std::size_t statistics_block_elements = 16384;
+    constexpr std::size_t statistics_block_columns = 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(i) for all i in [0, count), concurrently if the reduction
+    // touches at least statistics_parallel_threshold elements
+    template <typename F>
+    void statistics_for_each(std::size_t size, std::size_t count, F&& f)
+    {
+        if (count > 1 && size >= statistics_parallel_threshold)
+        {
+            hpx::for_loop(hpx::execution::par, std::size_t(0), count, f);
+            return;
+        }
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            f(i);
+        }
+    }
+
+    // Number of chunks a reduction touching size elements that can be
+    // split at count places is split into
+    inline std::size_t statistics_chunks(std::size_t size, std::size_t count)
+    {
+        if (size < statistics_parallel_threshold)
+        {
+            return 1;
+        }
+
+        return (std::min)({count, 4 * hpx::get_os_thread_count(),
+            size / (statistics_parallel_threshold / 4)});
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reduce the items [0, count) (touching size elements overall) into
+    // value, where f(op, value, begin, end) reduces the items [begin, end)
+    // using op. Large inputs are split into chunks which are reduced
+    // concurrently, each starting off Op::initial(). The partial results are
+    // combined pairwise (as a tree), which also bounds the rounding errors of
+    // long summations.
+    template <typename Op, typename Init, typename F>
+    Init statistics_reduce(
+        Op& op, Init value, std::size_t count, std::size_t size, F&& f)
+    {
+        std::size_t const chunks = statistics_chunks(size, count);
+        if (chunks < 2)
+        {
+            return f(op, value, std::size_t(0), count);
+        }
+
+        std::vector<Op> ops(chunks, op);
+        std::vector<Init> values(chunks, Op::initial());
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), chunks,
+            [&](std::size_t c) {
+                values[c] = f(ops[c], values[c], c * count / chunks,
+                    (c + 1) * count / chunks);
+            });
+
+        for (std::size_t stride = 1; stride < chunks; stride *= 2)
+        {
+            for (std::size_t c = 0; c + stride < chunks; c += 2 * stride)
+            {
+                values[c] = ops[c].combine(
+                    values[c], ops[c + stride], values[c + stride]);
+            }
+        }
+
+        return op.combine(value, ops[0], values[0]);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The independent reductions producing the elements of the result of an
+    // axis reduction. The data is fed as vectors, or as the rows or columns
+    // of matrices. All data of a result element has to be fed in order.
+    template <typename Op, typename Init>
+    class statistics_axis_reduction
+    {
+    public:
+        using result_type = typename Op::result_type;
+
+        statistics_axis_reduction(std::size_t size, Init initial,
+            std::string const& name, std::string const& codename)
+          : ops_(size, Op{name, codename})
+          , values_(size, initial)
+          , name_(name)
+          , codename_(codename)
+        {
+        }
+
+        // Reduce the given vector into the result element index
+        template <typename Vector>
+        void reduce(std::size_t index, Vector&& v)
+        {
+            values_[index] = ops_[index](v, values_[index]);
+        }
+
+        // Reduce row i of the given matrix into the result element
+        // offset + i
+        template <typename Matrix>
+        void rows(Matrix& m, std::size_t offset)
+        {
+            statistics_for_each(m.rows() * m.columns(), m.rows(),
+                [&](std::size_t i) { reduce(offset + i, blaze::row(m, i)); });
+        }
+
+        // Reduce column j of the given matrix into the result element
+        // offset + j. Tall matrices are split into chunks of rows that are
+        // reduced concurrently, the partial results are combined afterwards.
+        template <typename Matrix>
+        void columns(Matrix& m, std::size_t offset)
+        {
+            std::size_t const rows = m.rows();
+            std::size_t const columns = m.columns();
+            if (rows == 0 || columns == 0)
+            {
+                return;
+            }
+
+            // there is enough parallelism across the columns
+            std::size_t const blocks =
+                (columns + statistics_block_columns - 1) /
+                statistics_block_columns;
+            std::size_t const chunks = statistics_chunks(
+                rows * columns, rows / statistics_block_columns);
+            if (chunks <= blocks)
+            {
+                statistics_for_each(
+                    rows * columns, blocks, [&](std::size_t b) {
+                        std::size_t const begin = b * statistics_block_columns;
+                        reduce_columns(m, offset, 0, rows, begin,
+                            (std::min)(
+                                begin + statistics_block_columns, columns));
+                    });
+                return;
+            }
+
+            // the first chunk of rows is reduced into this object directly
+            std::vector<statistics_axis_reduction> parts(chunks - 1,
+                statistics_axis_reduction(
+                    columns, Op::initial(), name_, codename_));
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), chunks,
+                [&](std::size_t c) {
+                    std::size_t const begin = c * rows / chunks;
+                    std::size_t const end = (c + 1) * rows / chunks;
+                    if (c == 0)
+                    {
+                        reduce_columns(m, offset, begin, end, 0, columns);
+                    }
+                    else
+                    {
+                        parts[c - 1].reduce_columns(
+                            m, 0, begin, end, 0, columns);
+                    }
+                });
+
+            for (auto& part : parts)
+            {
+                for (std::size_t j = 0; j != columns; ++j)
+                {
+                    values_[offset + j] = ops_[offset + j].combine(
+                        values_[offset + j], part.ops_[j], part.values_[j]);
+                }
+            }
+        }
+
+        result_type finalize(std::size_t index, std::size_t size) const
+        {
+            return ops_[index].finalize(values_[index], size);
+        }
+
+    private:
+        // Reduce the columns [column_begin, column_end) of the rows
+        // [row_begin, row_end) of the given matrix. Tiles of the matrix are
+        // copied into a column-major temporary, which makes reducing the
+        // columns access contiguous memory.
+        template <typename Matrix>
+        void reduce_columns(Matrix& m, std::size_t offset,
+            std::size_t row_begin, std::size_t row_end,
+            std::size_t column_begin, std::size_t column_end)
+        {
+            using T = blaze::ElementType_t<Matrix>;
+
+            std::size_t const columns = column_end - column_begin;
+            std::size_t const height = statistics_block_elements /
+                (std::min)(columns, statistics_block_columns);
+
+            blaze::DynamicMatrix<T, blaze::columnMajor> tile;
+            for (std::size_t row = row_begin; row < row_end; row += height)
+            {
+                std::size_t const rows = (std::min)(height, row_end - row);
+                for (std::size_t column = column_begin; column < column_end;
+                     column += statistics_block_columns)
+                {
+                    std::size_t const width = (std::min)(
+                        statistics_block_columns, column_end - column);
+
+                    tile = blaze::submatrix(m, row, column, rows, width);
+                    for (std::size_t j = 0; j != width; ++j)
+                    {
+                        reduce(offset + column + j, blaze::column(tile, j));
+                    }
+                }
+            }
+        }
+
+        std::vector<Op> ops_;
+        std::vector<Init> values_;
+
+        std::string const& name_;
+        std::string const& codename_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Tensor>
+    using statistics_matrix_view = blaze::CustomMatrix<
+        blaze::ElementType_t<Tensor>, blaze::unaligned, blaze::unpadded>;
+
+    // View the rows of all pages of a tensor as the rows of one matrix
+    template <typename Tensor>
+    statistics_matrix_view<Tensor> statistics_tensor_rows(Tensor& t)
+    {
+        if (t.data() == nullptr)
+        {
+            return statistics_matrix_view<Tensor>{};
+        }
+
+        return statistics_matrix_view<Tensor>(
+            t.data(), t.pages() * t.rows(), t.columns(), t.spacing());
+    }
+
+    // View every page of a tensor as a row of a matrix, element (i, j) of a
+    // page is element i * t.spacing() + j of the row
+    template <typename Tensor>
+    statistics_matrix_view<Tensor> statistics_tensor_pages(Tensor& t)
+    {
+        if (t.data() == nullptr)
+        {
+            return statistics_matrix_view<Tensor>{};
+        }
+
+        return statistics_matrix_view<Tensor>(
+            t.data(), t.pages(), t.rows() * t.spacing());
+    }
+}}}    // namespace phylanx::common::detail
+
+#endif
@@ -45,10 +45,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
 
     private:
         template <typename T>
-        execution_tree::primitive_argument_type distGaussInv(
+        execution_tree::primitive_argument_type dist_lu_inverse(
             ir::node_data<T>&& arg,
             execution_tree::localities_information&& lhs_localities) const;
-        execution_tree::primitive_argument_type distGaussInv(
+        execution_tree::primitive_argument_type dist_lu_inverse(
             execution_tree::primitive_argument_type&& lhs) const;
     };
 
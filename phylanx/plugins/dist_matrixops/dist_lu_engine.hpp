@@ -0,0 +1,76 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_DIST_LU_ENGINE)
+#define PHYLANX_DIST_MATRIXOPS_DIST_LU_ENGINE
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace dist_matrixops
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The LU factors (with partial pivoting, P A = L U) of a square matrix
+    // that is tiled by columns
+    struct dist_lu_factors
+    {
+        // the local columns of the combined factors, L has an implicit unit
+        // diagonal
+        blaze::DynamicMatrix<double> lu_;
+
+        // row i was interchanged with row pivots_[i] (LAPACK style, but zero
+        // based), this is known on all localities
+        std::vector<std::int64_t> pivots_;
+
+        // the global index of the first local column
+        std::size_t column_start_ = 0;
+    };
+
+    // Number of columns factored at once (configured by
+    // phylanx.dist_lu.block_size, defaults to 64)
+    std::size_t dist_lu_block_size();
+
+    // Base name of the collective operations of one invocation of the
+    // engine on the given matrix. Every invocation on the same matrix gets a
+    // new name, the invocations are expected to happen in the same order on
+    // all localities.
+    std::string dist_lu_basename(
+        execution_tree::localities_information const& locs);
+
+    // Blocked right-looking LU factorization of a distributed square matrix
+    // that is tiled by columns. Every locality splits its tile into panels of
+    // (at most) dist_lu_block_size() columns. The owner of a panel factors
+    // it and broadcasts it once, all localities then update their part of
+    // the trailing matrix. The owner of the next panel updates and factors
+    // that panel first, and sends it off while the remaining trailing
+    // update is performed.
+    dist_lu_factors dist_lu_factorize(blaze::DynamicMatrix<double>&& local,
+        execution_tree::localities_information const& locs,
+        std::string const& basename, std::string const& name,
+        std::string const& codename);
+
+    // Solve A X = B given the distributed LU factors of A, B has to be the
+    // same on all localities. The substitutions run panel by panel where the
+    // factors are stored: the updates of the rows of a panel contributed by
+    // all panels solved before are summed up (the only communication), then
+    // the owner of the panel solves for its block of X and applies it to its
+    // part of the remaining rows. Returns the rows of X corresponding to the
+    // local columns of the factors.
+    blaze::DynamicMatrix<double> dist_lu_solve(dist_lu_factors const& factors,
+        blaze::DynamicMatrix<double> const& b,
+        execution_tree::localities_information const& locs,
+        std::string const& basename, std::string const& name,
+        std::string const& codename);
+}}
+
+#endif
@@ -15,7 +15,10 @@
 #include <phylanx/plugins/dist_matrixops/dist_dot_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_identity.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_inverse_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_random.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_solve.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_summa_product.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/retile_annotations.hpp>
 
@@ -0,0 +1,107 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DIST_SUMMA_PRODUCT)
+#define PHYLANX_PRIMITIVES_DIST_SUMMA_PRODUCT
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    // Number of panels that are fetched ahead of the one being multiplied
+    // (configured by phylanx.summa.prefetch_depth, defaults to 2)
+    std::size_t summa_prefetch_depth();
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A panel is a range of the inner dimension of the product for which
+        // both, the needed part of the lhs and the rhs, are held by a single
+        // locality each
+        struct summa_panel
+        {
+            std::size_t start_;
+            std::size_t stop_;
+            std::uint32_t lhs_owner_;
+            std::uint32_t rhs_owner_;
+            std::size_t lhs_offset_;    // first column inside the lhs tile
+            std::size_t rhs_offset_;    // first row inside the rhs tile
+        };
+
+        // Calculate the panels needed for the local tile of the result. The
+        // local tile spans the rows of the local lhs tile and the columns of
+        // the local rhs tile. All lhs tiles spanning the same rows (and all
+        // rhs tiles spanning the same columns) have to cover the inner
+        // dimension, i.e. the tiles have to form a (possibly rectangular)
+        // process grid.
+        std::vector<summa_panel> summa_panels(
+            execution_tree::localities_information const& lhs_localities,
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& name, std::string const& codename);
+    }
+
+    class dist_summa_product
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<dist_summa_product>
+    {
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    public:
+        static execution_tree::match_pattern_type const match_data;
+
+        dist_summa_product() = default;
+
+        dist_summa_product(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        template <typename T>
+        execution_tree::primitive_argument_type product(ir::node_data<T>&& lhs,
+            ir::node_data<T>&& rhs,
+            execution_tree::localities_information&& lhs_localities,
+            execution_tree::localities_information const& rhs_localities,
+            std::size_t prefetch_depth) const;
+
+        template <typename T>
+        execution_tree::primitive_argument_type dot2d2d(ir::node_data<T>&& lhs,
+            ir::node_data<T>&& rhs,
+            execution_tree::localities_information&& lhs_localities,
+            execution_tree::localities_information const& rhs_localities,
+            std::size_t prefetch_depth) const;
+
+        execution_tree::primitive_argument_type dot2d(
+            execution_tree::primitive_argument_type&& lhs,
+            execution_tree::primitive_argument_type&& rhs,
+            std::size_t prefetch_depth) const;
+    };
+
+    inline execution_tree::primitive create_dist_summa_product(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return execution_tree::create_primitive_component(
+            locality, "summa_product_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
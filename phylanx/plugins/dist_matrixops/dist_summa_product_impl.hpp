@@ -0,0 +1,272 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_SUMMA_PRODUCT_IMPL)
+#define PHYLANX_DIST_SUMMA_PRODUCT_IMPL
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/locality_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_summa_product.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+#include <phylanx/util/scoped_timer.hpp>
+#include <phylanx/util/summa_statistics.hpp>
+
+#include <hpx/assert.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+using std_int64_t = std::int64_t;
+using std_uint8_t = std::uint8_t;
+
+////////////////////////////////////////////////////////////////////////////////
+REGISTER_DISTRIBUTED_MATRIX_DECLARATION(double);
+REGISTER_DISTRIBUTED_MATRIX_DECLARATION(std_int64_t);
+REGISTER_DISTRIBUTED_MATRIX_DECLARATION(std_uint8_t);
+
+////////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    namespace detail
+    {
+        template <typename T>
+        struct summa_panel_data
+        {
+            // the parts of the panel, empty if held by this locality
+            blaze::DynamicMatrix<T> lhs_;
+            blaze::DynamicMatrix<T> rhs_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    execution_tree::primitive_argument_type dist_summa_product::product(
+        ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
+        execution_tree::localities_information&& lhs_localities,
+        execution_tree::localities_information const& rhs_localities,
+        std::size_t prefetch_depth) const
+    {
+        using panel_data = detail::summa_panel_data<T>;
+
+        std::vector<detail::summa_panel> panels = detail::summa_panels(
+            lhs_localities, rhs_localities, name_, codename_);
+
+        std::uint32_t const num_localities =
+            lhs_localities.locality_.num_localities_;
+        std::uint32_t const locality_id = lhs_localities.locality_.locality_id_;
+
+        auto lhs_m = lhs.matrix();
+        auto rhs_m = rhs.matrix();
+
+        std::size_t const rows = lhs_m.rows();
+        std::size_t const columns = rhs_m.columns();
+
+        // construct a distributed matrix object for both tiles
+        util::distributed_matrix<T> lhs_data(
+            lhs_localities.annotation_.name_ + "/summa_lhs", lhs_m,
+            num_localities, locality_id);
+        util::distributed_matrix<T> rhs_data(
+            rhs_localities.annotation_.name_ + "/summa_rhs", rhs_m,
+            num_localities, locality_id);
+
+        std::int64_t bytes_moved = 0;
+        std::int64_t wait_time = 0;
+        std::int64_t compute_time = 0;
+
+        // fetch the remote parts of the given panel
+        auto fetch_panel = [&](detail::summa_panel const& p)
+            -> hpx::future<panel_data>
+        {
+            std::size_t const width = p.stop_ - p.start_;
+
+            hpx::future<blaze::DynamicMatrix<T>> lhs_f;
+            if (p.lhs_owner_ != locality_id)
+            {
+                lhs_f = lhs_data.fetch(p.lhs_owner_, 0, p.lhs_offset_, rows,
+                    p.lhs_offset_ + width);
+                bytes_moved += rows * width * sizeof(T);
+            }
+            else
+            {
+                lhs_f = hpx::make_ready_future(blaze::DynamicMatrix<T>{});
+            }
+
+            hpx::future<blaze::DynamicMatrix<T>> rhs_f;
+            if (p.rhs_owner_ != locality_id)
+            {
+                rhs_f = rhs_data.fetch(p.rhs_owner_, p.rhs_offset_, 0,
+                    p.rhs_offset_ + width, columns);
+                bytes_moved += width * columns * sizeof(T);
+            }
+            else
+            {
+                rhs_f = hpx::make_ready_future(blaze::DynamicMatrix<T>{});
+            }
+
+            return hpx::dataflow(hpx::launch::sync,
+                [](hpx::future<blaze::DynamicMatrix<T>>&& lhs_f,
+                    hpx::future<blaze::DynamicMatrix<T>>&& rhs_f)
+                {
+                    return panel_data{lhs_f.get(), rhs_f.get()};
+                },
+                std::move(lhs_f), std::move(rhs_f));
+        };
+
+        // keep up to prefetch_depth panels in flight
+        std::vector<hpx::future<panel_data>> in_flight;
+        std::vector<std::size_t> in_flight_panels;
+        in_flight.reserve(prefetch_depth);
+        in_flight_panels.reserve(prefetch_depth);
+
+        std::size_t next_panel = 0;
+        while (next_panel != panels.size() &&
+            in_flight.size() != prefetch_depth)
+        {
+            in_flight.push_back(fetch_panel(panels[next_panel]));
+            in_flight_panels.push_back(next_panel++);
+        }
+
+        blaze::DynamicMatrix<T> result_matrix(rows, columns, T{0});
+
+        // accumulate the partial products in the order the panels arrive
+        while (!in_flight.empty())
+        {
+            std::size_t idx = 0;
+            {
+                util::scoped_timer<std::int64_t> timer(wait_time);
+                auto any = hpx::when_any(in_flight).get();
+                in_flight = std::move(any.futures);
+                idx = any.index;
+            }
+
+            panel_data data = in_flight[idx].get();
+            detail::summa_panel const& p = panels[in_flight_panels[idx]];
+
+            // request the next panel before multiplying this one
+            if (next_panel != panels.size())
+            {
+                in_flight[idx] = fetch_panel(panels[next_panel]);
+                in_flight_panels[idx] = next_panel++;
+            }
+            else
+            {
+                in_flight.erase(in_flight.begin() + idx);
+                in_flight_panels.erase(in_flight_panels.begin() + idx);
+            }
+
+            util::scoped_timer<std::int64_t> timer(compute_time);
+
+            std::size_t const width = p.stop_ - p.start_;
+            if (p.lhs_owner_ == locality_id && p.rhs_owner_ == locality_id)
+            {
+                result_matrix +=
+                    blaze::submatrix(lhs_m, 0, p.lhs_offset_, rows, width) *
+                    blaze::submatrix(
+                        rhs_m, p.rhs_offset_, 0, width, columns);
+            }
+            else if (p.lhs_owner_ == locality_id)
+            {
+                result_matrix +=
+                    blaze::submatrix(lhs_m, 0, p.lhs_offset_, rows, width) *
+                    data.rhs_;
+            }
+            else if (p.rhs_owner_ == locality_id)
+            {
+                result_matrix += data.lhs_ *
+                    blaze::submatrix(
+                        rhs_m, p.rhs_offset_, 0, width, columns);
+            }
+            else
+            {
+                result_matrix += data.lhs_ * data.rhs_;
+            }
+        }
+
+        util::summa_statistics::add(bytes_moved, wait_time, compute_time);
+
+        // make sure no locality releases its tiles while others might still
+        // fetch from them
+        if (num_localities > 1)
+        {
+            hpx::lcos::barrier b(
+                "barrier_summa_" + lhs_localities.annotation_.name_,
+                num_localities, locality_id);
+            b.wait();
+        }
+
+        // the result is tiled like the rows of the lhs and the columns of
+        // the rhs
+        execution_tree::primitive_argument_type result =
+            execution_tree::primitive_argument_type{std::move(result_matrix)};
+
+        execution_tree::tiling_information_2d tile_info(
+            lhs_localities.get_span(0), rhs_localities.get_span(1));
+
+        ++lhs_localities.annotation_.generation_;
+
+        auto locality_ann = lhs_localities.locality_.as_annotation();
+        result.set_annotation(
+            execution_tree::localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                lhs_localities.annotation_, name_, codename_),
+            name_, codename_);
+
+        return result;
+    }
+
+    template <typename T>
+    execution_tree::primitive_argument_type dist_summa_product::dot2d2d(
+        ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
+        execution_tree::localities_information&& lhs_localities,
+        execution_tree::localities_information const& rhs_localities,
+        std::size_t prefetch_depth) const
+    {
+        if (lhs_localities.num_dimensions() != 2 ||
+            rhs_localities.num_dimensions() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::dot2d2d",
+                generate_error_message(
+                    "the operands have incompatible dimensionalities"));
+        }
+
+        if (lhs_localities.columns(name_, codename_) !=
+            rhs_localities.rows(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::dot2d2d",
+                generate_error_message(
+                    "the operands have incompatible number of dimensions"));
+        }
+
+        if (lhs_localities.locality_.num_localities_ !=
+            rhs_localities.locality_.num_localities_)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::dot2d2d",
+                generate_error_message(
+                    "the operands have to be tiled over the same number of "
+                    "localities"));
+        }
+
+        return product(std::move(lhs), std::move(rhs),
+            std::move(lhs_localities), rhs_localities, prefetch_depth);
+    }
+}}}    // namespace phylanx::dist_matrixops::primitives
+
+#endif
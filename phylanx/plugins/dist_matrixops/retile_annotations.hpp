@@ -8,15 +8,19 @@
 #define PHYLANX_EXECUTION_TREE_PRIMITIVES_RETILE_ANNOTATIONS
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
 
 #include <hpx/futures/future.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -24,6 +28,11 @@
 
 namespace phylanx { namespace dist_matrixops { namespace primitives
 {
+    namespace detail
+    {
+        struct retile_plan;
+    }
+
     class retile_annotations
       : public execution_tree::primitives::primitive_component_base
       , public std::enable_shared_from_this<retile_annotations>
@@ -76,6 +85,22 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
             std::uint32_t numtiles, ir::range&& new_tiling,
             execution_tree::localities_information&& arr_localities) const;
+
+        // Calculate (or retrieve from the cache) the parts of the current
+        // tiles of all localities that make up the new local tile
+        std::shared_ptr<detail::retile_plan const> get_retile_plan(
+            execution_tree::localities_information const& arr_localities,
+            std::size_t numdims,
+            std::array<std::size_t, 3> const& span_indices,
+            std::array<execution_tree::tiling_span, 3> const& des_spans) const;
+
+    private:
+        // Retiling is usually repeated with the same tiles in every
+        // iteration of an algorithm, the plans are cached per instance
+        mutable hpx::lcos::local::spinlock plans_mtx_;
+        mutable std::map<std::vector<std::int64_t>,
+            std::shared_ptr<detail::retile_plan const>>
+            plans_;
     };
 
     inline execution_tree::primitive create_retile_annotations(
@@ -0,0 +1,71 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_ARRAY_FILE_HPP)
+#define PHYLANX_PRIMITIVES_ARRAY_FILE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Binary array files hold a single numeric array of up to four
+    // dimensions. The file starts with the fixed size header below, followed
+    // by the raw array data in row-major order (host byte order). Every row
+    // (the innermost dimension) is padded with zeros to 'spacing' elements,
+    // and the data starts at an offset that is a multiple of 'alignment'
+    // bytes. This is the memory layout of the (aligned and padded) blaze
+    // types, which allows to use the data directly from a memory mapped file.
+    enum class array_file_dtype : std::uint32_t
+    {
+        bool_ = 0,       // stored as std::uint8_t
+        int64 = 1,
+        float64 = 2
+    };
+
+    struct array_file_header
+    {
+        char magic[8];               // "PHYLANXA"
+        std::uint32_t version;       // currently 1
+        std::uint32_t dtype;         // array_file_dtype
+        std::uint32_t rank;          // number of dimensions (0 to 4)
+        std::uint32_t alignment;     // in bytes
+        std::uint64_t shape[4];      // extent of each dimension
+        std::uint64_t spacing;       // elements between consecutive rows
+        std::uint64_t data_offset;   // offset of the array data in bytes
+        std::uint8_t reserved[56];
+    };
+
+    static_assert(sizeof(array_file_header) == 128,
+        "the array file header is expected to have a size of 128 bytes");
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Write the given array to a file. If append is true and the file
+    // exists already, the array is appended along the first dimension to
+    // the array stored in the file (the data types, the number of
+    // dimensions, and the extents of all other dimensions have to match).
+    // The header is updated only after all data was written, an interrupted
+    // append leaves the previous content of the file intact. Otherwise the
+    // data is written to a temporary file which then replaces the target,
+    // arrays previously read from the target are not affected.
+    void write_array_file(std::string const& filename,
+        primitive_argument_type const& data, bool append,
+        std::string const& name = "", std::string const& codename = "");
+
+    // Read the array stored in the given file. Unless copy is true, the file
+    // is mapped into memory (copy-on-write) and the returned array refers to
+    // the mapped data directly. The mapping is released once the last array
+    // referring to it goes away.
+    primitive_argument_type read_array_file(std::string const& filename,
+        bool copy, std::string const& name = "",
+        std::string const& codename = "");
+}}}
+
+#endif
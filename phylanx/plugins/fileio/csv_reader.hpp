@@ -0,0 +1,96 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_CSV_READER_HPP)
+#define PHYLANX_PRIMITIVES_CSV_READER_HPP
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Reader for csv files holding numeric data. The file is memory mapped
+    // and split into chunks of whole lines while being opened, the number of
+    // rows in each chunk is determined concurrently. Reading parses (any
+    // subset of) the rows and columns concurrently and stores the values
+    // directly into the memory provided by the caller.
+    class csv_reader
+    {
+    public:
+        // If skip_rows is negative all leading lines that don't consist of
+        // numeric values only (e.g. column headers) are skipped, otherwise
+        // exactly the given number of lines is skipped. Empty lines are
+        // ignored.
+        csv_reader(std::string const& filename, std::int64_t skip_rows = -1,
+            std::string const& name = "", std::string const& codename = "");
+        ~csv_reader();
+
+        csv_reader(csv_reader const&) = delete;
+        csv_reader& operator=(csv_reader const&) = delete;
+
+        std::size_t rows() const
+        {
+            return num_rows_;
+        }
+        std::size_t columns() const
+        {
+            return num_columns_;
+        }
+
+        // Verify that all given column indices are valid and unique
+        void check_columns(std::vector<std::size_t> const& columns) const;
+
+        // Parse the rows [row_start, row_start + num_rows) of the given
+        // columns (all columns if none are given). The values of a row are
+        // stored consecutively, successive rows start 'spacing' elements
+        // apart (i.e. the layout of a row-major blaze matrix or tensor).
+        void read(double* data, std::size_t spacing, std::size_t row_start,
+            std::size_t num_rows,
+            std::vector<std::size_t> const& columns = {}) const;
+        void read(std::int64_t* data, std::size_t spacing,
+            std::size_t row_start, std::size_t num_rows,
+            std::vector<std::size_t> const& columns = {}) const;
+        void read(std::uint8_t* data, std::size_t spacing,
+            std::size_t row_start, std::size_t num_rows,
+            std::vector<std::size_t> const& columns = {}) const;
+
+    private:
+        struct chunk
+        {
+            char const* begin;
+            char const* end;
+            std::size_t first_row;
+            std::size_t num_rows;
+        };
+
+        void map_file();
+        void find_chunks(char const* begin, char const* end);
+
+        template <typename T>
+        void read_rows(T* data, std::size_t spacing, std::size_t row_start,
+            std::size_t num_rows,
+            std::vector<std::size_t> const& columns) const;
+
+        std::string filename_;
+        std::string name_;
+        std::string codename_;
+
+        char const* data_;
+        std::size_t size_;
+        bool mapped_;
+        std::vector<char> buffer_;    // used if memory mapping is unavailable
+
+        std::vector<chunk> chunks_;
+        std::size_t num_rows_;
+        std::size_t num_columns_;
+    };
+}}}
+
+#endif
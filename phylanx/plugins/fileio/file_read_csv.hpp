@@ -8,12 +8,14 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/plugins/fileio/csv_reader.hpp>
 
 #include <hpx/futures/future.hpp>
 
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,11 +36,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::string const& name, std::string const& codename);
 
     private:
-        primitive_argument_type read(
-            std::ifstream&& infile, std::string const& filename) const;
+        template <typename T>
+        primitive_argument_type read(csv_reader const& reader,
+            std::vector<std::size_t> const& columns) const;
 
-        primitive_argument_type read_3d(std::ifstream&& infile,
-            std::string const& filename, std::int64_t given_nrows) const;
+        template <typename T>
+        primitive_argument_type read_3d(csv_reader const& reader,
+            std::vector<std::size_t> const& columns,
+            std::int64_t given_nrows) const;
+
+        primitive_argument_type read(csv_reader const& reader,
+            std::vector<std::size_t> const& columns, node_data_type dtype,
+            bool mode3d, std::int64_t given_nrows) const;
 
     protected:
         hpx::future<primitive_argument_type> eval(
@@ -8,9 +8,11 @@
 
 #include <phylanx/plugins/fileio/dist_file_read_csv.hpp>
 #include <phylanx/plugins/fileio/file_read.hpp>
+#include <phylanx/plugins/fileio/file_read_array.hpp>
 #include <phylanx/plugins/fileio/file_read_csv.hpp>
 #include <phylanx/plugins/fileio/file_read_hdf5.hpp>
 #include <phylanx/plugins/fileio/file_write.hpp>
+#include <phylanx/plugins/fileio/file_write_array.hpp>
 #include <phylanx/plugins/fileio/file_write_csv.hpp>
 #include <phylanx/plugins/fileio/file_write_hdf5.hpp>
 
@@ -49,33 +49,9 @@ namespace phylanx { namespace execution_tree { namespace primitives {
             std::string const& name, std::string const& codename);
 
     private:
-        template <typename Tensor>
-        double mean(const Tensor& t) const;
-
-        primitive_argument_type avg_pool3d(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
         primitive_argument_type avg_pool3d(ir::node_data<double>&& arg,
             std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type avg_pool3d_same(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
-        primitive_argument_type avg_pool3d_same(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type avg_pool_any_pad(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::string&& padding) const;
-        primitive_argument_type avg_pool_any_pad(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::string&& padding,
+            std::size_t filter_width, std::string const& padding,
             std::size_t stride_depth, std::size_t stride_height,
             std::size_t stride_width) const;
     };
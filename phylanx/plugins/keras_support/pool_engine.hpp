@@ -0,0 +1,90 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_KERAS_SUPPORT_POOL_ENGINE)
+#define PHYLANX_KERAS_SUPPORT_POOL_ENGINE
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The pooling windows along one dimension: result element o pools the
+    // input elements begin(o) to end(o), i.e. the window of the size of the
+    // filter starting at o * stride - pad, clipped to the input.
+    struct pool_dimension
+    {
+        std::int64_t start(std::size_t o) const
+        {
+            return std::int64_t(o * stride_) - std::int64_t(pad_);
+        }
+        std::size_t begin(std::size_t o) const
+        {
+            return std::size_t((std::max)(start(o), std::int64_t(0)));
+        }
+        std::size_t end(std::size_t o) const
+        {
+            return std::size_t((std::min)(
+                start(o) + std::int64_t(filter_), std::int64_t(size_)));
+        }
+
+        std::size_t size_;      // size of the input
+        std::size_t filter_;
+        std::size_t stride_;
+        std::size_t pad_;       // padding in front of the input
+        std::size_t result_;    // size of the result
+    };
+
+    // Create the windows for the given padding mode ('same' or 'valid'),
+    // using the same conventions as Keras
+    pool_dimension make_pool_dimension(std::size_t size,
+        std::size_t filter, std::size_t stride, bool same);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Pooling of the 2nd and 3rd dimension of a (batch, height, width,
+    // channels) array. If indices is not nullptr, it receives the position
+    // of each maximum inside of its (height, width) plane as
+    // row * width + column (the first one if the maximum is not unique).
+    //
+    // The windows are separable, each dimension is reduced in a separate
+    // pass over a compact copy of the data. The innermost loops run over
+    // the contiguous elements following the pooled dimension and all passes
+    // run in parallel. Larger windows with unit stride use running maxima
+    // (van Herk/Gil-Werman) and running sums, which take constant time per
+    // element regardless of the size of the window.
+    blaze::DynamicArray<4UL, double> max_pool2d(
+        ir::node_data<double>::custom_storage4d_type const& x,
+        pool_dimension const& height, pool_dimension const& width,
+        blaze::DynamicArray<4UL, std::int64_t>* indices = nullptr);
+
+    blaze::DynamicArray<4UL, double> avg_pool2d(
+        ir::node_data<double>::custom_storage4d_type const& x,
+        pool_dimension const& height, pool_dimension const& width);
+
+    // Pooling of all dimensions of a tensor, indices receive the positions
+    // of the maxima as (page * rows + row) * columns + column
+    blaze::DynamicTensor<double> max_pool3d(
+        ir::node_data<double>::custom_storage3d_type const& x,
+        pool_dimension const& depth, pool_dimension const& height,
+        pool_dimension const& width,
+        blaze::DynamicTensor<std::int64_t>* indices = nullptr);
+
+    blaze::DynamicTensor<double> avg_pool3d(
+        ir::node_data<double>::custom_storage3d_type const& x,
+        pool_dimension const& depth, pool_dimension const& height,
+        pool_dimension const& width);
+}}}}
+
+#endif
@@ -13,6 +13,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/dot_operation.hpp>
 #include <phylanx/plugins/common/dot_operation_nd.hpp>
+#include <phylanx/plugins/common/gemm_engine.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -318,7 +319,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the operands have incompatible number of dimensions"));
         }
 
-        lhs = blaze::trans(rhs.matrix() * lhs.matrix());
+        lhs = common::gemm(
+            blaze::trans(lhs.matrix()), blaze::trans(rhs.matrix()));
         return primitive_argument_type{std::move(lhs)};
     }
 
@@ -486,10 +488,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.rows(), t.columns(), m.columns());
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.columns(), m.columns()),
-                0) = blaze::rowslice(t, i) * m;
+        common::gemm_for_each(t.rows(), t.columns(), t.pages(), m.columns(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::rowslice(t, i), m, page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -561,10 +564,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.pages(), t.columns(), m.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.columns(), m.rows()),
-                0) = blaze::trans(m * blaze::pageslice(t, i));
+        common::gemm_for_each(t.pages(), t.columns(), t.rows(), m.rows(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::trans(blaze::pageslice(t, i)),
+                    blaze::trans(m), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -586,10 +591,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), m.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.rows(), m.rows()), 0) =
-                blaze::pageslice(t, i) * blaze::trans(m);
+        common::gemm_for_each(t.pages(), t.rows(), t.columns(), m.rows(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(
+                    blaze::pageslice(t, i), blaze::trans(m), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
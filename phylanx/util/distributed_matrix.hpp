@@ -44,7 +44,7 @@ namespace phylanx { namespace util { namespace server
     public:
         using data_type = blaze::DynamicMatrix<T>;
         using reference_type =
-            blaze::CustomMatrix<T, blaze::aligned, blaze::padded>;
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>;
 
         distributed_matrix_part() = default;
 
@@ -46,7 +46,7 @@ namespace phylanx { namespace util { namespace server
     public:
         using data_type = blaze::DynamicTensor<T>;
         using reference_type =
-            blaze::CustomTensor<T, blaze::aligned, blaze::padded>;
+            blaze::CustomTensor<T, blaze::unaligned, blaze::unpadded>;
 
         distributed_tensor_part() = default;
 
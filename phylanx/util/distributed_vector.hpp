@@ -44,7 +44,7 @@ namespace phylanx { namespace util { namespace server
     public:
         using data_type = blaze::DynamicVector<T>;
         using reference_type =
-            blaze::CustomVector<T, blaze::aligned, blaze::padded>;
+            blaze::CustomVector<T, blaze::unaligned, blaze::unpadded>;
 
         distributed_vector_part() = default;
 
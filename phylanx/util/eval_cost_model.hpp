@@ -0,0 +1,115 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_EVAL_COST_MODEL_OCT_18_2020_0445PM)
+#define PHYLANX_UTIL_EVAL_COST_MODEL_OCT_18_2020_0445PM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Online cost model for the evaluation of a single primitive instance.
+    //
+    // The model estimates the duration of an evaluation as a linear function
+    // of the number of elements the evaluation works on:
+    //
+    //      duration(n) = fixed_cost + cost_per_element * n
+    //
+    // The coefficients are fitted using an exponentially weighted least
+    // squares estimate, older samples decay so that the model follows
+    // changes of the workload over time (for instance, if the size of the
+    // data grows inside a loop). The model is sampled for every evaluation
+    // until it has seen enough samples and afterwards only periodically or
+    // whenever the number of elements the evaluation is expected to work on
+    // changes significantly.
+    class PHYLANX_EXPORT eval_cost_model
+    {
+    public:
+        eval_cost_model();
+
+        // copies of a primitive start with a fresh model
+        eval_cost_model(eval_cost_model const&)
+          : eval_cost_model()
+        {
+        }
+        eval_cost_model& operator=(eval_cost_model const&) = delete;
+
+        // Decide whether the upcoming evaluation (expected to work on the
+        // given number of elements) should be measured.
+        bool sample_eval(std::size_t work_size);
+
+        // Add the measured duration (in ns) of an evaluation.
+        void add_sample(std::size_t work_size, std::size_t result_size,
+            std::int64_t duration);
+
+        // Record the size of the result of an evaluation that was not
+        // measured.
+        void set_result_size(std::size_t result_size)
+        {
+            result_size_.store(result_size, std::memory_order_relaxed);
+        }
+
+        // Return the predicted duration (in ns) of an evaluation working on
+        // the given number of elements, returns -1 if the model has not seen
+        // enough samples yet.
+        std::int64_t predicted_duration(std::size_t n) const;
+
+        // Return the predicted duration (in ns) of the next evaluation, see
+        // work_size().
+        std::int64_t predicted_duration() const
+        {
+            return predicted_duration(work_size());
+        }
+
+        // Number of elements the next evaluation is expected to work on as
+        // far as it can't be derived from its operands: the size of the
+        // result of the latest evaluation
+        std::size_t work_size() const
+        {
+            return result_size_.load(std::memory_order_relaxed);
+        }
+
+        // Return whether the cost model should be used to decide whether to
+        // execute primitives directly (phylanx.eval_cost_model)
+        static bool enabled();
+
+        // Number of initial evaluations that will be measured
+        // (phylanx.eval_count_threshold)
+        static std::size_t min_samples();
+
+        // Measure every n-th evaluation once enough samples were collected
+        // (phylanx.eval_sample_interval)
+        static std::size_t sample_interval();
+
+    private:
+        std::int64_t predict(double n) const;
+
+        mutable hpx::lcos::local::spinlock mtx_;
+
+        // exponentially weighted sums needed for the least squares estimate
+        double sum_weights_;
+        double sum_n_;
+        double sum_nn_;
+        double sum_t_;
+        double sum_nt_;
+
+        std::size_t num_samples_;
+
+        std::atomic<std::size_t> eval_count_;
+        std::atomic<std::size_t> last_work_size_;
+        std::atomic<std::size_t> result_size_;
+        std::atomic<bool> has_prediction_;
+    };
+}}
+
+#endif
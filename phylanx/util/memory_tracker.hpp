@@ -0,0 +1,91 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_MEMORY_TRACKER)
+#define PHYLANX_UTIL_MEMORY_TRACKER
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Process-wide accounting of the memory owned by the (blaze) storage of
+    // all node_data instances. Views referring to other data (for instance
+    // memory mapped files or numpy arrays) are not accounted for. Storage
+    // resized in place through the mutable accessors of node_data is
+    // accounted for the next time it is accessed (or moved).
+    struct PHYLANX_EXPORT memory_tracker
+    {
+        static void allocate(std::size_t bytes);
+        static void deallocate(std::size_t bytes);
+
+        // Number of bytes currently held by node_data instances (this value
+        // can't be reset)
+        static std::int64_t live_bytes(bool reset);
+
+        // Maximum of the number of bytes held by node_data instances at any
+        // point in time since the last reset, resetting starts over with
+        // the current number of live bytes
+        static std::int64_t high_water_mark(bool reset);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Keeps track of the memory owned by a single object. The number of
+    // bytes is recorded whenever the object acquires new storage and is
+    // released on destruction (or when the object acquires different
+    // storage).
+    class tracked_memory
+    {
+    public:
+        explicit tracked_memory(std::size_t bytes = 0)
+          : bytes_(bytes)
+        {
+            if (bytes_ != 0)
+            {
+                memory_tracker::allocate(bytes_);
+            }
+        }
+
+        tracked_memory(tracked_memory const&) = delete;
+        tracked_memory& operator=(tracked_memory const&) = delete;
+
+        ~tracked_memory()
+        {
+            if (bytes_ != 0)
+            {
+                memory_tracker::deallocate(bytes_);
+            }
+        }
+
+        void update(std::size_t bytes)
+        {
+            if (bytes != bytes_)
+            {
+                if (bytes_ != 0)
+                {
+                    memory_tracker::deallocate(bytes_);
+                }
+                if (bytes != 0)
+                {
+                    memory_tracker::allocate(bytes);
+                }
+                bytes_ = bytes;
+            }
+        }
+
+        std::size_t bytes() const
+        {
+            return bytes_;
+        }
+
+    private:
+        std::size_t bytes_;
+    };
+}}
+
+#endif
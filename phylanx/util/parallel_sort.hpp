@@ -0,0 +1,200 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PARALLEL_SORT)
+#define PHYLANX_UTIL_PARALLEL_SORT
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Inputs with fewer elements are sorted sequentially, the overheads of
+    // running in parallel don't pay off for those.
+    constexpr std::size_t parallel_sort_threshold = 65536;
+
+    namespace detail
+    {
+        // Radix sort keys, signed integers are ordered by flipping the sign
+        // bit of their two's complement representation.
+        inline std::uint64_t radix_key(std::int64_t value)
+        {
+            return static_cast<std::uint64_t>(value) ^ (std::uint64_t(1) << 63);
+        }
+
+        inline std::uint64_t radix_key(std::uint8_t value)
+        {
+            return value;
+        }
+
+        // Parallel least significant digit radix sort (8 bit digits). Each
+        // pass builds per-chunk histograms in parallel, derives the output
+        // offsets of each chunk from those, and scatters the elements stably
+        // in parallel. Passes where all elements have the same digit are
+        // skipped.
+        template <typename T>
+        void parallel_radix_sort(T* data, std::size_t size)
+        {
+            constexpr std::size_t num_buckets = 256;
+            using histogram = std::array<std::size_t, num_buckets>;
+
+            std::size_t const num_chunks = (std::max)(std::size_t(1),
+                (std::min)(std::size_t(hpx::get_os_thread_count()),
+                    size / (parallel_sort_threshold / 4)));
+
+            std::vector<T> buffer(size);
+            std::vector<histogram> offsets(num_chunks);
+
+            T* src = data;
+            T* dest = buffer.data();
+
+            for (std::size_t shift = 0; shift != 8 * sizeof(T); shift += 8)
+            {
+                auto digit = [shift](T value) {
+                    return (radix_key(value) >> shift) & (num_buckets - 1);
+                };
+
+                hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+                    [&](std::size_t chunk) {
+                        histogram& counts = offsets[chunk];
+                        counts.fill(0);
+
+                        std::size_t last = (chunk + 1) * size / num_chunks;
+                        for (std::size_t i = chunk * size / num_chunks;
+                             i != last; ++i)
+                        {
+                            ++counts[digit(src[i])];
+                        }
+                    });
+
+                // turn the counts into the offsets each chunk starts writing
+                // its elements of a particular bucket to
+                bool skip = false;
+                std::size_t offset = 0;
+                for (std::size_t bucket = 0; bucket != num_buckets; ++bucket)
+                {
+                    std::size_t bucket_begin = offset;
+                    for (std::size_t chunk = 0; chunk != num_chunks; ++chunk)
+                    {
+                        std::size_t count = offsets[chunk][bucket];
+                        offsets[chunk][bucket] = offset;
+                        offset += count;
+                    }
+                    if (offset - bucket_begin == size)
+                    {
+                        skip = true;    // all elements have the same digit
+                        break;
+                    }
+                }
+                if (skip)
+                {
+                    continue;
+                }
+
+                hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+                    [&](std::size_t chunk) {
+                        histogram& dest_offsets = offsets[chunk];
+
+                        std::size_t last = (chunk + 1) * size / num_chunks;
+                        for (std::size_t i = chunk * size / num_chunks;
+                             i != last; ++i)
+                        {
+                            dest[dest_offsets[digit(src[i])]++] = src[i];
+                        }
+                    });
+
+                std::swap(src, dest);
+            }
+
+            if (src != data)
+            {
+                hpx::parallel::copy(
+                    hpx::execution::par, src, src + size, data);
+            }
+        }
+
+        template <typename T>
+        struct use_radix_sort
+          : std::integral_constant<bool,
+                std::is_same<T, std::int64_t>::value ||
+                    std::is_same<T, std::uint8_t>::value>
+        {
+        };
+
+        template <typename T>
+        void sort_values(T* begin, T* end, std::true_type)
+        {
+            parallel_radix_sort(begin, static_cast<std::size_t>(end - begin));
+        }
+
+        template <typename T>
+        void sort_values(T* begin, T* end, std::false_type)
+        {
+            hpx::parallel::sort(hpx::execution::par, begin, end);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Sort the given iterator range, large ranges are sorted in parallel.
+    template <typename Iter, typename Compare = std::less<>>
+    void parallel_sort(Iter begin, Iter end, Compare&& comp = Compare{})
+    {
+        if (static_cast<std::size_t>(std::distance(begin, end)) <
+            parallel_sort_threshold)
+        {
+            std::sort(begin, end, std::forward<Compare>(comp));
+            return;
+        }
+        hpx::parallel::sort(
+            hpx::execution::par, begin, end, std::forward<Compare>(comp));
+    }
+
+    // Sort the given contiguous range of values in ascending order, large
+    // ranges are sorted in parallel (using a radix sort for integral data).
+    template <typename T>
+    void sort_values(T* begin, T* end)
+    {
+        if (static_cast<std::size_t>(end - begin) < parallel_sort_threshold)
+        {
+            std::sort(begin, end);
+            return;
+        }
+        detail::sort_values(begin, end, detail::use_radix_sort<T>{});
+    }
+
+    // Invoke the given function for each of a number of independent slices
+    // of an array (e.g. the rows of a matrix), in parallel if the overall
+    // number of elements is large enough.
+    template <typename F>
+    void for_each_slice(std::size_t num_slices, std::size_t slice_size, F&& f)
+    {
+        if (num_slices < 2 || num_slices * slice_size < parallel_sort_threshold)
+        {
+            for (std::size_t i = 0; i != num_slices; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_slices,
+            std::forward<F>(f));
+    }
+}}
+
+#endif
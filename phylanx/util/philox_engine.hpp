@@ -0,0 +1,99 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PHILOX_ENGINE)
+#define PHYLANX_UTIL_PHILOX_ENGINE
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Counter based random number engine (Philox4x32-10, see Salmon et.al.,
+    // "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11). Every value is
+    // a pure function of the seed, the stream, the offset, and the number of
+    // values drawn so far. Any element of a (random) array can therefore be
+    // generated independently of all others by using its offset inside the
+    // array, which makes filling arrays in parallel reproducible.
+    //
+    // The engine satisfies the UniformRandomBitGenerator requirements and
+    // can be used with all of the standard distributions.
+    class philox_engine
+    {
+    public:
+        using result_type = std::uint32_t;
+
+        philox_engine(std::uint32_t seed, std::uint64_t stream,
+                std::uint64_t offset = 0)
+          : counter_{0, static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(offset >> 32),
+                static_cast<std::uint32_t>(stream)}
+          , key_{seed, static_cast<std::uint32_t>(stream >> 32)}
+          , index_(4)
+        {
+        }
+
+        static constexpr result_type (min)()
+        {
+            return 0;
+        }
+        static constexpr result_type (max)()
+        {
+            return (std::numeric_limits<result_type>::max)();
+        }
+
+        result_type operator()()
+        {
+            if (index_ == 4)
+            {
+                generate_block();
+                index_ = 0;
+            }
+            return block_[index_++];
+        }
+
+    private:
+        static void mulhilo(std::uint32_t a, std::uint32_t b,
+            std::uint32_t& hi, std::uint32_t& lo)
+        {
+            std::uint64_t const product = std::uint64_t(a) * b;
+            hi = static_cast<std::uint32_t>(product >> 32);
+            lo = static_cast<std::uint32_t>(product);
+        }
+
+        void generate_block()
+        {
+            std::array<std::uint32_t, 4> ctr = counter_;
+            std::array<std::uint32_t, 2> key = key_;
+
+            for (int round = 0; round != 10; ++round)
+            {
+                std::uint32_t hi0, lo0, hi1, lo1;
+                mulhilo(0xD2511F53, ctr[0], hi0, lo0);
+                mulhilo(0xCD9E8D57, ctr[2], hi1, lo1);
+
+                ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+
+            block_ = ctr;
+            ++counter_[0];    // next block of the same element
+        }
+
+        std::array<std::uint32_t, 4> counter_;
+        std::array<std::uint32_t, 2> key_;
+        std::array<std::uint32_t, 4> block_;
+        std::size_t index_;
+    };
+}}
+
+#endif
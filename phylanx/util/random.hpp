@@ -1,13 +1,20 @@
 // Copyright (c) 2018 Parsa Amini
-// Copyright (c) 2018 Hartmut Kaiser
+// Copyright (c) 2018-2020 Hartmut Kaiser
 //
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/philox_engine.hpp>
 
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <random>
+#include <string>
 
 #if !defined(PHYLANX_PRIMITIVES_RANDOM_UTILS)
 #define PHYLANX_PRIMITIVES_RANDOM_UTILS
@@ -23,6 +30,86 @@ namespace phylanx { namespace util
     PHYLANX_EXPORT void set_seed(std::uint32_t seed);
 
     PHYLANX_EXPORT std::uint32_t get_seed();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the stream for the counter based generator for the next
+    // invocation of the primitive (or the distributed array) with the given
+    // name. The stream is derived from the name (ignoring the locality the
+    // primitive was created on) and the number of times it was requested for
+    // that name before. It does not depend on the order in which concurrently
+    // running primitives draw random numbers and is the same on all
+    // localities. The invocations are counted from zero again whenever the
+    // seed is set.
+    PHYLANX_EXPORT std::uint64_t next_random_stream(std::string const& name);
+
+    // Return the number of streams handed out for the given name before and
+    // count this invocation, random_stream(name, invocation) returns the
+    // same stream next_random_stream(name) would have returned
+    PHYLANX_EXPORT std::uint64_t next_random_invocation(
+        std::string const& name);
+
+    // Return the stream next_random_stream(name) hands out for the given
+    // invocation
+    PHYLANX_EXPORT std::uint64_t random_stream(
+        std::string const& name, std::uint64_t invocation);
+
+    // Return the stream for the counter based generator that is associated
+    // with the given name. This is the same for all invocations and on all
+    // localities and never collides with the streams returned by
+    // next_random_stream().
+    PHYLANX_EXPORT std::uint64_t random_stream(std::string const& name);
+
+    // Generate the random value for the element at the given offset of the
+    // array that is associated with the given stream
+    template <typename Dist>
+    typename Dist::result_type random_value(Dist& dist, std::uint32_t seed,
+        std::uint64_t stream, std::uint64_t offset)
+    {
+        philox_engine gen(seed, stream, offset);
+        dist.reset();
+        return dist(gen);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Arrays with fewer elements are filled sequentially, the overheads of
+    // running in parallel don't pay off for those.
+    constexpr std::size_t parallel_random_threshold = 65536;
+
+    // Call f(dist, i) for all i in [0, size). Large arrays are split into
+    // chunks that are filled in parallel, each using its own copy of the
+    // distribution. As long as f derives the generated values from i only
+    // (see random_value), the result does not depend on the number of
+    // threads.
+    template <typename Dist, typename F>
+    void parallel_random_fill(Dist const& dist, std::size_t size, F&& f)
+    {
+        if (size < parallel_random_threshold)
+        {
+            Dist d(dist);
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                f(d, i);
+            }
+            return;
+        }
+
+        std::size_t const num_chunks =
+            (std::min)(std::size_t(hpx::get_os_thread_count()),
+                size / (parallel_random_threshold / 4));
+        std::size_t const chunk_size = (size + num_chunks - 1) / num_chunks;
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+            [&](std::size_t chunk)
+            {
+                Dist d(dist);
+                std::size_t const end =
+                    (std::min)(size, (chunk + 1) * chunk_size);
+                for (std::size_t i = chunk * chunk_size; i < end; ++i)
+                {
+                    f(d, i);
+                }
+            });
+    }
 }}
 
 #endif
@@ -16,11 +16,42 @@
 #include <blaze/Math.h>
 #include <blaze_tensor/Math.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <vector>
 
 namespace hpx { namespace serialization
 {
+    namespace detail
+    {
+        // Load rows that were stored with the given spacing into a target
+        // whose rows might be padded differently (for instance, if the data
+        // was sent from an unpadded custom view).
+        template <typename T>
+        void load_rows(input_archive& archive, T* target,
+            std::size_t target_spacing, std::size_t rows, std::size_t columns,
+            std::size_t spacing)
+        {
+            if (spacing == target_spacing)
+            {
+                archive >> hpx::serialization::make_array(
+                               target, rows * spacing);
+                return;
+            }
+
+            std::vector<T> buffer(rows * spacing);
+            archive >> hpx::serialization::make_array(
+                           buffer.data(), buffer.size());
+
+            for (std::size_t i = 0; i != rows; ++i)
+            {
+                std::copy_n(buffer.data() + i * spacing, columns,
+                    target + i * target_spacing);
+            }
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, bool TF>
     void load(
@@ -32,8 +63,8 @@ namespace hpx { namespace serialization
         archive >> count >> spacing;
 
         target.resize(count, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), spacing);
+        detail::load_rows(
+            archive, target.data(), target.spacing(), 1, count, spacing);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -48,8 +79,8 @@ namespace hpx { namespace serialization
         archive >> rows >> columns >> spacing;
 
         target.resize(rows, columns, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), spacing * columns);
+        detail::load_rows(archive, target.data(), target.spacing(), columns,
+            rows, spacing);
     }
 
     template <typename T>
@@ -63,8 +94,8 @@ namespace hpx { namespace serialization
         archive >> rows >> columns >> spacing;
 
         target.resize(rows, columns, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), rows * spacing);
+        detail::load_rows(archive, target.data(), target.spacing(), rows,
+            columns, spacing);
     }
 
     template <typename T>
@@ -78,8 +109,8 @@ namespace hpx { namespace serialization
         archive >> pages >> rows >> columns >> spacing;
 
         target.resize(pages, rows, columns, false);
-        archive >> hpx::serialization::make_array(
-                       target.data(), rows * spacing * pages);
+        detail::load_rows(archive, target.data(), target.spacing(),
+            pages * rows, columns, spacing);
     }
 
     template <typename T>
@@ -96,8 +127,8 @@ namespace hpx { namespace serialization
 
         target.resize(
             std::array<std::size_t, 4UL>{columns, rows, pages, quats}, false);
-        archive >> hpx::serialization::make_array(
-                       target.data(), rows * spacing * pages * quats);
+        detail::load_rows(archive, target.data(), target.spacing(),
+            quats * pages * rows, columns, spacing);
     }
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, blaze::AlignmentFlag AF, blaze::PaddingFlag PF,
@@ -0,0 +1,72 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_STORAGE_POOL)
+#define PHYLANX_UTIL_STORAGE_POOL
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns whether the storage of node_data instances is recycled through
+    // the storage pool (configured by phylanx.allocator, which is either
+    // 'pooled' or 'default', the default is 'default')
+    PHYLANX_EXPORT bool storage_pool_enabled();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Pool of recently released (blaze) containers. Every worker thread keeps
+    // its own cache of containers, which avoids any synchronization and
+    // keeps the memory on the NUMA domain of the worker that last touched
+    // it. A container is handed out again only for a request for exactly the
+    // same shape, this is the typical pattern of iterative algorithms, which
+    // allocate and free the same shapes in every iteration. The number of
+    // bytes cached per worker is limited by phylanx.allocator.max_cached_bytes
+    // (defaults to 64MB), the least recently released containers are freed
+    // first.
+    //
+    // The elements of the returned containers are not initialized.
+    template <typename T>
+    struct PHYLANX_EXPORT storage_pool
+    {
+        static blaze::DynamicVector<T> vector(std::size_t size);
+        static blaze::DynamicMatrix<T> matrix(
+            std::size_t rows, std::size_t columns);
+        static blaze::DynamicTensor<T> tensor(
+            std::size_t pages, std::size_t rows, std::size_t columns);
+
+        // Hand the memory of the given container to the pool
+        static void release(blaze::DynamicVector<T>&& v);
+        static void release(blaze::DynamicMatrix<T>&& m);
+        static void release(blaze::DynamicTensor<T>&& t);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Process-wide statistics of the storage pool, exposed as performance
+    // counters
+    struct PHYLANX_EXPORT storage_pool_statistics
+    {
+        // Number of requests satisfied from the pool
+        static std::int64_t hits(bool reset);
+
+        // Number of requests that required a new allocation
+        static std::int64_t misses(bool reset);
+
+        // Percentage of the requests satisfied from the pool
+        static std::int64_t hit_rate(bool reset);
+
+        // Number of bytes currently cached by all workers (this value can't
+        // be reset)
+        static std::int64_t cached_bytes(bool reset);
+    };
+}}
+
+#endif
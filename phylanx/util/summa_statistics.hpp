@@ -0,0 +1,35 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_SUMMA_STATISTICS)
+#define PHYLANX_UTIL_SUMMA_STATISTICS
+
+#include <phylanx/config.hpp>
+
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Process-wide statistics collected by the distributed (SUMMA) matrix
+    // product, exposed as performance counters. This allows to judge how
+    // well the communication is overlapped with the computation.
+    struct PHYLANX_EXPORT summa_statistics
+    {
+        static void add(std::int64_t bytes_moved, std::int64_t wait_time,
+            std::int64_t compute_time);
+
+        // Number of bytes fetched from other localities
+        static std::int64_t bytes_moved(bool reset);
+
+        // Time spent waiting for remote tiles to arrive [ns]
+        static std::int64_t wait_time(bool reset);
+
+        // Time spent multiplying and accumulating tiles [ns]
+        static std::int64_t compute_time(bool reset);
+    };
+}}
+
+#endif
@@ -128,6 +128,10 @@ namespace phylanx { namespace bindings
 
                 auto x = code_x.run(state.eval_ctx);
 
+                // numpy arrays passed as arguments are referenced (instead
+                // of copied) for the duration of the evaluation
+                zero_copy_arguments zero_copy;
+
                 phylanx::execution_tree::primitive_arguments_type fargs;
                 fargs.reserve(args.size() + kwargs.size());
 
@@ -135,6 +139,8 @@ namespace phylanx { namespace bindings
 
                 {
                     pybind11::gil_scoped_acquire acquire;
+                    zero_copy_arguments::activate enable_zero_copy(zero_copy);
+
                     for (auto const& item : args)
                     {
                         fargs.emplace_back(item.cast<primitive_argument_type>());
@@ -403,7 +409,8 @@ namespace phylanx { namespace bindings
                 std::ostringstream os;
 
                 // CSV Header
-                os << "primitive_instance,display_name,count,time,eval_direct\n";
+                os << "primitive_instance,display_name,count,time,"
+                      "eval_direct,result_bytes,live_bytes\n";
 
                 // Print performance data
                 for (auto const& entry :
@@ -41,6 +41,69 @@
 #define PHYLANX_PYBIND_DESCR_GETNAME() name
 #endif
 
+namespace phylanx { namespace bindings
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // While an instance of zero_copy_arguments is activated on the current
+    // thread, numpy arrays that are converted to node_data are referenced
+    // instead of being copied, as long as they are C-contiguous and their
+    // element type matches the one of the node_data. The arrays are kept
+    // alive until the zero_copy_arguments instance is destroyed, which
+    // therefore has to outlive the evaluation the arguments are used for.
+    class zero_copy_arguments
+    {
+    public:
+        zero_copy_arguments() = default;
+
+        zero_copy_arguments(zero_copy_arguments const&) = delete;
+        zero_copy_arguments& operator=(zero_copy_arguments const&) = delete;
+
+        ~zero_copy_arguments()
+        {
+            // releasing the references requires holding the GIL
+            pybind11::gil_scoped_acquire acquire;
+            keep_alive_.clear();
+        }
+
+        // Activates zero-copy conversions on the current thread for the
+        // lifetime of the guard (the GIL must be held).
+        class activate
+        {
+        public:
+            explicit activate(zero_copy_arguments& args)
+              : previous_(current())
+            {
+                current() = &args;
+            }
+            ~activate()
+            {
+                current() = previous_;
+            }
+
+            activate(activate const&) = delete;
+            activate& operator=(activate const&) = delete;
+
+        private:
+            zero_copy_arguments* previous_;
+        };
+
+        static zero_copy_arguments*& current()
+        {
+            static thread_local zero_copy_arguments* args = nullptr;
+            return args;
+        }
+
+        void keep_alive(pybind11::handle obj)
+        {
+            keep_alive_.push_back(
+                pybind11::reinterpret_borrow<pybind11::object>(obj));
+        }
+
+    private:
+        std::vector<pybind11::object> keep_alive_;
+    };
+}}
+
 // older versions of pybind11 don't support variant-like types
 namespace pybind11 { namespace detail
 {
@@ -463,11 +526,77 @@ namespace pybind11 { namespace detail
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Only float64 and int64 arrays can be referenced without conversion
+    template <typename T>
+    struct supports_zero_copy
+      : std::integral_constant<bool,
+            std::is_same<T, double>::value ||
+                std::is_same<T, std::int64_t>::value>
+    {
+    };
+
     template <typename T>
     class type_caster<phylanx::ir::node_data<T>>
     {
         using result_type = typename casted_type<T>::type;
 
+        // Reference the data of C-contiguous arrays of the exact element
+        // type without copying. The blaze custom types used by node_data
+        // neither require the data to be aligned nor the rows to be padded,
+        // thus any such array can be referenced.
+        bool load_reference(handle src, std::false_type)
+        {
+            return false;
+        }
+
+        bool load_reference(handle src, std::true_type)
+        {
+            auto* args = phylanx::bindings::zero_copy_arguments::current();
+            if (args == nullptr || !isinstance<array_t<T, array::c_style>>(src))
+            {
+                return false;
+            }
+
+            auto buf = reinterpret_borrow<array>(src);
+
+            auto dims = buf.ndim();
+            if (dims == 0 || dims > 4 || buf.size() == 0)
+            {
+                return false;
+            }
+
+            std::size_t const columns = buf.shape(dims - 1);
+            T* data = const_cast<T*>(static_cast<T const*>(buf.data()));
+
+            using storage = phylanx::ir::node_data<T>;
+            switch (dims)
+            {
+            case 1:
+                value = typename storage::custom_storage1d_type(data, columns);
+                break;
+
+            case 2:
+                value = typename storage::custom_storage2d_type(
+                    data, buf.shape(0), columns, columns);
+                break;
+
+            case 3:
+                value = typename storage::custom_storage3d_type(
+                    data, buf.shape(0), buf.shape(1), columns, columns);
+                break;
+
+            default:
+                value = typename storage::custom_storage4d_type(data,
+                    buf.shape(0), buf.shape(1), buf.shape(2), columns,
+                    columns);
+                break;
+            }
+
+            args->keep_alive(src);
+            return true;
+        }
+
         bool load0d(handle src, bool convert)
         {
             // np.array([0]) is convertible to a scalar value
@@ -972,7 +1101,8 @@ namespace pybind11 { namespace detail
     public:
         bool load(handle src, bool convert)
         {
-            return load0d(src, convert)
+            return load_reference(src, supports_zero_copy<T>{})
+                || load0d(src, convert)
                 || load1d(src, convert)
                 || load2d(src, convert)
                 || load3d(src, convert)
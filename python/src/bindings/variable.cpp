@@ -275,6 +275,10 @@ namespace phylanx { namespace execution_tree
     ///////////////////////////////////////////////////////////////////////////
     pybind11::object variable::eval(pybind11::args args) const
     {
+        // numpy arrays passed as arguments are referenced (instead of copied)
+        // for the duration of the evaluation
+        phylanx::bindings::zero_copy_arguments zero_copy;
+
         phylanx::execution_tree::primitive_arguments_type keep_alive;
         keep_alive.reserve(args.size());
         phylanx::execution_tree::primitive_arguments_type fargs;
@@ -282,6 +286,9 @@ namespace phylanx { namespace execution_tree
 
         {
             pybind11::gil_scoped_acquire acquire;
+            phylanx::bindings::zero_copy_arguments::activate enable_zero_copy(
+                zero_copy);
+
             for (auto const& item : args)
             {
                 using phylanx::execution_tree::primitive_argument_type;
@@ -7,9 +7,12 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compile_cache.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compiler_component.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/scoped_timer.hpp>
 
 #include <hpx/modules/format.hpp>
 #include <hpx/include/naming.hpp>
@@ -17,6 +20,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,34 +32,40 @@ namespace phylanx { namespace execution_tree
     {
         compiler::function compile(std::string const& name,
             ast::expression const& expr, compiler::function_list& snippets,
-            compiler::environment& env, hpx::id_type const& default_locality)
+            compiler::environment& env,
+            compiler::expression_pattern_list const& patterns,
+            hpx::id_type const& default_locality)
         {
             ++snippets.compile_id_;
-            return compiler::compile(name, expr, snippets, env,
-                compiler::generate_patterns(), default_locality);
+
+            std::int64_t elapsed = 0;
+            compiler::function result;
+            {
+                util::scoped_timer<std::int64_t> timer(elapsed);
+                result = compiler::compile(
+                    name, expr, snippets, env, patterns, default_locality);
+            }
+            compile_statistics::add(compile_statistics::generate, elapsed);
+            return result;
         }
 
         compiler::function compile(std::string const& name,
             ast::expression const& expr, compiler::function_list& snippets,
-            hpx::id_type const& default_locality)
+            compiler::environment& env, hpx::id_type const& default_locality)
         {
-            compiler::environment env =
-                compiler::default_environment(default_locality);
-
-            ++snippets.compile_id_;
-            return compiler::compile(name, expr, snippets, env,
+            return compile(name, expr, snippets, env,
                 compiler::generate_patterns(), default_locality);
         }
 
         compiler::function compile(std::string const& name,
             ast::expression const& expr, compiler::function_list& snippets,
-            compiler::environment& env,
-            compiler::expression_pattern_list const& patterns,
             hpx::id_type const& default_locality)
         {
-            ++snippets.compile_id_;
-            return compiler::compile(
-                name, expr, snippets, env, patterns, default_locality);
+            compiler::environment env =
+                compiler::default_environment(default_locality);
+
+            return compile(name, expr, snippets, env,
+                compiler::generate_patterns(), default_locality);
         }
     }
 
@@ -121,7 +131,7 @@ namespace phylanx { namespace execution_tree
         compiler::environment& env, hpx::id_type const& default_locality)
     {
         return compile(name, detail::generate_unique_function_name(),
-            ast::generate_ast(expr), snippets, env, default_locality);
+            generate_ast_cached(expr), snippets, env, default_locality);
     }
 
     compiler::entry_point const& compile(std::string const& name,
@@ -129,8 +139,8 @@ namespace phylanx { namespace execution_tree
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality)
     {
-        return compile(name, func_name, ast::generate_ast(expr), snippets, env,
-            default_locality);
+        return compile(name, func_name, generate_ast_cached(expr), snippets,
+            env, default_locality);
     }
 
     compiler::entry_point const& compile(std::string const& name,
@@ -158,7 +168,7 @@ namespace phylanx { namespace execution_tree
         hpx::id_type const& default_locality)
     {
         return compile(name, detail::generate_unique_function_name(),
-            ast::generate_ast(expr), snippets, default_locality);
+            generate_ast_cached(expr), snippets, default_locality);
     }
 
     compiler::entry_point const& compile(std::string const& name,
@@ -173,7 +183,7 @@ namespace phylanx { namespace execution_tree
         std::string const& func_name, std::string const& expr,
         compiler::function_list& snippets, hpx::id_type const& default_locality)
     {
-        return compile(name, func_name, ast::generate_ast(expr), snippets,
+        return compile(name, func_name, generate_ast_cached(expr), snippets,
             default_locality);
     }
 
@@ -192,7 +202,7 @@ namespace phylanx { namespace execution_tree
         hpx::id_type const& default_locality)
     {
         return compile("<unknown>", detail::generate_unique_function_name(),
-            ast::generate_ast(expr), snippets, env, default_locality);
+            generate_ast_cached(expr), snippets, env, default_locality);
     }
 
     compiler::entry_point const& compile(
@@ -207,7 +217,7 @@ namespace phylanx { namespace execution_tree
         compiler::function_list& snippets, hpx::id_type const& default_locality)
     {
         return compile("<unknown>", detail::generate_unique_function_name(),
-            ast::generate_ast(expr), snippets, default_locality);
+            generate_ast_cached(expr), snippets, default_locality);
     }
 
     ///////////////////////////////////////////////////////////////////////////
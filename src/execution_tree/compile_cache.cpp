@@ -0,0 +1,270 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/generate_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compile_cache.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
+#include <phylanx/util/scoped_timer.hpp>
+#include <phylanx/util/serialization/ast.hpp>
+
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // bump this whenever the layout of the cache files changes
+        constexpr std::uint32_t compile_cache_version = 1;
+        constexpr char const compile_cache_magic[8] = {
+            'P', 'H', 'Y', 'S', 'L', 'A', 'S', 'T'};
+
+        // The hash has to be stable across processes, thus we can't rely on
+        // std::hash (FNV-1a, 64 bit).
+        inline std::uint64_t fnv1a_hash(
+            char const* data, std::size_t size, std::uint64_t hash)
+        {
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                hash ^= static_cast<std::uint8_t>(data[i]);
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        inline std::uint64_t fnv1a_hash(
+            std::string const& s, std::uint64_t hash = 0xcbf29ce484222325ull)
+        {
+            return fnv1a_hash(s.data(), s.size(), hash);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::int64_t get_process_id()
+        {
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+            return static_cast<std::int64_t>(::_getpid());
+#else
+            return static_cast<std::int64_t>(::getpid());
+#endif
+        }
+
+        template <typename T>
+        void write_value(std::ofstream& os, T value)
+        {
+            os.write(reinterpret_cast<char const*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool read_value(std::ifstream& is, T& value)
+        {
+            return !!is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        }
+
+        bool read_block(std::ifstream& is, std::vector<char>& data)
+        {
+            std::uint64_t size = 0;
+            if (!read_value(is, size))
+            {
+                return false;
+            }
+            data.resize(size);
+            return size == 0 ||
+                !!is.read(data.data(), static_cast<std::streamsize>(size));
+        }
+
+        // The cache file stores the source as well, this protects against
+        // hash collisions.
+        bool read_cache_entry(std::string const& filename,
+            std::string const& expr, std::vector<ast::expression>& result)
+        {
+            std::ifstream is(filename, std::ios::in | std::ios::binary);
+            if (!is.is_open())
+            {
+                return false;
+            }
+
+            char magic[sizeof(compile_cache_magic)];
+            std::uint32_t version = 0;
+            if (!is.read(magic, sizeof(magic)) ||
+                std::memcmp(magic, compile_cache_magic, sizeof(magic)) != 0 ||
+                !read_value(is, version) || version != compile_cache_version)
+            {
+                return false;
+            }
+
+            std::vector<char> source;
+            if (!read_block(is, source) || source.size() != expr.size() ||
+                !std::equal(source.begin(), source.end(), expr.begin()))
+            {
+                return false;
+            }
+
+            std::vector<char> data;
+            if (!read_block(is, data))
+            {
+                return false;
+            }
+
+            try
+            {
+                result = util::unserialize<std::vector<ast::expression>>(data);
+            }
+            catch (...)
+            {
+                return false;    // corrupted cache entry, recompile
+            }
+            return true;
+        }
+
+        // Return a name for the temporary file the cache entry is written to
+        // that is unique for the process (the localities of several
+        // applications might run with the same id on the same node) and for
+        // concurrently compiled expressions inside of the process.
+        std::string temporary_cache_entry_name(std::string const& filename)
+        {
+            static std::atomic<std::uint64_t> count(0);
+
+            std::random_device rd;
+            std::uint64_t const suffix =
+                (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+
+            return hpx::util::format("{}.{}.{:016x}.{}.tmp", filename,
+                detail::get_process_id(), suffix, ++count);
+        }
+
+        // Write the cache file atomically, concurrently running processes
+        // must never see a partially written entry.
+        void write_cache_entry(std::string const& filename,
+            std::string const& expr,
+            std::vector<ast::expression> const& exprs)
+        {
+            std::vector<char> data = util::serialize(exprs);
+
+            std::string const tmpname = temporary_cache_entry_name(filename);
+            {
+                std::ofstream os(tmpname, std::ios::out | std::ios::binary);
+                if (!os.is_open())
+                {
+                    return;
+                }
+
+                os.write(compile_cache_magic, sizeof(compile_cache_magic));
+                write_value(os, compile_cache_version);
+                write_value(os, static_cast<std::uint64_t>(expr.size()));
+                os.write(
+                    expr.data(), static_cast<std::streamsize>(expr.size()));
+                write_value(os, static_cast<std::uint64_t>(data.size()));
+                os.write(
+                    data.data(), static_cast<std::streamsize>(data.size()));
+
+                if (!os)
+                {
+                    os.close();
+                    std::remove(tmpname.c_str());
+                    return;
+                }
+            }
+
+            if (std::rename(tmpname.c_str(), filename.c_str()) != 0)
+            {
+                std::remove(tmpname.c_str());
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string compile_cache_key(std::string const& expr)
+    {
+        std::ostringstream strm;
+        strm << std::hex << std::setfill('0') << std::setw(16)
+             << detail::fnv1a_hash(expr) << std::dec << '-' << expr.size();
+        return strm.str();
+    }
+
+    std::string const& compile_cache_directory()
+    {
+        static std::string directory =
+            hpx::get_config_entry("phylanx.compile_cache_directory", "");
+        return directory;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::vector<ast::expression> generate_ast_cached(
+            std::string const& expr, std::string const& cache_directory);
+    }
+
+    std::vector<ast::expression> generate_ast_cached(
+        std::string const& expr, std::string const& cache_directory)
+    {
+        std::int64_t elapsed = 0;
+        std::vector<ast::expression> result;
+        {
+            util::scoped_timer<std::int64_t> timer(elapsed);
+            result = detail::generate_ast_cached(expr, cache_directory);
+        }
+        compile_statistics::add(compile_statistics::parse, elapsed);
+        return result;
+    }
+
+    std::vector<ast::expression> detail::generate_ast_cached(
+        std::string const& expr, std::string const& cache_directory)
+    {
+        if (cache_directory.empty())
+        {
+            return ast::generate_ast(expr);
+        }
+
+        hpx::filesystem::path path(cache_directory);
+        path /= compile_cache_key(expr) + ".physl-ast";
+
+        std::vector<ast::expression> result;
+        if (detail::read_cache_entry(path.string(), expr, result))
+        {
+            return result;
+        }
+
+        // cache miss, parse the source and store the result
+        result = ast::generate_ast(expr);
+
+        hpx::filesystem::error_code ec;
+        hpx::filesystem::create_directories(cache_directory, ec);
+        if (!ec)
+        {
+            detail::write_cache_entry(path.string(), expr, result);
+        }
+
+        return result;
+    }
+
+    std::vector<ast::expression> generate_ast_cached(std::string const& expr)
+    {
+        return generate_ast_cached(expr, compile_cache_directory());
+    }
+}}
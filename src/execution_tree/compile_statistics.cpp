@@ -0,0 +1,66 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    static std::atomic<std::int64_t> phase_times_[4] = {{0}, {0}, {0}, {0}};
+    static std::atomic<std::int64_t> lookups_(0);
+    static std::atomic<std::int64_t> candidates_(0);
+
+    void compile_statistics::add(phase p, std::int64_t time)
+    {
+        phase_times_[p].fetch_add(time, std::memory_order_relaxed);
+    }
+
+    void compile_statistics::add_lookup(std::int64_t candidates)
+    {
+        lookups_.fetch_add(1, std::memory_order_relaxed);
+        candidates_.fetch_add(candidates, std::memory_order_relaxed);
+    }
+
+    std::int64_t compile_statistics::time(phase p, bool reset)
+    {
+        return hpx::util::get_and_reset_value(phase_times_[p], reset);
+    }
+
+    std::int64_t compile_statistics::parse_time(bool reset)
+    {
+        return time(parse, reset);
+    }
+
+    std::int64_t compile_statistics::index_time(bool reset)
+    {
+        return time(index, reset);
+    }
+
+    std::int64_t compile_statistics::match_time(bool reset)
+    {
+        return time(match, reset);
+    }
+
+    std::int64_t compile_statistics::generate_time(bool reset)
+    {
+        return time(generate, reset);
+    }
+
+    std::int64_t compile_statistics::lookups(bool reset)
+    {
+        return hpx::util::get_and_reset_value(lookups_, reset);
+    }
+
+    std::int64_t compile_statistics::candidates(bool reset)
+    {
+        return hpx::util::get_and_reset_value(candidates_, reset);
+    }
+}}
@@ -17,16 +17,20 @@
 #include <phylanx/ast/traverse.hpp>
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compiler/locality_attribute.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/scoped_timer.hpp>
 
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
 
 #include <boost/fusion/include/std_pair.hpp>
 #include <boost/spirit/include/qi_attr.hpp>
@@ -138,24 +142,18 @@ namespace phylanx { namespace execution_tree { namespace compiler {
         }
 
         ///////////////////////////////////////////////////////////////////////
-        // parse an __arg(_1, _2) construct
-        bool parse_argument_value(expression_pattern_list const& patterns,
+        // parse an __arg(_1, _2) construct, arg_pattern is the parsed
+        // __arg(_1, _2) pattern
+        bool parse_argument_value(ast::expression const& arg_pattern,
             ast::expression const& expr, std::string& argname,
-            std::string& value)
+            ast::expression& value)
         {
             using placeholder_map_type =
                 std::multimap<std::string, ast::expression>;
 
-            // find __arg pattern
-            auto arg_it = patterns.lower_bound("__arg");
-            if (arg_it == patterns.end())
-            {
-                return false;
-            }
-
             // attempt to match the argument against __arg(_1, _2)
             placeholder_map_type placeholders;
-            bool result = ast::match_ast(arg_it->second.pattern_ast_, expr,
+            bool result = ast::match_ast(arg_pattern, expr,
                 ast::detail::on_placeholder_match{placeholders});
             if (!result)
                 return false;
@@ -177,11 +175,55 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             }
 
             argname = std::move(names.second);
-            value = to_string(p->second, true);
+            value = std::move(p->second);
 
             return true;
         }
 
+        bool parse_argument_value(expression_pattern_list const& patterns,
+            ast::expression const& expr, std::string& argname,
+            std::string& value)
+        {
+            // find __arg pattern
+            auto arg_it = patterns.lower_bound("__arg");
+            if (arg_it == patterns.end())
+            {
+                return false;
+            }
+
+            ast::expression value_expr;
+            if (!parse_argument_value(
+                    arg_it->second.pattern_ast_, expr, argname, value_expr))
+            {
+                return false;
+            }
+
+            value = to_string(value_expr, true);
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // parse the default values of a pattern once, when the pattern is
+        // created
+        std::vector<ast::expression> parse_default_values(
+            std::vector<std::string> const& defaults)
+        {
+            std::vector<ast::expression> result;
+            result.reserve(defaults.size());
+            for (auto const& d : defaults)
+            {
+                if (d.empty())
+                {
+                    result.emplace_back();  // argument has no default value
+                }
+                else
+                {
+                    result.push_back(ast::generate_ast(d)[0]);
+                }
+            }
+            return result;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         bool extract_arguments(std::string const& name,
             expression_pattern_list const& patterns,
@@ -336,10 +378,13 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     p.primitive_type_ + suffix,
                     expression_pattern{std::move(pattern), std::move(exprs[0]),
                         p.create_primitive_, std::move(args),
-                        std::move(defaults)}));
+                        std::move(defaults), {}}));
             }
             else
             {
+                std::vector<ast::expression> defaults_ast =
+                    parse_default_values(defaults);
+
                 // reconstruct all patterns (with varying number of default
                 // arguments)
                 for (std::size_t i = defaults.size() + 1; i != 0; --i)
@@ -353,7 +398,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         p.primitive_type_ + suffix,
                         expression_pattern{std::move(resulting_pattern),
                             std::move(exprs[0]), p.create_primitive_, args,
-                            defaults}));
+                            defaults, defaults_ast}));
                 }
             }
         }
@@ -407,6 +452,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
           , env_(env)
           , snippets_(snippets)
           , patterns_(patterns)
+          , index_(patterns.index())
           , default_locality_(default_locality)
         {
         }
@@ -598,12 +644,11 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             ast::expression const& arg, hpx::id_type const& locality,
             ast::tagged const& id) const
         {
-            expression_pattern_list::const_iterator cit =
-                patterns_.lower_bound("__arg");
-            HPX_ASSERT(cit != patterns_.end());
+            ast::expression const* arg_pattern = index_->argument_pattern();
+            HPX_ASSERT(arg_pattern != nullptr);
 
             placeholder_map_type placeholders;
-            if (!ast::match_ast(cit->second.pattern_ast_, arg,
+            if (!ast::match_ast(*arg_pattern, arg,
                     ast::detail::on_placeholder_match{placeholders}))
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -1281,9 +1326,10 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         ast::detail::function_name(argexpr) == "__arg")
                     {
                         std::string argname;
-                        std::string value;
+                        ast::expression value;
                         detail::parse_argument_value(
-                            patterns_, argexpr, argname, value);
+                            *index_->argument_pattern(), argexpr, argname,
+                            value);
 
                         HPX_THROW_EXCEPTION(hpx::bad_parameter,
                             "phylanx::execution_tree::compiler::"
@@ -1325,12 +1371,12 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         continue;    // skip arguments that have no default value
                     }
 
-                    ast::expression default_expr =
-                        ast::generate_ast(it->second.defaults_[default_arg])[0];
-
-                    fargs[base + pos] = compile(name_, default_expr, snippets_,
-                        env, patterns_, locality)
-                                            .arg_;
+                    // the default values were parsed when the pattern was
+                    // created
+                    fargs[base + pos] =
+                        compile(name_, it->second.defaults_ast_[default_arg],
+                            snippets_, env, patterns_, locality)
+                            .arg_;
                     args_valid[pos] = true;
                 }
             }
@@ -1347,10 +1393,11 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 {
                     // named argument
                     std::string argname;
-                    std::string value;
+                    ast::expression value;
 
                     if (detail::parse_argument_value(
-                            patterns_, argexpr, argname, value))
+                            *index_->argument_pattern(), argexpr, argname,
+                            value))
                     {
                         std::size_t pos = it->second.keyword_position(argname);
                         if (pos == std::size_t(-1))
@@ -1371,10 +1418,9 @@ namespace phylanx { namespace execution_tree { namespace compiler {
 
                         // place the keyword argument into the argument slot
                         // it belongs
-                        fargs[base + pos] =
-                            compile(name_, ast::generate_ast(value)[0],
-                                snippets_, env, patterns_, locality)
-                                .arg_;
+                        fargs[base + pos] = compile(
+                            name_, value, snippets_, env, patterns_, locality)
+                                                .arg_;
                         args_valid[pos] = true;
 
                         count = base + pos + 1;
@@ -1545,6 +1591,208 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     name_, id));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Chains of nested element-wise operations are compiled into a single
+        // __fused primitive that evaluates the whole chain in one pass without
+        // creating intermediate arrays.
+        static bool fuse_elementwise_operations()
+        {
+            static bool fuse_operations = hpx::get_config_entry(
+                "phylanx.fuse_elementwise_operations", "1") == "1";
+            return fuse_operations;
+        }
+
+        // the element-wise operations that can be fused (name -> true if the
+        // operation is unary)
+        static std::map<std::string, bool> const& fusible_operations()
+        {
+            static std::map<std::string, bool> const operations = {
+                {"__add", false}, {"__sub", false}, {"__mul", false},
+                {"__div", false}, {"maximum", false}, {"minimum", false},
+                {"__minus", true}, {"absolute", true}, {"floor", true},
+                {"ceil", true}, {"trunc", true}, {"rint", true},
+                {"sqrt", true}, {"invsqrt", true}, {"cbrt", true},
+                {"invcbrt", true}, {"exp", true}, {"exp2", true},
+                {"exp10", true}, {"log", true}, {"log2", true},
+                {"log10", true}, {"sin", true}, {"cos", true}, {"tan", true},
+                {"sinh", true}, {"cosh", true}, {"tanh", true},
+                {"arcsin", true}, {"arccos", true}, {"arctan", true},
+                {"arcsinh", true}, {"arccosh", true}, {"arctanh", true},
+                {"erf", true}, {"erfc", true}, {"square", true},
+                {"sign", true}};
+            return operations;
+        }
+
+        // only plain invocations (no keyword arguments, no dtype, no
+        // locality attribute) of the built-in operations above can be fused
+        bool is_fusible_operation(ast::expression const& expr)
+        {
+            if (!ast::detail::is_function_call(expr) ||
+                !ast::detail::function_attribute(expr).empty())
+            {
+                return false;
+            }
+
+            auto it = fusible_operations().find(
+                ast::detail::function_name(expr));
+            if (it == fusible_operations().end())
+            {
+                return false;
+            }
+
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(expr);
+            if (it->second ? args.size() != 1 : args.size() < 2)
+            {
+                return false;
+            }
+
+            // user defined functions may shadow the built-in operations
+            environment::definition_data* def = env_.find_data(it->first);
+            if (def == nullptr || def->codename_ != "<builtin>")
+            {
+                return false;
+            }
+
+            for (auto const& arg : args)
+            {
+                if (ast::detail::is_function_call(arg) &&
+                    ast::detail::function_name(arg) == "__arg")
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // generate the postfix representation of the fused expression,
+        // collect its leaves, and count the number of fused operations
+        std::size_t collect_fused_expression(ast::expression const& expr,
+            std::string& program, std::vector<ast::expression>& leaves)
+        {
+            if (!is_fusible_operation(expr))
+            {
+                if (!program.empty())
+                {
+                    program += ' ';
+                }
+                program += '$' + std::to_string(leaves.size());
+                leaves.push_back(expr);
+                return 0;
+            }
+
+            std::string const& name = ast::detail::function_name(expr);
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(expr);
+
+            // n-ary operations are folded from the left
+            std::size_t count =
+                collect_fused_expression(args[0], program, leaves) + 1;
+            if (args.size() == 1)
+            {
+                program += ' ' + name;
+                return count;
+            }
+
+            for (auto it = args.begin() + 1; it != args.end(); ++it)
+            {
+                count += collect_fused_expression(*it, program, leaves);
+                program += ' ' + name;
+            }
+            return count;
+        }
+
+        // The fused primitive falls back to the unfused expression whenever
+        // the actual argument values can't be handled by the fused kernel.
+        // The leaves of the unfused expression are the values of the fused
+        // leaves that are passed along as arguments.
+        function compile_fused_fallback(
+            ast::expression const& expr, std::size_t& leaf)
+        {
+            ast::tagged id = ast::detail::tagged_id(expr);
+
+            if (!is_fusible_operation(expr))
+            {
+                static std::string fused_argument_("fused_argument");
+                primitive_name_parts name_parts(fused_argument_, 0ull, id.id,
+                    id.col, snippets_.compile_id_ - 1,
+                    get_locality_id(default_locality_));
+
+                return access_argument(leaf++, default_locality_)(
+                    std::list<function>{}, std::move(name_parts), name_);
+            }
+
+            std::string const& name = ast::detail::function_name(expr);
+
+            std::list<function> args;
+            for (auto const& arg : ast::detail::function_arguments(expr))
+            {
+                args.push_back(compile_fused_fallback(arg, leaf));
+            }
+
+            compiled_function* cf = env_.find(name);
+            HPX_ASSERT(cf != nullptr);
+
+            primitive_name_parts name_parts(name,
+                snippets_.sequence_numbers_[name]++, id.id, id.col,
+                snippets_.compile_id_ - 1, get_locality_id(default_locality_));
+
+            return (*cf)(std::move(args), std::move(name_parts), name_);
+        }
+
+        bool handle_fused_operations(
+            ast::expression const& expr, ast::tagged const& id, function& result)
+        {
+            static std::string fused_("__fused");
+
+            // the __fused primitive might not be available
+            if (!fuse_elementwise_operations() ||
+                patterns_.find(fused_) == patterns_.end() ||
+                !is_fusible_operation(expr))
+            {
+                return false;
+            }
+
+            std::string program;
+            std::vector<ast::expression> leaves;
+            if (collect_fused_expression(expr, program, leaves) < 2)
+            {
+                return false;    // nothing to fuse
+            }
+
+            primitive_arguments_type fargs;
+            fargs.reserve(leaves.size() + 2);
+
+            fargs.emplace_back(std::move(program));
+
+            std::size_t leaf = 0;
+            fargs.push_back(compile_fused_fallback(expr, leaf).arg_);
+            HPX_ASSERT(leaf == leaves.size());
+
+            {
+                environment env(&env_);
+                for (auto const& leaf_expr : leaves)
+                {
+                    fargs.push_back(compile(name_, leaf_expr, snippets_, env,
+                        patterns_, default_locality_)
+                                        .arg_);
+                }
+            }
+
+            primitive_name_parts name_parts(fused_,
+                snippets_.sequence_numbers_[fused_]++, id.id, id.col,
+                snippets_.compile_id_ - 1, get_locality_id(default_locality_));
+
+            std::string full_name = compose_primitive_name(name_parts);
+            result = function{
+                primitive_argument_type{create_primitive_component(
+                    default_locality_, fused_, std::move(fargs), full_name,
+                    name_)},
+                full_name};
+
+            return true;
+        }
+
         // separate name from possible dtype
         static std::string extract_name_and_dtype(std::string const& fullname)
         {
@@ -1556,6 +1804,129 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             return fullname;
         }
 
+        // find the first pattern matching the given function call, starting
+        // with the pattern cit refers to
+        bool match_function_call(ast::expression const& expr,
+            std::string const& function_name,
+            expression_pattern_list::const_iterator& cit,
+            placeholder_map_type& placeholders) const
+        {
+            std::int64_t elapsed = 0;
+            std::int64_t candidates = 0;
+            bool result = false;
+            {
+                util::scoped_timer<std::int64_t> timer(elapsed);
+
+                auto const args = ast::detail::function_arguments(expr);
+                bool const has_ellipses = std::any_of(args.begin(),
+                    args.end(), [](ast::expression const& arg) {
+                        return ast::detail::is_placeholder_ellipses(arg);
+                    });
+
+                pattern_index::candidate_list const* candidate_list =
+                    nullptr;
+                if (!has_ellipses)
+                {
+                    candidate_list = index_->function_call_candidates(
+                        function_name, args.size());
+                }
+
+                if (candidate_list != nullptr)
+                {
+                    for (auto const& candidate : *candidate_list)
+                    {
+                        ++candidates;
+                        if (ast::match_ast(expr, candidate->second.pattern_ast_,
+                                ast::detail::on_placeholder_match{
+                                    placeholders}))
+                        {
+                            cit = candidate;
+                            result = true;
+                            break;
+                        }
+                        placeholders.clear();
+                    }
+                }
+                else
+                {
+                    // the arguments could match any number of pattern
+                    // arguments, try all patterns for the given function
+                    for (/**/; cit != patterns_.end() &&
+                         (*cit).first == function_name;
+                         ++cit)
+                    {
+                        ++candidates;
+                        if (ast::match_ast(expr, cit->second.pattern_ast_,
+                                ast::detail::on_placeholder_match{
+                                    placeholders}))
+                        {
+                            result = true;
+                            break;
+                        }
+                        placeholders.clear();
+                    }
+                }
+            }
+
+            compile_statistics::add(compile_statistics::match, elapsed);
+            compile_statistics::add_lookup(candidates);
+            return result;
+        }
+
+        // find the first pattern matching the given expression (which is not
+        // a function call)
+        bool match_expression(ast::expression const& expr,
+            expression_pattern_list::const_iterator& cit,
+            placeholder_map_type& placeholders) const
+        {
+            std::int64_t elapsed = 0;
+            std::int64_t candidates = 0;
+            bool result = false;
+            {
+                util::scoped_timer<std::int64_t> timer(elapsed);
+
+                if (ast::detail::is_placeholder(expr))
+                {
+                    // a placeholder matches any pattern
+                    for (cit = patterns_.begin(); cit != patterns_.end(); ++cit)
+                    {
+                        ++candidates;
+                        if (ast::match_ast(expr, cit->second.pattern_ast_,
+                                ast::detail::on_placeholder_match{
+                                    placeholders}))
+                        {
+                            result = true;
+                            break;
+                        }
+                        placeholders.clear();
+                    }
+                }
+                else
+                {
+                    // function call patterns can't match other expressions
+                    auto const& candidate_list =
+                        index_->expression_candidates();
+                    for (auto const& candidate : candidate_list)
+                    {
+                        ++candidates;
+                        if (ast::match_ast(expr, candidate->second.pattern_ast_,
+                                ast::detail::on_placeholder_match{
+                                    placeholders}))
+                        {
+                            cit = candidate;
+                            result = true;
+                            break;
+                        }
+                        placeholders.clear();
+                    }
+                }
+            }
+
+            compile_statistics::add(compile_statistics::match, elapsed);
+            compile_statistics::add_lookup(candidates);
+            return result;
+        }
+
     public:
         function operator()(ast::expression const& expr)
         {
@@ -1643,19 +2014,19 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     //     }
                     // }
 
-                    // handle all non-special functions
-                    while (
-                        cit != patterns_.end() && (*cit).first == function_name)
+                    // fuse chains of element-wise operations
+                    function fused_result;
+                    if (handle_fused_operations(expr, id, fused_result))
                     {
-                        placeholder_map_type placeholders;
-                        if (!ast::match_ast(expr, cit->second.pattern_ast_,
-                                ast::detail::on_placeholder_match{
-                                    placeholders}))
-                        {
-                            ++cit;
-                            continue;    // no match found for the current pattern
-                        }
+                        return fused_result;
+                    }
 
+                    // handle all non-special functions, only the patterns
+                    // accepting the given number of arguments are tried
+                    placeholder_map_type placeholders;
+                    if (match_function_call(
+                            expr, function_name, cit, placeholders))
+                    {
                         return handle_placeholders(
                             placeholders, (*cit).first, id);
                     }
@@ -1668,16 +2039,11 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             else
             {
                 // this should handle all remaining constructs (non-function calls)
-                for (auto const& pattern : patterns_)
+                expression_pattern_list::const_iterator cit;
+                placeholder_map_type placeholders;
+                if (match_expression(expr, cit, placeholders))
                 {
-                    placeholder_map_type placeholders;
-                    if (!ast::match_ast(expr, pattern.second.pattern_ast_,
-                            ast::detail::on_placeholder_match{placeholders}))
-                    {
-                        continue;    // no match found for the current pattern
-                    }
-
-                    return handle_placeholders(placeholders, pattern.first, id);
+                    return handle_placeholders(placeholders, (*cit).first, id);
                 }
             }
 
@@ -1772,6 +2138,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
         environment& env_;           // current compilation environment
         function_list& snippets_;    // list of compiled snippets
         expression_pattern_list const& patterns_;
+        std::shared_ptr<pattern_index const> index_;
         hpx::id_type default_locality_;
     };
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_placeholder_ellipses.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+#include <phylanx/util/scoped_timer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Return the smallest number of arguments a call has to have to match
+        // the given function call pattern, set variadic if the pattern
+        // accepts more arguments than that
+        std::size_t minimal_arity(
+            ast::expression const& pattern, bool& variadic)
+        {
+            variadic = false;
+
+            std::size_t arity = 0;
+            for (auto const& arg : ast::detail::function_arguments(pattern))
+            {
+                // an ellipsis matches zero or more of the remaining arguments
+                if (ast::detail::is_placeholder_ellipses(arg))
+                {
+                    variadic = true;
+                    break;
+                }
+                ++arity;
+            }
+            return arity;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pattern_index::pattern_index(expression_pattern_list const& patterns)
+      : argument_pattern_(nullptr)
+      , size_(patterns.size())
+    {
+        std::int64_t elapsed = 0;
+        {
+            util::scoped_timer<std::int64_t> timer(elapsed);
+
+            struct call_pattern
+            {
+                const_iterator it;
+                std::size_t arity;
+                bool variadic;
+            };
+            std::map<std::string, std::vector<call_pattern>> calls;
+
+            for (auto it = patterns.begin(); it != patterns.end(); ++it)
+            {
+                ast::expression const& pattern = it->second.pattern_ast_;
+                if (!ast::detail::is_function_call(pattern))
+                {
+                    expressions_.push_back(it);
+                    continue;
+                }
+
+                bool variadic = false;
+                std::size_t arity = detail::minimal_arity(pattern, variadic);
+                calls[it->first].push_back(call_pattern{it, arity, variadic});
+            }
+
+            // list the candidates for each possible number of arguments,
+            // keeping the order of the patterns
+            for (auto const& call : calls)
+            {
+                std::size_t max_arity = 0;
+                for (auto const& p : call.second)
+                {
+                    max_arity = (std::max)(max_arity, p.arity);
+                }
+
+                function_call_node& node = function_calls_[call.first];
+                node.arities_.resize(max_arity + 1);
+
+                for (auto const& p : call.second)
+                {
+                    if (!p.variadic)
+                    {
+                        node.arities_[p.arity].push_back(p.it);
+                        continue;
+                    }
+
+                    for (std::size_t i = p.arity; i <= max_arity; ++i)
+                    {
+                        node.arities_[i].push_back(p.it);
+                    }
+                    node.variadics_.push_back(p.it);
+                }
+            }
+
+            auto arg_it = patterns.find("__arg");
+            if (arg_it != patterns.end())
+            {
+                argument_pattern_ = &arg_it->second.pattern_ast_;
+            }
+        }
+        compile_statistics::add(compile_statistics::index, elapsed);
+    }
+
+    pattern_index::candidate_list const*
+    pattern_index::function_call_candidates(
+        std::string const& name, std::size_t arity) const
+    {
+        auto it = function_calls_.find(name);
+        if (it == function_calls_.end())
+        {
+            return nullptr;
+        }
+
+        function_call_node const& node = it->second;
+        if (arity < node.arities_.size())
+        {
+            return &node.arities_[arity];
+        }
+        return &node.variadics_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<pattern_index const> expression_pattern_list::index() const
+    {
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+            if (index_ && index_->size() == size())
+            {
+                return index_;
+            }
+        }
+
+        // the index is built without holding the lock, concurrent callers
+        // may build it more than once
+        auto index = std::make_shared<pattern_index const>(*this);
+
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        index_ = index;
+        return index;
+    }
+}}}
@@ -7,6 +7,7 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compile_cache.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compiler_component.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
@@ -131,7 +132,7 @@ namespace phylanx { namespace execution_tree
     {
         using action_type = typename compiler_component::compile_action;
         return hpx::async(action_type(), this->base_type::get_id(), name,
-            ast::generate_ast(expr));
+            generate_ast_cached(expr));
     }
 
     compiler::entry_point physl_compiler::compile(hpx::launch::sync_policy,
@@ -145,7 +146,7 @@ namespace phylanx { namespace execution_tree
     {
         using action_type = typename compiler_component::compile_action;
         return hpx::async(action_type(), this->base_type::get_id(), "<unknown>",
-            ast::generate_ast(expr));
+            generate_ast_cached(expr));
     }
 
     compiler::entry_point physl_compiler::compile(hpx::launch::sync_policy,
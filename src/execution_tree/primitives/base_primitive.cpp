@@ -762,6 +762,54 @@ namespace phylanx { namespace execution_tree
                 name, codename));
     }
 
+    namespace detail
+    {
+        // move the storage of all arrays held by the given value into shared
+        // storage
+        void share_value(primitive_argument_type& val)
+        {
+            switch (val.index())
+            {
+            case primitive_argument_type::bool_index:
+                util::get<1>(val).share();
+                break;
+
+            case primitive_argument_type::int64_index:
+                util::get<2>(val).share();
+                break;
+
+            case primitive_argument_type::float64_index:
+                util::get<4>(val).share();
+                break;
+
+            case primitive_argument_type::list_index:
+                {
+                    auto& r = util::get<7>(val);
+                    if (r.is_args())
+                    {
+                        for (auto& arg : r.args())
+                        {
+                            share_value(arg);
+                        }
+                    }
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    primitive_argument_type extract_shared_value(primitive_argument_type&& val,
+        std::string const& name, std::string const& codename)
+    {
+        primitive_argument_type result =
+            extract_copy_value(std::move(val), name, codename);
+        detail::share_value(result);
+        return result;
+    }
+
     primitive_argument_type&& extract_ref_value(primitive_argument_type&& val,
         std::string const& name, std::string const& codename)
     {
@@ -840,6 +888,91 @@ namespace phylanx { namespace execution_tree
                 name, codename));
     }
 
+    std::size_t allocated_bytes(primitive_argument_type const& val)
+    {
+        switch (val.index())
+        {
+        case primitive_argument_type::bool_index:
+            return util::get<1>(val).allocated_bytes();
+
+        case primitive_argument_type::int64_index:
+            return util::get<2>(val).allocated_bytes();
+
+        case primitive_argument_type::float64_index:
+            return util::get<4>(val).allocated_bytes();
+
+        case primitive_argument_type::list_index:
+            {
+                auto const& list = util::get<7>(val);
+                if (!list.is_args())
+                {
+                    break;
+                }
+
+                std::size_t bytes = 0;
+                for (auto const& elem : list.args())
+                {
+                    bytes += allocated_bytes(elem);
+                }
+                return bytes;
+            }
+
+        default:
+            break;
+        }
+        return 0;
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        void const* owned_array_data(ir::node_data<T> const& data)
+        {
+            if (data.is_ref())
+            {
+                return nullptr;
+            }
+
+            switch (data.num_dimensions())
+            {
+            case 1:
+                return data.vector().data();
+
+            case 2:
+                return data.matrix().data();
+
+            case 3:
+                return data.tensor().data();
+
+            case 4:
+                return data.quatern().data();
+
+            default:
+                break;
+            }
+            return nullptr;
+        }
+    }
+
+    void const* owned_array_data(primitive_argument_type const& val)
+    {
+        switch (val.index())
+        {
+        case primitive_argument_type::bool_index:
+            return detail::owned_array_data(util::get<1>(val));
+
+        case primitive_argument_type::int64_index:
+            return detail::owned_array_data(util::get<2>(val));
+
+        case primitive_argument_type::float64_index:
+            return detail::owned_array_data(util::get<4>(val));
+
+        default:
+            break;
+        }
+        return nullptr;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type extract_literal_value(
         primitive_argument_type const& val,
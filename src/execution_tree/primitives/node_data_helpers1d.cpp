@@ -9,6 +9,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/storage_pool.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
 
@@ -36,7 +37,7 @@ namespace phylanx { namespace execution_tree
         {
         case 0:
             {
-                result.resize(size);
+                result = util::storage_pool<T>::vector(size);
                 result = rhs.scalar();
                 return;
             }
@@ -47,7 +48,7 @@ namespace phylanx { namespace execution_tree
                 // vectors of size one can be broadcast into any other vector
                 if (rhs.size() == 1)
                 {
-                    result.resize(size);
+                    result = util::storage_pool<T>::vector(size);
                     result = rhs[0];
                     return;
                 }
@@ -79,7 +80,7 @@ namespace phylanx { namespace execution_tree
                 // matrices of size one can be broadcast into any vector
                 if (rhs.size() == 1)
                 {
-                    result.resize(size);
+                    result = util::storage_pool<T>::vector(size);
                     result = rhs[0];
                     return;
                 }
@@ -88,7 +89,7 @@ namespace phylanx { namespace execution_tree
                 // with the same number of elements
                 if (rhs.dimension(0) == 1 && size == rhs.dimension(1))
                 {
-                    result.resize(size);
+                    result = util::storage_pool<T>::vector(size);
 
                     auto m = rhs.matrix();
                     result = blaze::trans(blaze::row(m, 0));
@@ -99,7 +100,7 @@ namespace phylanx { namespace execution_tree
                 // with the same number of elements
                 if (rhs.dimension(1) == 1 && size == rhs.dimension(0))
                 {
-                    result.resize(size);
+                    result = util::storage_pool<T>::vector(size);
 
                     auto m = rhs.matrix();
                     result = blaze::column(m, 0);
@@ -119,7 +120,7 @@ namespace phylanx { namespace execution_tree
                 // tensors of size one can be broadcast into any vector
                 if (rhs.size() == 1)
                 {
-                    result.resize(size);
+                    result = util::storage_pool<T>::vector(size);
 
                     result = rhs.at(0, 0, 0);
                     return;
@@ -9,6 +9,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/storage_pool.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
 
@@ -36,7 +37,7 @@ namespace phylanx { namespace execution_tree
         {
         case 0:
             {
-                result.resize(rows, columns);
+                result = util::storage_pool<T>::matrix(rows, columns);
                 result = rhs.scalar();
             }
             return;
@@ -46,7 +47,7 @@ namespace phylanx { namespace execution_tree
                 // vectors of size one can be broadcast into any matrix
                 if (rhs.size() == 1)
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
                     result = rhs[0];
                     return;
                 }
@@ -61,7 +62,7 @@ namespace phylanx { namespace execution_tree
                             name, codename));
                 }
 
-                result.resize(rows, columns);
+                result = util::storage_pool<T>::matrix(rows, columns);
 
                 for (std::size_t i = 0; i != rows; ++i)
                 {
@@ -75,7 +76,7 @@ namespace phylanx { namespace execution_tree
                 // matrices of size one can be broadcast into any other matrix
                 if (rhs.size() == 1)
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     result = rhs[0];
                     return;
@@ -85,7 +86,7 @@ namespace phylanx { namespace execution_tree
                 // matrix with the same number of rows
                 if (rhs.dimension(0) == 1 && columns == rhs.dimension(1))
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     auto m = rhs.matrix();
                     auto row = blaze::row(m, 0);
@@ -100,7 +101,7 @@ namespace phylanx { namespace execution_tree
                 // matrix with the same number of columns
                 if (rhs.dimension(1) == 1 && rows == rhs.dimension(0))
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     auto m = rhs.matrix();
                     auto column = blaze::column(m, 0);
@@ -137,7 +138,7 @@ namespace phylanx { namespace execution_tree
                 // tensors of size one can be broadcast into any other matrix
                 if (rhs.size() == 1)
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     result = rhs.at(0, 0, 0);
                     return;
@@ -148,7 +149,7 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == rows &&
                     rhs.dimension(2) == 1)
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     auto t = rhs.tensor();
                     auto column = blaze::column(blaze::pageslice(t, 0), 0);
@@ -164,7 +165,7 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == 1 &&
                     rhs.dimension(2) == columns)
                 {
-                    result.resize(rows, columns);
+                    result = util::storage_pool<T>::matrix(rows, columns);
 
                     auto t = rhs.tensor();
                     auto row = blaze::row(blaze::pageslice(t, 0), 0);
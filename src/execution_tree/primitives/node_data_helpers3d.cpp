@@ -10,6 +10,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/storage_pool.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
 
@@ -38,7 +39,7 @@ namespace phylanx { namespace execution_tree
         {
         case 0:
             {
-                result.resize(pages, rows, columns);
+                result = util::storage_pool<T>::tensor(pages, rows, columns);
                 result = rhs.scalar();
             }
             return;
@@ -48,7 +49,8 @@ namespace phylanx { namespace execution_tree
                 // vectors of size one can be broadcast into any tensor
                 if (rhs.size() == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
                     result = rhs[0];
                     return;
                 }
@@ -63,7 +65,7 @@ namespace phylanx { namespace execution_tree
                             name, codename));
                 }
 
-                result.resize(pages, rows, columns);
+                result = util::storage_pool<T>::tensor(pages, rows, columns);
 
                 auto v = rhs.vector();
                 auto row = blaze::trans(v);
@@ -83,7 +85,8 @@ namespace phylanx { namespace execution_tree
                 // matrices of size one can be broadcast into any other tensor
                 if (rhs.size() == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
                     result = rhs[0];
                     return;
                 }
@@ -92,7 +95,8 @@ namespace phylanx { namespace execution_tree
                 // matrix with the same number of columns
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == columns)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto m = rhs.matrix();
                     auto row = blaze::row(m, 0);
@@ -111,7 +115,8 @@ namespace phylanx { namespace execution_tree
                 // matrix with the same number of rows
                 if (rhs.dimension(0) == rows && rhs.dimension(1) == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto m = rhs.matrix();
                     auto column = blaze::column(m, 0);
@@ -136,7 +141,7 @@ namespace phylanx { namespace execution_tree
                             name, codename));
                 }
 
-                result.resize(pages, rows, columns);
+                result = util::storage_pool<T>::tensor(pages, rows, columns);
                 for (std::size_t k = 0; k != pages; ++k)
                 {
                     blaze::pageslice(result, k) = rhs.matrix();
@@ -149,7 +154,8 @@ namespace phylanx { namespace execution_tree
                 // tensors of size one can be broadcast into any other tensor
                 if (rhs.size() == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     result = rhs.at(0, 0, 0);
                     return;
@@ -160,7 +166,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == 1 &&
                     rhs.dimension(2) == columns)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto t = rhs.tensor();
                     auto row = blaze::row(blaze::pageslice(t, 0), 0);
@@ -180,7 +187,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == rows &&
                     rhs.dimension(2) == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto t = rhs.tensor();
                     auto column = blaze::column(blaze::pageslice(t, 0), 0);
@@ -200,7 +208,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == pages && rhs.dimension(1) == 1 &&
                     rhs.dimension(2) == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto t = rhs.tensor();
                     auto row = blaze::row(blaze::rowslice(t, 0), 0);
@@ -220,7 +229,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == 1 && rhs.dimension(1) == rows &&
                     rhs.dimension(2) == columns)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto t = rhs.tensor();
                     auto rhs_page = blaze::pageslice(t, 0);
@@ -236,7 +246,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == pages && rhs.dimension(1) == 1 &&
                     rhs.dimension(2) == columns)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
 
                     auto t = rhs.tensor();
                     auto rhs_rowslice = blaze::rowslice(t, 0);
@@ -252,7 +263,8 @@ namespace phylanx { namespace execution_tree
                 if (rhs.dimension(0) == pages && rhs.dimension(1) == rows &&
                     rhs.dimension(2) == 1)
                 {
-                    result.resize(pages, rows, columns);
+                    result = util::storage_pool<T>::tensor(
+                        pages, rows, columns);
                     auto t = rhs.tensor();
 
                     auto rhs_columnslice = blaze::columnslice(t, 0);
@@ -183,6 +183,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return primitive_->get_direct_execution(reset);
     }
 
+    std::int64_t primitive_component::get_direct_eval_count(bool reset) const
+    {
+        return primitive_->get_direct_eval_count(reset);
+    }
+
+    std::int64_t primitive_component::get_async_eval_count(bool reset) const
+    {
+        return primitive_->get_async_eval_count(reset);
+    }
+
+    std::int64_t primitive_component::get_predicted_eval_duration(
+        bool reset) const
+    {
+        return primitive_->get_predicted_eval_duration(reset);
+    }
+
+    std::int64_t primitive_component::get_result_bytes(bool reset) const
+    {
+        return primitive_->get_result_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_live_bytes(bool reset) const
+    {
+        return primitive_->get_live_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_donated_results(bool reset) const
+    {
+        return primitive_->get_donated_results(reset);
+    }
+
+    std::int64_t primitive_component::get_fresh_results(bool reset) const
+    {
+        return primitive_->get_fresh_results(reset);
+    }
+
     void primitive_component::enable_measurements()
     {
         primitive_->enable_measurements();
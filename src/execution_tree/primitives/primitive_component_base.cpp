@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/util/eval_cost_model.hpp>
 #include <phylanx/util/scoped_timer.hpp>
 
 #include <hpx/async_base/launch_policy.hpp>
@@ -15,7 +16,9 @@
 #include <hpx/include/util.hpp>
 #include <hpx/modules/naming.hpp>
 #include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -98,69 +101,199 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::forward<T>(t));
     }
 
-    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
-        primitive_arguments_type const& params,
-        eval_context ctx) const
+    namespace detail
     {
-#if defined(HPX_HAVE_APEX)
-        hpx::util::annotate_function annotate(eval_name_.c_str());
-#endif
+        // number of elements an evaluation works on
+        std::size_t eval_work_size(primitive_argument_type const& arg)
+        {
+            switch (arg.index())
+            {
+            case primitive_argument_type::bool_index:
+                return util::get<1>(arg).size();
 
-        // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
+            case primitive_argument_type::int64_index:
+                return util::get<2>(arg).size();
 
-        util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
-        if (enable_timer)
-        {
-            ++eval_count_;
-        }
+            case primitive_argument_type::float64_index:
+                return util::get<4>(arg).size();
 
-        auto f = this->eval(params, std::move(ctx));
+            case primitive_argument_type::list_index:
+                return static_cast<std::size_t>(util::get<7>(arg).size());
 
-        if (enable_timer && !f.is_ready())
+            default:
+                break;
+            }
+            return 1;
+        }
+
+        std::size_t eval_work_size(primitive_arguments_type const& args)
         {
-            using shared_state_ptr =
-                typename hpx::traits::detail::shared_state_ptr_for<
-                    decltype(f)>::type;
-            shared_state_ptr const& state =
-                hpx::traits::future_access<decltype(f)>::get_shared_state(f);
+            std::size_t size = 0;
+            for (auto const& arg : args)
+            {
+                size += eval_work_size(arg);
+            }
+            return size;
+        }
 
-            state->set_on_completed(keep_alive(std::move(timer)));
+        // Number of elements the next evaluation is expected to work on. The
+        // operands that are not primitives are known up front, the values
+        // the others evaluate to are estimated from the latest evaluation.
+        std::size_t expected_work_size(util::eval_cost_model const& cost_model,
+            primitive_arguments_type const& operands)
+        {
+            return (std::max)(
+                eval_work_size(operands), cost_model.work_size());
         }
 
-        return f;
+        // Predict the duration of the next evaluation
+        std::int64_t predicted_eval_duration(
+            util::eval_cost_model const& cost_model,
+            primitive_arguments_type const& operands)
+        {
+            return cost_model.predicted_duration(
+                expected_work_size(cost_model, operands));
+        }
     }
 
-    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
-        primitive_argument_type&& param, eval_context ctx) const
+    template <typename F>
+    hpx::future<primitive_argument_type> primitive_component_base::measure_eval(
+        std::size_t arg_size, F&& eval_f) const
     {
-#if defined(HPX_HAVE_APEX)
-        hpx::util::annotate_function annotate(eval_name_.c_str());
-#endif
+        if (!util::eval_cost_model::enabled())
+        {
+            // perform measurements only when needed
+            bool enable_timer =
+                measurements_enabled_ || (execute_directly_ == -1);
+
+            util::scoped_timer<std::int64_t> timer(
+                eval_duration_, enable_timer);
+            if (enable_timer)
+            {
+                ++eval_count_;
+            }
 
-        // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
+            auto f = eval_f();
 
-        util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
-        if (enable_timer)
+            if (enable_timer && !f.is_ready())
+            {
+                using shared_state_ptr =
+                    typename hpx::traits::detail::shared_state_ptr_for<
+                        decltype(f)>::type;
+                shared_state_ptr const& state =
+                    hpx::traits::future_access<decltype(f)>::get_shared_state(
+                        f);
+
+                state->set_on_completed(keep_alive(std::move(timer)));
+            }
+
+            return f;
+        }
+
+        // the cost model decides which evaluations have to be measured
+        std::size_t const work_size = (std::max)(
+            arg_size, detail::expected_work_size(cost_model_, operands_));
+        bool const sample =
+            cost_model_.sample_eval(work_size) || measurements_enabled_;
+        if (sample)
         {
             ++eval_count_;
         }
 
-        auto f = this->eval(std::move(param), std::move(ctx));
+        std::uint64_t const started_at =
+            sample ? hpx::chrono::high_resolution_clock::now() : 0;
+
+        auto f = eval_f();
+
+        using shared_state_ptr =
+            typename hpx::traits::detail::shared_state_ptr_for<
+                decltype(f)>::type;
+        shared_state_ptr const& state =
+            hpx::traits::future_access<decltype(f)>::get_shared_state(f);
+
+        // The size of the result of every evaluation is recorded, it
+        // determines the amount of work of the next one. The callback is
+        // owned by the shared state, thus it can safely refer to it.
+        auto* result_state = state.get();
+        auto on_completed = [this, result_state, sample, work_size,
+                                started_at]() {
+            std::int64_t const duration = sample ?
+                static_cast<std::int64_t>(
+                    hpx::chrono::high_resolution_clock::now() - started_at) :
+                0;
+
+            hpx::error_code ec(hpx::lightweight);
+            primitive_argument_type const* result =
+                result_state->get_result(ec);
+            std::size_t const result_size =
+                !ec && result != nullptr ? detail::eval_work_size(*result) : 0;
+
+            if (!sample)
+            {
+                cost_model_.set_result_size(result_size);
+                return;
+            }
 
-        if (enable_timer && !f.is_ready())
+            eval_duration_ += duration;
+            cost_model_.add_sample(work_size, result_size, duration);
+        };
+
+        if (f.is_ready())
+        {
+            on_completed();
+        }
+        else
         {
-            using shared_state_ptr =
-                typename hpx::traits::detail::shared_state_ptr_for<
-                    decltype(f)>::type;
-            shared_state_ptr const& state =
-                hpx::traits::future_access<decltype(f)>::get_shared_state(f);
+            state->set_on_completed(std::move(on_completed));
+        }
+        return f;
+    }
 
-            state->set_on_completed(keep_alive(std::move(timer)));
+    hpx::future<primitive_argument_type>
+    primitive_component_base::account_result_bytes(
+        hpx::future<primitive_argument_type>&& f) const
+    {
+        if (!measurements_enabled_)
+        {
+            return std::move(f);
         }
 
-        return f;
+        return f.then(hpx::launch::sync,
+            [this](hpx::future<primitive_argument_type>&& f)
+            ->  primitive_argument_type
+            {
+                primitive_argument_type result = f.get();
+                result_bytes_ +=
+                    static_cast<std::int64_t>(allocated_bytes(result));
+                return result;
+            });
+    }
+
+    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
+        primitive_arguments_type const& params,
+        eval_context ctx) const
+    {
+#if defined(HPX_HAVE_APEX)
+        hpx::util::annotate_function annotate(eval_name_.c_str());
+#endif
+
+        return account_result_bytes(
+            measure_eval(detail::eval_work_size(params), [&]() {
+                return this->eval(params, std::move(ctx));
+            }));
+    }
+
+    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
+        primitive_argument_type&& param, eval_context ctx) const
+    {
+#if defined(HPX_HAVE_APEX)
+        hpx::util::annotate_function annotate(eval_name_.c_str());
+#endif
+
+        return account_result_bytes(
+            measure_eval(detail::eval_work_size(param), [&]() {
+                return this->eval(std::move(param), std::move(ctx));
+            }));
     }
 
     // eval_action
@@ -303,6 +436,70 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::util::get_and_reset_value(execute_directly_, reset);
     }
 
+    std::int64_t primitive_component_base::get_direct_eval_count(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(direct_eval_count_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_async_eval_count(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(async_eval_count_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_predicted_eval_duration(
+        bool) const
+    {
+        return detail::predicted_eval_duration(cost_model_, operands_);
+    }
+
+    std::int64_t primitive_component_base::get_result_bytes(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(result_bytes_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_donated_results(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(donated_results_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_fresh_results(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(fresh_results_, reset);
+    }
+
+    void primitive_component_base::count_result_storage(bool donated) const
+    {
+        if (donated)
+        {
+            ++donated_results_;
+        }
+        else
+        {
+            ++fresh_results_;
+        }
+    }
+
+    void primitive_component_base::count_result_storage(
+        primitive_argument_type const& result,
+        std::vector<void const*> const& operands) const
+    {
+        void const* data = owned_array_data(result);
+        if (data != nullptr)
+        {
+            count_result_storage(
+                std::find(operands.begin(), operands.end(), data) !=
+                operands.end());
+        }
+    }
+
+    std::int64_t primitive_component_base::get_live_bytes(bool) const
+    {
+        return 0;
+    }
+
     void primitive_component_base::enable_measurements()
     {
         measurements_enabled_ = true;
@@ -540,16 +737,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
         // always run this on an HPX thread
         if (hpx::threads::get_self_ptr() == nullptr)
         {
-            return hpx::launch::async;
+            return count_eval_execution(hpx::launch::async);
         }
 
         // always execute synchronously, if requested
         if (get_sync_execution())
         {
-            return hpx::launch::sync;
+            return count_eval_execution(hpx::launch::sync);
         }
 
-        if ((eval_count_ != 0 && measurements_enabled_) ||
+        if (util::eval_cost_model::enabled())
+        {
+            // Use the predicted duration of the next evaluation, keep the
+            // previous decision while the prediction is in between the
+            // thresholds (hysteresis).
+            std::int64_t exec_time =
+                detail::predicted_eval_duration(cost_model_, operands_);
+            if (exec_time > get_exec_upper_threshold())
+            {
+                execute_directly_ = 0;
+            }
+            else if (exec_time >= 0 && exec_time < get_exec_lower_threshold())
+            {
+                execute_directly_ = 1;
+            }
+        }
+        else if ((eval_count_ != 0 && measurements_enabled_) ||
             (eval_count_ > get_ec_threshold()))
         {
             // check whether execution status needs to be changed (with some
@@ -571,13 +784,27 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         if (execute_directly_ == 1)
         {
-            return hpx::launch::sync;
+            return count_eval_execution(hpx::launch::sync);
         }
         else if (execute_directly_ == 0)
         {
-            return hpx::launch::async;
+            return count_eval_execution(hpx::launch::async);
         }
 
+        return count_eval_execution(policy);
+    }
+
+    hpx::launch primitive_component_base::count_eval_execution(
+        hpx::launch policy) const
+    {
+        if (policy == hpx::launch::sync)
+        {
+            ++direct_eval_count_;
+        }
+        else
+        {
+            ++async_eval_count_;
+        }
         return policy;
     }
 }}}
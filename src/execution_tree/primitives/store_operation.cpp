@@ -64,6 +64,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {}
 
     ///////////////////////////////////////////////////////////////////////////
+    void store_operation::store_value(primitive&& target,
+        primitive_argument_type&& value, primitive_arguments_type&& args,
+        eval_context ctx) const
+    {
+        live_bytes_ = static_cast<std::int64_t>(allocated_bytes(value));
+        target.store(hpx::launch::sync, std::move(value), std::move(args),
+            std::move(ctx));
+    }
+
+    std::int64_t store_operation::get_live_bytes(bool) const
+    {
+        return live_bytes_;
+    }
+
     hpx::future<primitive_argument_type> store_operation::eval(
         primitive_arguments_type const& args, eval_context ctx) const
     {
@@ -119,11 +133,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             (hpx::future<primitive_argument_type>&& val) mutable
             ->  primitive_argument_type
             {
-                auto p = primitive_operand(
-                    std::move(lhs), this_->name_, this_->codename_);
-
-                p.store(hpx::launch::sync, val.get(), std::move(args),
-                    std::move(ctx));
+                this_->store_value(
+                    primitive_operand(
+                        std::move(lhs), this_->name_, this_->codename_),
+                    val.get(), std::move(args), std::move(ctx));
                 return primitive_argument_type{};
             });
     }
@@ -176,11 +189,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 ](hpx::future<primitive_argument_type>&& val) mutable
                 -> primitive_argument_type
                 {
-                    auto p = primitive_operand(
-                        std::move(lhs), this_->name_, this_->codename_);
-
-                    p.store(hpx::launch::sync, val.get(), std::move(args),
-                        std::move(ctx));
+                    this_->store_value(
+                        primitive_operand(
+                            std::move(lhs), this_->name_, this_->codename_),
+                        val.get(), std::move(args), std::move(ctx));
                     return primitive_argument_type{};
                 });
     }
@@ -14,6 +14,7 @@
 #include <hpx/errors/throw_exception.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -83,11 +84,27 @@ namespace phylanx { namespace execution_tree { namespace primitives
             // the first argument is the expression the variable should be
             // bound to
             operands_[0] =
-                extract_copy_value(std::move(operands_[0]), name_, codename_);
+                extract_shared_value(std::move(operands_[0]), name_, codename_);
             value_set_ = true;
+            update_live_bytes();
         }
     }
 
+    void variable::update_live_bytes() const
+    {
+        std::size_t bytes = allocated_bytes(bound_value_);
+        if (!operands_.empty())
+        {
+            bytes += allocated_bytes(operands_[0]);
+        }
+        live_bytes_ = static_cast<std::int64_t>(bytes);
+    }
+
+    std::int64_t variable::get_live_bytes(bool) const
+    {
+        return live_bytes_;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     hpx::future<primitive_argument_type> variable::eval(
         primitive_arguments_type const& args, eval_context ctx) const
@@ -268,7 +285,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive const* p = util::get_if<primitive>(&operands_[0]);
         if (p != nullptr)
         {
-            bound_value_ = extract_copy_value(
+            bound_value_ = extract_shared_value(
                 p->eval(hpx::launch::sync, args, std::move(ctx)),
                 name_, codename_);
         }
@@ -277,6 +294,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             bound_value_ = extract_ref_value(operands_[0], name_, codename_);
         }
 
+        update_live_bytes();
         return true;
     }
 
@@ -296,7 +314,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             value_operand_sync(std::move(data[1]), std::move(params), name_,
                 codename_, ctx),
             std::move(data[0]), name_, codename_, ctx);
-        bound_value_ = std::move(result);
+        bound_value_ =
+            extract_shared_value(std::move(result), name_, codename_);
+        update_live_bytes();
     }
 
     void variable::store2dslice(primitive_arguments_type&& data,
@@ -317,7 +337,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             value_operand_sync(
                 data[2], std::move(params), name_, codename_, ctx),
             std::move(data[0]), name_, codename_, ctx);
-        bound_value_ = std::move(result);
+        bound_value_ =
+            extract_shared_value(std::move(result), name_, codename_);
+        update_live_bytes();
     }
 
     void variable::store3dslice(primitive_arguments_type&& data,
@@ -339,7 +361,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 value_operand_sync(
                     data[3], std::move(params), name_, codename_, ctx),
                 std::move(data[0]), name_, codename_, ctx);
-        bound_value_ = std::move(result);
+        bound_value_ =
+            extract_shared_value(std::move(result), name_, codename_);
+        update_live_bytes();
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -369,8 +393,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             }
 
             operands_[0] =
-                extract_copy_value(std::move(data[0]), name_, codename_);
+                extract_shared_value(std::move(data[0]), name_, codename_);
             value_set_ = true;
+            update_live_bytes();
         }
         else
         {
@@ -378,7 +403,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
             case 1:
                 bound_value_ =
-                    extract_copy_value(std::move(data[0]), name_, codename_);
+                    extract_shared_value(std::move(data[0]), name_, codename_);
+                update_live_bytes();
                 return;
 
             case 2:
@@ -430,14 +456,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             // extract the initial value for this variable
             operands_[0] =
-                extract_copy_value(std::move(data), name_, codename_);
+                extract_shared_value(std::move(data), name_, codename_);
             value_set_ = true;
         }
         else
         {
             bound_value_ =
-                extract_copy_value(std::move(data), name_, codename_);
+                extract_shared_value(std::move(data), name_, codename_);
         }
+        update_live_bytes();
     }
 
     ///////////////////////////////////////////////////////////////////////////
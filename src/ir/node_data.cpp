@@ -7,6 +7,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/storage_pool.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 #include <phylanx/util/serialization/variant.hpp>
 
@@ -23,6 +24,7 @@
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -98,6 +100,30 @@ namespace phylanx { namespace ir
         return hpx::util::get_and_reset_value(count_move_assignments_, reset);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    std::size_t node_data<T>::storage_bytes(storage_type const& data)
+    {
+        switch (data.index())
+        {
+        case storage1d:
+            return util::get<storage1d>(data).capacity() * sizeof(T);
+
+        case storage2d:
+            return util::get<storage2d>(data).capacity() * sizeof(T);
+
+        case storage3d:
+            return util::get<storage3d>(data).capacity() * sizeof(T);
+
+        case storage4d:
+            return util::get<storage4d>(data).capacity() * sizeof(T);
+
+        default:
+            break;
+        }
+        return 0;    // scalars and references don't own any (heap) memory
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Create node data for a 0-dimensional value
     template <typename T>
@@ -152,20 +178,21 @@ namespace phylanx { namespace ir
         }
         else if (dims[2] != 0)
         {
-            data_ = storage3d_type(dims[0], dims[1], dims[2]);
+            data_ = util::storage_pool<T>::tensor(dims[0], dims[1], dims[2]);
         }
         else if (dims[1] != 0)
         {
-            data_ = storage2d_type(dims[0], dims[1]);
+            data_ = util::storage_pool<T>::matrix(dims[0], dims[1]);
         }
         else if (dims[0] != 0)
         {
-            data_ = storage1d_type(dims[0]);
+            data_ = util::storage_pool<T>::vector(dims[0]);
         }
         else
         {
             data_ = storage0d_type();
         }
+        tracked_.update(storage_bytes(data_));
     }
 
     template <typename T>
@@ -178,26 +205,34 @@ namespace phylanx { namespace ir
         }
         else if (dims[2] != 0)
         {
-            data_ = storage3d_type(dims[0], dims[1], dims[2], default_value);
+            storage3d_type t =
+                util::storage_pool<T>::tensor(dims[0], dims[1], dims[2]);
+            t = default_value;
+            data_ = std::move(t);
         }
         else if (dims[1] != 0)
         {
-            data_ = storage2d_type(dims[0], dims[1], default_value);
+            storage2d_type m = util::storage_pool<T>::matrix(dims[0], dims[1]);
+            m = default_value;
+            data_ = std::move(m);
         }
         else if (dims[0] != 0)
         {
-            data_ = storage1d_type(dims[1], default_value);
+            storage1d_type v = util::storage_pool<T>::vector(dims[0]);
+            v = default_value;
+            data_ = std::move(v);
         }
         else
         {
             data_ = default_value;
         }
+        tracked_.update(storage_bytes(data_));
     }
 
     template <typename T>
     node_data<T>::node_data(custom_storage1d_type const& values)
       : data_(custom_storage1d_type{
-            const_cast<T*>(values.data()), values.size(), values.spacing()})
+            const_cast<T*>(values.data()), values.size()})
     {
         increment_move_construction_count();
     }
@@ -412,7 +447,7 @@ namespace phylanx { namespace ir
             {
                 increment_move_construction_count();
                 auto v = d.vector();
-                return custom_storage1d_type{v.data(), v.size(), v.spacing()};
+                return custom_storage1d_type{v.data(), v.size()};
             }
             break;
 
@@ -464,18 +499,59 @@ namespace phylanx { namespace ir
         }
     }
 
+    template <typename T>
+    node_data<T>::node_data(std::shared_ptr<node_data> shared)
+      : data_(shared->ref().data_)
+      , shared_(std::move(shared))
+    {
+    }
+
     /// Create node data from a node data
     template <typename T>
     node_data<T>::node_data(node_data const& d)
       : data_(init_data_from(d))
+      , shared_(d.shared_)
     {
     }
 
     template <typename T>
     node_data<T>::node_data(node_data&& d)
       : data_(std::move(d.data_))
+      , shared_(std::move(d.shared_))
     {
         increment_move_construction_count();
+        d.tracked_.update(storage_bytes(d.data_));
+
+        // a moved instance that is the last one referring to shared storage
+        // can safely be modified, take over the storage
+        reclaim_shared();
+    }
+
+    template <typename T>
+    node_data<T>::~node_data()
+    {
+        // hand the storage over to the pool, it will most likely be needed
+        // again soon (if pooling is enabled)
+        switch (data_.index())
+        {
+        case storage1d:
+            util::storage_pool<T>::release(
+                std::move(util::get<storage1d>(data_)));
+            break;
+
+        case storage2d:
+            util::storage_pool<T>::release(
+                std::move(util::get<storage2d>(data_)));
+            break;
+
+        case storage3d:
+            util::storage_pool<T>::release(
+                std::move(util::get<storage3d>(data_)));
+            break;
+
+        default:
+            break;
+        }
     }
 
     template <typename T>
@@ -483,6 +559,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -491,6 +569,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -499,6 +579,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -507,6 +589,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -515,6 +599,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -522,8 +608,9 @@ namespace phylanx { namespace ir
     node_data<T>& node_data<T>::operator=(custom_storage1d_type const& val)
     {
         increment_move_assignment_count();
-        data_ = custom_storage1d_type{
-            const_cast<T*>(val.data()), val.size(), val.spacing()};
+        data_ = custom_storage1d_type{const_cast<T*>(val.data()), val.size()};
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -532,6 +619,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -540,6 +629,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -548,6 +639,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -557,6 +650,8 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage2d_type{const_cast<T*>(val.data()), val.rows(),
             val.columns(), val.spacing()};
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -565,6 +660,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -573,6 +670,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -581,6 +680,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -590,6 +691,8 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage3d_type{const_cast<T*>(val.data()), val.pages(),
             val.rows(), val.columns(), val.spacing()};
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -598,6 +701,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -607,6 +712,8 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -615,6 +722,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -624,6 +733,8 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage4d_type{const_cast<T*>(val.data()), val.quats(),
             val.pages(), val.rows(), val.columns(), val.spacing()};
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -632,6 +743,8 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -645,6 +758,8 @@ namespace phylanx { namespace ir
         {
             util::get<storage1d>(data_)[i] = values[i];
         }
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -663,6 +778,8 @@ namespace phylanx { namespace ir
                 util::get<storage2d>(data_)(i, j) = row[j];
             }
         }
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -688,6 +805,8 @@ namespace phylanx { namespace ir
                 }
             }
         }
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -718,6 +837,8 @@ namespace phylanx { namespace ir
                 }
             }
         }
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -748,8 +869,7 @@ namespace phylanx { namespace ir
             {
                 increment_move_assignment_count();
                 auto v = d.vector();
-                return custom_storage1d_type{
-                    v.data(), v.size(), v.spacing()};
+                return custom_storage1d_type{v.data(), v.size()};
             }
             break;
 
@@ -807,7 +927,9 @@ namespace phylanx { namespace ir
         if (this != &d)
         {
             data_ = copy_data_from(d);
+            shared_ = d.shared_;
         }
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -818,7 +940,11 @@ namespace phylanx { namespace ir
         {
             increment_move_assignment_count();
             data_ = std::move(d.data_);
+            shared_ = std::move(d.shared_);
+            d.tracked_.update(storage_bytes(d.data_));
+            reclaim_shared();
         }
+        tracked_.update(storage_bytes(data_));
         return *this;
     }
 
@@ -1119,6 +1245,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::storage4d_type& node_data<T>::quatern_non_ref()
     {
+        sync_tracked();
+
         storage4d_type* t = util::get_if<storage4d_type>(&data_);
         if (t == nullptr)
         {
@@ -1232,6 +1360,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::custom_storage4d_type node_data<T>::quatern() &
     {
+        sync_tracked();
+
         custom_storage4d_type* ct =
             util::get_if<custom_storage4d_type>(&data_);
         if (ct != nullptr)
@@ -1309,6 +1439,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::storage3d_type& node_data<T>::tensor_non_ref()
     {
+        sync_tracked();
+
         storage3d_type* t = util::get_if<storage3d_type>(&data_);
         if (t == nullptr)
         {
@@ -1422,6 +1554,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::custom_storage3d_type node_data<T>::tensor() &
     {
+        sync_tracked();
+
         custom_storage3d_type* ct =
             util::get_if<custom_storage3d_type>(&data_);
         if (ct != nullptr)
@@ -1498,6 +1632,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::storage2d_type& node_data<T>::matrix_non_ref()
     {
+        sync_tracked();
+
         storage2d_type* m = util::get_if<storage2d_type>(&data_);
         if (m == nullptr)
         {
@@ -1611,6 +1747,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::custom_storage2d_type node_data<T>::matrix() &
     {
+        sync_tracked();
+
         custom_storage2d_type* cm =
             util::get_if<custom_storage2d_type>(&data_);
         if (cm != nullptr)
@@ -1687,6 +1825,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::storage1d_type& node_data<T>::vector_non_ref()
     {
+        sync_tracked();
+
         storage1d_type* v = util::get_if<storage1d_type>(&data_);
         if (v == nullptr)
         {
@@ -1799,6 +1939,8 @@ namespace phylanx { namespace ir
     template <typename T>
     typename node_data<T>::custom_storage1d_type node_data<T>::vector() &
     {
+        sync_tracked();
+
         custom_storage1d_type* cv = util::get_if<custom_storage1d_type>(&data_);
         if (cv != nullptr)
         {
@@ -1808,7 +1950,7 @@ namespace phylanx { namespace ir
         storage1d_type* v = util::get_if<storage1d_type>(&data_);
         if (v != nullptr)
         {
-            return custom_storage1d_type(v->data(), v->size(), v->spacing());
+            return custom_storage1d_type(v->data(), v->size());
         }
 
         HPX_THROW_EXCEPTION(hpx::invalid_status,
@@ -1824,14 +1966,13 @@ namespace phylanx { namespace ir
         if (cv != nullptr)
         {
             return custom_storage1d_type{
-                const_cast<T*>(cv->data()), cv->size(), cv->spacing()};
+                const_cast<T*>(cv->data()), cv->size()};
         }
 
         storage1d_type const* v = util::get_if<storage1d_type>(&data_);
         if (v != nullptr)
         {
-            return custom_storage1d_type{
-                const_cast<T*>(v->data()), v->size(), v->spacing()};
+            return custom_storage1d_type{const_cast<T*>(v->data()), v->size()};
         }
 
         HPX_THROW_EXCEPTION(hpx::invalid_status,
@@ -2324,6 +2465,11 @@ namespace phylanx { namespace ir
     template <typename T>
     node_data<T> node_data<T>::copy() const
     {
+        if (shared_)
+        {
+            return *this;
+        }
+
         switch(data_.index())
         {
         case storage0d: HPX_FALLTHROUGH;
@@ -2392,6 +2538,63 @@ namespace phylanx { namespace ir
             "node_data object holds unsupported data type");
     }
 
+    template <typename T>
+    void node_data<T>::share()
+    {
+        switch (data_.index())
+        {
+        case storage1d: HPX_FALLTHROUGH;
+        case storage2d: HPX_FALLTHROUGH;
+        case storage3d: HPX_FALLTHROUGH;
+        case storage4d:
+            {
+                // move the storage into the shared instance, this doesn't
+                // copy any of the data
+                auto shared = std::make_shared<node_data>(std::move(*this));
+                data_ = std::move(shared->ref().data_);
+                shared_ = std::move(shared);
+                tracked_.update(storage_bytes(data_));
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    template <typename T>
+    void node_data<T>::unshare()
+    {
+        if (!shared_ || reclaim_shared())
+        {
+            return;
+        }
+
+        // other instances refer to the same storage, copy the data
+        node_data<T> data = shared_->copy();
+        data_ = std::move(data.data_);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
+    }
+
+    template <typename T>
+    bool node_data<T>::reclaim_shared()
+    {
+        // shared instances referring to external memory can't be taken
+        // over, the memory is owned by the shared pointer
+        if (!shared_ || shared_.use_count() != 1 || shared_->is_ref())
+        {
+            return false;
+        }
+
+        // moving the storage doesn't invalidate the data pointers, thus
+        // existing references to the shared data stay valid
+        data_ = std::move(shared_->data_);
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
+        return true;
+    }
+
     // conversion helpers for Python bindings and AST parsing
     template <typename T>
     std::vector<T> node_data<T>::as_vector() const
@@ -3100,6 +3303,9 @@ namespace phylanx { namespace ir
                 "node_data<T>::serialize",
                 "node_data object holds unsupported data type");
         }
+
+        shared_.reset();
+        tracked_.update(storage_bytes(data_));
     }
 }}
 
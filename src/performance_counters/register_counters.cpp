@@ -6,9 +6,13 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compile_statistics.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/memory_tracker.hpp>
+#include <phylanx/util/storage_pool.hpp>
+#include <phylanx/util/summa_statistics.hpp>
 
 #include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
@@ -247,6 +251,7 @@ namespace phylanx { namespace performance_counters
     public:
         direct_execution_counter()
           : first_init_(false)
+          , kind_(execution_policy)
         {}
 
         direct_execution_counter(
@@ -254,7 +259,48 @@ namespace phylanx { namespace performance_counters
           : hpx::performance_counters::base_performance_counter<
                 direct_execution_counter>(info)
           , first_init_(false)
-        {}
+          , kind_(execution_policy)
+        {
+            hpx::performance_counters::counter_path_elements paths;
+            hpx::performance_counters::get_counter_path_elements(
+                info.fullname_, paths);
+
+            if (paths.countername_.find("count/eval_direct") !=
+                std::string::npos)
+            {
+                kind_ = direct_eval_count;
+            }
+            else if (paths.countername_.find("count/eval_async") !=
+                std::string::npos)
+            {
+                kind_ = async_eval_count;
+            }
+            else if (paths.countername_.find("time/eval_predicted") !=
+                std::string::npos)
+            {
+                kind_ = predicted_eval_duration;
+            }
+            else if (paths.countername_.find("memory/result_bytes") !=
+                std::string::npos)
+            {
+                kind_ = result_bytes;
+            }
+            else if (paths.countername_.find("memory/live_bytes") !=
+                std::string::npos)
+            {
+                kind_ = live_bytes;
+            }
+            else if (paths.countername_.find("count/result_donated") !=
+                std::string::npos)
+            {
+                kind_ = donated_results;
+            }
+            else if (paths.countername_.find("count/result_fresh") !=
+                std::string::npos)
+            {
+                kind_ = fresh_results;
+            }
+        }
 
         // Produce the counter value
         hpx::performance_counters::counter_values_array
@@ -279,7 +325,7 @@ namespace phylanx { namespace performance_counters
             // Extract the values from instances_
             for (auto const& instance : instances_)
             {
-                result.push_back(instance->get_direct_execution(reset));
+                result.push_back(get_value(instance, reset));
             }
 
             value.values_ = std::move(result);
@@ -313,7 +359,7 @@ namespace phylanx { namespace performance_counters
                 // Consider the reset flag
                 if (reset)
                 {
-                    instance->get_direct_execution(true);
+                    get_value(instance, true);
                 }
                 instances_sorted[instance_info.sequence_number] = instance;
             }
@@ -332,8 +378,53 @@ namespace phylanx { namespace performance_counters
         using base_primitive_ptr = std::shared_ptr<
             phylanx::execution_tree::primitives::primitive_component>;
 
+        enum counter_kind
+        {
+            execution_policy,           // .../eval_direct
+            direct_eval_count,          // .../count/eval_direct
+            async_eval_count,           // .../count/eval_async
+            predicted_eval_duration,    // .../time/eval_predicted
+            result_bytes,               // .../memory/result_bytes
+            live_bytes,                 // .../memory/live_bytes
+            donated_results,            // .../count/result_donated
+            fresh_results               // .../count/result_fresh
+        };
+
+        std::int64_t get_value(
+            base_primitive_ptr const& instance, bool reset) const
+        {
+            switch (kind_)
+            {
+            case direct_eval_count:
+                return instance->get_direct_eval_count(reset);
+
+            case async_eval_count:
+                return instance->get_async_eval_count(reset);
+
+            case predicted_eval_duration:
+                return instance->get_predicted_eval_duration(reset);
+
+            case result_bytes:
+                return instance->get_result_bytes(reset);
+
+            case live_bytes:
+                return instance->get_live_bytes(reset);
+
+            case donated_results:
+                return instance->get_donated_results(reset);
+
+            case fresh_results:
+                return instance->get_fresh_results(reset);
+
+            default:
+                break;
+            }
+            return instance->get_direct_execution(reset);
+        }
+
         std::vector<base_primitive_ptr> instances_;
         std::atomic<bool> first_init_;
+        counter_kind kind_;
     };
 
     hpx::naming::gid_type direct_execution_counter_creator(
@@ -426,6 +517,99 @@ namespace phylanx { namespace performance_counters
             "returns the current value of the move-assignment count of "
                 "any node_data<double>");
 
+        // memory held by the storage of all node_data instances
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data/memory/live_bytes",
+            &util::memory_tracker::live_bytes,
+            "returns the number of bytes currently held by the storage of "
+                "all node_data instances", "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data/memory/high_water_mark",
+            &util::memory_tracker::high_water_mark,
+            "returns the maximum number of bytes held by the storage of "
+                "all node_data instances at any point in time", "bytes");
+
+        // recycling of node_data storage by the storage pool
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/allocator/count/hits",
+            &util::storage_pool_statistics::hits,
+            "returns the number of node_data storage requests that were "
+                "satisfied from the storage pool");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/allocator/count/misses",
+            &util::storage_pool_statistics::misses,
+            "returns the number of node_data storage requests that could "
+                "not be satisfied from the storage pool");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/allocator/hit_rate",
+            &util::storage_pool_statistics::hit_rate,
+            "returns the percentage of node_data storage requests that "
+                "were satisfied from the storage pool", "%");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/allocator/memory/cached_bytes",
+            &util::storage_pool_statistics::cached_bytes,
+            "returns the number of bytes currently held by the storage "
+                "pool", "bytes");
+
+        // communication and computation of the distributed matrix product
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/summa/bytes_moved",
+            &util::summa_statistics::bytes_moved,
+            "returns the number of bytes fetched from other localities by "
+                "summa_product_d", "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/summa/time/wait",
+            &util::summa_statistics::wait_time,
+            "returns the time summa_product_d spent waiting for remote "
+                "tiles to arrive", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/summa/time/compute",
+            &util::summa_statistics::compute_time,
+            "returns the time summa_product_d spent multiplying and "
+                "accumulating tiles", "ns");
+
+        // time spent in the phases of the PhySL compiler
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/time/parse",
+            &execution_tree::compile_statistics::parse_time,
+            "returns the time spent parsing PhySL source code", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/time/index",
+            &execution_tree::compile_statistics::index_time,
+            "returns the time spent building the index of the compiler "
+                "patterns", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/time/match",
+            &execution_tree::compile_statistics::match_time,
+            "returns the time spent matching expressions against the "
+                "compiler patterns", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/time/generate",
+            &execution_tree::compile_statistics::generate_time,
+            "returns the time spent generating execution trees (including "
+                "the pattern matching)", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/count/lookups",
+            &execution_tree::compile_statistics::lookups,
+            "returns the number of expressions looked up in the index of "
+                "the compiler patterns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/count/candidates",
+            &execution_tree::compile_statistics::candidates,
+            "returns the number of patterns expressions were matched "
+                "against");
+
         // Iterate and register a time and count performance counter per each
         // primitive
         namespace et = phylanx::execution_tree;
@@ -464,6 +648,78 @@ namespace phylanx { namespace performance_counters
                     "was executed directly",
                 &direct_execution_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
+
+            // Register the counters exposing the decisions of the eval cost
+            // model
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/eval_direct",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                    "the eval function for each " + name + " primitive "
+                    "was executed directly",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/eval_async",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                    "the eval function for each " + name + " primitive "
+                    "was scheduled on a new thread",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/time/eval_predicted",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the predicted "
+                    "execution time of the next invocation of the eval "
+                    "function for each " + name + " primitive (-1 if not "
+                    "known yet)",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "ns");
+
+            // Register the memory accounting counters
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/result_bytes",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the overall number "
+                    "of bytes owned by the results of the eval function for "
+                    "each " + name + " primitive",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/live_bytes",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of bytes "
+                    "currently held by each " + name + " primitive (values "
+                    "bound to variables or written by store)",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            // Register the counters exposing the reuse of operand storage
+            // by element-wise operations
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/result_donated",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                    "each " + name + " primitive wrote its result into the "
+                    "storage of one of its operands",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/result_fresh",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                    "each " + name + " primitive had to allocate new storage "
+                    "for its result",
+                &direct_execution_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
         }
     }
 }}
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/als.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
@@ -28,18 +29,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const als::match_data = {hpx::make_tuple("als",
         std::vector<std::string>{
-            "als(_1, _2, _3, _4, _5, _6)", "als(_1, _2, _3, _4, _5)"},
+            "als(_1, _2, _3, _4, _5, __arg(_6_enable_output, false), "
+                "__arg(_7_cg_steps, nil), __arg(_8_format, \"coo\"))"},
         &create_als, &create_primitive<als>,
-        R"(ratings, reg, num, iters, alpha, enable_output
+        R"(ratings, reg, num, iters, alpha, enable_output, cg_steps, format
         Args:
 
-            ratings (matrix): the matrix representing user feedback over
-                             different items
+            ratings (matrix or list): the matrix representing user feedback
+                             over different items, or the non-zero entries
+                             of it as list(rows, columns, values[, shape])
+                             (format 'coo') or list(offsets, columns,
+                             values[, shape]) (format 'csr')
             reg (float): the regularization parameter
             num (integer): the number of factors
             iters (integer): the number of iterations
             alpha (float): the scaling factor
             enable_output(boolean): whether output should be enabled.
+            cg_steps (integer, optional): the number of conjugate gradient
+                             steps performed for each user and item, zero
+                             solves the systems directly. Defaults to zero
+                             for dense and to three for sparse ratings.
+            format (string, optional): the format of sparse ratings, either
+                             'coo' (default) or 'csr'.
 
         Returns:
 
@@ -62,15 +73,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type&& args) const
     {
         // extract arguments
-        auto arg1 = extract_numeric_value(args[0], name_, codename_);
-        if (arg1.num_dimensions() != 2)
+        std::size_t cg_steps = 0;
+        detail::als_ratings ratings;
+        if (is_list_operand_strict(args[0]))
         {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
-                generate_error_message(
-                    "the als algorithm primitive requires for the first "
-                    "argument ('ratings') to represent a matrix"));
+            std::string format = "coo";
+            if (args.size() > 7 && valid(args[7]))
+            {
+                format = extract_string_value(args[7], name_, codename_);
+            }
+            ratings = detail::als_ratings_from_list(
+                std::move(args[0]), format, name_, codename_);
+            cg_steps = detail::als_default_cg_steps();
+        }
+        else
+        {
+            auto arg1 = extract_numeric_value(args[0], name_, codename_);
+            if (arg1.num_dimensions() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                    generate_error_message(
+                        "the als algorithm primitive requires for the first "
+                        "argument ('ratings') to represent a matrix or a "
+                        "list of sparse ratings"));
+            }
+            ratings = detail::als_ratings_from_matrix(arg1.matrix());
         }
-        auto ratings = arg1.matrix();
 
         auto arg2 = extract_numeric_value(args[1], name_, codename_);
         if (arg2.num_dimensions() != 0)
@@ -97,57 +125,48 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto alpha = arg5.scalar();
 
         bool enable_output = false;
-        if (args.size() == 6 && valid(args[5]))
+        if (args.size() > 5 && valid(args[5]))
         {
             enable_output =
-                extract_scalar_integer_value(args[5], name_, codename_) != 0;
+                extract_scalar_boolean_value(args[5], name_, codename_) != 0;
+        }
+
+        if (args.size() > 6 && valid(args[6]))
+        {
+            std::int64_t steps =
+                extract_scalar_integer_value(args[6], name_, codename_);
+            if (steps < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                    generate_error_message(
+                        "the als algorithm primitive requires for the number "
+                        "of conjugate gradient steps to be non-negative"));
+            }
+            cg_steps = std::size_t(steps);
         }
 
-        using vector_type = ir::node_data<double>::storage1d_type;
         using matrix_type = ir::node_data<double>::storage2d_type;
 
-        // perform calculations
+        // perform calculations, the items are updated using the transposed
+        // ratings
         std::int64_t num_users = ratings.rows();
         std::int64_t num_items = ratings.columns();
-        auto conf = alpha * ratings;
-
-        matrix_type X(num_users, num_factors);
-        matrix_type Y(num_items, num_factors);
+        detail::als_ratings ratings_t = detail::als_transpose(ratings);
 
         matrix_type XtX(num_factors, num_factors);
         matrix_type YtY(num_factors, num_factors);
 
-        std::uint32_t seed_ = 0;
-        std::mt19937 rng_{seed_};
-        std::normal_distribution<double> dist;
-
-        for (std::size_t row = 0; row != blaze::rows(X); ++row)
-        {
-            for (auto& val : blaze::row(X, row))
-            {
-                val = dist(rng_);
-            }
-        }
-
-        for (std::size_t row = 0; row != blaze::rows(Y); ++row)
-        {
-            for (auto& val : blaze::row(Y, row))
-            {
-                val = dist(rng_);
-            }
-        }
-
-        blaze::IdentityMatrix<double> I_f(num_factors);
-        blaze::IdentityMatrix<double> I_i(num_items);
-        blaze::IdentityMatrix<double> I_u(num_users);
-
-        blaze::DynamicMatrix<double> c_u(num_items, num_items, 0);
-        blaze::DynamicMatrix<double> c_i(num_users, num_users, 0);
+        // start off the same factors as als_d(), independently of any other
+        // random numbers that were generated before
+        matrix_type X = detail::als_initial_factors(
+            num_users, num_factors, "als$X");
+        matrix_type Y = detail::als_initial_factors(
+            num_items, num_factors, "als$Y");
 
         for (std::int64_t step = 0; step < iterations; ++step)
         {
-            YtY = (blaze::trans(Y) * Y) + regularization * I_f;
-            XtX = (blaze::trans(X) * X) + regularization * I_f;
+            YtY = detail::als_gramian(Y, regularization);
+            XtX = detail::als_gramian(X, regularization);
 
             if (enable_output)
             {
@@ -155,31 +174,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
                           << "\nY: " << Y << std::endl;
             }
 
-            for (std::int64_t u = 0; u < num_users; u++)
-            {
-                auto conf_u = blaze::trans(blaze::row(conf, u));
-                auto diag = blaze::band(c_u, 0);
-                diag = conf_u;
-                blaze::DynamicVector<double> p_u =
-                    blaze::map(conf_u, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(Y) * c_u) * Y + YtY;
-                auto b = (blaze::trans(Y) * (c_u + I_i)) * (p_u);
-                auto row_x = blaze::row(X, u);
-                row_x = (trans(b) * blaze::inv(A));
-            }
-
-            for (std::int64_t i = 0; i < num_items; i++)
-            {
-                auto conf_i = blaze::column(conf, i);
-                auto diag = blaze::band(c_i, 0);
-                diag = conf_i;
-                blaze::DynamicVector<double> p_i =
-                    blaze::map(conf_i, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(X) * c_i) * X + XtX;
-                auto b = (blaze::trans(X) * (c_i + I_u)) * (p_i);
-                auto row_y = blaze::row(Y, i);
-                row_y = (trans(b) * blaze::inv(A));
-            }
+            detail::als_update_factors(
+                ratings, Y, YtY, X, 0, alpha, cg_steps);
+            detail::als_update_factors(
+                ratings_t, X, XtX, Y, 0, alpha, cg_steps);
         }
 
         return primitive_argument_type
@@ -195,17 +193,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 5 && operands.size() != 6)
+        if (operands.size() < 5 || operands.size() > 8)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "als::eval",
                 generate_error_message("the als algorithm primitive "
-                                       "requires exactly either "
-                                       "five or six operands"));
+                                       "requires between five and eight "
+                                       "operands"));
         }
 
         bool arguments_valid = true;
-        for (std::size_t i = 0; i != operands.size(); ++i)
+        for (std::size_t i = 0; i != 5; ++i)
         {
             if (!valid(operands[i]))
             {
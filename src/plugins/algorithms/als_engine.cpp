@@ -0,0 +1,513 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+#include <phylanx/util/random.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    als_ratings als_ratings_from_matrix(
+        ir::node_data<double>::storage2d_type const& ratings)
+    {
+        als_ratings result(ratings.rows(), ratings.columns());
+        for (std::size_t r = 0; r != ratings.rows(); ++r)
+        {
+            for (std::size_t c = 0; c != ratings.columns(); ++c)
+            {
+                double const value = ratings(r, c);
+                if (value != 0.0)
+                {
+                    result.indices_.push_back(c);
+                    result.values_.push_back(value);
+                }
+            }
+            result.offsets_[r + 1] = result.values_.size();
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // sort the entries of each row by column and merge duplicates
+        void als_normalize_rows(als_ratings& ratings)
+        {
+            std::vector<std::pair<std::size_t, double>> row;
+
+            std::size_t next = 0;
+            for (std::size_t r = 0; r != ratings.rows(); ++r)
+            {
+                std::size_t const first = ratings.offsets_[r];
+                std::size_t const last = ratings.offsets_[r + 1];
+
+                row.clear();
+                for (std::size_t k = first; k != last; ++k)
+                {
+                    row.emplace_back(ratings.indices_[k], ratings.values_[k]);
+                }
+                std::sort(row.begin(), row.end(),
+                    [](std::pair<std::size_t, double> const& lhs,
+                        std::pair<std::size_t, double> const& rhs) {
+                        return lhs.first < rhs.first;
+                    });
+
+                ratings.offsets_[r] = next;
+                for (std::size_t k = 0; k != row.size(); ++k)
+                {
+                    if (k != 0 && row[k].first == row[k - 1].first)
+                    {
+                        ratings.values_[next - 1] += row[k].second;
+                        continue;
+                    }
+                    ratings.indices_[next] = row[k].first;
+                    ratings.values_[next] = row[k].second;
+                    ++next;
+                }
+            }
+            ratings.offsets_[ratings.rows()] = next;
+
+            ratings.indices_.resize(next);
+            ratings.values_.resize(next);
+        }
+    }
+
+    als_ratings als_ratings_from_coo(std::vector<std::int64_t> const& rows,
+        std::vector<std::int64_t> const& columns,
+        std::vector<double> const& values, std::size_t num_rows,
+        std::size_t num_columns, std::string const& name,
+        std::string const& codename)
+    {
+        if (rows.size() != values.size() || columns.size() != values.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als::als_ratings_from_coo",
+                util::generate_error_message(
+                    "the row indices, column indices, and values of the "
+                    "ratings must have the same size",
+                    name, codename));
+        }
+
+        als_ratings result(num_rows, num_columns);
+        for (std::size_t k = 0; k != rows.size(); ++k)
+        {
+            if (rows[k] < 0 || std::size_t(rows[k]) >= num_rows ||
+                columns[k] < 0 || std::size_t(columns[k]) >= num_columns)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als::als_ratings_from_coo",
+                    util::generate_error_message(
+                        "the indices of the ratings are out of bounds of "
+                        "the given shape",
+                        name, codename));
+            }
+            ++result.offsets_[rows[k] + 1];
+        }
+
+        for (std::size_t r = 0; r != num_rows; ++r)
+        {
+            result.offsets_[r + 1] += result.offsets_[r];
+        }
+
+        // scatter the entries into their rows
+        result.indices_.resize(values.size());
+        result.values_.resize(values.size());
+
+        std::vector<std::size_t> next(
+            result.offsets_.begin(), result.offsets_.end() - 1);
+        for (std::size_t k = 0; k != rows.size(); ++k)
+        {
+            std::size_t const pos = next[rows[k]]++;
+            result.indices_[pos] = columns[k];
+            result.values_[pos] = values[k];
+        }
+
+        als_normalize_rows(result);
+        return result;
+    }
+
+    als_ratings als_ratings_from_csr(std::vector<std::int64_t> const& offsets,
+        std::vector<std::int64_t> const& indices,
+        std::vector<double> const& values, std::size_t num_columns,
+        std::string const& name, std::string const& codename)
+    {
+        if (offsets.empty() || offsets.front() != 0 ||
+            std::size_t(offsets.back()) != values.size() ||
+            indices.size() != values.size() ||
+            !std::is_sorted(offsets.begin(), offsets.end()))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als::als_ratings_from_csr",
+                util::generate_error_message(
+                    "the row offsets of the ratings must be ascending, "
+                    "start at zero, and end at the number of values",
+                    name, codename));
+        }
+
+        als_ratings result(offsets.size() - 1, num_columns);
+        std::copy(offsets.begin(), offsets.end(), result.offsets_.begin());
+
+        result.indices_.reserve(indices.size());
+        for (std::int64_t index : indices)
+        {
+            if (index < 0 || std::size_t(index) >= num_columns)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als::als_ratings_from_csr",
+                    util::generate_error_message(
+                        "the column indices of the ratings are out of "
+                        "bounds of the given shape",
+                        name, codename));
+            }
+            result.indices_.push_back(index);
+        }
+        result.values_ = values;
+
+        als_normalize_rows(result);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        std::vector<std::int64_t> als_extract_indices(
+            primitive_argument_type&& arg, std::string const& name,
+            std::string const& codename)
+        {
+            auto indices =
+                extract_integer_value(std::move(arg), name, codename);
+            if (indices.num_dimensions() != 1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als::als_ratings_from_list",
+                    util::generate_error_message(
+                        "the indices of sparse ratings must be given as "
+                        "vectors",
+                        name, codename));
+            }
+            auto v = indices.vector();
+            return std::vector<std::int64_t>(v.begin(), v.end());
+        }
+
+        std::size_t als_max_index(std::vector<std::int64_t> const& indices)
+        {
+            if (indices.empty())
+            {
+                return 0;
+            }
+            return std::size_t(
+                (std::max)(std::int64_t(-1),
+                    *std::max_element(indices.begin(), indices.end())) + 1);
+        }
+    }
+
+    als_ratings als_ratings_from_list(primitive_argument_type&& ratings,
+        std::string const& format, std::string const& name,
+        std::string const& codename)
+    {
+        if (format != "coo" && format != "csr")
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als::als_ratings_from_list",
+                util::generate_error_message(
+                    "the format of sparse ratings must be either 'coo' or "
+                    "'csr'",
+                    name, codename));
+        }
+
+        ir::range list = extract_list_value(std::move(ratings), name, codename);
+        if (list.size() != 3 && list.size() != 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als::als_ratings_from_list",
+                util::generate_error_message(
+                    "sparse ratings must be given as a list of three "
+                    "vectors (and optionally the shape of the ratings)",
+                    name, codename));
+        }
+
+        primitive_arguments_type parts = list.copy();
+
+        std::vector<std::int64_t> first =
+            als_extract_indices(std::move(parts[0]), name, codename);
+        std::vector<std::int64_t> second =
+            als_extract_indices(std::move(parts[1]), name, codename);
+
+        auto values_data =
+            extract_numeric_value(std::move(parts[2]), name, codename);
+        if (values_data.num_dimensions() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als::als_ratings_from_list",
+                util::generate_error_message(
+                    "the values of sparse ratings must be given as a vector",
+                    name, codename));
+        }
+        auto v = values_data.vector();
+        std::vector<double> values(v.begin(), v.end());
+
+        // the shape is derived from the indices if not given
+        std::size_t num_rows = format == "coo" ?
+            als_max_index(first) :
+            (first.empty() ? 0 : first.size() - 1);
+        std::size_t num_columns = als_max_index(second);
+
+        if (parts.size() == 4 && valid(parts[3]))
+        {
+            primitive_arguments_type shape =
+                extract_list_value(std::move(parts[3]), name, codename).copy();
+            if (shape.size() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als::als_ratings_from_list",
+                    util::generate_error_message(
+                        "the shape of sparse ratings must be a list of two "
+                        "integers",
+                        name, codename));
+            }
+            std::int64_t rows =
+                extract_scalar_integer_value(shape[0], name, codename);
+            std::int64_t columns =
+                extract_scalar_integer_value(shape[1], name, codename);
+            if (rows < std::int64_t(num_rows) ||
+                columns < std::int64_t(num_columns) ||
+                (format == "csr" && rows != std::int64_t(num_rows)))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als::als_ratings_from_list",
+                    util::generate_error_message(
+                        "the shape of sparse ratings is not consistent with "
+                        "the given indices",
+                        name, codename));
+            }
+            num_rows = std::size_t(rows);
+            num_columns = std::size_t(columns);
+        }
+
+        if (format == "coo")
+        {
+            return als_ratings_from_coo(first, second, values, num_rows,
+                num_columns, name, codename);
+        }
+        return als_ratings_from_csr(
+            first, second, values, num_columns, name, codename);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    als_ratings als_transpose(als_ratings const& ratings)
+    {
+        als_ratings result(ratings.columns(), ratings.rows());
+        for (std::size_t index : ratings.indices_)
+        {
+            ++result.offsets_[index + 1];
+        }
+        for (std::size_t c = 0; c != result.rows(); ++c)
+        {
+            result.offsets_[c + 1] += result.offsets_[c];
+        }
+
+        result.indices_.resize(ratings.nonzeros());
+        result.values_.resize(ratings.nonzeros());
+
+        // rows are visited in order, the transposed rows end up sorted
+        std::vector<std::size_t> next(
+            result.offsets_.begin(), result.offsets_.end() - 1);
+        for (std::size_t r = 0; r != ratings.rows(); ++r)
+        {
+            for (std::size_t k = ratings.offsets_[r];
+                 k != ratings.offsets_[r + 1]; ++k)
+            {
+                std::size_t const pos = next[ratings.indices_[k]]++;
+                result.indices_[pos] = r;
+                result.values_[pos] = ratings.values_[k];
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t als_default_cg_steps()
+    {
+        static std::size_t steps = std::stoul(
+            hpx::get_config_entry("phylanx.als.cg_steps", "3"));
+        return steps;
+    }
+
+    blaze::DynamicMatrix<double> als_initial_factors(
+        std::size_t rows, std::size_t columns, std::string const& stream)
+    {
+        std::uint64_t const id = util::random_stream(stream);
+        std::normal_distribution<double> dist;
+
+        blaze::DynamicMatrix<double> result(rows, columns);
+        for (std::size_t i = 0; i != rows * columns; ++i)
+        {
+            result(i / columns, i % columns) =
+                util::random_value(dist, 0, id, i);
+        }
+        return result;
+    }
+
+    blaze::DynamicMatrix<double> als_gramian(
+        blaze::DynamicMatrix<double> const& factors, double regularization)
+    {
+        blaze::DynamicMatrix<double> result = blaze::trans(factors) * factors;
+        for (std::size_t i = 0; i != result.rows(); ++i)
+        {
+            result(i, i) += regularization;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // number of non-zero ratings handled by one partition of the rows
+        constexpr std::size_t als_partition_nonzeros = 4096;
+
+        // Solve the system for one row directly
+        void als_solve_direct(als_ratings const& ratings, std::size_t r,
+            blaze::DynamicMatrix<double> const& other,
+            blaze::DynamicMatrix<double> const& YtY,
+            blaze::DynamicMatrix<double>& factors, std::size_t row,
+            double alpha)
+        {
+            std::size_t const num_factors = YtY.rows();
+
+            // A = YtY + Yt (C_u - I) Y, b = Yt C_u p_u
+            blaze::DynamicMatrix<double> A(YtY);
+            blaze::DynamicVector<double> b(num_factors, 0.0);
+            for (std::size_t k = ratings.offsets_[r];
+                 k != ratings.offsets_[r + 1]; ++k)
+            {
+                double const confidence = alpha * ratings.values_[k];
+                auto y = blaze::trans(blaze::row(other, ratings.indices_[k]));
+
+                A += confidence * (y * blaze::trans(y));
+                b += (1.0 + confidence) * y;
+            }
+
+            blaze::posv(A, b, 'U');
+            blaze::row(factors, row) = blaze::trans(b);
+        }
+
+        // Perform the given number of conjugate gradient steps for one row,
+        // starting off the current factors
+        void als_solve_cg(als_ratings const& ratings, std::size_t r,
+            blaze::DynamicMatrix<double> const& other,
+            blaze::DynamicMatrix<double> const& YtY,
+            blaze::DynamicMatrix<double>& factors, std::size_t row,
+            double alpha, std::size_t cg_steps)
+        {
+            std::size_t const first = ratings.offsets_[r];
+            std::size_t const last = ratings.offsets_[r + 1];
+
+            blaze::DynamicVector<double> x =
+                blaze::trans(blaze::row(factors, row));
+
+            // residual r = b - A x, touching only the rated items
+            blaze::DynamicVector<double> residual = -(YtY * x);
+            for (std::size_t k = first; k != last; ++k)
+            {
+                double const confidence = alpha * ratings.values_[k];
+                auto y = blaze::trans(blaze::row(other, ratings.indices_[k]));
+                residual +=
+                    (1.0 + confidence - confidence * blaze::dot(y, x)) * y;
+            }
+
+            blaze::DynamicVector<double> p = residual;
+            double rsold = blaze::dot(residual, residual);
+
+            blaze::DynamicVector<double> Ap;
+            for (std::size_t step = 0; step != cg_steps && rsold >= 1e-20;
+                 ++step)
+            {
+                Ap = YtY * p;
+                for (std::size_t k = first; k != last; ++k)
+                {
+                    double const confidence = alpha * ratings.values_[k];
+                    auto y =
+                        blaze::trans(blaze::row(other, ratings.indices_[k]));
+                    Ap += (confidence * blaze::dot(y, p)) * y;
+                }
+
+                double const step_size = rsold / blaze::dot(p, Ap);
+                x += step_size * p;
+                residual -= step_size * Ap;
+
+                double const rsnew = blaze::dot(residual, residual);
+                p = residual + (rsnew / rsold) * p;
+                rsold = rsnew;
+            }
+
+            blaze::row(factors, row) = blaze::trans(x);
+        }
+    }
+
+    void als_update_factors(als_ratings const& ratings,
+        blaze::DynamicMatrix<double> const& other,
+        blaze::DynamicMatrix<double> const& YtY,
+        blaze::DynamicMatrix<double>& factors, std::size_t first,
+        double alpha, std::size_t cg_steps)
+    {
+        std::size_t const rows = ratings.rows();
+        std::size_t const partitions = (std::max)(std::size_t(1),
+            (std::min)(std::size_t(4 * hpx::get_os_thread_count()),
+                (ratings.nonzeros() + rows) / als_partition_nonzeros));
+
+        // partition the rows such that each partition covers roughly the
+        // same number of ratings (the number of ratings per user or item is
+        // usually very skewed)
+        std::vector<std::size_t> bounds(partitions + 1, rows);
+        bounds[0] = 0;
+        for (std::size_t p = 1; p != partitions; ++p)
+        {
+            std::size_t const target = p * ratings.nonzeros() / partitions;
+            bounds[p] = std::size_t(
+                std::lower_bound(ratings.offsets_.begin(),
+                    ratings.offsets_.end() - 1, target) -
+                ratings.offsets_.begin());
+            bounds[p] = (std::max)(bounds[p], bounds[p - 1]);
+        }
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), partitions,
+            [&](std::size_t p) {
+                for (std::size_t r = bounds[p]; r != bounds[p + 1]; ++r)
+                {
+                    if (cg_steps == 0)
+                    {
+                        als_solve_direct(ratings, r, other, YtY, factors,
+                            first + r, alpha);
+                    }
+                    else
+                    {
+                        als_solve_cg(ratings, r, other, YtY, factors,
+                            first + r, alpha, cg_steps);
+                    }
+                }
+            });
+    }
+}}}}
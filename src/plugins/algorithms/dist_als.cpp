@@ -0,0 +1,589 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
+#include <phylanx/plugins/algorithms/dist_als.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_als::match_data = {hpx::make_tuple("als_d",
+        std::vector<std::string>{
+            "als_d(_1, _2, _3, _4, _5, __arg(_6_enable_output, false), "
+                "__arg(_7_cg_steps, nil))"},
+        &create_dist_als, &create_primitive<dist_als>,
+        R"(ratings, reg, num, iters, alpha, enable_output, cg_steps
+        Args:
+
+            ratings (list): the part of the user feedback held by this
+                             locality, given as list(rows, columns,
+                             values[, shape]) using global user (row) and
+                             item (column) indices
+            reg (float): the regularization parameter
+            num (integer): the number of factors
+            iters (integer): the number of iterations
+            alpha (float): the scaling factor
+            enable_output(boolean): whether output should be enabled.
+            cg_steps (integer, optional): the number of conjugate gradient
+                             steps performed for each user and item, zero
+                             solves the systems directly. Defaults to three.
+
+        Returns:
+
+        The algorithm returns a list of two matrices: [X, Y] :
+        X: user-factors matrix
+        Y: item-factors matrix
+
+        The users and the items are split into contiguous, evenly sized
+        shards, one per locality. Each locality solves for the factors of
+        its users and items, after each half step it sends the factors to
+        the localities whose ratings refer to them. All localities have to
+        invoke als_d in the same order.)"
+        )};
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_als::dist_als(primitive_arguments_type && operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // the ratings sent to the locality that owns a user (or an item)
+        struct als_entries
+        {
+            std::vector<std::int64_t> rows_;
+            std::vector<std::int64_t> columns_;
+            std::vector<double> values_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                // clang-format off
+                ar & rows_ & columns_ & values_;
+                // clang-format on
+            }
+        };
+
+        // first index of the shard owned by the given locality
+        std::size_t als_shard_begin(
+            std::size_t size, std::uint32_t loc, std::uint32_t num_localities)
+        {
+            return std::size_t(loc) * size / num_localities;
+        }
+
+        // locality owning the given index
+        std::uint32_t als_shard_owner(
+            std::size_t index, std::size_t size, std::uint32_t num_localities)
+        {
+            return std::uint32_t(
+                ((index + 1) * num_localities - 1) / size);
+        }
+
+        // The rows of the other side's factors referenced by the local
+        // ratings (the ghost rows). They are sorted by their index, thus the
+        // ghost rows owned by locality loc start at offsets_[loc].
+        struct als_ghosts
+        {
+            // global indices of the rows received from each locality
+            std::vector<std::vector<std::int64_t>> received_;
+            std::vector<std::size_t> offsets_;
+
+            // rows of the local shard sent to each locality, relative to
+            // the first row of the shard
+            std::vector<std::vector<std::int64_t>> sent_;
+
+            std::size_t size() const
+            {
+                return offsets_.back();
+            }
+        };
+
+        // Determine the ghost rows of the given ratings and renumber the
+        // columns of the ratings to refer to them. Each locality tells the
+        // owners which of their rows it needs.
+        als_ghosts als_make_ghosts(als_ratings& ratings, std::size_t size,
+            std::string const& basename, std::uint32_t this_locality,
+            std::uint32_t num_localities)
+        {
+            std::vector<std::size_t> referenced(ratings.indices_);
+            std::sort(referenced.begin(), referenced.end());
+            referenced.erase(std::unique(referenced.begin(), referenced.end()),
+                referenced.end());
+
+            als_ghosts ghosts;
+            ghosts.received_.resize(num_localities);
+            ghosts.offsets_.resize(num_localities + 1, 0);
+            for (std::size_t index : referenced)
+            {
+                std::uint32_t const loc =
+                    als_shard_owner(index, size, num_localities);
+                ghosts.received_[loc].push_back(std::int64_t(index));
+                ++ghosts.offsets_[loc + 1];
+            }
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                ghosts.offsets_[loc + 1] += ghosts.offsets_[loc];
+            }
+
+            for (std::size_t& index : ratings.indices_)
+            {
+                auto const it = std::lower_bound(
+                    referenced.begin(), referenced.end(), index);
+                index = std::size_t(it - referenced.begin());
+            }
+            ratings.columns_ = referenced.size();
+
+            if (num_localities == 1)
+            {
+                ghosts.sent_ = ghosts.received_;
+            }
+            else
+            {
+                ghosts.sent_ = hpx::all_to_all(basename.c_str(),
+                    std::vector<std::vector<std::int64_t>>(ghosts.received_),
+                    num_localities, 1, this_locality)
+                    .get();
+            }
+
+            std::int64_t const first = std::int64_t(
+                als_shard_begin(size, this_locality, num_localities));
+            for (auto& rows : ghosts.sent_)
+            {
+                for (std::int64_t& row : rows)
+                {
+                    row -= first;
+                }
+            }
+            return ghosts;
+        }
+
+        // Copy the given rows of the factors into a matrix
+        blaze::DynamicMatrix<double> als_select_rows(
+            blaze::DynamicMatrix<double> const& factors,
+            std::vector<std::int64_t> const& rows)
+        {
+            blaze::DynamicMatrix<double> result(
+                rows.size(), factors.columns());
+            for (std::size_t i = 0; i != rows.size(); ++i)
+            {
+                blaze::row(result, i) = blaze::row(factors, rows[i]);
+            }
+            return result;
+        }
+
+        // Send the rows of the local shard of the factors to the localities
+        // referring to them, and receive the ghost rows
+        void als_exchange_factors(blaze::DynamicMatrix<double> const& local,
+            als_ghosts const& ghosts, blaze::DynamicMatrix<double>& result,
+            std::string const& basename, std::size_t generation,
+            std::uint32_t this_locality, std::uint32_t num_localities)
+        {
+            std::vector<blaze::DynamicMatrix<double>> parts(num_localities);
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                parts[loc] = als_select_rows(local, ghosts.sent_[loc]);
+            }
+
+            if (num_localities != 1)
+            {
+                parts = hpx::all_to_all(basename.c_str(), std::move(parts),
+                    num_localities, generation, this_locality)
+                    .get();
+            }
+
+            result.resize(ghosts.size(), local.columns(), false);
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                blaze::submatrix(result, ghosts.offsets_[loc], 0,
+                    parts[loc].rows(), result.columns()) = parts[loc];
+            }
+        }
+
+        // Return Yt Y + reg * I of the factors sharded over all localities
+        blaze::DynamicMatrix<double> als_reduce_gramian(
+            blaze::DynamicMatrix<double> const& local, double regularization,
+            std::string const& basename, std::size_t generation,
+            std::uint32_t this_locality, std::uint32_t num_localities)
+        {
+            if (num_localities == 1)
+            {
+                return als_gramian(local, regularization);
+            }
+
+            blaze::DynamicMatrix<double> result =
+                hpx::all_reduce(basename.c_str(), als_gramian(local, 0.0),
+                    std::plus<blaze::DynamicMatrix<double>>{}, num_localities,
+                    generation, this_locality)
+                    .get();
+            for (std::size_t i = 0; i != result.rows(); ++i)
+            {
+                result(i, i) += regularization;
+            }
+            return result;
+        }
+
+        // Collect the shards of the factors from all localities
+        blaze::DynamicMatrix<double> als_gather_factors(
+            blaze::DynamicMatrix<double> const& local, std::size_t size,
+            std::string const& basename, std::size_t generation,
+            std::uint32_t this_locality, std::uint32_t num_localities)
+        {
+            if (num_localities == 1)
+            {
+                return local;
+            }
+
+            std::vector<blaze::DynamicMatrix<double>> parts =
+                hpx::all_gather(basename.c_str(),
+                    blaze::DynamicMatrix<double>(local), num_localities,
+                    generation, this_locality)
+                    .get();
+
+            blaze::DynamicMatrix<double> result(size, local.columns());
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                std::size_t const begin =
+                    als_shard_begin(size, loc, num_localities);
+                blaze::submatrix(result, begin, 0, parts[loc].rows(),
+                    result.columns()) = parts[loc];
+            }
+            return result;
+        }
+
+        // Send each rating to the localities owning its user and its item
+        // and build the ratings of the local users and the local items
+        std::pair<als_ratings, als_ratings> als_distribute_ratings(
+            als_ratings const& ratings, std::string const& basename,
+            std::uint32_t this_locality, std::uint32_t num_localities,
+            std::string const& name, std::string const& codename)
+        {
+            std::size_t const num_users = ratings.rows();
+            std::size_t const num_items = ratings.columns();
+
+            std::vector<als_entries> by_user(num_localities);
+            std::vector<als_entries> by_item(num_localities);
+            for (std::size_t u = 0; u != num_users; ++u)
+            {
+                als_entries& user_entries =
+                    by_user[als_shard_owner(u, num_users, num_localities)];
+                for (std::size_t k = ratings.offsets_[u];
+                     k != ratings.offsets_[u + 1]; ++k)
+                {
+                    std::size_t const i = ratings.indices_[k];
+                    user_entries.rows_.push_back(u);
+                    user_entries.columns_.push_back(i);
+                    user_entries.values_.push_back(ratings.values_[k]);
+
+                    als_entries& item_entries =
+                        by_item[als_shard_owner(i, num_items, num_localities)];
+                    item_entries.rows_.push_back(i);
+                    item_entries.columns_.push_back(u);
+                    item_entries.values_.push_back(ratings.values_[k]);
+                }
+            }
+
+            auto users = hpx::all_to_all((basename + "_users").c_str(),
+                std::move(by_user), num_localities, 1, this_locality);
+            auto items = hpx::all_to_all((basename + "_items").c_str(),
+                std::move(by_item), num_localities, 1, this_locality);
+
+            // the rows of the local ratings are relative to the first user
+            // (item) of the shard
+            auto make_ratings = [&](std::vector<als_entries>&& received,
+                                    std::size_t size, std::size_t columns) {
+                std::size_t const first =
+                    als_shard_begin(size, this_locality, num_localities);
+                std::size_t const last =
+                    als_shard_begin(size, this_locality + 1, num_localities);
+
+                std::vector<std::int64_t> rows, cols;
+                std::vector<double> values;
+                for (auto& entries : received)
+                {
+                    for (std::int64_t row : entries.rows_)
+                    {
+                        rows.push_back(row - std::int64_t(first));
+                    }
+                    cols.insert(cols.end(), entries.columns_.begin(),
+                        entries.columns_.end());
+                    values.insert(values.end(), entries.values_.begin(),
+                        entries.values_.end());
+                }
+                return als_ratings_from_coo(
+                    rows, cols, values, last - first, columns, name, codename);
+            };
+
+            als_ratings user_ratings =
+                make_ratings(users.get(), num_users, num_items);
+            als_ratings item_ratings =
+                make_ratings(items.get(), num_items, num_users);
+
+            return std::make_pair(
+                std::move(user_ratings), std::move(item_ratings));
+        }
+
+        // the collective operations of each invocation of als_d use
+        // separate names
+        std::string als_basename()
+        {
+            static std::atomic<std::size_t> invocation(0);
+            return "als_d_" + std::to_string(++invocation);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_als::calculate_als(
+        primitive_arguments_type&& args) const
+    {
+        if (!is_list_operand_strict(args[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "als_d::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires for the first "
+                    "argument ('ratings') to be a list of sparse ratings"));
+        }
+
+        // the ratings held by this locality
+        detail::als_ratings local_ratings = detail::als_ratings_from_list(
+            std::move(args[0]), "coo", name_, codename_);
+
+        auto regularization =
+            extract_scalar_numeric_value(args[1], name_, codename_);
+        auto num_factors =
+            extract_scalar_integer_value(args[2], name_, codename_);
+        auto iterations =
+            extract_scalar_integer_value(args[3], name_, codename_);
+        auto alpha = extract_scalar_numeric_value(args[4], name_, codename_);
+
+        bool enable_output = false;
+        if (args.size() > 5 && valid(args[5]))
+        {
+            enable_output =
+                extract_scalar_boolean_value(args[5], name_, codename_) != 0;
+        }
+
+        std::size_t cg_steps = detail::als_default_cg_steps();
+        if (args.size() > 6 && valid(args[6]))
+        {
+            std::int64_t steps =
+                extract_scalar_integer_value(args[6], name_, codename_);
+            if (steps < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "als_d::eval",
+                    generate_error_message(
+                        "the als_d algorithm primitive requires for the "
+                        "number of conjugate gradient steps to be "
+                        "non-negative"));
+            }
+            cg_steps = std::size_t(steps);
+        }
+
+        std::uint32_t const this_locality = hpx::get_locality_id();
+        std::uint32_t const num_localities =
+            hpx::get_num_localities(hpx::launch::sync);
+        std::string const basename = detail::als_basename();
+
+        // the overall number of users and items is the largest shape
+        // seen by any of the localities
+        std::size_t num_users = local_ratings.rows();
+        std::size_t num_items = local_ratings.columns();
+        if (num_localities != 1)
+        {
+            std::vector<std::vector<std::size_t>> shapes =
+                hpx::all_gather((basename + "_shape").c_str(),
+                    std::vector<std::size_t>{num_users, num_items},
+                    num_localities, 1, this_locality)
+                    .get();
+            for (auto const& shape : shapes)
+            {
+                num_users = (std::max)(num_users, shape[0]);
+                num_items = (std::max)(num_items, shape[1]);
+            }
+            local_ratings.offsets_.resize(
+                num_users + 1, local_ratings.offsets_.back());
+            local_ratings.columns_ = num_items;
+        }
+
+        // shard the users and items
+        detail::als_ratings user_ratings;
+        detail::als_ratings item_ratings;
+        if (num_localities == 1)
+        {
+            item_ratings = detail::als_transpose(local_ratings);
+            user_ratings = std::move(local_ratings);
+        }
+        else
+        {
+            std::tie(user_ratings, item_ratings) =
+                detail::als_distribute_ratings(local_ratings, basename,
+                    this_locality, num_localities, name_, codename_);
+        }
+
+        std::size_t const first_user =
+            detail::als_shard_begin(num_users, this_locality, num_localities);
+        std::size_t const last_user = detail::als_shard_begin(
+            num_users, this_locality + 1, num_localities);
+        std::size_t const first_item =
+            detail::als_shard_begin(num_items, this_locality, num_localities);
+        std::size_t const last_item = detail::als_shard_begin(
+            num_items, this_locality + 1, num_localities);
+
+        // each locality keeps the factors of its own users and items and the
+        // factors of the items (users) referenced by the ratings of its users
+        // (items) only
+        detail::als_ghosts const item_ghosts =
+            detail::als_make_ghosts(user_ratings, num_items,
+                basename + "_item_ghosts", this_locality, num_localities);
+        detail::als_ghosts const user_ghosts =
+            detail::als_make_ghosts(item_ratings, num_users,
+                basename + "_user_ghosts", this_locality, num_localities);
+
+        using matrix_type = ir::node_data<double>::storage2d_type;
+
+        // all localities start off the same factors, independently of any
+        // other random numbers that were generated before
+        matrix_type X;
+        matrix_type Y;
+        matrix_type Y_ghosts;
+        {
+            matrix_type initial_X = detail::als_initial_factors(
+                num_users, num_factors, "als$X");
+            matrix_type initial_Y = detail::als_initial_factors(
+                num_items, num_factors, "als$Y");
+
+            X = blaze::submatrix(initial_X, first_user, 0,
+                last_user - first_user, num_factors);
+            Y = blaze::submatrix(initial_Y, first_item, 0,
+                last_item - first_item, num_factors);
+
+            Y_ghosts.resize(item_ghosts.size(), num_factors, false);
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                blaze::submatrix(Y_ghosts, item_ghosts.offsets_[loc], 0,
+                    item_ghosts.received_[loc].size(), num_factors) =
+                    detail::als_select_rows(
+                        initial_Y, item_ghosts.received_[loc]);
+            }
+        }
+        matrix_type X_ghosts;
+
+        matrix_type XtX(num_factors, num_factors);
+        matrix_type YtY(num_factors, num_factors);
+
+        for (std::int64_t step = 0; step < iterations; ++step)
+        {
+            std::size_t const generation = std::size_t(step + 1);
+
+            YtY = detail::als_reduce_gramian(Y, regularization,
+                basename + "_yty", generation, this_locality, num_localities);
+            XtX = detail::als_reduce_gramian(X, regularization,
+                basename + "_xtx", generation, this_locality, num_localities);
+
+            if (enable_output)
+            {
+                matrix_type all_X = detail::als_gather_factors(X, num_users,
+                    basename + "_output_x", generation, this_locality,
+                    num_localities);
+                matrix_type all_Y = detail::als_gather_factors(Y, num_items,
+                    basename + "_output_y", generation, this_locality,
+                    num_localities);
+                if (this_locality == 0)
+                {
+                    hpx::cout << "iteration " << step << "\nX: " << all_X
+                              << "\nY: " << all_Y << std::endl;
+                }
+            }
+
+            detail::als_update_factors(
+                user_ratings, Y_ghosts, YtY, X, 0, alpha, cg_steps);
+            detail::als_exchange_factors(X, user_ghosts, X_ghosts,
+                basename + "_x", generation, this_locality, num_localities);
+
+            detail::als_update_factors(
+                item_ratings, X_ghosts, XtX, Y, 0, alpha, cg_steps);
+            detail::als_exchange_factors(Y, item_ghosts, Y_ghosts,
+                basename + "_y", generation, this_locality, num_localities);
+        }
+
+        X = detail::als_gather_factors(X, num_users, basename + "_result_x",
+            1, this_locality, num_localities);
+        Y = detail::als_gather_factors(Y, num_items, basename + "_result_y",
+            1, this_locality, num_localities);
+
+        return primitive_argument_type
+        {
+            primitive_arguments_type{
+                primitive_argument_type{ir::node_data<double>{std::move(X)}},
+                primitive_argument_type{ir::node_data<double>{std::move(Y)}}}
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_als::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 5 || operands.size() > 7)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "als_d::eval",
+                generate_error_message("the als_d algorithm primitive "
+                                       "requires between five and seven "
+                                       "operands"));
+        }
+
+        for (std::size_t i = 0; i != 5; ++i)
+        {
+            if (!valid(operands[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "als_d::eval",
+                    generate_error_message(
+                        "the als_d algorithm primitive requires that the "
+                        "arguments given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_als(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
@@ -11,13 +11,16 @@
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <random>
 #include <string>
@@ -40,28 +43,37 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     __arg(_3_iterations, 10),
                     __arg(_4_show_result, false),
                     __arg(_5_seed, nil),
-                    __arg(_6_initial_centroids, nil)
+                    __arg(_6_initial_centroids, nil),
+                    __arg(_7_tolerance, 0.0),
+                    __arg(_8_init, "random")
                 )
             )"},
             &create_kmeans, &create_primitive<kmeans>, R"(
             points, num_centroids, iterations, show_result, seed,
-            initial_centroids
+            initial_centroids, tolerance, init
 
             Args:
 
-                points (matrix): a matrix with any number of rows and two
-                    columns. Any data that can be represented by two features
-                    can create the point matrix.
+                points (matrix): a matrix with any number of rows and any
+                    number of columns. Each row represents a point, each
+                    column one of its features.
                 num_centroids (int, optional): the number of clusters in which
                     we need to break down the data. It sets to 3 by default
-                iterations (int, optional): the number of iterations. It sets
-                    to 10 by default.
+                iterations (int, optional): the maximal number of iterations.
+                    It sets to 10 by default.
                 show_result (bool, optional): defaults to false.
                 seed (int) : the seed of a random number generator.
                 initial_centroids (matrix): if not given, the centroids are
-                    initialized by num_centroids randomly chosen points. If
-                    given there is no use for a seed. The initial_centroids
-                    matrix should have num_centroids rows and 2 columns.
+                    initialized as specified by init. If given there is no
+                    use for a seed. The initial_centroids matrix should have
+                    num_centroids rows and as many columns as points.
+                tolerance (float, optional): the iteration stops early once
+                    no centroid has moved farther than tolerance (euclidean
+                    distance) during the last iteration. Defaults to 0.0.
+                init (string, optional): the method used to initialize the
+                    centroids if no initial_centroids are given, either
+                    'random' (num_centroids randomly chosen points, the
+                    default) or 'kmeans++'.
 
             Returns:
 
@@ -75,15 +87,60 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // number of points handled by one invocation of the distance kernel
+        constexpr std::size_t kmeans_block_size = 256;
+
+        // number of partitions the points are split into, one per HPX worker
+        // thread (but at least one block per partition)
+        std::size_t num_partitions(std::size_t num_points)
+        {
+            return (std::max)(std::size_t(1),
+                (std::min)(std::size_t(hpx::get_os_thread_count()),
+                    (num_points + kmeans_block_size - 1) / kmeans_block_size));
+        }
+
+        // Split the points into contiguous partitions and invoke the given
+        // function for each of them in parallel.
+        template <typename F>
+        void for_each_partition(std::size_t num_points, F&& f)
+        {
+            std::size_t const partitions = num_partitions(num_points);
+            hpx::for_loop(hpx::execution::par, std::size_t(0), partitions,
+                [&](std::size_t partition) {
+                    std::size_t first = partition * num_points / partitions;
+                    std::size_t last =
+                        (partition + 1) * num_points / partitions;
+                    f(partition, first, last);
+                });
+        }
+
+        // squared euclidean norm of each of the points
+        blaze::DynamicVector<double> squared_norms(
+            kmeans::points_type const& points)
+        {
+            blaze::DynamicVector<double> result(points.rows());
+            for_each_partition(points.rows(),
+                [&](std::size_t, std::size_t first, std::size_t last) {
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        result[i] = blaze::sqrNorm(blaze::row(points, i));
+                    }
+                });
+            return result;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // choose num_centroids random points as the initial centroids
     blaze::DynamicMatrix<double> kmeans::initialize_centroids(
-        blaze::DynamicMatrix<double> const& points, std::size_t num_points,
-        std::size_t num_centroids) const
+        points_type const& points, std::size_t num_centroids) const
     {
-        blaze::DynamicMatrix<double> centroids(num_centroids, 2);
+        blaze::DynamicMatrix<double> centroids(num_centroids, points.columns());
         std::uniform_int_distribution<std::int64_t> distribution(
-            0, num_points - 1);
+            0, points.rows() - 1);
         std::vector<std::size_t> indices;
         std::int64_t rand_index;
 
@@ -101,62 +158,205 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             blaze::row(centroids, i) = blaze::row(points, rand_index);
         }
-        return std::move(centroids);
+        return centroids;
     }
 
-    // assign each point to its closest centroid
-    blaze::DynamicVector<std::size_t> kmeans::closest_centroids(
-        blaze::DynamicMatrix<double> const& points,
-        blaze::DynamicMatrix<double> const& centroids, std::size_t num_points,
+    // k-means++: choose the first centroid randomly, every following centroid
+    // is chosen with a probability proportional to its squared distance from
+    // the closest centroid chosen so far
+    blaze::DynamicMatrix<double> kmeans::initialize_centroids_kmeans_pp(
+        points_type const& points,
+        blaze::DynamicVector<double> const& squared_norms,
         std::size_t num_centroids) const
     {
-        auto points_x = blaze::column(points, 0);
-        auto points_y = blaze::column(points, 1);
-        auto centroids_x = blaze::column(centroids, 0);
-        auto centroids_y = blaze::column(centroids, 1);
-
-        // calculating the index for each row of points
-        blaze::DynamicVector<std::size_t> result(num_points);
-        for (std::size_t i = 0; i != num_points; ++i)
+        std::size_t const num_points = points.rows();
+
+        blaze::DynamicMatrix<double> centroids(num_centroids, points.columns());
+        blaze::DynamicVector<double> min_distances(
+            num_points, std::numeric_limits<double>::max());
+
+        std::uniform_int_distribution<std::size_t> distribution(
+            0, num_points - 1);
+        std::size_t index = distribution(util::rng_);
+
+        for (std::size_t k = 0; k != num_centroids; ++k)
         {
-            auto temp = blaze::DynamicVector<double>(num_centroids);
-            for (std::size_t j = 0; j != num_centroids; ++j)
+            blaze::row(centroids, k) = blaze::row(points, index);
+            if (k + 1 == num_centroids)
+            {
+                break;
+            }
+
+            // update the distances to the closest centroid
+            auto centroid = blaze::trans(blaze::row(centroids, k));
+            double const centroid_norm = squared_norms[index];
+
+            std::vector<double> partial_sums(
+                detail::num_partitions(num_points), 0.0);
+            detail::for_each_partition(num_points,
+                [&](std::size_t partition, std::size_t first,
+                    std::size_t last) {
+                    auto block = blaze::submatrix(points, first, 0,
+                        last - first, points.columns());
+                    blaze::DynamicVector<double> cross = block * centroid;
+
+                    double sum = 0.0;
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        double d = (std::max)(0.0,
+                            squared_norms[i] - 2.0 * cross[i - first] +
+                                centroid_norm);
+                        if (d < min_distances[i])
+                        {
+                            min_distances[i] = d;
+                        }
+                        sum += min_distances[i];
+                    }
+                    partial_sums[partition] = sum;
+                });
+
+            double total = 0.0;
+            for (double sum : partial_sums)
+            {
+                total += sum;
+            }
+
+            // all remaining points coincide with one of the centroids
+            if (total <= 0.0)
+            {
+                index = distribution(util::rng_);
+                continue;
+            }
+
+            std::uniform_real_distribution<double> real_distribution(
+                0.0, total);
+            double threshold = real_distribution(util::rng_);
+
+            index = num_points - 1;
+            for (std::size_t i = 0; i != num_points; ++i)
             {
-                temp[j] = blaze::sqrt(
-                    blaze::pow(points_x[i] - centroids_x[j], 2) +
-                    blaze::pow(points_y[i] - centroids_y[j], 2));
+                threshold -= min_distances[i];
+                if (threshold < 0.0)
+                {
+                    index = i;
+                    break;
+                }
             }
-            result[i] = blaze::argmin(temp);
         }
-        return std::move(result);
+        return centroids;
     }
 
-    // generates new centroids as the centers of clusters
-    blaze::DynamicMatrix<double> kmeans::move_centroids(
-        blaze::DynamicMatrix<double> const& points,
-        blaze::DynamicVector<std::size_t>&& closest,
-        blaze::DynamicMatrix<double>&& centroids,
-        std::size_t num_points, std::size_t num_centroids) const
+    // assign each point to its closest centroid, the distances are computed
+    // block-wise as |x|^2 - 2 x.c + |c|^2, where x.c is a matrix product
+    void kmeans::closest_centroids(points_type const& points,
+        blaze::DynamicMatrix<double> const& centroids,
+        blaze::DynamicVector<std::size_t>& closest) const
     {
-        blaze::DynamicMatrix<double> result(num_centroids, 2, 0.0);
-        std::size_t count;
-        for (size_t k = 0; k != num_centroids; ++k)
+        std::size_t const num_centroids = centroids.rows();
+
+        blaze::DynamicVector<double> centroid_norms(num_centroids);
+        for (std::size_t j = 0; j != num_centroids; ++j)
         {
-            count = 0;
-            for (size_t i = 0; i != num_points; ++i)
-            {
-                if (closest[i] == k)
+            centroid_norms[j] = blaze::sqrNorm(blaze::row(centroids, j));
+        }
+
+        closest.resize(points.rows(), false);
+        detail::for_each_partition(points.rows(),
+            [&](std::size_t, std::size_t first, std::size_t last) {
+                blaze::DynamicMatrix<double> cross;
+                for (std::size_t block = first; block < last;
+                     block += detail::kmeans_block_size)
                 {
-                    blaze::row(result, k) += blaze::row(points, i);
-                    count += 1;
+                    std::size_t size =
+                        (std::min)(detail::kmeans_block_size, last - block);
+
+                    cross = blaze::submatrix(points, block, 0, size,
+                                points.columns()) *
+                        blaze::trans(centroids);
+
+                    for (std::size_t i = 0; i != size; ++i)
+                    {
+                        // |x|^2 is the same for all centroids
+                        std::size_t min_index = 0;
+                        double min_distance =
+                            centroid_norms[0] - 2.0 * cross(i, 0);
+                        for (std::size_t j = 1; j != num_centroids; ++j)
+                        {
+                            double d = centroid_norms[j] - 2.0 * cross(i, j);
+                            if (d < min_distance)
+                            {
+                                min_distance = d;
+                                min_index = j;
+                            }
+                        }
+                        closest[block + i] = min_index;
+                    }
                 }
+            });
+    }
+
+    // generates new centroids as the centers of clusters, clusters that end
+    // up without any points keep their previous centroid
+    blaze::DynamicMatrix<double> kmeans::move_centroids(
+        points_type const& points,
+        blaze::DynamicVector<std::size_t> const& closest,
+        blaze::DynamicMatrix<double> const& centroids) const
+    {
+        std::size_t const num_points = points.rows();
+        std::size_t const num_centroids = centroids.rows();
+        std::size_t const num_features = points.columns();
+
+        // accumulate the partial sums of each partition in parallel
+        std::size_t const num_partitions =
+            detail::num_partitions(num_points);
+
+        std::vector<blaze::DynamicMatrix<double>> sums(num_partitions);
+        std::vector<std::vector<std::size_t>> counts(num_partitions);
+
+        detail::for_each_partition(num_points,
+            [&](std::size_t partition, std::size_t first, std::size_t last) {
+                blaze::DynamicMatrix<double>& sum = sums[partition];
+                sum.resize(num_centroids, num_features, false);
+                sum = 0.0;
+
+                std::vector<std::size_t>& count = counts[partition];
+                count.assign(num_centroids, 0);
+
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    blaze::row(sum, closest[i]) += blaze::row(points, i);
+                    ++count[closest[i]];
+                }
+            });
+
+        blaze::DynamicMatrix<double> result(num_centroids, num_features, 0.0);
+        std::vector<std::size_t> count(num_centroids, 0);
+        for (std::size_t p = 0; p != num_partitions; ++p)
+        {
+            if (counts[p].empty())
+            {
+                continue;    // partition was not used
+            }
+
+            result += sums[p];
+            for (std::size_t k = 0; k != num_centroids; ++k)
+            {
+                count[k] += counts[p][k];
+            }
+        }
+
+        for (std::size_t k = 0; k != num_centroids; ++k)
+        {
+            if (count[k] != 0)
+            {
+                blaze::row(result, k) /= static_cast<double>(count[k]);
             }
-            if (count != 0)
+            else
             {
-                blaze::row(result, k) /= count;
+                blaze::row(result, k) = blaze::row(centroids, k);
             }
         }
-        return std::move(result);
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -173,12 +373,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "argument, points, to represent a matrix"));
         }
         auto const points = arg0.matrix();
-        if (points.columns() != 2)
+        if (points.rows() == 0 || points.columns() == 0)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::calculate_kmeans",
                 generate_error_message(
                     "the kmeans algorithm primitive requires for the first "
-                    "argument, points, to have exacty 2 columns"));
+                    "argument, points, to be non-empty"));
         }
 
         std::size_t num_centroids = 3;
@@ -210,7 +410,46 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
         util::set_seed(seed);
 
+        double tolerance = 0.0;
+        if (args.size() > 6 && valid(args[6]))
+        {
+            tolerance = extract_scalar_numeric_value(
+                std::move(args[6]), name_, codename_);
+            if (tolerance < 0.0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans algorithm primitive requires for the "
+                        "tolerance to be non-negative"));
+            }
+        }
+
+        std::string init = "random";
+        if (args.size() > 7 && valid(args[7]))
+        {
+            init = extract_string_value(std::move(args[7]), name_, codename_);
+            if (init != "random" && init != "kmeans++")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans algorithm primitive requires for init "
+                        "to be either 'random' or 'kmeans++'"));
+            }
+        }
+
         std::size_t num_points = points.rows();
+        if (num_centroids > num_points)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::calculate_kmeans",
+                generate_error_message(
+                    "the kmeans algorithm primitive requires for the number "
+                    "of centroids to not exceed the number of points"));
+        }
+
+        blaze::DynamicVector<double> squared_norms =
+            detail::squared_norms(points);
 
         // initializing the centroids
         blaze::DynamicMatrix<double> centroids;
@@ -227,34 +466,57 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "initial_centroids to represent a matrix"));
             }
             centroids = arg5.matrix();
-            if (centroids.columns() != 2 || centroids.rows() != num_centroids)
+            if (centroids.columns() != points.columns() ||
+                centroids.rows() != num_centroids)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "kmeans::calculate_kmeans",
                     generate_error_message(
                         "the kmeans algorithm primitive requires for the "
-                        "initial_centroids to have num_centroids rows and 2 "
-                        "columns"));
+                        "initial_centroids to have num_centroids rows and as "
+                        "many columns as points"));
             }
         }
+        else if (init == "kmeans++")
+        {
+            centroids = initialize_centroids_kmeans_pp(
+                points, squared_norms, num_centroids);
+        }
         else
         {
-            centroids = initialize_centroids(points, num_points, num_centroids);
+            centroids = initialize_centroids(points, num_centroids);
         }
 
         // kmeans calculations
+        double const squared_tolerance = tolerance * tolerance;
+
         blaze::DynamicVector<std::size_t> closest;
         for (std::size_t i = 0; i != iterations; ++i)
         {
-            closest =
-                closest_centroids(points, centroids, num_points, num_centroids);
-            centroids = move_centroids(points, std::move(closest),
-                std::move(centroids), num_points, num_centroids);
+            closest_centroids(points, centroids, closest);
+            blaze::DynamicMatrix<double> new_centroids =
+                move_centroids(points, closest, centroids);
+
+            // determine the largest distance any of the centroids has moved
+            double max_shift = 0.0;
+            for (std::size_t k = 0; k != num_centroids; ++k)
+            {
+                max_shift = (std::max)(max_shift,
+                    blaze::sqrNorm(blaze::row(new_centroids, k) -
+                        blaze::row(centroids, k)));
+            }
+
+            centroids = std::move(new_centroids);
             if (show_result)
             {
                 std::cout << "centroids after iteration " << i << ": "
                           << centroids << std::endl;
             }
+
+            if (max_shift <= squared_tolerance)
+            {
+                break;    // converged
+            }
         }
 
         return primitive_argument_type{std::move(centroids)};
@@ -265,12 +527,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 6)
+        if (operands.empty() || operands.size() > 8)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::eval",
                 generate_error_message(
                     "the kmeans algorithm primitive requires at least one and "
-                    "at most 6 operands"));
+                    "at most 8 operands"));
         }
 
         if (!valid(operands[0]))
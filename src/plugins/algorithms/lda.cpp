@@ -4,7 +4,10 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
 #include <phylanx/plugins/algorithms/lda.hpp>
+#include <phylanx/plugins/algorithms/lda_trainer.hpp>
+#include <phylanx/util/random.hpp>
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
@@ -17,6 +20,7 @@
 #include <memory>
 #include <numeric>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -29,24 +33,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const lda_trainer::match_data =
         {hpx::make_tuple("lda_trainer",
             std::vector<std::string>{
-                "lda_trainer(_1, _2, _3, _4, _5)"},
+                "lda_trainer(_1, _2, _3, _4, _5, __arg(_6_seed, nil), "
+                    "__arg(_7_format, \"coo\"))"},
             &create_lda_trainer, &create_primitive<lda_trainer>,
-            "n_topics, alpha, beta, iters, word_doc_matrix\n"
+            "n_topics, alpha, beta, iters, word_doc_matrix, seed, format\n"
             "Args:\n"
             "\n"
             "    n_topics (integer): number of topics to compute\n"
             "    alpha (float): alpha parameter\n"
             "    beta (float): beta parameter\n"
             "    iters (integer): the number of iterations\n"
-            "    word_doc_matrix (2x2 matrix float): word-document histogram,\n"
-            "    words are columns, documents are rows\n"
+            "    word_doc_matrix (matrix or list): word-document histogram,\n"
+            "        words are columns, documents are rows, or the non-zero\n"
+            "        entries of it as list(docs, words, counts[, shape])\n"
+            "        (format 'coo') or list(offsets, words, counts[, shape])\n"
+            "        (format 'csr')\n"
+            "    seed (integer, optional): the seed of the random number\n"
+            "        generator, the global seed is used if not given\n"
+            "    format (string, optional): the format of a sparse\n"
+            "        word_doc_matrix, either 'coo' (default) or 'csr'\n"
             "\n"
             "Returns:\n"
             "\n"
             "The algorithm returns a list of two matrices:\n"
             "    [word_topic, document_topic] :\n"
             "\n"
-            "word_topic: document-topic assignment matrix\n"
+            "word_topic: word-topic assignment matrix\n"
             "document_topic: document-topic assignment matrix\n"
             "\n"
         )};
@@ -63,23 +75,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type && args) const
     {
         // extract arguments
-        auto arg1 = extract_numeric_value(args[0], name_, codename_);
-        if (arg1.num_dimensions() != 2)
+        auto topics = extract_scalar_integer_value(args[0], name_, codename_);
+        if (topics <= 0)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the first "
-                    "argument ('n_topics') to represent a matrix"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "first argument ('n_topics') to be positive"));
         }
-        auto topics = arg1.scalar();
 
         auto arg2 = extract_numeric_value(args[1], name_, codename_);
         if (arg2.num_dimensions() != 0)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('alpha') to represent a scalar"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "second argument ('alpha') to represent a scalar"));
         }
         auto alpha = arg2.scalar();
 
@@ -88,67 +99,58 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('beta') to represent a scalar"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "third argument ('beta') to represent a scalar"));
         }
         auto beta = arg3.scalar();
 
-        auto iterations = extract_scalar_integer_value(args[3], name_, codename_);
+        auto iterations =
+            extract_scalar_integer_value(args[3], name_, codename_);
 
-        // this is the word-count matrix
-        //
-
-        using namespace execution_tree;
-
-        auto arg5 = extract_numeric_value(args[4], name_, codename_);
-
-/*
-        // what about a local matrix
-        if (arg5.has_annotation())
+        // this is the word-count matrix, documents are rows
+        lda_corpus corpus;
+        if (is_list_operand_strict(args[4]))
         {
-            // is distributed, run distributed algo logic
-            //execution_tree::localities_information wcm_localities =
-            //    extract_localities_information(args[4], name_, codename_);
-            // distributed lda!
-            //
-            if(wcm_localities.locality_.num_localities_ > 1) {
-
-                util::distributed_matrix<double> dist_word_doc_mat(
-                    wcm_localities.annotation_.name_,
-                    word_doc_mat,
-                    wcm_localities,
-                    wcm_localities.locality_.locality_id_
-                );
-
-                auto result =
-                    trainer(dist_word_doc_mat, topics, iterations, wcm_localities);
- 
-                return primitive_argument_type
-                {
-                    primitive_arguments_type{
-                        ir::node_data<double>{std::move(std::get<0>(result))},
-                        ir::node_data<double>{std::move(std::get<1>(result))}
-                    }
-                };
+            std::string format = "coo";
+            if (args.size() > 6 && valid(args[6]))
+            {
+                format = extract_string_value(args[6], name_, codename_);
             }
+            corpus = detail::als_ratings_from_list(
+                std::move(args[4]), format, name_, codename_);
         }
-*/
-
-        if (arg5.num_dimensions() > 0)
+        else
         {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
-                generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('word_doc_mat') to represent a matrix"));
+            auto arg5 = extract_numeric_value(args[4], name_, codename_);
+            if (arg5.num_dimensions() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
+                    generate_error_message(
+                        "the lda_trainer algorithm primitive requires for the "
+                        "fifth argument ('word_doc_mat') to represent a "
+                        "matrix or a list of sparse word counts"));
+            }
+            corpus = detail::als_ratings_from_matrix(arg5.matrix());
         }
-        auto word_doc_mat = arg5.matrix();
 
-        using lda_trainer_t =
-            phylanx::execution_tree::primitives::lda_trainer_impl;
+        // an explicit seed gives the same topics regardless of how many
+        // random numbers were drawn before
+        std::uint32_t seed = util::get_seed();
+        std::uint64_t stream = 0;
+        if (args.size() > 5 && valid(args[5]))
+        {
+            seed = static_cast<std::uint32_t>(
+                extract_scalar_integer_value(args[5], name_, codename_));
+            stream = util::random_stream("lda_trainer");
+        }
+        else
+        {
+            stream = util::next_random_stream(name_);
+        }
 
-        lda_trainer_t trainer(alpha, beta);
+        lda_trainer_impl trainer(alpha, beta);
 
-        auto result = trainer(word_doc_mat, topics, iterations);
+        auto result = trainer(corpus, topics, iterations, seed, stream);
 
         return primitive_argument_type
         {
@@ -162,19 +164,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<primitive_argument_type> lda_trainer::eval(
         primitive_arguments_type const& operands,
-        primitive_arguments_type const& args) const
+        primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 5)
+        if (operands.size() < 5 || operands.size() > 7)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "lda_trainer::eval",
                 generate_error_message("the lda_trainer algorithm primitive "
-                                       "requires exactly "
-                                       "five operands"));
+                                       "requires between five and seven "
+                                       "operands"));
         }
 
         bool arguments_valid = true;
-        for (std::size_t i = 0; i != operands.size(); ++i)
+        for (std::size_t i = 0; i != 5; ++i)
         {
             if (!valid(operands[i]))
             {
@@ -200,18 +202,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return this_->calculate_lda_trainer(std::move(args));
                 }),
             detail::map_operands(
-                operands, functional::value_operand{}, args, name_, codename_));
-    }
-
-/*
-    hpx::future<primitive_argument_type> lda_trainer::eval(
-        primitive_arguments_type const& args) const
-    {
-        if (this->no_operands())
-        {
-            return eval(args, noargs);
-        }
-        return eval(this->operands(), args);
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
     }
-*/
 }}}
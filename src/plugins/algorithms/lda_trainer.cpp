@@ -3,188 +3,375 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
-#include "phylanx/plugins/algorithms/lda_trainer.hpp"
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/algorithms/als_engine.hpp>
+#include <phylanx/plugins/algorithms/lda_trainer.hpp>
+#include <phylanx/util/philox_engine.hpp>
+#include <phylanx/util/random.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-/////////////////////////////////////////////////////////////////////
-REGISTER_DISTRIBUTED_MATRIX_DECLARATION(double);
+#include <blaze/Math.h>
 
 /////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives {
 
-// https://bitbucket.org/blaze-lib/blaze/issues/158/random-number-distributions
-//
-template< typename Rand    // Random number generator
-        , typename Dist >  // Random distribution
-decltype(auto) random( size_t size, Rand& rand, Dist& dist ) {
-  return blaze::generate( size, [&rand,&dist]( size_t ){
-     return dist( rand );
-  } );
+namespace {
+
+// number of tokens sampled by one shard of the documents, this doesn't
+// depend on the number of threads to keep the results reproducible
+std::size_t lda_shard_tokens() {
+    static std::size_t tokens = []() -> std::size_t {
+        std::size_t size = std::stoul(
+            hpx::get_config_entry("phylanx.lda.shard_tokens", "16384"));
+        return size != 0 ? size : 16384;
+    }();
+    return tokens;
 }
 
-void lda_trainer_impl::gibbs(
-    const blaze::DynamicMatrix<double> & word_doc_mat,
-    const double alpha,
-    const double beta,
-    blaze::DynamicVector<std::int64_t> & z,
-    blaze::DynamicMatrix<double> & wp0,
-    blaze::DynamicMatrix<double> & dp,
-    blaze::DynamicVector<double, blaze::rowVector> & ztot) {
-
-    const std::int64_t D = word_doc_mat.rows();
-    const std::int64_t W = word_doc_mat.columns();
-    const std::int64_t T = z.size();
-
-    const double wbeta = static_cast<double>(W) * beta;
-    blaze::DynamicMatrix<double> wp(W, T);
-    wp = wp0;
-
-    blaze::DynamicVector<double> lhs(T), rhs(T), zprob(T), probs(T);
-
-    using row_iterator =
-        blaze::DynamicMatrix<double, blaze::rowMajor>::Iterator;
-
-    using vec_iterator =
-        blaze::DynamicVector<double>::Iterator;
-
-    // N (total instance count of words) == sum(word_doc_mat)
-    std::int64_t n = 0;
-
-    for(std::int64_t d = 0; d < D; ++d) {
-        for(std::int64_t w = 0; w < W; ++w) {
+using count_t = std::uint32_t;
+
+struct lda_topic_count {
+    count_t topic;
+    count_t count;
+};
+
+// non-zero word-topic counts, the entries of word w are offsets[w] to
+// offsets[w + 1], sorted by decreasing count
+struct lda_word_topics {
+    std::vector<std::size_t> offsets;
+    std::vector<lda_topic_count> entries;
+};
+
+void lda_build_word_topics(
+    const std::vector<count_t> & word_topic,
+    const std::size_t W,
+    const std::size_t T,
+    lda_word_topics & result) {
+
+    result.offsets.assign(W + 1, 0);
+    hpx::for_loop(hpx::execution::par, std::size_t(0), W,
+        [&](std::size_t w) {
+            const count_t* counts = word_topic.data() + w * T;
+            result.offsets[w + 1] = static_cast<std::size_t>(
+                std::count_if(counts, counts + T,
+                    [](count_t c) { return c != 0; }));
+        });
+
+    std::partial_sum(result.offsets.begin(), result.offsets.end(),
+        result.offsets.begin());
+    result.entries.resize(result.offsets[W]);
+
+    hpx::for_loop(hpx::execution::par, std::size_t(0), W,
+        [&](std::size_t w) {
+            const count_t* counts = word_topic.data() + w * T;
+            auto first = result.entries.begin() + result.offsets[w];
+            auto out = first;
+            for(std::size_t t = 0; t != T; ++t) {
+                if(counts[t] != 0) {
+                    *out++ = lda_topic_count{
+                        static_cast<count_t>(t), counts[t]};
+                }
+            }
+            std::sort(first, out,
+                [](const lda_topic_count& lhs, const lda_topic_count& rhs) {
+                    return lhs.count > rhs.count;
+                });
+        });
+}
 
-            const auto wdf =
-                static_cast<std::int64_t>(word_doc_mat(d, w));
+// word-topic count changes of one shard (indices into the W x T counts)
+struct lda_shard_changes {
+    std::vector<std::size_t> removed;
+    std::vector<std::size_t> added;
+};
 
-            if(wdf < 1) { continue; }
+} // end anonymous namespace
 
-            for(std::int64_t f = 0; f < wdf; ++f) {
+using dmatrix_t = blaze::DynamicMatrix<double>;
 
-                std::int64_t t = z[n];
-                --ztot[t];
-                --wp(w, t);
-                --dp(d, t);
+std::tuple<dmatrix_t, dmatrix_t> lda_trainer_impl::operator()(
+    const lda_corpus & corpus,
+    const std::int64_t T,
+    const std::int64_t iter,
+    const std::uint32_t seed,
+    const std::uint64_t stream) {
+
+    const std::size_t D = corpus.rows();
+    const std::size_t W = corpus.columns();
+    const std::size_t topics = static_cast<std::size_t>(T);
+
+    // expand the word counts into tokens, document d holds the tokens
+    // token_offsets[d] to token_offsets[d + 1]
+    std::vector<std::size_t> token_offsets(D + 1, 0);
+    for(std::size_t d = 0; d != D; ++d) {
+        std::size_t tokens = 0;
+        for(std::size_t e = corpus.offsets_[d];
+            e != corpus.offsets_[d + 1]; ++e) {
+            if(corpus.values_[e] >= 1.0) {
+                tokens += static_cast<std::size_t>(corpus.values_[e]);
+            }
+        }
+        token_offsets[d + 1] = token_offsets[d] + tokens;
+    }
 
-                row_iterator wp_beg = wp.begin(w);
-                row_iterator wp_end = wp.end(w);
+    const std::size_t N = token_offsets[D];
+
+    std::vector<count_t> token_words(N);
+    hpx::for_loop(hpx::execution::par, std::size_t(0), D,
+        [&](std::size_t d) {
+            std::size_t n = token_offsets[d];
+            for(std::size_t e = corpus.offsets_[d];
+                e != corpus.offsets_[d + 1]; ++e) {
+                if(corpus.values_[e] < 1.0) { continue; }
+                const auto wdf = static_cast<std::size_t>(corpus.values_[e]);
+                std::fill_n(token_words.begin() + n, wdf,
+                    static_cast<count_t>(corpus.indices_[e]));
+                n += wdf;
+            }
+        });
+
+    // random initial topics, the engines of the sweeps below use the
+    // offsets following the ones of the tokens
+    std::vector<count_t> z(N);
+    util::parallel_random_fill(
+        std::uniform_int_distribution<count_t>(0, count_t(topics - 1)), N,
+        [&](std::uniform_int_distribution<count_t>& dist, std::size_t i) {
+            z[i] = util::random_value(dist, seed, stream, i);
+        });
+
+    std::vector<count_t> doc_topic(D * topics, 0);
+    hpx::for_loop(hpx::execution::par, std::size_t(0), D,
+        [&](std::size_t d) {
+            for(std::size_t i = token_offsets[d];
+                i != token_offsets[d + 1]; ++i) {
+                ++doc_topic[d * topics + z[i]];
+            }
+        });
 
-                std::transform(wp_beg, wp_end, lhs.begin(),
-                    [&beta](const auto& val) {
-                        return val + beta;
-                });
+    std::vector<count_t> word_topic(W * topics, 0);
+    std::vector<std::int64_t> topic_totals(topics, 0);
+    for(std::size_t i = 0; i != N; ++i) {
+        ++word_topic[token_words[i] * topics + z[i]];
+        ++topic_totals[z[i]];
+    }
 
-                row_iterator dp_beg = dp.begin(d);
-                row_iterator dp_end = dp.end(d);
+    // split the documents into shards of roughly the same number of tokens
+    const std::size_t shard_tokens = lda_shard_tokens();
+    const std::size_t shards = (std::max)(std::size_t(1),
+        (N + shard_tokens - 1) / shard_tokens);
+
+    std::vector<std::size_t> bounds(shards + 1, D);
+    bounds[0] = 0;
+    for(std::size_t p = 1; p != shards; ++p) {
+        const std::size_t target = p * N / shards;
+        bounds[p] = static_cast<std::size_t>(
+            std::lower_bound(token_offsets.begin(),
+                token_offsets.end() - 1, target) - token_offsets.begin());
+        bounds[p] = (std::max)(bounds[p], bounds[p - 1]);
+    }
 
-                std::transform(dp_beg, dp_end, rhs.begin(),
-                    [&alpha](const auto& val) {
-                        return val + alpha;
-                });
+    const double wbeta = static_cast<double>(W) * beta;
+    const double alpha_beta = alpha * beta;
 
-                vec_iterator ztot_beg = ztot.begin();
-                vec_iterator ztot_end = ztot.end();
+    std::vector<double> inv_totals(topics);
+    std::vector<lda_shard_changes> changes(shards);
+    lda_word_topics word_topics;
 
-                std::transform(ztot_beg, ztot_end, zprob.begin(),
-                    [&wbeta](const auto& val) {
-                        return val + wbeta;
-                });
+    for(std::int64_t i = 0; i < iter; ++i) {
 
-                probs = (lhs * ( rhs / zprob ));
+        // all shards sample against the counts of the start of the sweep
+        lda_build_word_topics(word_topic, W, topics, word_topics);
 
-                double max_prob = std::abs(rand() / (RAND_MAX + 1.0)) *
-                    (*std::max_element(probs.begin(), probs.end())) * 2.0;
+        double s_total = 0.0;
+        for(std::size_t t = 0; t != topics; ++t) {
+            inv_totals[t] =
+                1.0 / (static_cast<double>(topic_totals[t]) + wbeta);
+            s_total += alpha_beta * inv_totals[t];
+        }
 
-                t = static_cast<std::int64_t>(
-                    std::abs(rand() / (RAND_MAX + 1.0)) * T);
+        hpx::for_loop(hpx::execution::par, std::size_t(0), shards,
+            [&](std::size_t p) {
+                util::philox_engine gen(seed, stream,
+                    N + static_cast<std::size_t>(i) * shards + p);
+                std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+                lda_shard_changes& delta = changes[p];
+                delta.removed.clear();
+                delta.added.clear();
+
+                // (n_dt + alpha) / (n_t + W beta), only the topics of the
+                // current document differ from alpha / (n_t + W beta)
+                std::vector<double> coeff(topics);
+                for(std::size_t t = 0; t != topics; ++t) {
+                    coeff[t] = alpha * inv_totals[t];
+                }
 
-                while(max_prob > 1e-10) {
-                    max_prob -= probs[t];
-                    t = ((t+1) % T);
+                std::vector<double> q(topics);
+                std::vector<count_t> doc_topics;
+                doc_topics.reserve(topics);
+                std::vector<std::size_t> position(topics);
+
+                for(std::size_t d = bounds[p]; d != bounds[p + 1]; ++d) {
+
+                    count_t* ndt = doc_topic.data() + d * topics;
+
+                    // r bucket: sum of n_dt beta / (n_t + W beta)
+                    double r_total = 0.0;
+                    doc_topics.clear();
+                    for(std::size_t t = 0; t != topics; ++t) {
+                        if(ndt[t] == 0) { continue; }
+                        position[t] = doc_topics.size();
+                        doc_topics.push_back(static_cast<count_t>(t));
+                        coeff[t] = (ndt[t] + alpha) * inv_totals[t];
+                        r_total += ndt[t] * beta * inv_totals[t];
+                    }
+
+                    for(std::size_t n = token_offsets[d];
+                        n != token_offsets[d + 1]; ++n) {
+
+                        const count_t w = token_words[n];
+                        const count_t old = z[n];
+
+                        r_total -= beta * inv_totals[old];
+                        if(--ndt[old] == 0) {
+                            const count_t last = doc_topics.back();
+                            doc_topics[position[old]] = last;
+                            position[last] = position[old];
+                            doc_topics.pop_back();
+                        }
+                        coeff[old] = (ndt[old] + alpha) * inv_totals[old];
+
+                        // the counts of the start of the sweep still hold
+                        // this token, correct the terms of its old topic
+                        const double inv_old = 1.0 /
+                            (static_cast<double>(topic_totals[old]) - 1.0 +
+                                wbeta);
+                        const double inv_diff = inv_old - inv_totals[old];
+
+                        const double s = s_total + alpha_beta * inv_diff;
+                        const double r =
+                            r_total + ndt[old] * beta * inv_diff;
+
+                        // q bucket: sum of n_wt (n_dt + alpha) / (n_t + W beta)
+                        const std::size_t first = word_topics.offsets[w];
+                        const std::size_t count =
+                            word_topics.offsets[w + 1] - first;
+                        const lda_topic_count* entries =
+                            word_topics.entries.data() + first;
+
+                        double q_total = 0.0;
+                        for(std::size_t k = 0; k != count; ++k) {
+                            if(entries[k].topic == old) {
+                                q[k] = (entries[k].count - 1.0) *
+                                    (ndt[old] + alpha) * inv_old;
+                            }
+                            else {
+                                q[k] = entries[k].count *
+                                    coeff[entries[k].topic];
+                            }
+                            q_total += q[k];
+                        }
+
+                        // pick the bucket, then the topic inside it
+                        double u = uniform(gen) * (s + r + q_total);
+                        count_t topic = old;
+
+                        if(u < q_total) {
+                            for(std::size_t k = 0; k != count; ++k) {
+                                if(q[k] == 0.0) { continue; }
+                                topic = entries[k].topic;
+                                if((u -= q[k]) < 0.0) { break; }
+                            }
+                        }
+                        else if((u -= q_total) < r) {
+                            for(const count_t t : doc_topics) {
+                                topic = t;
+                                u -= ndt[t] * beta *
+                                    (t == old ? inv_old : inv_totals[t]);
+                                if(u < 0.0) { break; }
+                            }
+                        }
+                        else {
+                            u -= r;
+                            for(std::size_t t = 0; t != topics; ++t) {
+                                topic = static_cast<count_t>(t);
+                                u -= alpha_beta *
+                                    (t == old ? inv_old : inv_totals[t]);
+                                if(u < 0.0) { break; }
+                            }
+                        }
+
+                        r_total += beta * inv_totals[topic];
+                        if(ndt[topic]++ == 0) {
+                            position[topic] = doc_topics.size();
+                            doc_topics.push_back(topic);
+                        }
+                        coeff[topic] = (ndt[topic] + alpha) * inv_totals[topic];
+
+                        if(topic != old) {
+                            z[n] = topic;
+                            delta.removed.push_back(w * topics + old);
+                            delta.added.push_back(w * topics + topic);
+                        }
+                    }
+
+                    for(const count_t t : doc_topics) {
+                        coeff[t] = alpha * inv_totals[t];
+                    }
                 }
+            });
 
-                z[n] = t;
-                ++ztot[t];
-                ++wp(w, t);
-                ++dp(d, t);
-                ++n;
+        // merge the changes of all shards
+        for(const lda_shard_changes& delta : changes) {
+            for(const std::size_t k : delta.removed) {
+                --word_topic[k];
+                --topic_totals[k % topics];
+            }
+            for(const std::size_t k : delta.added) {
+                ++word_topic[k];
+                ++topic_totals[k % topics];
             }
         }
     }
-}
 
-using dmatrix_t = blaze::DynamicMatrix<double>;
-using dvector_t = blaze::DynamicVector<double>;
-using i64vector_t = blaze::DynamicVector<std::int64_t>;
-
-std::tuple<dmatrix_t, dmatrix_t> lda_trainer_impl::operator()(
-    const dmatrix_t & word_doc_mat,
-    const std::int64_t T,
-    const std::int64_t iter) {
-
-    const std::int64_t D = word_doc_mat.rows();
-    const std::int64_t W = word_doc_mat.columns();
-    const std::int64_t N =
-        static_cast<std::int64_t>(blaze::sum(word_doc_mat));
-
-    dmatrix_t wp(W, T); // this component stores information that
-                            // contains a distributed reduce and scatter
-                            //
-    dmatrix_t dp(D, T); // this component is distributed, but unchanging
-    i64vector_t z(N);
-
-    {
-        // values near the mean are the most likely
-        // standard deviation affects the dispersion of generated values from the mean
-        {
-            std::random_device rd{};
-            std::default_random_engine eng{rd()};
-            std::uniform_int_distribution<> dist(0, T-1);
-            z = random(N, eng, dist);
-        }
-
-        blaze::DynamicVector<double, blaze::columnwise> word_index_pos;
-        blaze::DynamicVector<double, blaze::rowwise> doc_index_pos;
-
-        word_index_pos = blaze::sum<blaze::rowwise>(word_doc_mat);
-        doc_index_pos = blaze::sum<blaze::columnwise>(word_doc_mat);
-
-        // word and doc topic updates are parallel blocks
-        {
-            std::int64_t k = 0;
-            for(std::int64_t i = 0; i < W; ++i) {
-                for(std::int64_t j = 0; j < word_index_pos[i]; ++j) {
-                    wp(i, z[k]) += 1.0;
-                    ++k;
-                }
-            }
+    dmatrix_t wp(W, topics);
+    for(std::size_t w = 0; w != W; ++w) {
+        for(std::size_t t = 0; t != topics; ++t) {
+            wp(w, t) = word_topic[w * topics + t];
         }
+    }
 
-        {
-            std::int64_t k = 0;
-            for(std::int64_t i = 0; i < D; ++i) {
-                for(std::int64_t j = 0; j < doc_index_pos[i]; ++j) {
-                    dp(i, z[k]) += 1.0;
-                    ++k;
-                }
-            }
+    dmatrix_t dp(D, topics);
+    for(std::size_t d = 0; d != D; ++d) {
+        for(std::size_t t = 0; t != topics; ++t) {
+            dp(d, t) = doc_topic[d * topics + t];
         }
     }
 
-    blaze::DynamicMatrix<double> wp0(W, T);
-    blaze::DynamicVector<double, blaze::rowVector> ztot0; //(T);
+    return std::make_tuple(std::move(wp), std::move(dp));
+}
 
-    for(std::int64_t i = 0; i < iter; ++i) {
-        wp0 = wp;
-        ztot0 = blaze::eval( blaze::sum<blaze::columnwise>(wp0) );
-        // parallel portion
-        //
-        // z, wp, dp
-        //
-        gibbs(word_doc_mat, alpha, beta, z, wp, dp, ztot0);
-        wp = wp0 + (wp - wp0);
-    }
+std::tuple<dmatrix_t, dmatrix_t> lda_trainer_impl::operator()(
+    const dmatrix_t & word_doc_mat,
+    const std::int64_t T,
+    const std::int64_t iter,
+    const std::uint32_t seed,
+    const std::uint64_t stream) {
 
-    return std::make_tuple(wp, dp);
+    return (*this)(detail::als_ratings_from_matrix(word_doc_mat),
+        T, iter, seed, stream);
 }
 
 } } } // end namespaces
@@ -5,14 +5,17 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/lra.hpp>
-#include <phylanx/util/detail/add_simd.hpp>
-#include <phylanx/util/detail/div_simd.hpp>
+#include <phylanx/util/philox_engine.hpp>
+#include <phylanx/util/random.hpp>
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -26,25 +29,129 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        enum class lra_optimizer
+        {
+            sgd,
+            momentum,
+            adam
+        };
+
+        constexpr double lra_momentum = 0.9;
+        constexpr double lra_adam_beta1 = 0.9;
+        constexpr double lra_adam_beta2 = 0.999;
+        constexpr double lra_adam_epsilon = 1e-8;
+
+        // number of rows handled by one partition of the gradient
+        constexpr std::size_t lra_partition_rows = 4096;
+
+        // Calculate the gradient of the log-loss over a range of rows,
+        //
+        //      sum(x_i * (1.0 / (1.0 + exp(-dot(x_i, weights))) - y_i))
+        //
+        // in a single pass over the rows without creating any temporaries
+        // of the size of the range. Larger ranges are split into
+        // partitions that are handled concurrently, the partial results
+        // are added in a fixed order.
+        class lra_gradient_kernel
+        {
+        public:
+            using vector_type = ir::node_data<double>::storage1d_type;
+
+            lra_gradient_kernel(std::size_t columns, std::size_t rows)
+              : partials_(
+                    (rows + lra_partition_rows - 1) / lra_partition_rows,
+                    vector_type(columns))
+            {
+            }
+
+            template <typename Matrix, typename Vector>
+            void operator()(Matrix const& x, Vector const& y,
+                vector_type const& weights, std::size_t first,
+                std::size_t last, vector_type& gradient)
+            {
+                std::size_t const partitions =
+                    (last - first + lra_partition_rows - 1) /
+                    lra_partition_rows;
+
+                if (partitions < 2)
+                {
+                    accumulate(x, y, weights, first, last, gradient);
+                    return;
+                }
+
+                hpx::for_loop(hpx::execution::par, std::size_t(0),
+                    partitions, [&](std::size_t p) {
+                        std::size_t const begin =
+                            first + p * lra_partition_rows;
+                        accumulate(x, y, weights, begin,
+                            (std::min)(last, begin + lra_partition_rows),
+                            partials_[p]);
+                    });
+
+                gradient = partials_[0];
+                for (std::size_t p = 1; p != partitions; ++p)
+                {
+                    gradient += partials_[p];
+                }
+            }
+
+        private:
+            template <typename Matrix, typename Vector>
+            static void accumulate(Matrix const& x, Vector const& y,
+                vector_type const& weights,
+                std::size_t first, std::size_t last, vector_type& gradient)
+            {
+                gradient = 0.0;
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    auto row = blaze::row(x, i);
+                    double const pred =
+                        1.0 / (1.0 + std::exp(-(row * weights)));
+                    gradient += (pred - y[i]) * blaze::trans(row);
+                }
+            }
+
+            std::vector<vector_type> partials_;
+        };
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const lra::match_data =
     {
         hpx::make_tuple("lra",
             std::vector<std::string>{
-                "lra(_1, _2, _3, _4, _5)",
-                "lra(_1, _2, _3, _4)"
+                "lra(_1, _2, _3, _4, __arg(_5_enable_output, false), "
+                    "__arg(_6_batch_size, 0), __arg(_7_optimizer, \"sgd\"), "
+                    "__arg(_8_tolerance, 0.0), __arg(_9_seed, nil))"
             },
             &create_lra, &create_primitive<lra>,
-            R"(x, y, alpha, iters, enable_output
+            R"(x, y, alpha, iters, enable_output, batch_size, optimizer,
+                tolerance, seed
             Args:
 
                 x (matrix) : a matrix
                 y (vector) : a vector
             the data
                 alpha (float): It is the learning rate
-                iters (int): The number of iterations
+                iters (int): The number of iterations (epochs, if a
+                    batch_size is given)
                 enable_output (optional, boolean): If enabled, prints out the step
             number and weights during each iteration
+                batch_size (optional, int): The number of consecutive rows
+                    of 'x' used for one update of the weights, the order of
+                    the batches is shuffled for every epoch. Defaults to
+                    zero, which uses all rows for every update (gradient
+                    descent)
+                optimizer (optional, string): The update rule, either
+                    'sgd' (default), 'momentum' (momentum of 0.9) or 'adam'
+                tolerance (optional, float): Stop as soon as no weight
+                    changed by more than this during an iteration. Defaults
+                    to zero, which runs all iterations
+                seed (optional, int): The seed used for shuffling the
+                    batches, the global seed is used if not given
 
             Returns:
 
@@ -106,19 +213,92 @@ namespace phylanx { namespace execution_tree { namespace primitives
             extract_scalar_integer_value(args[3], name_, codename_);
 
         bool enable_output = false;
-        if (args.size() == 5 && valid(args[4]))
+        if (args.size() > 4 && valid(args[4]))
         {
             enable_output =
                 extract_scalar_boolean_value(args[4], name_, codename_) != 0;
         }
 
+        std::size_t batch_size = 0;
+        if (args.size() > 5 && valid(args[5]))
+        {
+            std::int64_t size =
+                extract_scalar_integer_value(args[5], name_, codename_);
+            if (size < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra::eval",
+                    generate_error_message(
+                        "the lra algorithm primitive requires for the "
+                        "batch size to be non-negative"));
+            }
+            batch_size = std::size_t(size);
+        }
+
+        lra_optimizer optimizer = lra_optimizer::sgd;
+        if (args.size() > 6 && valid(args[6]))
+        {
+            std::string name =
+                extract_string_value(args[6], name_, codename_);
+            if (name == "momentum")
+            {
+                optimizer = lra_optimizer::momentum;
+            }
+            else if (name == "adam")
+            {
+                optimizer = lra_optimizer::adam;
+            }
+            else if (name != "sgd")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra::eval",
+                    generate_error_message(
+                        "the lra algorithm primitive supports the "
+                        "optimizers 'sgd', 'momentum', and 'adam' only"));
+            }
+        }
+
+        double tolerance = 0.0;
+        if (args.size() > 7 && valid(args[7]))
+        {
+            tolerance =
+                extract_scalar_numeric_value(args[7], name_, codename_);
+        }
+
         using vector_type = ir::node_data<double>::storage1d_type;
-        using matrix_type = ir::node_data<double>::storage2d_type;
 
         // perform calculations
-        vector_type weights(x.columns(), 0.0);
-        matrix_type transx = blaze::trans(x);
+        std::size_t const rows = x.rows();
+        std::size_t const columns = x.columns();
+        std::size_t const batch =
+            (batch_size == 0 || batch_size > rows) ? rows : batch_size;
+        std::size_t const num_batches =
+            batch == 0 ? 0 : (rows + batch - 1) / batch;
 
+        std::vector<std::size_t> order(num_batches);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+
+        // the batches are shuffled only if there is more than one, don't
+        // consume a random stream otherwise
+        std::uint32_t seed = util::get_seed();
+        std::uint64_t stream = 0;
+        if (args.size() > 8 && valid(args[8]))
+        {
+            seed = static_cast<std::uint32_t>(
+                extract_scalar_integer_value(args[8], name_, codename_));
+            stream = util::random_stream("lra");
+        }
+        else if (num_batches > 1)
+        {
+            stream = util::next_random_stream(name_);
+        }
+
+        vector_type weights(columns, 0.0);
+        vector_type previous(columns);
+        vector_type gradient(columns);
+        vector_type velocity(columns, 0.0);
+        vector_type second_moment(columns, 0.0);
+        lra_gradient_kernel kernel(columns, batch);
+
+        std::int64_t updates = 0;
         for (std::int64_t step = 0; step < iterations; ++step)
         {
             if (enable_output)
@@ -126,13 +306,59 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 hpx::cout << "step: " << step << ", " << weights << std::endl;
             }
 
-            // pred = 1.0 / (1.0 + exp(-dot(x, weights)))
-            auto pred = blaze::map(
-                blaze::map(blaze::exp(-(x * weights)),
-                    util::detail::addnd0d_simd(1.0)),
-                util::detail::div0dnd_simd(1.0));
+            if (num_batches > 1)
+            {
+                util::philox_engine gen(seed, stream, std::uint64_t(step));
+                std::shuffle(order.begin(), order.end(), gen);
+            }
+
+            previous = weights;
+            for (std::size_t b : order)
+            {
+                std::size_t const first = b * batch;
+                kernel(x, y, weights, first, (std::min)(rows, first + batch),
+                    gradient);
+                ++updates;
+
+                switch (optimizer)
+                {
+                case lra_optimizer::sgd:
+                    weights -= alpha * gradient;
+                    break;
 
-            weights = weights - (alpha * (transx * (pred - y)));
+                case lra_optimizer::momentum:
+                    velocity = lra_momentum * velocity + gradient;
+                    weights -= alpha * velocity;
+                    break;
+
+                case lra_optimizer::adam:
+                    {
+                        velocity = lra_adam_beta1 * velocity +
+                            (1.0 - lra_adam_beta1) * gradient;
+                        second_moment = lra_adam_beta2 * second_moment +
+                            (1.0 - lra_adam_beta2) * (gradient * gradient);
+
+                        double const step_size = alpha *
+                            std::sqrt(1.0 -
+                                std::pow(lra_adam_beta2, double(updates))) /
+                            (1.0 - std::pow(lra_adam_beta1, double(updates)));
+
+                        weights -= step_size *
+                            blaze::map(velocity, second_moment,
+                                [](double m, double v) {
+                                    return m /
+                                        (std::sqrt(v) + lra_adam_epsilon);
+                                });
+                    }
+                    break;
+                }
+            }
+
+            if (tolerance > 0.0 && columns != 0 &&
+                blaze::max(blaze::abs(weights - previous)) < tolerance)
+            {
+                break;
+            }
         }
 
         return primitive_argument_type{std::move(weights)};
@@ -143,17 +369,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 4 && operands.size() != 5)
+        if (operands.size() < 4 || operands.size() > 9)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "lra::eval",
                 generate_error_message(
-                    "the lra algorithm primitive requires exactly either "
-                        "four or five operands"));
+                    "the lra algorithm primitive requires between four "
+                        "and nine operands"));
         }
 
         bool arguments_valid = true;
-        for (std::size_t i = 0; i != operands.size(); ++i)
+        for (std::size_t i = 0; i != 4; ++i)
         {
             if (!valid(operands[i]))
             {
@@ -7,10 +7,8 @@
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/arithmetics/cumulative_impl.hpp>
 #include <phylanx/plugins/arithmetics/cumprod.hpp>
+#include <phylanx/plugins/arithmetics/scan_operations.hpp>
 
-#include <hpx/include/parallel_scan.hpp>
-
-#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -45,28 +43,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    namespace detail
-    {
-        struct cumprod_op
-        {
-            template <typename T>
-            static T initial()
-            {
-                return T(1);
-            }
-
-            template <typename InIter, typename OutIter, typename T>
-            OutIter operator()(
-                InIter begin, InIter end, OutIter dest, T init) const
-            {
-                return hpx::parallel::inclusive_scan(
-                    hpx::execution::seq, begin, end, dest,
-                    std::multiplies<>{}, init);
-            }
-        };
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     cumprod::cumprod(primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename)
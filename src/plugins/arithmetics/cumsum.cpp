@@ -6,10 +6,8 @@
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/arithmetics/cumulative_impl.hpp>
 #include <phylanx/plugins/arithmetics/cumsum.hpp>
+#include <phylanx/plugins/arithmetics/scan_operations.hpp>
 
-#include <hpx/include/parallel_scan.hpp>
-
-#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,10 +21,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         match_pattern_type{
             "cumsum",
             std::vector<std::string>{
-                "cumsum(_1_a, __arg(_2_axis, nil), __arg(_3_dtype, nil))"
+                "cumsum(_1_a, __arg(_2_axis, nil), __arg(_3_dtype, nil), "
+                    "__arg(_4_compensated, false))"
             },
             &create_cumsum, &create_primitive<cumsum>, R"(
-            a, axis
+            a, axis, dtype, compensated
             Args:
 
                 a (array_like) : input array
@@ -35,6 +34,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     the flattened array.
                 dtype (nil, optional) : the data-type of the returned array,
                   defaults to dtype of input arrays.
+                compensated (bool, optional) : use compensated (Kahan)
+                  summation for floating point data, which keeps the rounding
+                  errors of long sequences bounded, defaults to False.
 
             Returns:
 
@@ -42,28 +44,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    namespace detail
-    {
-        struct cumsum_op
-        {
-            template <typename T>
-            static T initial()
-            {
-                return T(0);
-            }
-
-            template <typename InIter, typename OutIter, typename T>
-            OutIter operator()(
-                InIter begin, InIter end, OutIter dest, T init) const
-            {
-                return hpx::parallel::inclusive_scan(
-                    hpx::execution::seq, begin, end, dest,
-                    std::plus<>{}, init);
-            }
-        };
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     cumsum::cumsum(primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename)
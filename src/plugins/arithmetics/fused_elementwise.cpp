@@ -0,0 +1,625 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/arithmetics/fused_elementwise.hpp>
+
+#include <hpx/assert.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const fused_elementwise::match_data =
+    {
+        match_pattern_type{"__fused",
+            std::vector<std::string>{"__fused(_1, _2, __3)"},
+            &create_fused_elementwise, &create_primitive<fused_elementwise>,
+            R"(
+            program, fallback, *leaves
+            Args:
+
+                program (string) : the fused expression in postfix notation
+                fallback (expression) : the equivalent unfused expression
+                *leaves (arrays) : the operands of the fused expression
+
+            Returns:
+
+            The result of evaluating the fused chain of element-wise
+            operations. This primitive is generated by the compiler and is
+            not meant to be used directly.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // number of elements processed at once for each of the nodes of the
+        // fused expression, the intermediate values stay in the L1 cache
+        constexpr std::size_t const fused_block_size = 256;
+
+        // minimal number of blocks evaluated by each of the concurrently
+        // running tasks
+        constexpr std::size_t const fused_parallel_blocks = 64;
+
+#define PHYLANX_FUSED_UNARY_FUNCTION(name, expr)                               \
+    {                                                                          \
+        name, [](double* dest, double const* src, std::size_t count) {         \
+            for (std::size_t i = 0; i != count; ++i)                           \
+            {                                                                  \
+                double const m = src[i];                                       \
+                dest[i] = (expr);                                              \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+    /**/
+
+        std::map<std::string, fused_elementwise::unary_function_ptr> const&
+        get_fused_unary_functions()
+        {
+            static std::map<std::string,
+                fused_elementwise::unary_function_ptr> const functions = {
+                PHYLANX_FUSED_UNARY_FUNCTION("__minus", -m),
+                PHYLANX_FUSED_UNARY_FUNCTION("absolute", blaze::abs(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("floor", blaze::floor(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("ceil", blaze::ceil(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("trunc", blaze::trunc(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("rint", blaze::round(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("sqrt", blaze::sqrt(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("invsqrt", blaze::invsqrt(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("cbrt", blaze::cbrt(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("invcbrt", blaze::invcbrt(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("exp", blaze::exp(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("exp2", blaze::exp2(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("exp10", blaze::pow(10.0, m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("log", blaze::log(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("log2", blaze::log2(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("log10", blaze::log10(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("sin", blaze::sin(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("cos", blaze::cos(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("tan", blaze::tan(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("sinh", blaze::sinh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("cosh", blaze::cosh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("tanh", blaze::tanh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arcsin", blaze::asin(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arccos", blaze::acos(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arctan", blaze::atan(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arcsinh", blaze::asinh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arccosh", blaze::acosh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("arctanh", blaze::atanh(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("erf", blaze::erf(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("erfc", blaze::erfc(m)),
+                PHYLANX_FUSED_UNARY_FUNCTION("square", m * m),
+                PHYLANX_FUSED_UNARY_FUNCTION("sign", blaze::sign(m)),
+            };
+            return functions;
+        }
+
+#undef PHYLANX_FUSED_UNARY_FUNCTION
+
+        // unary functions that retain the data type of their argument (all
+        // other functions always produce floating point results)
+        bool fused_function_retains_type(std::string const& funcname)
+        {
+            static std::set<std::string> const functions = {
+                "__minus", "absolute", "square", "sign"};
+            return functions.find(funcname) != functions.end();
+        }
+
+        std::map<std::string,
+            fused_elementwise::instruction::opcode_type> const&
+        get_fused_binary_operations()
+        {
+            using instruction = fused_elementwise::instruction;
+
+            static std::map<std::string, instruction::opcode_type> const
+                operations = {
+                    {"__add", instruction::add},
+                    {"__sub", instruction::sub},
+                    {"__mul", instruction::mul},
+                    {"__div", instruction::div},
+                    {"maximum", instruction::maximum},
+                    {"minimum", instruction::minimum},
+                };
+            return operations;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // A leaf of the fused expression is represented either as a scalar
+        // value or as a sequence of contiguous rows of elements.
+        struct fused_operand
+        {
+            double const* data_ = nullptr;
+            std::size_t spacing_ = 0;
+            double value_ = 0.0;
+        };
+
+        fused_operand make_fused_operand(ir::node_data<double> const& data)
+        {
+            fused_operand result;
+            switch (data.num_dimensions())
+            {
+            case 0:
+                result.value_ = data.scalar();
+                break;
+
+            case 1:
+                {
+                    auto v = data.vector();
+                    result.data_ = v.data();
+                }
+                break;
+
+            case 2:
+                {
+                    auto m = data.matrix();
+                    result.data_ = m.data();
+                    result.spacing_ = m.spacing();
+                }
+                break;
+
+            case 3:
+                {
+                    auto t = data.tensor();
+                    result.data_ = t.data();
+                    result.spacing_ = t.spacing();
+                }
+                break;
+
+            default:
+                HPX_ASSERT(false);
+                break;
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void apply_binary_operation(
+            fused_elementwise::instruction::opcode_type opcode, double* dest,
+            double const* lhs, double const* rhs, std::size_t count)
+        {
+            using instruction = fused_elementwise::instruction;
+
+            switch (opcode)
+            {
+            case instruction::add:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = lhs[i] + rhs[i];
+                }
+                break;
+
+            case instruction::sub:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = lhs[i] - rhs[i];
+                }
+                break;
+
+            case instruction::mul:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = lhs[i] * rhs[i];
+                }
+                break;
+
+            case instruction::div:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = lhs[i] / rhs[i];
+                }
+                break;
+
+            case instruction::maximum:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = (blaze::max)(lhs[i], rhs[i]);
+                }
+                break;
+
+            case instruction::minimum:
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dest[i] = (blaze::min)(lhs[i], rhs[i]);
+                }
+                break;
+
+            default:
+                HPX_ASSERT(false);
+                break;
+            }
+        }
+
+        // Evaluate the given program for 'count' consecutive elements of the
+        // given row, the result is written to 'dest'.
+        void evaluate_fused_block(
+            std::vector<fused_elementwise::instruction> const& program,
+            std::vector<fused_operand> const& operands, double* dest,
+            std::size_t row, std::size_t first, std::size_t count,
+            double* scratch, double const** stack)
+        {
+            using instruction = fused_elementwise::instruction;
+
+            std::size_t top = 0;
+            for (auto const& instr : program)
+            {
+                switch (instr.opcode_)
+                {
+                case instruction::load:
+                    {
+                        fused_operand const& op = operands[instr.leaf_];
+                        if (op.data_ == nullptr)
+                        {
+                            double* buffer = scratch + top * fused_block_size;
+                            std::fill(buffer, buffer + count, op.value_);
+                            stack[top] = buffer;
+                        }
+                        else
+                        {
+                            stack[top] = op.data_ + row * op.spacing_ + first;
+                        }
+                        ++top;
+                    }
+                    break;
+
+                case instruction::unary:
+                    {
+                        double* buffer =
+                            scratch + (top - 1) * fused_block_size;
+                        instr.func_(buffer, stack[top - 1], count);
+                        stack[top - 1] = buffer;
+                    }
+                    break;
+
+                default:
+                    {
+                        double* buffer =
+                            scratch + (top - 2) * fused_block_size;
+                        apply_binary_operation(instr.opcode_, buffer,
+                            stack[top - 2], stack[top - 1], count);
+                        stack[top - 2] = buffer;
+                        --top;
+                    }
+                    break;
+                }
+            }
+
+            HPX_ASSERT(top == 1);
+            std::copy(stack[0], stack[0] + count, dest);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    fused_elementwise::fused_elementwise(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , stack_depth_(0)
+    {
+        if (operands_.size() < 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_elementwise::fused_elementwise",
+                generate_error_message(
+                    "the __fused primitive requires at least three operands"));
+        }
+
+        // parse the program, verify its consistency
+        std::istringstream strm(
+            extract_string_value(operands_[0], name_, codename_));
+
+        std::size_t const num_leaves = operands_.size() - 2;
+        std::size_t top = 0;
+
+        std::string token;
+        while (strm >> token)
+        {
+            instruction instr{instruction::load, 0, nullptr, false};
+            if (token[0] == '$')
+            {
+                instr.leaf_ = std::stoul(token.substr(1));
+                if (instr.leaf_ >= num_leaves)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "fused_elementwise::fused_elementwise",
+                        generate_error_message(
+                            "the fused expression refers to a non-existing "
+                            "operand: " + token));
+                }
+                stack_depth_ = (std::max)(stack_depth_, ++top);
+            }
+            else
+            {
+                auto const& binary_ops = detail::get_fused_binary_operations();
+                auto const& unary_funcs = detail::get_fused_unary_functions();
+
+                auto bit = binary_ops.find(token);
+                if (bit != binary_ops.end() && top >= 2)
+                {
+                    instr.opcode_ = bit->second;
+                    --top;
+                }
+                else
+                {
+                    auto uit = unary_funcs.find(token);
+                    if (uit == unary_funcs.end() || top == 0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "fused_elementwise::fused_elementwise",
+                            generate_error_message(
+                                "malformed fused expression, unexpected "
+                                "token: " + token));
+                    }
+                    instr.opcode_ = instruction::unary;
+                    instr.func_ = uit->second;
+                    instr.retains_type_ =
+                        detail::fused_function_retains_type(token);
+                }
+            }
+            program_.push_back(instr);
+        }
+
+        if (top != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_elementwise::fused_elementwise",
+                generate_error_message("malformed fused expression"));
+        }
+
+        // the remaining operands are the leaves of the fused expression
+        fallback_ = std::move(operands_[1]);
+        operands_.erase(operands_.begin(), operands_.begin() + 2);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool fused_elementwise::supports_fused_evaluation(
+        primitive_arguments_type const& leaves) const
+    {
+        std::size_t dims = 0;
+        std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> shape{};
+
+        for (auto const& leaf : leaves)
+        {
+            if (!is_numeric_operand(leaf) || leaf.has_annotation())
+            {
+                return false;
+            }
+
+            std::size_t leaf_dims =
+                extract_numeric_value_dimension(leaf, name_, codename_);
+            if (leaf_dims == 0)
+            {
+                continue;
+            }
+
+            // the fused kernel does not implement broadcasting
+            auto leaf_shape =
+                extract_numeric_value_dimensions(leaf, name_, codename_);
+            if (dims == 0)
+            {
+                if (leaf_dims > 3)
+                {
+                    return false;
+                }
+                dims = leaf_dims;
+                shape = leaf_shape;
+            }
+            else if (dims != leaf_dims || shape != leaf_shape)
+            {
+                return false;
+            }
+        }
+
+        // All operations are performed on floating point values. This is
+        // equivalent to the unfused evaluation as long as no operation is
+        // applied to integer or boolean values only.
+        std::vector<bool> is_float;
+        is_float.reserve(stack_depth_);
+
+        for (auto const& instr : program_)
+        {
+            switch (instr.opcode_)
+            {
+            case instruction::load:
+                is_float.push_back(extract_common_type(leaves[instr.leaf_]) ==
+                    node_data_type_double);
+                break;
+
+            case instruction::unary:
+                if (instr.retains_type_ && !is_float.back())
+                {
+                    return false;
+                }
+                is_float.back() = true;
+                break;
+
+            default:
+                {
+                    bool rhs = is_float.back();
+                    is_float.pop_back();
+                    if (!rhs && !is_float.back())
+                    {
+                        return false;
+                    }
+                    is_float.back() = true;
+                }
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    primitive_argument_type fused_elementwise::fused_evaluation(
+        primitive_arguments_type&& leaves) const
+    {
+        // keep the leaf values alive while the expression is being evaluated
+        std::vector<ir::node_data<double>> values;
+        values.reserve(leaves.size());
+
+        std::vector<detail::fused_operand> fused_operands;
+        fused_operands.reserve(leaves.size());
+
+        std::size_t dims = 0;
+        std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> shape{};
+
+        for (auto&& leaf : leaves)
+        {
+            values.emplace_back(
+                extract_numeric_value(std::move(leaf), name_, codename_));
+            fused_operands.push_back(
+                detail::make_fused_operand(values.back()));
+
+            if (dims == 0 && values.back().num_dimensions() != 0)
+            {
+                dims = values.back().num_dimensions();
+                shape = values.back().dimensions();
+            }
+        }
+
+        // evaluate all rows of the result, block by block. Large results are
+        // split into chunks of blocks that are evaluated concurrently, each
+        // with its own evaluation stack.
+        auto evaluate = [&](double* data, std::size_t spacing,
+                            std::size_t rows, std::size_t columns) {
+            std::size_t const row_blocks =
+                (columns + detail::fused_block_size - 1) /
+                detail::fused_block_size;
+            std::size_t const num_blocks = rows * row_blocks;
+
+            auto evaluate_blocks = [&](std::size_t begin, std::size_t end) {
+                std::vector<double> scratch(
+                    stack_depth_ * detail::fused_block_size);
+                std::vector<double const*> stack(stack_depth_);
+
+                for (std::size_t block = begin; block != end; ++block)
+                {
+                    std::size_t const row = block / row_blocks;
+                    std::size_t const first =
+                        (block % row_blocks) * detail::fused_block_size;
+                    std::size_t const count = (std::min)(
+                        detail::fused_block_size, columns - first);
+
+                    detail::evaluate_fused_block(program_, fused_operands,
+                        data + row * spacing + first, row, first, count,
+                        scratch.data(), stack.data());
+                }
+            };
+
+            std::size_t const num_chunks = (std::min)(
+                std::size_t(hpx::get_os_thread_count()),
+                num_blocks / detail::fused_parallel_blocks);
+            if (num_chunks < 2)
+            {
+                evaluate_blocks(0, num_blocks);
+                return;
+            }
+
+            std::size_t const chunk_size =
+                (num_blocks + num_chunks - 1) / num_chunks;
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+                [&](std::size_t chunk)
+                {
+                    evaluate_blocks(chunk * chunk_size,
+                        (std::min)(num_blocks, (chunk + 1) * chunk_size));
+                });
+        };
+
+        switch (dims)
+        {
+        case 0:
+            {
+                double result = 0.0;
+                evaluate(&result, 0, 1, 1);
+                return primitive_argument_type{result};
+            }
+
+        case 1:
+            {
+                blaze::DynamicVector<double> result(shape[0]);
+                evaluate(result.data(), 0, 1, shape[0]);
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 2:
+            {
+                blaze::DynamicMatrix<double> result(shape[0], shape[1]);
+                evaluate(result.data(), result.spacing(), shape[0], shape[1]);
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 3:
+            {
+                blaze::DynamicTensor<double> result(
+                    shape[0], shape[1], shape[2]);
+                evaluate(result.data(), result.spacing(), shape[0] * shape[1],
+                    shape[2]);
+                return primitive_argument_type{std::move(result)};
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "fused_elementwise::fused_evaluation",
+            generate_error_message(
+                "the fused expression has an unsupported dimensionality"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> fused_elementwise::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "fused_elementwise::eval",
+                generate_error_message(
+                    "the __fused primitive requires at least one leaf "
+                    "operand"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), ctx](primitive_arguments_type&& leaves)
+            ->  hpx::future<primitive_argument_type>
+            {
+                if (this_->supports_fused_evaluation(leaves))
+                {
+                    return hpx::make_ready_future(
+                        this_->fused_evaluation(std::move(leaves)));
+                }
+
+                // otherwise evaluate the equivalent unfused expression, the
+                // leaf values are passed along as its arguments
+                return value_operand(this_->fallback_, std::move(leaves),
+                    this_->name_, this_->codename_, ctx);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, ctx));
+    }
+}}}
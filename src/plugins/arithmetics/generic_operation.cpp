@@ -183,22 +183,33 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                         node_data_type_double;
         }
 
+        // the functions write their result into the operand's storage
+        // unless it refers to a value held elsewhere or had to be converted
+        std::vector<void const*> const operands = {owned_array_data(op)};
+
+        primitive_argument_type result;
         switch (t)
         {
         case node_data_type_int64:
-            return generic1d(
+            result = generic1d(
                 extract_integer_value(std::move(op), name_, codename_));
+            break;
 
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
-            return generic1d(
+            result = generic1d(
                 extract_numeric_value(std::move(op), name_, codename_));
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "generic_operation::generic1d",
+                generate_error_message("operand has unsupported type"));
         }
 
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "generic_operation::generic1d",
-            generate_error_message("operand has unsupported type"));
+        count_result_storage(result, operands);
+        return result;
     }
 
     primitive_argument_type generic_operation::generic2d(
@@ -210,22 +221,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                         node_data_type_double;
         }
 
+        std::vector<void const*> const operands = {owned_array_data(op)};
+
+        primitive_argument_type result;
         switch (t)
         {
         case node_data_type_int64:
-            return generic2d(
+            result = generic2d(
                 extract_integer_value(std::move(op), name_, codename_));
+            break;
 
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
-            return generic2d(
+            result = generic2d(
                 extract_numeric_value(std::move(op), name_, codename_));
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "generic_operation::generic2d",
+                generate_error_message("operand has unsupported type"));
         }
 
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "generic_operation::generic2d",
-            generate_error_message("operand has unsupported type"));
+        count_result_storage(result, operands);
+        return result;
     }
 
     primitive_argument_type generic_operation::generic3d(
@@ -237,22 +257,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                         node_data_type_double;
         }
 
+        std::vector<void const*> const operands = {owned_array_data(op)};
+
+        primitive_argument_type result;
         switch (t)
         {
         case node_data_type_int64:
-            return generic3d(
+            result = generic3d(
                 extract_integer_value(std::move(op), name_, codename_));
+            break;
 
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
-            return generic3d(
+            result = generic3d(
                 extract_numeric_value(std::move(op), name_, codename_));
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "generic_operation::generic3d",
+                generate_error_message("operand has unsupported type"));
         }
 
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "generic_operation::generic3d",
-            generate_error_message("operand has unsupported type"));
+        count_result_storage(result, operands);
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
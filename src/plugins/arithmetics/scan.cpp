@@ -0,0 +1,175 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/plugins/arithmetics/cumulative_impl.hpp>
+#include <phylanx/plugins/arithmetics/scan.hpp>
+#include <phylanx/plugins/arithmetics/scan_operations.hpp>
+
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const scan_operation::match_data =
+    {
+        match_pattern_type{
+            "scan",
+            std::vector<std::string>{
+                "scan(_1_op, _2_a, __arg(_3_axis, nil), __arg(_4_dtype, nil))"
+            },
+            &create_scan_operation, &create_primitive<scan_operation>, R"(
+            op, a, axis, dtype
+            Args:
+
+                op (string) : the operation to accumulate the elements with,
+                  one of 'add', 'multiply', 'maximum', or 'minimum'
+                a (array_like) : input array
+                axis (int, optional) : Axis along which the scan is performed.
+                  The default (None) is to scan the flattened array.
+                dtype (string, optional) : the data-type of the returned array,
+                  defaults to dtype of input arrays.
+
+            Returns:
+
+            Return the inclusive scan of the elements along a given axis, i.e.
+            element `i` of the result is `op` applied to the elements `0`
+            through `i` of the input (`scan("add", a)` is equivalent to
+            `cumsum(a)`, `scan("maximum", a)` is the running maximum).)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    scan_operation::scan_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    primitive_argument_type scan_operation::scan(std::string const& op,
+        primitive_argument_type&& arg,
+        hpx::util::optional<std::int64_t> const& axis) const
+    {
+        ir::node_data<T> value =
+            extract_node_data<T>(std::move(arg), name_, codename_);
+
+        if (op == "add")
+        {
+            return detail::cumulativend<detail::cumsum_op>(
+                std::move(value), axis, false, name_, codename_);
+        }
+        if (op == "multiply")
+        {
+            return detail::cumulativend<detail::cumprod_op>(
+                std::move(value), axis, false, name_, codename_);
+        }
+        if (op == "maximum")
+        {
+            return detail::cumulativend<detail::cummax_op>(
+                std::move(value), axis, false, name_, codename_);
+        }
+        if (op == "minimum")
+        {
+            return detail::cumulativend<detail::cummin_op>(
+                std::move(value), axis, false, name_, codename_);
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "scan_operation::scan",
+            generate_error_message(
+                "the scan primitive requires for its first argument to be "
+                "one of 'add', 'multiply', 'maximum', or 'minimum'"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> scan_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "scan_operation::eval",
+                generate_error_message(
+                    "the scan primitive requires between two and four "
+                    "operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "scan_operation::eval",
+                generate_error_message(
+                    "the scan primitive requires that the arguments given "
+                    "by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_arguments_type&& ops)
+            ->  primitive_argument_type
+            {
+                std::string op = extract_string_value(
+                    std::move(ops[0]), this_->name_, this_->codename_);
+
+                hpx::util::optional<std::int64_t> axis;
+                if (ops.size() >= 3 && valid(ops[2]))
+                {
+                    axis = extract_scalar_integer_value(
+                        std::move(ops[2]), this_->name_, this_->codename_);
+                }
+
+                node_data_type t = node_data_type_unknown;
+                if (ops.size() >= 4 && valid(ops[3]))
+                {
+                    t = map_dtype(extract_string_value(
+                        std::move(ops[3]), this_->name_, this_->codename_));
+                }
+
+                if (t == node_data_type_unknown)
+                {
+                    t = extract_common_type(ops[1]);
+                }
+
+                switch (t)
+                {
+                case node_data_type_bool:
+                    return this_->scan<std::uint8_t>(
+                        op, std::move(ops[1]), axis);
+
+                case node_data_type_int64:
+                    return this_->scan<std::int64_t>(
+                        op, std::move(ops[1]), axis);
+
+                case node_data_type_unknown: HPX_FALLTHROUGH;
+                case node_data_type_double:
+                    return this_->scan<double>(op, std::move(ops[1]), axis);
+
+                default:
+                    break;
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "scan_operation::eval",
+                    this_->generate_error_message(
+                        "target operand has unsupported type"));
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -0,0 +1,685 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/common/conv2d_engine.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace common {
+
+    ///////////////////////////////////////////////////////////////////////////
+    char const* conv2d_backend_name(conv2d_backend backend)
+    {
+        switch (backend)
+        {
+        case conv2d_backend::direct:
+            return "direct";
+        case conv2d_backend::im2col:
+            return "im2col";
+        case conv2d_backend::winograd:
+            return "winograd";
+        default:
+            break;
+        }
+        return "auto";
+    }
+
+    conv2d_backend conv2d_configured_backend()
+    {
+        static conv2d_backend backend = []() {
+            std::string name =
+                hpx::get_config_entry("phylanx.conv2d_backend", "auto");
+            if (name == "direct")
+                return conv2d_backend::direct;
+            if (name == "im2col")
+                return conv2d_backend::im2col;
+            if (name == "winograd")
+                return conv2d_backend::winograd;
+            return conv2d_backend::automatic;
+        }();
+        return backend;
+    }
+
+    conv2d_backend select_conv2d_backend(std::size_t filter_height,
+        std::size_t filter_width, conv2d_parameters const& params,
+        conv2d_backend backend)
+    {
+        if (backend == conv2d_backend::automatic)
+        {
+            backend = conv2d_configured_backend();
+        }
+
+        bool const supports_winograd = filter_height == 3 &&
+            filter_width == 3 && params.stride_height == 1 &&
+            params.stride_width == 1 && params.dilation_height == 1 &&
+            params.dilation_width == 1;
+
+        switch (backend)
+        {
+        case conv2d_backend::direct:
+            return conv2d_backend::direct;
+
+        case conv2d_backend::winograd:
+            return supports_winograd ? conv2d_backend::winograd :
+                                       conv2d_backend::im2col;
+
+        case conv2d_backend::automatic:
+            // the input and output transformations of Winograd pay off only
+            // if there is more than a single output tile
+            if (supports_winograd && params.out_height >= 4 &&
+                params.out_width >= 4)
+            {
+                return conv2d_backend::winograd;
+            }
+            break;
+
+        default:
+            break;
+        }
+        return conv2d_backend::im2col;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using quatern_type = ir::node_data<double>::custom_storage4d_type;
+
+        // Invoke the given function for each batch and for a range of output
+        // channels. The output channels are split into blocks if there are
+        // less batches than worker threads, which keeps all threads busy for
+        // small batches.
+        template <typename F>
+        void for_each_batch_and_channel_block(
+            std::size_t batch, std::size_t out_channels, F&& f)
+        {
+            std::size_t const threads = hpx::get_os_thread_count();
+
+            std::size_t blocks = 1;
+            if (batch < threads && out_channels > 1)
+            {
+                blocks =
+                    (std::min)(out_channels, (threads + batch - 1) / batch);
+            }
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), batch * blocks,
+                [&](std::size_t index) {
+                    std::size_t n = index / blocks;
+                    std::size_t block = index % blocks;
+                    f(n, block * out_channels / blocks,
+                        (block + 1) * out_channels / blocks);
+                });
+        }
+
+        inline bool in_range(std::int64_t index, std::int64_t size)
+        {
+            return index >= 0 && index < size;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void conv2d_direct(quatern_type const& q, quatern_type const& k,
+            conv2d_parameters const& params,
+            blaze::DynamicArray<4UL, double>& result)
+        {
+            auto const in_height = static_cast<std::int64_t>(q.pages());
+            auto const in_width = static_cast<std::int64_t>(q.rows());
+            std::size_t const in_channels = q.columns();
+            std::size_t const filter_height = k.quats();
+            std::size_t const filter_width = k.pages();
+            std::size_t const out_channels = k.columns();
+
+            for_each_batch_and_channel_block(q.quats(), out_channels,
+                [&](std::size_t n, std::size_t first, std::size_t last) {
+                    std::vector<double> acc(last - first);
+                    for (std::size_t i = 0; i != params.out_height; ++i)
+                    {
+                        for (std::size_t j = 0; j != params.out_width; ++j)
+                        {
+                            std::fill(acc.begin(), acc.end(), 0.0);
+                            for (std::size_t a = 0; a != filter_height; ++a)
+                            {
+                                std::int64_t y = i * params.stride_height -
+                                    params.pad_top + a * params.dilation_height;
+                                if (!in_range(y, in_height))
+                                    continue;
+
+                                for (std::size_t b = 0; b != filter_width; ++b)
+                                {
+                                    std::int64_t x = j * params.stride_width -
+                                        params.pad_left +
+                                        b * params.dilation_width;
+                                    if (!in_range(x, in_width))
+                                        continue;
+
+                                    for (std::size_t c = 0; c != in_channels;
+                                         ++c)
+                                    {
+                                        double v = q(n, y, x, c);
+                                        for (std::size_t o = first; o != last;
+                                             ++o)
+                                        {
+                                            acc[o - first] += v * k(a, b, c, o);
+                                        }
+                                    }
+                                }
+                            }
+                            for (std::size_t o = first; o != last; ++o)
+                            {
+                                result(n, i, j, o) = acc[o - first];
+                            }
+                        }
+                    }
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Lower the convolution onto a matrix product: each row of the
+        // (out_height * out_width) x (filter_height * filter_width *
+        // in_channels) patch matrix holds the input elements contributing to
+        // one output pixel. The patch matrix is built for tiles of output
+        // rows that fit into the cache, each tile is multiplied with the
+        // kernels of all output channels at once.
+        //
+        // A tile of the patch matrix holds at most this many elements (256kB,
+        // which leaves room in L2 for the part of the kernel matrix used by
+        // the product).
+        constexpr std::size_t conv2d_im2col_tile_elements = 32768;
+
+        void conv2d_im2col(quatern_type const& q, quatern_type const& k,
+            conv2d_parameters const& params,
+            blaze::DynamicArray<4UL, double>& result)
+        {
+            auto const in_height = static_cast<std::int64_t>(q.pages());
+            auto const in_width = static_cast<std::int64_t>(q.rows());
+            std::size_t const batch = q.quats();
+            std::size_t const in_channels = q.columns();
+            std::size_t const filter_height = k.quats();
+            std::size_t const filter_width = k.pages();
+            std::size_t const out_channels = k.columns();
+
+            std::size_t const patch_size =
+                filter_height * filter_width * in_channels;
+
+            blaze::DynamicMatrix<double> kernel_matrix(
+                patch_size, out_channels);
+            for (std::size_t a = 0; a != filter_height; ++a)
+            {
+                for (std::size_t b = 0; b != filter_width; ++b)
+                {
+                    for (std::size_t c = 0; c != in_channels; ++c)
+                    {
+                        std::size_t row =
+                            (a * filter_width + b) * in_channels + c;
+                        for (std::size_t o = 0; o != out_channels; ++o)
+                        {
+                            kernel_matrix(row, o) = k(a, b, c, o);
+                        }
+                    }
+                }
+            }
+
+            // number of output rows per tile, the tiles are made smaller if
+            // there are not enough of them to keep all threads busy
+            std::size_t tile_rows = (std::max)(std::size_t(1),
+                conv2d_im2col_tile_elements /
+                    (std::max)(std::size_t(1), params.out_width * patch_size));
+
+            std::size_t const threads = hpx::get_os_thread_count();
+            std::size_t const min_tiles =
+                (threads + batch - 1) / (std::max)(batch, std::size_t(1));
+            tile_rows = (std::min)(tile_rows,
+                (std::max)(std::size_t(1), params.out_height / min_tiles));
+
+            std::size_t const tiles =
+                (params.out_height + tile_rows - 1) / tile_rows;
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), batch * tiles,
+                [&](std::size_t index) {
+                    std::size_t const n = index / tiles;
+                    std::size_t const first_row = (index % tiles) * tile_rows;
+                    std::size_t const rows = (std::min)(
+                        tile_rows, params.out_height - first_row);
+
+                    blaze::DynamicMatrix<double> patches(
+                        rows * params.out_width, patch_size, 0.0);
+                    for (std::size_t r = 0; r != rows; ++r)
+                    {
+                        std::size_t const i = first_row + r;
+                        for (std::size_t j = 0; j != params.out_width; ++j)
+                        {
+                            auto patch =
+                                blaze::row(patches, r * params.out_width + j);
+                            for (std::size_t a = 0; a != filter_height; ++a)
+                            {
+                                std::int64_t y = i * params.stride_height -
+                                    params.pad_top + a * params.dilation_height;
+                                if (!in_range(y, in_height))
+                                    continue;
+
+                                for (std::size_t b = 0; b != filter_width; ++b)
+                                {
+                                    std::int64_t x = j * params.stride_width -
+                                        params.pad_left +
+                                        b * params.dilation_width;
+                                    if (!in_range(x, in_width))
+                                        continue;
+
+                                    std::size_t col =
+                                        (a * filter_width + b) * in_channels;
+                                    for (std::size_t c = 0; c != in_channels;
+                                         ++c)
+                                    {
+                                        patch[col + c] = q(n, y, x, c);
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    blaze::DynamicMatrix<double> products =
+                        patches * kernel_matrix;
+
+                    for (std::size_t r = 0; r != rows; ++r)
+                    {
+                        std::size_t const i = first_row + r;
+                        for (std::size_t j = 0; j != params.out_width; ++j)
+                        {
+                            std::size_t row = r * params.out_width + j;
+                            for (std::size_t o = 0; o != out_channels; ++o)
+                            {
+                                result(n, i, j, o) = products(row, o);
+                            }
+                        }
+                    }
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Winograd F(2x2,3x3), see: A. Lavin, S. Gray, "Fast Algorithms for
+        // Convolutional Neural Networks", 2016. The transformed input tiles
+        // are multiplied with the transformed kernel using 16 independent
+        // matrix products.
+        constexpr std::size_t winograd_tile = 4;
+        constexpr std::size_t winograd_elements = winograd_tile * winograd_tile;
+
+        // G g for one column of the kernel (3 elements -> 4 elements)
+        inline void winograd_kernel_transform(double const* g, double* out)
+        {
+            out[0] = g[0];
+            out[1] = 0.5 * (g[0] + g[1] + g[2]);
+            out[2] = 0.5 * (g[0] - g[1] + g[2]);
+            out[3] = g[2];
+        }
+
+        // B^T d for one column of the input tile (4 elements -> 4 elements)
+        inline void winograd_input_transform(double const* d, double* out)
+        {
+            out[0] = d[0] - d[2];
+            out[1] = d[1] + d[2];
+            out[2] = d[2] - d[1];
+            out[3] = d[1] - d[3];
+        }
+
+        // A^T m for one column of the product tile (4 elements -> 2 elements)
+        inline void winograd_output_transform(double const* m, double* out)
+        {
+            out[0] = m[0] + m[1] + m[2];
+            out[1] = m[1] - m[2] - m[3];
+        }
+
+        void conv2d_winograd(quatern_type const& q, quatern_type const& k,
+            conv2d_parameters const& params,
+            blaze::DynamicArray<4UL, double>& result)
+        {
+            auto const in_height = static_cast<std::int64_t>(q.pages());
+            auto const in_width = static_cast<std::int64_t>(q.rows());
+            std::size_t const in_channels = q.columns();
+            std::size_t const out_channels = k.columns();
+
+            std::size_t const tiles_height = (params.out_height + 1) / 2;
+            std::size_t const tiles_width = (params.out_width + 1) / 2;
+            std::size_t const tiles = tiles_height * tiles_width;
+
+            // U = G g G^T, one in_channels x out_channels matrix per element
+            // of the transformed tile
+            std::vector<blaze::DynamicMatrix<double>> u(winograd_elements,
+                blaze::DynamicMatrix<double>(in_channels, out_channels));
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), out_channels,
+                [&](std::size_t o) {
+                    double gt[4][3], tmp[4], col[3];
+                    for (std::size_t c = 0; c != in_channels; ++c)
+                    {
+                        // transform the columns, then the rows
+                        for (std::size_t b = 0; b != 3; ++b)
+                        {
+                            for (std::size_t a = 0; a != 3; ++a)
+                            {
+                                col[a] = k(a, b, c, o);
+                            }
+                            winograd_kernel_transform(col, tmp);
+                            for (std::size_t r = 0; r != 4; ++r)
+                            {
+                                gt[r][b] = tmp[r];
+                            }
+                        }
+                        for (std::size_t r = 0; r != 4; ++r)
+                        {
+                            winograd_kernel_transform(gt[r], tmp);
+                            for (std::size_t s = 0; s != 4; ++s)
+                            {
+                                u[r * winograd_tile + s](c, o) = tmp[s];
+                            }
+                        }
+                    }
+                });
+
+            for_each_batch_and_channel_block(q.quats(), out_channels,
+                [&](std::size_t n, std::size_t first, std::size_t last) {
+                    // V = B^T d B, one tiles x in_channels matrix per element
+                    // of the transformed tile
+                    std::vector<blaze::DynamicMatrix<double>> v(
+                        winograd_elements,
+                        blaze::DynamicMatrix<double>(tiles, in_channels));
+
+                    double d[4][4], dt[4][4], col[4], tmp[4];
+                    for (std::size_t th = 0; th != tiles_height; ++th)
+                    {
+                        for (std::size_t tw = 0; tw != tiles_width; ++tw)
+                        {
+                            std::size_t tile = th * tiles_width + tw;
+                            std::int64_t y0 = 2 * th - params.pad_top;
+                            std::int64_t x0 = 2 * tw - params.pad_left;
+                            for (std::size_t c = 0; c != in_channels; ++c)
+                            {
+                                for (std::size_t r = 0; r != 4; ++r)
+                                {
+                                    for (std::size_t s = 0; s != 4; ++s)
+                                    {
+                                        std::int64_t y = y0 + r;
+                                        std::int64_t x = x0 + s;
+                                        d[r][s] = in_range(y, in_height) &&
+                                                in_range(x, in_width) ?
+                                            q(n, y, x, c) :
+                                            0.0;
+                                    }
+                                }
+
+                                // transform the columns, then the rows
+                                for (std::size_t s = 0; s != 4; ++s)
+                                {
+                                    for (std::size_t r = 0; r != 4; ++r)
+                                    {
+                                        col[r] = d[r][s];
+                                    }
+                                    winograd_input_transform(col, tmp);
+                                    for (std::size_t r = 0; r != 4; ++r)
+                                    {
+                                        dt[r][s] = tmp[r];
+                                    }
+                                }
+                                for (std::size_t r = 0; r != 4; ++r)
+                                {
+                                    winograd_input_transform(dt[r], tmp);
+                                    for (std::size_t s = 0; s != 4; ++s)
+                                    {
+                                        v[r * winograd_tile + s](tile, c) =
+                                            tmp[s];
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    // M = U * V, element-wise over the transformed tile
+                    std::vector<blaze::DynamicMatrix<double>> m(
+                        winograd_elements);
+                    for (std::size_t e = 0; e != winograd_elements; ++e)
+                    {
+                        m[e] = v[e] *
+                            blaze::submatrix(
+                                u[e], 0, first, in_channels, last - first);
+                    }
+
+                    // Y = A^T M A
+                    double mt[2][4], y[2], row[4];
+                    for (std::size_t th = 0; th != tiles_height; ++th)
+                    {
+                        for (std::size_t tw = 0; tw != tiles_width; ++tw)
+                        {
+                            std::size_t tile = th * tiles_width + tw;
+                            for (std::size_t o = first; o != last; ++o)
+                            {
+                                // transform the columns, then the rows
+                                for (std::size_t s = 0; s != 4; ++s)
+                                {
+                                    for (std::size_t r = 0; r != 4; ++r)
+                                    {
+                                        col[r] = m[r * winograd_tile + s](
+                                            tile, o - first);
+                                    }
+                                    winograd_output_transform(col, tmp);
+                                    mt[0][s] = tmp[0];
+                                    mt[1][s] = tmp[1];
+                                }
+                                for (std::size_t r = 0; r != 2; ++r)
+                                {
+                                    std::size_t i = 2 * th + r;
+                                    if (i >= params.out_height)
+                                        break;
+
+                                    std::copy(mt[r], mt[r] + 4, row);
+                                    winograd_output_transform(row, y);
+                                    for (std::size_t s = 0; s != 2; ++s)
+                                    {
+                                        std::size_t j = 2 * tw + s;
+                                        if (j < params.out_width)
+                                        {
+                                            result(n, i, j, o) = y[s];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Transposed convolution as a matrix product followed by scattering
+        // (col2im) the partial products into the result. Input pixel i
+        // contributes to output pixel (i * stride + a * dilation - pad) for
+        // kernel element a.
+        void conv2d_transpose_col2im(quatern_type const& q,
+            quatern_type const& k, conv2d_parameters const& params,
+            blaze::DynamicArray<4UL, double>& result)
+        {
+            std::size_t const in_height = q.pages();
+            std::size_t const in_width = q.rows();
+            std::size_t const in_channels = q.columns();
+            std::size_t const filter_height = k.quats();
+            std::size_t const filter_width = k.pages();
+            std::size_t const out_channels = k.rows();
+            std::size_t const filter_size = filter_height * filter_width;
+
+            auto const out_height =
+                static_cast<std::int64_t>(params.out_height);
+            auto const out_width = static_cast<std::int64_t>(params.out_width);
+
+            // the padding of the equivalent forward convolution is measured
+            // from the flipped kernel
+            std::int64_t const pad_top =
+                params.dilation_height * (filter_height - 1) - params.pad_top;
+            std::int64_t const pad_left =
+                params.dilation_width * (filter_width - 1) - params.pad_left;
+
+            blaze::DynamicMatrix<double> kernel_matrix(
+                in_channels, out_channels * filter_size);
+            for (std::size_t a = 0; a != filter_height; ++a)
+            {
+                for (std::size_t b = 0; b != filter_width; ++b)
+                {
+                    for (std::size_t o = 0; o != out_channels; ++o)
+                    {
+                        std::size_t col =
+                            o * filter_size + a * filter_width + b;
+                        for (std::size_t c = 0; c != in_channels; ++c)
+                        {
+                            kernel_matrix(c, col) = k(a, b, o, c);
+                        }
+                    }
+                }
+            }
+
+            for_each_batch_and_channel_block(q.quats(), out_channels,
+                [&](std::size_t n, std::size_t first, std::size_t last) {
+                    blaze::DynamicMatrix<double> pixels(
+                        in_height * in_width, in_channels);
+                    for (std::size_t i = 0; i != in_height; ++i)
+                    {
+                        for (std::size_t j = 0; j != in_width; ++j)
+                        {
+                            for (std::size_t c = 0; c != in_channels; ++c)
+                            {
+                                pixels(i * in_width + j, c) = q(n, i, j, c);
+                            }
+                        }
+                    }
+
+                    blaze::DynamicMatrix<double> products = pixels *
+                        blaze::submatrix(kernel_matrix, 0, first * filter_size,
+                            in_channels, (last - first) * filter_size);
+
+                    for (std::size_t i = 0; i != in_height; ++i)
+                    {
+                        for (std::size_t j = 0; j != in_width; ++j)
+                        {
+                            auto contributions =
+                                blaze::row(products, i * in_width + j);
+                            for (std::size_t o = first; o != last; ++o)
+                            {
+                                std::size_t col = (o - first) * filter_size;
+                                for (std::size_t a = 0; a != filter_height; ++a)
+                                {
+                                    std::int64_t y = i * params.stride_height +
+                                        a * params.dilation_height - pad_top;
+                                    if (!in_range(y, out_height))
+                                        continue;
+
+                                    for (std::size_t b = 0; b != filter_width;
+                                         ++b)
+                                    {
+                                        std::int64_t x =
+                                            j * params.stride_width +
+                                            b * params.dilation_width -
+                                            pad_left;
+                                        if (in_range(x, out_width))
+                                        {
+                                            result(n, y, x, o) += contributions[
+                                                col + a * filter_width + b];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicArray<4UL, double> conv2d_compute(
+        ir::node_data<double> const& x, ir::node_data<double> const& kernel,
+        conv2d_parameters const& params, conv2d_backend backend)
+    {
+        auto q = x.quatern();
+        auto k = kernel.quatern();
+
+        blaze::DynamicArray<4UL, double> result(blaze::init_from_value, 0.0,
+            q.quats(), params.out_height, params.out_width, k.columns());
+        if (result.quats() == 0 || result.pages() == 0 ||
+            result.rows() == 0 || result.columns() == 0)
+        {
+            return result;
+        }
+
+        switch (select_conv2d_backend(k.quats(), k.pages(), params, backend))
+        {
+        case conv2d_backend::direct:
+            detail::conv2d_direct(q, k, params, result);
+            break;
+
+        case conv2d_backend::winograd:
+            detail::conv2d_winograd(q, k, params, result);
+            break;
+
+        default:
+            detail::conv2d_im2col(q, k, params, result);
+            break;
+        }
+        return result;
+    }
+
+    blaze::DynamicArray<4UL, double> conv2d_transpose_compute(
+        ir::node_data<double> const& x, ir::node_data<double> const& kernel,
+        conv2d_parameters const& params, conv2d_backend backend)
+    {
+        auto k = kernel.quatern();
+
+        // with unit strides the transposed convolution is a convolution with
+        // the flipped kernel (swapping in and out channels), this enables
+        // using any of the backends
+        if (params.stride_height == 1 && params.stride_width == 1)
+        {
+            std::size_t const filter_height = k.quats();
+            std::size_t const filter_width = k.pages();
+            std::size_t const out_channels = k.rows();
+            std::size_t const in_channels = k.columns();
+
+            blaze::DynamicArray<4UL, double> flipped(
+                filter_height, filter_width, in_channels, out_channels);
+            for (std::size_t a = 0; a != filter_height; ++a)
+            {
+                for (std::size_t b = 0; b != filter_width; ++b)
+                {
+                    for (std::size_t c = 0; c != in_channels; ++c)
+                    {
+                        for (std::size_t o = 0; o != out_channels; ++o)
+                        {
+                            flipped(a, b, c, o) = k(filter_height - 1 - a,
+                                filter_width - 1 - b, o, c);
+                        }
+                    }
+                }
+            }
+
+            return conv2d_compute(
+                x, ir::node_data<double>(std::move(flipped)), params, backend);
+        }
+
+        auto q = x.quatern();
+        blaze::DynamicArray<4UL, double> result(blaze::init_from_value, 0.0,
+            q.quats(), params.out_height, params.out_width, k.rows());
+        if (result.quats() != 0 && result.columns() != 0)
+        {
+            detail::conv2d_transpose_col2im(q, k, params, result);
+        }
+        return result;
+    }
+}}
@@ -0,0 +1,183 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/common/gemm_engine.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#if defined(PHYLANX_HAVE_CBLAS)
+extern "C" {
+#include <cblas.h>
+
+#if defined(PHYLANX_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+int mkl_set_num_threads_local(int nt);
+#elif defined(PHYLANX_HAVE_OPENBLAS_SET_NUM_THREADS)
+void openblas_set_num_threads(int num_threads);
+#endif
+}
+
+#include <mutex>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace common {
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Products with less multiply-adds than this are always computed
+        // sequentially, larger products are split such that each partition
+        // performs at least this many multiply-adds
+        constexpr std::size_t gemm_partition_work = 262144;
+
+        // Products with at least this many multiply-adds are worth handing to
+        // an external CBLAS or the packed kernel (which have to copy the
+        // operands)
+        constexpr std::size_t gemm_large_work = 2097152;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    char const* gemm_backend_name(gemm_backend backend)
+    {
+        switch (backend)
+        {
+        case gemm_backend::blaze:
+            return "blaze";
+        case gemm_backend::cblas:
+            return "cblas";
+        case gemm_backend::packed:
+            return "packed";
+        default:
+            break;
+        }
+        return "auto";
+    }
+
+    gemm_backend gemm_configured_backend()
+    {
+        static gemm_backend backend = []() {
+            std::string name =
+                hpx::get_config_entry("phylanx.gemm_backend", "auto");
+            if (name == "blaze")
+                return gemm_backend::blaze;
+            if (name == "cblas")
+                return gemm_backend::cblas;
+            if (name == "packed")
+                return gemm_backend::packed;
+            return gemm_backend::automatic;
+        }();
+        return backend;
+    }
+
+    bool gemm_cblas_available()
+    {
+#if defined(PHYLANX_HAVE_CBLAS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    gemm_backend select_gemm_backend(std::size_t rows, std::size_t inner,
+        std::size_t columns, bool is_double, bool nested, gemm_backend backend)
+    {
+        if (backend == gemm_backend::automatic)
+        {
+            backend = gemm_configured_backend();
+        }
+
+        bool const supports_cblas =
+            is_double && !nested && gemm_cblas_available();
+
+        switch (backend)
+        {
+        case gemm_backend::blaze:
+            return gemm_backend::blaze;
+
+        case gemm_backend::packed:
+            return gemm_backend::packed;
+
+        case gemm_backend::cblas:
+            if (supports_cblas)
+            {
+                return gemm_backend::cblas;
+            }
+            // products that can't be handed to CBLAS are computed using the
+            // kernel that comes closest (blocked, explicitly partitioned)
+            return nested ? gemm_backend::packed : gemm_backend::blaze;
+
+        case gemm_backend::automatic:
+            if (rows * inner * columns >= detail::gemm_large_work)
+            {
+                if (supports_cblas)
+                {
+                    return gemm_backend::cblas;
+                }
+
+                // Blaze's own kernels for integral types are not blocked
+                // for the caches
+                if (!is_double)
+                {
+                    return gemm_backend::packed;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+        return gemm_backend::blaze;
+    }
+
+    std::size_t gemm_partitions(
+        std::size_t rows, std::size_t inner, std::size_t columns)
+    {
+        std::size_t const work = rows * inner * columns;
+        if (work < 2 * detail::gemm_partition_work)
+        {
+            return 1;
+        }
+
+        std::size_t const threads = hpx::get_os_thread_count();
+        return (std::max)(std::size_t(1),
+            (std::min)(threads, work / detail::gemm_partition_work));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void gemm_cblas(std::size_t m, std::size_t n, std::size_t k,
+        double const* a, std::size_t lda, double const* b, std::size_t ldb,
+        double* c, std::size_t ldc)
+    {
+#if defined(PHYLANX_HAVE_CBLAS)
+        // The products are partitioned over the worker threads already, the
+        // library must not spawn its own threads in addition to that.
+#if defined(PHYLANX_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+        // this affects the calling thread only, restore it afterwards
+        int const num_threads = mkl_set_num_threads_local(1);
+#elif defined(PHYLANX_HAVE_OPENBLAS_SET_NUM_THREADS)
+        // OpenBLAS has a process-wide setting only, which can't be restored
+        // while other workers may still be calling into the library
+        static std::once_flag single_threaded;
+        std::call_once(single_threaded, []() { openblas_set_num_threads(1); });
+#endif
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, int(m), int(n),
+            int(k), 1.0, a, int(lda), b, int(ldb), 0.0, c, int(ldc));
+#if defined(PHYLANX_HAVE_MKL_SET_NUM_THREADS_LOCAL)
+        mkl_set_num_threads_local(num_threads);
+#endif
+#else
+        HPX_THROW_EXCEPTION(hpx::invalid_status, "phylanx::common::gemm_cblas",
+            "Phylanx was built without support for an external CBLAS library "
+            "(reconfigure with PHYLANX_WITH_CBLAS=On)");
+#endif
+    }
+}}
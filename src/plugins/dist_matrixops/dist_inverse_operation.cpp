@@ -13,17 +13,17 @@
 #include <phylanx/execution_tree/tiling_annotations.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_inverse_operation.hpp>
-#include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
-#include <phylanx/util/detail/bad_swap.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu_engine.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/futures/future.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/serialization/vector.hpp>
 
-#include <algorithm>
-#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -34,16 +34,16 @@
 #include <blaze/Math.h>
 #include <blaze_tensor/Math.h>
 
-#include <phylanx/util/distributed_matrix.hpp>
-
 namespace phylanx { namespace dist_matrixops { namespace primitives {
 
     constexpr char const* const help_string = R"(
         inverse_d(matrix)
         Args:
-            blaze dynamic matrix
+            matrix (array): a square matrix that is tiled by columns
         Returns:
-            the inverse of the matrix
+            the inverse of the matrix, tiled like the argument. The inverse
+            is calculated from the distributed LU factorization of the matrix,
+            use solve_d to solve linear systems instead of forming the inverse
         )";
 
     execution_tree::match_pattern_type const dist_inverse::match_data = {
@@ -62,268 +62,105 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     {
     }
 
-    // find the first column belonging to a locality
-    std::size_t getStartCol(std::size_t id, std::size_t n, std::size_t numLocs)
-    {
-        std::size_t startCol =
-            id * (n / numLocs) + ((id < n % numLocs) ? id : (n % numLocs));
-        return startCol;
-    }
-
-    // find the final column belonging to a locality
-    std::size_t getEndCol(std::size_t id, std::size_t n, std::size_t numLocs)
-    {
-        std::size_t endCol;
-        if (id == numLocs - 1)
-            endCol = n;
-        else
-            endCol = getStartCol(id + 1, n, numLocs);
-        return endCol;
-    }
-
-    // find the locality who holds a given column locally
-    std::size_t findOwningLoc(
-        std::size_t n, std::size_t numLocs, std::size_t col)
-    {
-        std::size_t id;
-        if (col < (n % numLocs) * (n / numLocs + 1))
-            id = col / ((n / numLocs) + 1);
-        else
-            id = (n % numLocs) +
-                ((col - (n % numLocs) * (n / numLocs + 1)) / (n / numLocs));
-        return id;
-    }
-
-    // This is where the computation of the inverse is performed.
+    // The inverse is calculated from the (distributed) LU factorization of
+    // the matrix. The columns of the inverse of each locality are found by
+    // solving A X = I(:, columns) using the distributed factors, one
+    // locality at a time. Every locality ends up with the rows of each of
+    // those solutions that correspond to its columns of the factors, those
+    // are sent to where they belong at the end.
     template <typename T>
-    execution_tree::primitive_argument_type dist_inverse::distGaussInv(
+    execution_tree::primitive_argument_type dist_inverse::dist_lu_inverse(
         ir::node_data<T>&& arg,
         execution_tree::localities_information&& lhs_localities) const
     {
         if (lhs_localities.num_dimensions() != 2)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "dist_inverse::distGaussInv",
+                "dist_inverse::dist_lu_inverse",
                 generate_error_message("the input must be a 2d matrix"));
         }
 
-        std::size_t thisLocalityID = lhs_localities.locality_.locality_id_;
-        std::size_t numLocalities = lhs_localities.locality_.num_localities_;
+        std::size_t const numRows = lhs_localities.rows(name_, codename_);
+        std::string const basename = dist_lu_basename(lhs_localities);
 
-        util::distributed_matrix<T> lhs_data(lhs_localities.annotation_.name_,
-            arg.matrix(), lhs_localities.locality_.num_localities_,
-            lhs_localities.locality_.locality_id_);
+        dist_lu_factors factors = dist_lu_factorize(
+            blaze::DynamicMatrix<double>(arg.matrix()), lhs_localities,
+            basename, name_, codename_);
 
-        auto myMatrix = arg.matrix();
-        std::size_t numRows = myMatrix.rows();
-        std::size_t numCols = myMatrix.columns();
+        std::size_t const startCol = factors.column_start_;
+        std::size_t const numCols = factors.lu_.columns();
 
-        // Define some additional information on where
-        // columns lie in the full input
-        std::size_t startCol = thisLocalityID * (numRows / numLocalities) +
-            ((thisLocalityID < (numRows % numLocalities)) ?
-                    thisLocalityID :
-                    (numRows % numLocalities));
-        std::size_t endCol = startCol + numCols - 1;
+        std::uint32_t const loc_id = lhs_localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            lhs_localities.locality_.num_localities_;
 
-        // Definition of this loc's part of a nxn double row-major identity matrix
-        blaze::DynamicMatrix<double> invMatrix =
-            blaze::submatrix(blaze::IdentityMatrix<double>(numRows), 0,
-                startCol, arg.matrix().rows(), arg.matrix().columns());
+        std::vector<blaze::DynamicMatrix<double>> parts(num_localities);
+        for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+        {
+            auto const& columns = lhs_localities.tiles_[loc].spans_[1];
 
-            // Do gaussian elimination to get upper triangular
-            // matrix with 1's across diagonal
-            for (std::size_t current_row = 0; current_row != numRows;
-                 current_row++)
+            // the columns of the nxn identity matrix of locality loc
+            blaze::DynamicMatrix<double> identity(
+                numRows, columns.size(), 0.0);
+            for (std::int64_t col = 0; col != columns.size(); ++col)
             {
-                // Find the locality that owns the pivot element then get the pivot
-                std::size_t ownid1 =
-                    findOwningLoc(numRows, numLocalities, current_row);
-
-                std::size_t localIndexOffset =
-                    current_row - getStartCol(ownid1, numRows, numLocalities);
-                auto pulledColumn =
-                    lhs_data
-                        .fetch(ownid1, current_row, localIndexOffset, numRows,
-                            localIndexOffset + 1)
-                        .get();
-                double pivot = pulledColumn(0, 0);
-
-
-                if (numLocalities > 1)
-                {
-                    hpx::lcos::barrier b2(
-                        "barrierb_" + lhs_localities.annotation_.name_,
-                        lhs_localities.locality_.num_localities_,
-                        lhs_localities.locality_.locality_id_);
-                    b2.wait();
-                }
-
-                // Swaps current row with nearest subsequent row such that
-                // after swapping A[current_row][current_row] != 0.
-                if (pivot == 0)
-                {
-                    bool rowFound = false;
-                    std::size_t checkOffset = 1;
-                    while (current_row + checkOffset != numRows && !rowFound)
-                    {
-                        pivot = pulledColumn(checkOffset, 0);
-                        if (pivot != 0)
-                        {
-                            std::size_t checkRow =
-                                (current_row + checkOffset) % numRows;
-
-                            for (std::size_t swapCol = 0; swapCol!=numCols; swapCol++)
-                            {
-                                auto temp = (*lhs_data)(current_row, swapCol);
-                                (*lhs_data)(current_row, swapCol) =
-                                    (*lhs_data)(checkRow, swapCol);
-                                (*lhs_data)(checkRow, swapCol) = temp;
-
-                                auto invtemp = invMatrix(current_row, swapCol);
-                                invMatrix(current_row, swapCol) =
-                                    invMatrix(checkRow, swapCol);
-                                invMatrix(checkRow, swapCol) = invtemp;
-                            }
-                            rowFound = true;
-                        }
-                        else
-                            checkOffset++;
-                    }
-                    // swap row with nearest subsequent row such that after
-                    // swapping A[i][i] != 0
-                    // if fails, inverse does not exist
-                    if (!rowFound)
-                    {
-                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                            "dist_inverse::distGaussInv",
-                            generate_error_message("inverse does not exist"));
-                    }
-                    current_row--;    // After swapping, make sure to retry this row
-                }
-                else    // the inversion has not already failed
-                {
-                    for (std::size_t col = 0; col != numCols; col++)
-                    {
-
-                        (*lhs_data)(current_row, col) =
-                            (*lhs_data)(current_row, col) / pivot;
-                        invMatrix(current_row, col) =
-                            invMatrix(current_row, col) / pivot;
-                    }
-                    if (current_row < numRows - 1)
-                    {
-                        for (std::size_t nextRow = current_row + 1;
-                             nextRow != numRows; nextRow++)
-                        {
-                            // Find the locality that owns the pivot element
-                            // then get the pivot
-                            std::size_t ownid2 = findOwningLoc(
-                                numRows, numLocalities, current_row);
-                            std::size_t localIndexOffset2 = current_row -
-                                getStartCol(ownid2, numRows, numLocalities);
-                            auto pulledElement =
-                                lhs_data
-                                    .fetch(ownid2, nextRow, localIndexOffset2,
-                                         nextRow + 1,
-                                         localIndexOffset2 + 1)
-                                    .get();
-                            double factor = pulledElement(0, 0);
-
-                            // Removing this barrier causes errors
-                            if (numLocalities > 1)
-                            {
-                                hpx::lcos::barrier b5("barriere_" +
-                                        lhs_localities.annotation_.name_,
-                                    lhs_localities.locality_.num_localities_,
-                                    lhs_localities.locality_.locality_id_);
-                                b5.wait();
-                            }
-
-
-                            for (std::size_t nextCol = 0;
-                                 nextCol != numCols; nextCol++)
-                            {
-                                (*lhs_data)(nextRow, nextCol) =
-                                    (*lhs_data)(nextRow, nextCol) -
-                                    (factor *
-                                        (*lhs_data)(current_row, nextCol));
-                                invMatrix(nextRow, nextCol) =
-                                    invMatrix(nextRow, nextCol) -
-                                    (factor * invMatrix(current_row, nextCol));
-                            }
-                        }
-                    }
-                }
+                identity(columns.start_ + col, col) = 1.0;
             }
 
+            parts[loc] = dist_lu_solve(factors, identity, lhs_localities,
+                basename + "_" + std::to_string(loc), name_, codename_);
+        }
 
-            // Back substitution phase, going from bottom to top
-            // in matrix zeroing out columns except diagonal
-            for (std::size_t zeroCol = numRows - 1; zeroCol != 0; zeroCol--)
-            {
-                for (std::int64_t row = zeroCol - 1; row != -1; row--)
-                {
-                    // Find the locality that owns the pivot element then get the pivot
-                    std::size_t ownid3 =
-                        findOwningLoc(numRows, numLocalities, zeroCol);
-                    std::size_t localIndexOffset3 =
-                        zeroCol -
-                        getStartCol(ownid3, numRows, numLocalities);
-                    auto pulledElement =
-                        lhs_data
-                            .fetch(ownid3, row, localIndexOffset3, row + 1,
-                                localIndexOffset3 + 1)
-                            .get();
-                    double factor = pulledElement(0, 0);
-
-                    // Removing this barrier causes errors
-                    if (numLocalities > 1)
-                    {
-                        hpx::lcos::barrier b8(
-                            "barrierg_" + lhs_localities.annotation_.name_,
-                            lhs_localities.locality_.num_localities_,
-                            lhs_localities.locality_.locality_id_);
-                        b8.wait();
-                    }
-
+        if (num_localities != 1)
+        {
+            parts = hpx::all_to_all((basename + "_inverse").c_str(),
+                std::move(parts), num_localities, 1, loc_id)
+                        .get();
+        }
 
-                    for (std::size_t col = 0; col != numCols; col++)
-                    {
-                        myMatrix(row, col) = myMatrix(row, col) -
-                            (factor * myMatrix(zeroCol, col));
-                        invMatrix(row, col) = invMatrix(row, col) -
-                            (factor * invMatrix(zeroCol, col));
-                    }
-                }
+        blaze::DynamicMatrix<double> invMatrix(numRows, numCols);
+        for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+        {
+            auto const& rows = lhs_localities.tiles_[loc].spans_[1];
+            if (parts[loc].rows() != std::size_t(rows.size()) ||
+                parts[loc].columns() != numCols)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_inverse::dist_lu_inverse",
+                    generate_error_message(
+                        "unexpected shape of the partial inverse received "
+                        "from a remote locality"));
             }
+            blaze::submatrix(invMatrix, rows.start_, 0, rows.size(),
+                numCols) = parts[loc];
+        }
+
+        // Prepare the output
+        execution_tree::primitive_argument_type result =
+            execution_tree::primitive_argument_type{std::move(invMatrix)};
+        execution_tree::annotation ann{ir::range("tile",
+            ir::range("rows", static_cast<std::int64_t>(0),
+                static_cast<std::int64_t>(numRows)),
+            ir::range("columns", static_cast<std::int64_t>(startCol),
+                static_cast<std::int64_t>(startCol + numCols)))};
 
-            // Prepare the output
-            execution_tree::primitive_argument_type result =
-                execution_tree::primitive_argument_type{invMatrix};
-            execution_tree::annotation ann{ir::range("tile",
-                ir::range("rows", static_cast<std::int64_t>(0),
-                    static_cast<std::int64_t>(numRows)),
-                ir::range("columns", static_cast<std::int64_t>(startCol),
-                    static_cast<std::int64_t>(endCol+1)))};
-            // Generate new tiling annotation for the result vector
-            execution_tree::tiling_information_2d tile_info(
-                ann, name_, codename_);
+        // Generate new tiling annotation for the result vector
+        execution_tree::tiling_information_2d tile_info(
+            ann, name_, codename_);
 
-            ++lhs_localities.annotation_.generation_;
+        ++lhs_localities.annotation_.generation_;
 
-            auto locality_ann = lhs_localities.locality_.as_annotation();
-            result.set_annotation(
-                execution_tree::localities_annotation(locality_ann,
-                    tile_info.as_annotation(name_, codename_),
-                    lhs_localities.annotation_, name_, codename_),
-                name_, codename_);
+        auto locality_ann = lhs_localities.locality_.as_annotation();
+        result.set_annotation(
+            execution_tree::localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                lhs_localities.annotation_, name_, codename_),
+            name_, codename_);
 
         return result;
     }
 
-    // This is where the computation of the inverse should be performed.
-    execution_tree::primitive_argument_type dist_inverse::distGaussInv(
+    execution_tree::primitive_argument_type dist_inverse::dist_lu_inverse(
         execution_tree::primitive_argument_type&& lhs) const
     {
         using namespace execution_tree;
@@ -335,12 +172,12 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         {
         case 2:
             // Do the inverse operation
-            return distGaussInv(
+            return dist_lu_inverse(
                 extract_numeric_value(std::move(lhs), name_, codename_),
                 std::move(lhs_localities));
         default:
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                " dist_inverse::distGaussInv",
+                "dist_inverse::dist_lu_inverse",
                 generate_error_message("left hand side operand has unsupported "
                                        "number of dimensions"));
         }
@@ -360,8 +197,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_inverse::eval",
                 generate_error_message(
-                    "the gaussian inverse operation primitive requires"
-                    "exactly one operand"));
+                    "the inverse_d primitive requires exactly one "
+                    "operand"));
         }
 
         // Check if there are no valid operands
@@ -369,7 +206,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_inverse::eval",
                 generate_error_message(
-                    "the gaussian_inverse_operation primitive requires that "
+                    "the inverse_d primitive requires that "
                     "the arguments given by the operands array is valid"));
         }
 
@@ -379,7 +216,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
             hpx::util::unwrapping(
                 [this_ = std::move(this_)](primitive_arguments_type&& args)
                     -> primitive_argument_type {
-                    return this_->distGaussInv(std::move(args[0]));
+                    return this_->dist_lu_inverse(std::move(args[0]));
                 }),
             execution_tree::primitives::detail::map_operands(operands,
                 execution_tree::functional::value_operand{}, args, name_,
@@ -0,0 +1,146 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/locality_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu_engine.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const dist_lu::match_data =
+    {
+        hpx::make_tuple("lu_d", std::vector<std::string>{R"(
+                lu_d(_1_matrix)
+            )"},
+            &create_dist_lu, &execution_tree::create_primitive<dist_lu>, R"(
+            matrix
+            Args:
+
+                matrix (array): a square matrix that is tiled by columns
+
+            Returns:
+
+            A list of two elements: the combined LU factors of the matrix
+            (tiled like the argument, L has an implicit unit diagonal) and a
+            vector of pivot indices (row i of the matrix was interchanged with
+            row pivots[i]). The factorization uses partial pivoting and is
+            performed block column by block column across all localities.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_lu::dist_lu(execution_tree::primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::primitive_argument_type dist_lu::lu2d(
+        execution_tree::primitive_argument_type&& arg) const
+    {
+        using namespace execution_tree;
+
+        localities_information localities =
+            extract_localities_information(arg, name_, codename_);
+
+        dist_lu_factors factors = dist_lu_factorize(
+            blaze::DynamicMatrix<double>(
+                extract_numeric_value(std::move(arg), name_, codename_)
+                    .matrix()),
+            localities, dist_lu_basename(localities), name_, codename_);
+
+        std::size_t const rows = factors.lu_.rows();
+        std::size_t const column_start = factors.column_start_;
+        std::size_t const column_stop = column_start + factors.lu_.columns();
+
+        blaze::DynamicVector<std::int64_t> pivots(factors.pivots_.size());
+        std::copy(
+            factors.pivots_.begin(), factors.pivots_.end(), pivots.begin());
+
+        // the factors are tiled like the argument
+        primitive_argument_type lu{std::move(factors.lu_)};
+
+        tiling_information_2d tile_info(
+            tiling_span(0, static_cast<std::int64_t>(rows)),
+            tiling_span(static_cast<std::int64_t>(column_start),
+                static_cast<std::int64_t>(column_stop)));
+
+        ++localities.annotation_.generation_;
+
+        auto locality_ann = localities.locality_.as_annotation();
+        lu.set_annotation(
+            localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                localities.annotation_, name_, codename_),
+            name_, codename_);
+
+        return primitive_argument_type{primitive_arguments_type{
+            std::move(lu), primitive_argument_type{std::move(pivots)}}};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> dist_lu::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_lu::eval",
+                generate_error_message(
+                    "the lu_d primitive requires exactly one operand"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_lu::eval",
+                generate_error_message(
+                    "the lu_d primitive requires that the arguments given "
+                    "by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](
+                    execution_tree::primitive_arguments_type&& args)
+                    -> execution_tree::primitive_argument_type {
+                    if (execution_tree::extract_numeric_value_dimension(
+                            args[0], this_->name_, this_->codename_) != 2)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_lu::eval",
+                            this_->generate_error_message(
+                                "the lu_d primitive requires a matrix"));
+                    }
+                    return this_->lu2d(std::move(args[0]));
+                }),
+            execution_tree::primitives::detail::map_operands(operands,
+                execution_tree::functional::value_operand{}, args, name_,
+                codename_, std::move(ctx)));
+    }
+}}}
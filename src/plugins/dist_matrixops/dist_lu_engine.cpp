@@ -0,0 +1,572 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu_engine.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/collectives/all_reduce.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/serialization/vector.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t dist_lu_block_size()
+    {
+        static std::size_t block_size = []() -> std::size_t {
+            std::size_t size = std::stoul(
+                hpx::get_config_entry("phylanx.dist_lu.block_size", "64"));
+            return size != 0 ? size : 64;
+        }();
+        return block_size;
+    }
+
+    std::string dist_lu_basename(
+        execution_tree::localities_information const& locs)
+    {
+        static hpx::lcos::local::spinlock mtx;
+        static std::map<std::string, std::size_t> invocations;
+
+        std::string basename = "dist_lu_" + locs.annotation_.name_ + "_" +
+            std::to_string(locs.annotation_.generation_);
+
+        std::size_t invocation = 0;
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+            invocation = ++invocations[basename];
+        }
+        return basename + "_" + std::to_string(invocation);
+    }
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // a panel is a range of columns owned by one locality
+        struct lu_panel_info
+        {
+            std::uint32_t owner_;
+            std::size_t start_;
+            std::size_t stop_;
+        };
+
+        // the factored panel as sent to all localities
+        struct lu_panel
+        {
+            blaze::DynamicMatrix<double> data_;    // rows start_ to n
+            std::vector<std::int64_t> pivots_;
+            bool singular_ = false;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                // clang-format off
+                ar & data_ & pivots_ & singular_;
+                // clang-format on
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        std::vector<lu_panel_info> lu_panels(
+            execution_tree::localities_information const& locs,
+            std::size_t n, std::string const& name,
+            std::string const& codename)
+        {
+            std::size_t const block_size = dist_lu_block_size();
+
+            std::vector<lu_panel_info> panels;
+            for (std::uint32_t loc = 0; loc != locs.tiles_.size(); ++loc)
+            {
+                auto const& rows = locs.tiles_[loc].spans_[0];
+                auto const& columns = locs.tiles_[loc].spans_[1];
+
+                if (rows.start_ != 0 || rows.stop_ != std::int64_t(n))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_matrixops::detail::lu_panels",
+                        util::generate_error_message(
+                            "the matrix is expected to be tiled by columns "
+                            "(use retile_d(..., \"column\") first)",
+                            name, codename));
+                }
+
+                for (std::size_t start = columns.start_;
+                     start < std::size_t(columns.stop_); start += block_size)
+                {
+                    panels.push_back(lu_panel_info{loc, start,
+                        (std::min)(start + block_size,
+                            std::size_t(columns.stop_))});
+                }
+            }
+
+            std::sort(panels.begin(), panels.end(),
+                [](lu_panel_info const& lhs, lu_panel_info const& rhs) {
+                    return lhs.start_ < rhs.start_;
+                });
+
+            // the tiles have to cover all columns exactly once
+            std::size_t expected_start = 0;
+            for (auto const& panel : panels)
+            {
+                if (panel.start_ != expected_start)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_matrixops::detail::lu_panels",
+                        util::generate_error_message(
+                            "the column tiles of the matrix should not "
+                            "overlap and should cover all columns",
+                            name, codename));
+                }
+                expected_start = panel.stop_;
+            }
+
+            if (expected_start != n)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_matrixops::detail::lu_panels",
+                    util::generate_error_message(
+                        "the column tiles of the matrix should cover all "
+                        "columns",
+                        name, codename));
+            }
+
+            return panels;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // unblocked LU factorization with partial pivoting of the panel
+        // (rows start to n), the rows are interchanged inside the panel only
+        bool factor_panel(blaze::DynamicMatrix<double>& a,
+            lu_panel_info const& panel, std::size_t column_start,
+            std::vector<std::int64_t>& pivots)
+        {
+            std::size_t const rows = a.rows() - panel.start_;
+            std::size_t const width = panel.stop_ - panel.start_;
+
+            auto p = blaze::submatrix(
+                a, panel.start_, panel.start_ - column_start, rows, width);
+
+            for (std::size_t j = 0; j != width; ++j)
+            {
+                // find the pivot element
+                std::size_t pivot_row = j;
+                double max_value = std::abs(p(j, j));
+                for (std::size_t i = j + 1; i != rows; ++i)
+                {
+                    if (std::abs(p(i, j)) > max_value)
+                    {
+                        max_value = std::abs(p(i, j));
+                        pivot_row = i;
+                    }
+                }
+
+                if (max_value == 0.0)
+                {
+                    return false;
+                }
+
+                pivots[panel.start_ + j] = panel.start_ + pivot_row;
+                if (pivot_row != j)
+                {
+                    blaze::DynamicVector<double, blaze::rowVector> tmp =
+                        blaze::row(p, j);
+                    blaze::row(p, j) = blaze::row(p, pivot_row);
+                    blaze::row(p, pivot_row) = tmp;
+                }
+
+                if (j + 1 != rows)
+                {
+                    auto l = blaze::subvector(
+                        blaze::column(p, j), j + 1, rows - j - 1);
+                    l /= p(j, j);
+
+                    if (j + 1 != width)
+                    {
+                        blaze::submatrix(
+                            p, j + 1, j + 1, rows - j - 1, width - j - 1) -=
+                            l *
+                            blaze::subvector(
+                                blaze::row(p, j), j + 1, width - j - 1);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // apply the row interchanges of the given panel to the local columns
+        // [first, last)
+        void apply_pivots(blaze::DynamicMatrix<double>& a,
+            lu_panel_info const& panel,
+            std::vector<std::int64_t> const& pivots, std::size_t first,
+            std::size_t last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+
+            for (std::size_t i = panel.start_; i != panel.stop_; ++i)
+            {
+                std::size_t pivot_row = pivots[i];
+                if (pivot_row != i)
+                {
+                    auto row1 =
+                        blaze::subvector(blaze::row(a, i), first, last - first);
+                    auto row2 = blaze::subvector(
+                        blaze::row(a, pivot_row), first, last - first);
+
+                    blaze::DynamicVector<double, blaze::rowVector> tmp = row1;
+                    row1 = row2;
+                    row2 = tmp;
+                }
+            }
+        }
+
+        // update the local columns [first, last) using the factored panel
+        void update_trailing(blaze::DynamicMatrix<double>& a,
+            lu_panel_info const& panel, lu_panel const& factored,
+            std::size_t first, std::size_t last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+
+            std::size_t const n = a.rows();
+            std::size_t const width = panel.stop_ - panel.start_;
+            std::size_t const columns = last - first;
+
+            // U12 = L11^-1 A12 (L11 has a unit diagonal)
+            auto l11 = blaze::submatrix(factored.data_, 0, 0, width, width);
+            auto u12 = blaze::submatrix(a, panel.start_, first, width, columns);
+            for (std::size_t i = 1; i != width; ++i)
+            {
+                blaze::row(u12, i) -=
+                    blaze::subvector(blaze::row(l11, i), 0, i) *
+                    blaze::submatrix(u12, 0, 0, i, columns);
+            }
+
+            // A22 = A22 - L21 U12
+            if (panel.stop_ != n)
+            {
+                blaze::submatrix(a, panel.stop_, first, n - panel.stop_,
+                    columns) -= blaze::submatrix(factored.data_, width, 0,
+                                    n - panel.stop_, width) *
+                    u12;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_lu_factors dist_lu_factorize(blaze::DynamicMatrix<double>&& local,
+        execution_tree::localities_information const& locs,
+        std::string const& basename, std::string const& name,
+        std::string const& codename)
+    {
+        std::size_t const n = locs.rows(name, codename);
+        if (n != locs.columns(name, codename))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_matrixops::dist_lu_factorize",
+                util::generate_error_message(
+                    "the matrix to factorize has to be square", name,
+                    codename));
+        }
+
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const num_localities = locs.locality_.num_localities_;
+
+        std::vector<detail::lu_panel_info> const panels =
+            detail::lu_panels(locs, n, name, codename);
+
+        dist_lu_factors factors;
+        factors.lu_ = std::move(local);
+        factors.pivots_.resize(n);
+        factors.column_start_ = locs.tiles_[loc_id].spans_[1].start_;
+
+        blaze::DynamicMatrix<double>& a = factors.lu_;
+        std::vector<std::int64_t>& pivots = factors.pivots_;
+        std::size_t const column_start = factors.column_start_;
+        std::size_t const local_columns = a.columns();
+
+        std::string const factor_basename = basename + "_factor";
+
+        // factor the given panel (if owned by this locality) and send it to
+        // all localities, everybody else contributes an empty panel
+        auto publish = [&](std::size_t k) -> hpx::future<detail::lu_panel> {
+            auto const& panel = panels[k];
+
+            detail::lu_panel factored;
+            if (panel.owner_ == loc_id)
+            {
+                if (detail::factor_panel(a, panel, column_start, pivots))
+                {
+                    factored.data_ = blaze::submatrix(a, panel.start_,
+                        panel.start_ - column_start, n - panel.start_,
+                        panel.stop_ - panel.start_);
+                    factored.pivots_.assign(pivots.begin() + panel.start_,
+                        pivots.begin() + panel.stop_);
+                }
+                else
+                {
+                    factored.singular_ = true;
+                }
+            }
+
+            if (num_localities == 1)
+            {
+                return hpx::make_ready_future(std::move(factored));
+            }
+
+            std::uint32_t const owner = panel.owner_;
+            return hpx::all_gather(factor_basename.c_str(), std::move(factored),
+                num_localities, k + 1, loc_id)
+                .then(hpx::launch::sync,
+                    [owner](hpx::future<std::vector<detail::lu_panel>>&& f)
+                        -> detail::lu_panel {
+                        return std::move(f.get()[owner]);
+                    });
+        };
+
+        hpx::future<detail::lu_panel> next = publish(0);
+        for (std::size_t k = 0; k != panels.size(); ++k)
+        {
+            auto const& panel = panels[k];
+            detail::lu_panel factored = next.get();
+
+            if (factored.singular_)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_matrixops::dist_lu_factorize",
+                    util::generate_error_message(
+                        "the matrix is singular", name, codename));
+            }
+
+            std::copy(factored.pivots_.begin(), factored.pivots_.end(),
+                pivots.begin() + panel.start_);
+
+            // interchange the rows of all local columns (the owner has done
+            // that for the columns of the panel already)
+            if (panel.owner_ == loc_id)
+            {
+                std::size_t const first = panel.start_ - column_start;
+                std::size_t const last = panel.stop_ - column_start;
+
+                detail::apply_pivots(a, panel, pivots, 0, first);
+                detail::apply_pivots(a, panel, pivots, last, local_columns);
+            }
+            else
+            {
+                detail::apply_pivots(a, panel, pivots, 0, local_columns);
+            }
+
+            // local columns to the right of the panel
+            std::size_t first = local_columns;
+            if (column_start + local_columns > panel.stop_)
+            {
+                first = (std::max)(column_start, panel.stop_) - column_start;
+            }
+
+            if (k + 1 == panels.size())
+            {
+                detail::update_trailing(
+                    a, panel, factored, first, local_columns);
+                break;
+            }
+
+            auto const& next_panel = panels[k + 1];
+            if (next_panel.owner_ == loc_id)
+            {
+                // look ahead: update the next panel first and send it off
+                // before the remaining columns are updated
+                std::size_t const next_last = next_panel.stop_ - column_start;
+
+                detail::update_trailing(a, panel, factored, first, next_last);
+                next = publish(k + 1);
+                detail::update_trailing(
+                    a, panel, factored, next_last, local_columns);
+            }
+            else
+            {
+                next = publish(k + 1);
+                detail::update_trailing(
+                    a, panel, factored, first, local_columns);
+            }
+        }
+
+        return factors;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicMatrix<double> dist_lu_solve(dist_lu_factors const& factors,
+        blaze::DynamicMatrix<double> const& b,
+        execution_tree::localities_information const& locs,
+        std::string const& basename, std::string const& name,
+        std::string const& codename)
+    {
+        blaze::DynamicMatrix<double> const& lu = factors.lu_;
+        std::vector<std::int64_t> const& pivots = factors.pivots_;
+
+        std::size_t const n = lu.rows();
+        std::size_t const columns = b.columns();
+        std::size_t const column_start = factors.column_start_;
+
+        if (b.rows() != n)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_matrixops::dist_lu_solve",
+                util::generate_error_message(
+                    "the right hand side must have as many rows as the "
+                    "factored matrix",
+                    name, codename));
+        }
+
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const num_localities = locs.locality_.num_localities_;
+
+        std::vector<detail::lu_panel_info> const panels =
+            detail::lu_panels(locs, n, name, codename);
+
+        std::string const solve_basename = basename + "_solve";
+        std::size_t generation = 0;
+
+        // sum up the updates of the given rows contributed by all localities
+        auto sum_updates = [&](blaze::DynamicMatrix<double> const& updates,
+                               std::size_t start, std::size_t size)
+            -> blaze::DynamicMatrix<double> {
+            blaze::DynamicMatrix<double> local =
+                blaze::submatrix(updates, start, 0, size, columns);
+
+            ++generation;
+            if (num_localities == 1)
+            {
+                return local;
+            }
+
+            return hpx::all_reduce(solve_basename.c_str(), std::move(local),
+                std::plus<blaze::DynamicMatrix<double>>{}, num_localities,
+                generation, loc_id)
+                .get();
+        };
+
+        // B = P B
+        blaze::DynamicMatrix<double> pb = b;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            std::size_t pivot_row = pivots[i];
+            if (pivot_row != i)
+            {
+                blaze::DynamicVector<double, blaze::rowVector> tmp =
+                    blaze::row(pb, i);
+                blaze::row(pb, i) = blaze::row(pb, pivot_row);
+                blaze::row(pb, pivot_row) = tmp;
+            }
+        }
+
+        // the rows of Y (and X) corresponding to the local columns
+        blaze::DynamicMatrix<double> x(lu.columns(), columns);
+
+        // updates of all rows contributed by the local panels
+        blaze::DynamicMatrix<double> updates(n, columns, 0.0);
+
+        // solve L Y = P B (L has a unit diagonal)
+        for (auto const& panel : panels)
+        {
+            std::size_t const width = panel.stop_ - panel.start_;
+            blaze::DynamicMatrix<double> sum =
+                sum_updates(updates, panel.start_, width);
+
+            if (panel.owner_ != loc_id)
+            {
+                continue;
+            }
+
+            std::size_t const first = panel.start_ - column_start;
+            auto l11 = blaze::submatrix(lu, panel.start_, first, width, width);
+            auto y = blaze::submatrix(x, first, 0, width, columns);
+
+            y = blaze::submatrix(pb, panel.start_, 0, width, columns) + sum;
+            for (std::size_t i = 1; i != width; ++i)
+            {
+                blaze::row(y, i) -=
+                    blaze::subvector(blaze::row(l11, i), 0, i) *
+                    blaze::submatrix(y, 0, 0, i, columns);
+            }
+
+            if (panel.stop_ != n)
+            {
+                blaze::submatrix(updates, panel.stop_, 0, n - panel.stop_,
+                    columns) -= blaze::submatrix(lu, panel.stop_, first,
+                                    n - panel.stop_, width) *
+                    y;
+            }
+        }
+
+        // solve U X = Y
+        updates = 0.0;
+        for (auto it = panels.rbegin(); it != panels.rend(); ++it)
+        {
+            auto const& panel = *it;
+
+            std::size_t const width = panel.stop_ - panel.start_;
+            blaze::DynamicMatrix<double> sum =
+                sum_updates(updates, panel.start_, width);
+
+            if (panel.owner_ != loc_id)
+            {
+                continue;
+            }
+
+            std::size_t const first = panel.start_ - column_start;
+            auto u11 = blaze::submatrix(lu, panel.start_, first, width, width);
+            auto xb = blaze::submatrix(x, first, 0, width, columns);
+
+            xb += sum;
+            for (std::size_t i = width; i != 0; --i)
+            {
+                std::size_t const row = i - 1;
+                if (row + 1 != width)
+                {
+                    blaze::row(xb, row) -=
+                        blaze::subvector(
+                            blaze::row(u11, row), row + 1, width - row - 1) *
+                        blaze::submatrix(
+                            xb, row + 1, 0, width - row - 1, columns);
+                }
+                blaze::row(xb, row) /= u11(row, row);
+            }
+
+            if (panel.start_ != 0)
+            {
+                blaze::submatrix(updates, 0, 0, panel.start_, columns) -=
+                    blaze::submatrix(lu, 0, first, panel.start_, width) * xb;
+            }
+        }
+
+        return x;
+    }
+}}
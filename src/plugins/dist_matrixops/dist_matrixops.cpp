@@ -29,8 +29,14 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(dist_identity_plugin,
     phylanx::dist_matrixops::primitives::dist_identity::match_data)
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_inverse_operation_plugin,
     phylanx::dist_matrixops::primitives::dist_inverse::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dist_lu_plugin,
+    phylanx::dist_matrixops::primitives::dist_lu::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_random_plugin,
     phylanx::dist_matrixops::primitives::dist_random::match_data)
+PHYLANX_REGISTER_PLUGIN_FACTORY(dist_solve_plugin,
+    phylanx::dist_matrixops::primitives::dist_solve::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dist_summa_product_plugin,
+    phylanx::dist_matrixops::primitives::dist_summa_product::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_transpose_operation_plugin,
     phylanx::dist_matrixops::primitives::dist_transpose_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(retile_annotations_plugin,
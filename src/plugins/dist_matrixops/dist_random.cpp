@@ -21,6 +21,7 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/collectives.hpp>
 
 #include <array>
 #include <atomic>
@@ -79,7 +80,11 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             Returns:
 
             A part of an array of random numbers on tile_index-th tile out of
-            numtiles using the normal distribution)")
+            numtiles using the normal distribution. The generated values
+            depend on the seed (the one of the locality creating the first
+            tile), the array name, and the position of the elements in the
+            overall array only, i.e. the tiles of an array put together are
+            the same for any number of tiles.)")
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -95,6 +100,26 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
             return std::move(given_name);
         }
+
+        // All tiles of an array have to use the same seed. Unless it was set
+        // explicitly, each locality starts off with a different seed, thus
+        // all tiles use the seed of the first one.
+        std::uint32_t random_d_seed(std::string const& base_name,
+            std::uint64_t invocation, std::uint32_t tile_idx,
+            std::uint32_t numtiles)
+        {
+            std::uint32_t const seed = util::get_seed();
+            if (numtiles == 1)
+            {
+                return seed;
+            }
+
+            std::vector<std::uint32_t> seeds =
+                hpx::all_gather(("random_d_seed/" + base_name).c_str(), seed,
+                    numtiles, invocation + 1, tile_idx)
+                    .get();
+            return seeds[0];
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -126,6 +151,16 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         std::string base_name =
             detail::generate_random_name(std::move(given_name));
 
+        // all tiles of the array use the same seed and stream (a new one for
+        // every array of the same name), the elements are generated based on
+        // their global offset
+        std::uint64_t const invocation =
+            util::next_random_invocation(base_name);
+        std::uint64_t const stream =
+            util::random_stream(base_name, invocation);
+        std::uint32_t const seed =
+            detail::random_d_seed(base_name, invocation, tile_idx, numtiles);
+
         annotation_information ann_info(
             std::move(base_name), 0);    //generation 0
 
@@ -135,10 +170,11 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                 codename_));
 
         blaze::DynamicVector<double> v(size);
-        for (std::size_t i = 0; i != size; ++i)
-        {
-            v[i] = dist(util::rng_);
-        }
+        util::parallel_random_fill(dist, size,
+            [&](std::normal_distribution<>& d, std::size_t i)
+            {
+                v[i] = util::random_value(d, seed, stream, start + i);
+            });
 
         return primitive_argument_type(std::move(v), attached_annotation);
     }
@@ -173,6 +209,16 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         std::string base_name =
             detail::generate_random_name(std::move(given_name));
 
+        // all tiles of the array use the same seed and stream (a new one for
+        // every array of the same name), the elements are generated based on
+        // their global (row major) offset
+        std::uint64_t const invocation =
+            util::next_random_invocation(base_name);
+        std::uint64_t const stream =
+            util::random_stream(base_name, invocation);
+        std::uint32_t const seed =
+            detail::random_d_seed(base_name, invocation, tile_idx, numtiles);
+
         annotation_information ann_info(
             std::move(base_name), 0);    //generation 0
 
@@ -182,13 +228,14 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                 ann_info, name_, codename_));
 
         blaze::DynamicMatrix<double> m(row_size, column_size);
-        for (std::size_t i = 0; i != row_size; ++i)
-        {
-            for (std::size_t j = 0; j != column_size; ++j)
+        util::parallel_random_fill(dist, row_size * column_size,
+            [&](std::normal_distribution<>& d, std::size_t idx)
             {
-                m(i, j) = dist(util::rng_);
-            }
-        }
+                std::size_t const i = idx / column_size;
+                std::size_t const j = idx % column_size;
+                m(i, j) = util::random_value(d, seed, stream,
+                    (row_start + i) * columns + column_start + j);
+            });
 
         return primitive_argument_type(std::move(m), attached_annotation);
     }
@@ -225,6 +272,16 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         std::string base_name =
             detail::generate_random_name(std::move(given_name));
 
+        // all tiles of the array use the same seed and stream (a new one for
+        // every array of the same name), the elements are generated based on
+        // their global (row major) offset
+        std::uint64_t const invocation =
+            util::next_random_invocation(base_name);
+        std::uint64_t const stream =
+            util::random_stream(base_name, invocation);
+        std::uint32_t const seed =
+            detail::random_d_seed(base_name, invocation, tile_idx, numtiles);
+
         annotation_information ann_info(
             std::move(base_name), 0);    //generation 0
 
@@ -234,16 +291,16 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                 ann_info, name_, codename_));
 
         blaze::DynamicTensor<double> t(page_size, row_size, column_size);
-        for (std::size_t k = 0; k != page_size; ++k)
-        {
-            for (std::size_t i = 0; i != row_size; ++i)
+        util::parallel_random_fill(dist, page_size * row_size * column_size,
+            [&](std::normal_distribution<>& d, std::size_t idx)
             {
-                for (std::size_t j = 0; j != column_size; ++j)
-                {
-                    t(k, i, j) = dist(util::rng_);
-                }
-            }
-        }
+                std::size_t const j = idx % column_size;
+                std::size_t const i = (idx / column_size) % row_size;
+                std::size_t const k = idx / (column_size * row_size);
+                t(k, i, j) = util::random_value(d, seed, stream,
+                    ((page_start + k) * rows + row_start + i) * columns +
+                        column_start + j);
+            });
 
         return primitive_argument_type(std::move(t), attached_annotation);
     }
@@ -0,0 +1,181 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_lu_engine.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_solve.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/modules/collectives.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const dist_solve::match_data =
+    {
+        hpx::make_tuple("solve_d", std::vector<std::string>{R"(
+                solve_d(_1_a, _2_b)
+            )"},
+            &create_dist_solve, &execution_tree::create_primitive<dist_solve>,
+            R"(
+            a, b
+            Args:
+
+                a (array): a square matrix that is tiled by columns
+                b (array): the right hand side, a vector or a matrix that is
+                    available on all localities
+
+            Returns:
+
+            The solution x of the linear system a x = b (on all localities).
+            The solution is calculated from the distributed LU factorization
+            of a, without forming its inverse.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_solve::dist_solve(execution_tree::primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::primitive_argument_type dist_solve::solve(
+        execution_tree::primitive_argument_type&& lhs,
+        execution_tree::primitive_argument_type&& rhs) const
+    {
+        using namespace execution_tree;
+
+        localities_information localities =
+            extract_localities_information(lhs, name_, codename_);
+
+        std::size_t const n = localities.rows(name_, codename_);
+
+        auto b = extract_numeric_value(std::move(rhs), name_, codename_);
+        std::size_t const b_dims = b.num_dimensions();
+        if ((b_dims != 1 && b_dims != 2) || b.dimension(0) != n)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_solve::solve",
+                generate_error_message(
+                    "the right hand side has to be a vector or a matrix "
+                    "with as many rows as the left hand side matrix"));
+        }
+
+        std::string const basename = dist_lu_basename(localities);
+
+        dist_lu_factors factors = dist_lu_factorize(
+            blaze::DynamicMatrix<double>(
+                extract_numeric_value(std::move(lhs), name_, codename_)
+                    .matrix()),
+            localities, basename, name_, codename_);
+
+        blaze::DynamicMatrix<double> rhs_matrix;
+        if (b_dims == 1)
+        {
+            rhs_matrix.resize(n, 1);
+            blaze::column(rhs_matrix, 0) = b.vector();
+        }
+        else
+        {
+            rhs_matrix = b.matrix();
+        }
+
+        // every locality solves for the rows of x corresponding to its
+        // columns of a, collect the complete solution
+        blaze::DynamicMatrix<double> local_x = dist_lu_solve(
+            factors, rhs_matrix, localities, basename, name_, codename_);
+
+        std::uint32_t const num_localities =
+            localities.locality_.num_localities_;
+
+        blaze::DynamicMatrix<double> x;
+        if (num_localities == 1)
+        {
+            x = std::move(local_x);
+        }
+        else
+        {
+            std::vector<blaze::DynamicMatrix<double>> parts =
+                hpx::all_gather((basename + "_gather").c_str(),
+                    std::move(local_x), num_localities, 1,
+                    localities.locality_.locality_id_)
+                    .get();
+
+            x.resize(n, rhs_matrix.columns());
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                auto const& columns = localities.tiles_[loc].spans_[1];
+                blaze::submatrix(x, columns.start_, 0, columns.size(),
+                    x.columns()) = parts[loc];
+            }
+        }
+
+        if (b_dims == 1)
+        {
+            return primitive_argument_type{
+                blaze::DynamicVector<double>(blaze::column(x, 0))};
+        }
+        return primitive_argument_type{std::move(x)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> dist_solve::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_solve::eval",
+                generate_error_message(
+                    "the solve_d primitive requires exactly two operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_solve::eval",
+                generate_error_message(
+                    "the solve_d primitive requires that the arguments given "
+                    "by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](
+                    execution_tree::primitive_arguments_type&& args)
+                    -> execution_tree::primitive_argument_type {
+                    if (execution_tree::extract_numeric_value_dimension(
+                            args[0], this_->name_, this_->codename_) != 2)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_solve::eval",
+                            this_->generate_error_message(
+                                "the solve_d primitive requires the left "
+                                "hand side to be a matrix"));
+                    }
+                    return this_->solve(std::move(args[0]), std::move(args[1]));
+                }),
+            execution_tree::primitives::detail::map_operands(operands,
+                execution_tree::functional::value_operand{}, args, name_,
+                codename_, std::move(ctx)));
+    }
+}}}
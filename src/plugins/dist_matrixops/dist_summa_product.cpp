@@ -0,0 +1,336 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_summa_product.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const dist_summa_product::match_data =
+    {
+        execution_tree::match_pattern_type{
+            "summa_product_d",
+            std::vector<std::string>{
+                "summa_product_d(_1, _2, __arg(_3_prefetch_depth, nil))"},
+            &create_dist_summa_product,
+            &execution_tree::create_primitive<dist_summa_product>,
+            R"(a, b, prefetch_depth
+            Args:
+
+                a (array) : a matrix
+                b (array) : a matrix
+                prefetch_depth (int, optional) : the number of panels to
+                    fetch ahead, defaults to the configuration setting
+                    `phylanx.summa.prefetch_depth` (2 if not set)
+
+            Returns:
+
+            The dot product of two matrices: `a` and `b` using the SUMMA
+            algorithm. The dot product of an MxN matrix and an NxL is of size
+            MxL. The tiles of both matrices have to form a (possibly
+            rectangular) grid of localities, each locality calculates the
+            tile of the result spanning the rows of its tile of `a` and the
+            columns of its tile of `b`. The partial products are accumulated
+            in the order the remote tiles arrive.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t summa_prefetch_depth()
+    {
+        static std::size_t prefetch_depth = []() -> std::size_t {
+            std::size_t depth = std::stoul(
+                hpx::get_config_entry("phylanx.summa.prefetch_depth", "2"));
+            return depth != 0 ? depth : 1;
+        }();
+        return prefetch_depth;
+    }
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct summa_range
+        {
+            std::int64_t start_;
+            std::int64_t stop_;
+            std::uint32_t owner_;
+        };
+
+        // verify that the given ranges cover [0, size) without any gaps
+        void verify_summa_ranges(std::vector<summa_range>& ranges,
+            std::int64_t size, std::string const& name,
+            std::string const& codename)
+        {
+            std::sort(ranges.begin(), ranges.end(),
+                [](summa_range const& lhs, summa_range const& rhs) {
+                    return lhs.start_ < rhs.start_;
+                });
+
+            std::int64_t start = 0;
+            for (auto const& r : ranges)
+            {
+                if (r.start_ != start)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_summa_product::summa_panels",
+                        util::generate_error_message(
+                            "the tiles of the operands do not form a grid "
+                            "of localities",
+                            name, codename));
+                }
+                start = r.stop_;
+            }
+
+            if (start != size)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_summa_product::summa_panels",
+                    util::generate_error_message(
+                        "the tiles of the operands do not form a grid "
+                        "of localities",
+                        name, codename));
+            }
+        }
+
+        std::vector<summa_panel> summa_panels(
+            execution_tree::localities_information const& lhs_localities,
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& name, std::string const& codename)
+        {
+            execution_tree::tiling_span const lhs_rows =
+                lhs_localities.get_span(0);
+            execution_tree::tiling_span const rhs_columns =
+                rhs_localities.get_span(1);
+
+            // the lhs tiles in the same grid row and the rhs tiles in the
+            // same grid column as this locality
+            std::vector<summa_range> lhs_ranges;
+            std::vector<summa_range> rhs_ranges;
+
+            std::uint32_t const num_localities =
+                lhs_localities.locality_.num_localities_;
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                auto const& lhs_tile = lhs_localities.tiles_[loc];
+                if (lhs_tile.spans_[0].start_ == lhs_rows.start_ &&
+                    lhs_tile.spans_[0].stop_ == lhs_rows.stop_ &&
+                    lhs_tile.spans_[1].is_valid())
+                {
+                    lhs_ranges.push_back(summa_range{lhs_tile.spans_[1].start_,
+                        lhs_tile.spans_[1].stop_, loc});
+                }
+
+                auto const& rhs_tile = rhs_localities.tiles_[loc];
+                if (rhs_tile.spans_[1].start_ == rhs_columns.start_ &&
+                    rhs_tile.spans_[1].stop_ == rhs_columns.stop_ &&
+                    rhs_tile.spans_[0].is_valid())
+                {
+                    rhs_ranges.push_back(summa_range{rhs_tile.spans_[0].start_,
+                        rhs_tile.spans_[0].stop_, loc});
+                }
+            }
+
+            std::int64_t const size =
+                std::int64_t(lhs_localities.columns(name, codename));
+
+            verify_summa_ranges(lhs_ranges, size, name, codename);
+            verify_summa_ranges(rhs_ranges, size, name, codename);
+
+            // split the inner dimension at all tile boundaries
+            std::vector<summa_panel> panels;
+            panels.reserve(lhs_ranges.size() + rhs_ranges.size());
+
+            auto lhs_it = lhs_ranges.begin();
+            auto rhs_it = rhs_ranges.begin();
+            std::int64_t start = 0;
+            while (start != size)
+            {
+                std::int64_t const stop =
+                    (std::min)(lhs_it->stop_, rhs_it->stop_);
+
+                panels.push_back(summa_panel{std::size_t(start),
+                    std::size_t(stop), lhs_it->owner_, rhs_it->owner_,
+                    std::size_t(start - lhs_it->start_),
+                    std::size_t(start - rhs_it->start_)});
+
+                if (lhs_it->stop_ == stop)
+                {
+                    ++lhs_it;
+                }
+                if (rhs_it->stop_ == stop)
+                {
+                    ++rhs_it;
+                }
+                start = stop;
+            }
+
+            // start with the panels that are local to reduce the time spent
+            // waiting for the first remote tiles to arrive, rotate the
+            // remaining ones by the locality id to spread the requests
+            std::uint32_t const locality_id =
+                lhs_localities.locality_.locality_id_;
+            auto local_end = std::stable_partition(panels.begin(),
+                panels.end(), [&](summa_panel const& p) {
+                    return p.lhs_owner_ == locality_id &&
+                        p.rhs_owner_ == locality_id;
+                });
+            if (local_end != panels.end())
+            {
+                std::ptrdiff_t const num_remote = panels.end() - local_end;
+                std::rotate(local_end,
+                    local_end + std::ptrdiff_t(locality_id) % num_remote,
+                    panels.end());
+            }
+
+            return panels;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    dist_summa_product::dist_summa_product(
+            execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : execution_tree::primitives::primitive_component_base(
+            std::move(operands), name, codename)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    execution_tree::primitive_argument_type dist_summa_product::dot2d(
+        execution_tree::primitive_argument_type&& lhs,
+        execution_tree::primitive_argument_type&& rhs,
+        std::size_t prefetch_depth) const
+    {
+        using namespace execution_tree;
+
+        if (!lhs.has_annotation() || !rhs.has_annotation())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::dot2d",
+                generate_error_message(
+                    "the summa_product_d primitive requires both operands "
+                    "to be distributed"));
+        }
+
+        localities_information lhs_localities =
+            extract_localities_information(lhs, name_, codename_);
+        localities_information rhs_localities =
+            extract_localities_information(rhs, name_, codename_);
+
+        switch (extract_common_type(lhs, rhs))
+        {
+        case node_data_type_bool:
+            return dot2d2d(
+                extract_boolean_value(std::move(lhs), name_, codename_),
+                extract_boolean_value(std::move(rhs), name_, codename_),
+                std::move(lhs_localities), rhs_localities, prefetch_depth);
+
+        case node_data_type_int64:
+            return dot2d2d(
+                extract_integer_value(std::move(lhs), name_, codename_),
+                extract_integer_value(std::move(rhs), name_, codename_),
+                std::move(lhs_localities), rhs_localities, prefetch_depth);
+
+        case node_data_type_unknown:
+            HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return dot2d2d(
+                extract_numeric_value(std::move(lhs), name_, codename_),
+                extract_numeric_value(std::move(rhs), name_, codename_),
+                std::move(lhs_localities), rhs_localities, prefetch_depth);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_summa_product::dot2d",
+            generate_error_message(
+                "the summa_product_d primitive requires for all arguments "
+                "to be numeric data types"));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type>
+    dist_summa_product::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        using namespace execution_tree;
+
+        if (operands.size() < 2 || operands.size() > 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::eval",
+                generate_error_message(
+                    "the summa_product_d primitive requires two or three "
+                    "operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_summa_product::eval",
+                generate_error_message(
+                    "the summa_product_d primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type {
+                    std::size_t prefetch_depth = summa_prefetch_depth();
+                    if (args.size() == 3 && valid(args[2]))
+                    {
+                        prefetch_depth =
+                            extract_scalar_positive_integer_value_strict(
+                                std::move(args[2]), this_->name_,
+                                this_->codename_);
+                    }
+
+                    if (extract_numeric_value_dimension(
+                            args[0], this_->name_, this_->codename_) != 2)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_summa_product::eval",
+                            this_->generate_error_message(
+                                "left hand side operand has unsupported "
+                                "number of dimensions"));
+                    }
+
+                    return this_->dot2d(std::move(args[0]),
+                        std::move(args[1]), prefetch_depth);
+                }),
+            execution_tree::primitives::detail::map_operands(operands,
+                functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
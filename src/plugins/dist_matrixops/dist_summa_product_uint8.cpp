@@ -0,0 +1,27 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_summa_product.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_summa_product_impl.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    // explicitly instantiate the required functions
+
+    ///////////////////////////////////////////////////////////////////////////
+    template execution_tree::primitive_argument_type
+    dist_summa_product::dot2d2d(ir::node_data<std::uint8_t>&&,
+        ir::node_data<std::uint8_t>&&,
+        execution_tree::localities_information&& lhs_localities,
+        execution_tree::localities_information const& rhs_localities,
+        std::size_t prefetch_depth) const;
+}}}
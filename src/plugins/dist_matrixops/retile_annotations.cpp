@@ -26,11 +26,14 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -320,8 +323,252 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return tile_extraction_3d_helper(it, name, codename);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // A block of the new tile that is available from a given locality
+        struct retile_block
+        {
+            std::uint32_t locality_;
+            std::array<std::size_t, 3> local_start_;
+            std::array<std::size_t, 3> projected_start_;
+            std::array<std::size_t, 3> size_;
+        };
+
+        struct retile_plan
+        {
+            bool subset_ = false;         // new tile is part of the local one
+            bool has_local_ = false;      // local_ holds part of the new tile
+            bool overlapping_ = false;    // some of the blocks overlap
+            retile_block local_;
+            std::vector<retile_block> remote_;
+        };
+
+        inline bool blocks_overlap(retile_block const& lhs,
+            retile_block const& rhs, std::size_t numdims)
+        {
+            for (std::size_t d = 0; d != numdims; ++d)
+            {
+                if (lhs.projected_start_[d] >=
+                        rhs.projected_start_[d] + rhs.size_[d] ||
+                    rhs.projected_start_[d] >=
+                        lhs.projected_start_[d] + lhs.size_[d])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        retile_plan make_retile_plan(
+            execution_tree::localities_information const& arr_localities,
+            std::size_t numdims, std::array<std::size_t, 3> const& span_indices,
+            std::array<execution_tree::tiling_span, 3> const& des_spans)
+        {
+            std::uint32_t const loc_id = arr_localities.locality_.locality_id_;
+            std::uint32_t const num_localities =
+                arr_localities.locality_.num_localities_;
+
+            retile_plan plan;
+
+            // the local part of the new tile
+            auto const& cur_spans = arr_localities.tiles_[loc_id].spans_;
+
+            plan.subset_ = true;
+            plan.has_local_ = true;
+            plan.local_.locality_ = loc_id;
+            for (std::size_t d = 0; d != numdims; ++d)
+            {
+                auto const& cur = cur_spans[span_indices[d]];
+                auto const& des = des_spans[d];
+
+                if (des.start_ < cur.start_ || des.stop_ > cur.stop_)
+                {
+                    plan.subset_ = false;
+                }
+
+                if (des.start_ < cur.stop_ && des.stop_ > cur.start_)
+                {
+                    auto indices = util::index_calculation_1d(
+                        des.start_, des.stop_, cur.start_, cur.stop_);
+
+                    plan.local_.local_start_[d] = indices.local_start_;
+                    plan.local_.projected_start_[d] = indices.projected_start_;
+                    plan.local_.size_[d] = indices.intersection_size_;
+                }
+                else
+                {
+                    plan.has_local_ = false;
+                }
+            }
+
+            if (plan.subset_)
+            {
+                return plan;
+            }
+
+            // the blocks of the new tile available from remote localities
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                if (loc == loc_id)
+                {
+                    continue;
+                }
+
+                auto const& loc_spans = arr_localities.tiles_[loc].spans_;
+
+                retile_block block;
+                block.locality_ = loc;
+
+                bool intersects = true;
+                for (std::size_t d = 0; d != numdims; ++d)
+                {
+                    auto indices = util::retile_calculation_1d(
+                        loc_spans[span_indices[d]], des_spans[d].start_,
+                        des_spans[d].stop_);
+                    if (indices.intersection_size_ <= 0)
+                    {
+                        intersects = false;
+                        break;
+                    }
+
+                    block.local_start_[d] = indices.local_start_;
+                    block.projected_start_[d] = indices.projected_start_;
+                    block.size_[d] = indices.intersection_size_;
+                }
+
+                if (intersects)
+                {
+                    plan.remote_.push_back(block);
+                }
+            }
+
+            // blocks are copied into the result concurrently, overlapping
+            // blocks (tiles with intersections) have to be copied one by one
+            for (std::size_t i = 0;
+                 !plan.overlapping_ && i != plan.remote_.size(); ++i)
+            {
+                if (plan.has_local_ &&
+                    blocks_overlap(plan.local_, plan.remote_[i], numdims))
+                {
+                    plan.overlapping_ = true;
+                    break;
+                }
+                for (std::size_t j = i + 1; j != plan.remote_.size(); ++j)
+                {
+                    if (blocks_overlap(
+                            plan.remote_[i], plan.remote_[j], numdims))
+                    {
+                        plan.overlapping_ = true;
+                        break;
+                    }
+                }
+            }
+
+            return plan;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Fetch all remote blocks of the new tile at once, every block is
+        // copied into the result as soon as it has arrived.
+        template <typename Fetch, typename CopyLocal, typename CopyRemote>
+        void fetch_remote_blocks(retile_plan const& plan, Fetch&& fetch,
+            CopyLocal&& copy_local, CopyRemote&& copy_remote)
+        {
+            hpx::lcos::local::spinlock mtx;
+
+            std::vector<hpx::future<void>> blocks;
+            blocks.reserve(plan.remote_.size());
+
+            for (retile_block const& block : plan.remote_)
+            {
+                // resolving the id of the remote part may require an AGAS
+                // lookup, run those concurrently as well
+                blocks.push_back(hpx::async([&, block]()
+                {
+                    auto data = fetch(block).get();
+                    if (plan.overlapping_)
+                    {
+                        std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+                        copy_remote(block, data);
+                    }
+                    else
+                    {
+                        copy_remote(block, data);
+                    }
+                }));
+            }
+
+            // copy the local part while the remote blocks are in flight
+            if (plan.has_local_)
+            {
+                std::unique_lock<hpx::lcos::local::spinlock> l(
+                    mtx, std::defer_lock);
+                if (plan.overlapping_)
+                {
+                    l.lock();
+                }
+                copy_local(plan.local_);
+            }
+
+            hpx::wait_all(blocks);
+            for (auto&& f : blocks)
+            {
+                f.get();    // rethrow exceptions
+            }
+        }
     }    // namespace detail
 
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<detail::retile_plan const>
+    retile_annotations::get_retile_plan(
+        execution_tree::localities_information const& arr_localities,
+        std::size_t numdims, std::array<std::size_t, 3> const& span_indices,
+        std::array<execution_tree::tiling_span, 3> const& des_spans) const
+    {
+        // the plan depends on the current tiles of all localities and on the
+        // new local tile only
+        std::vector<std::int64_t> key;
+        key.reserve(2 * numdims * (arr_localities.tiles_.size() + 1) + 2);
+
+        key.push_back(numdims);
+        key.push_back(arr_localities.locality_.locality_id_);
+        for (std::size_t d = 0; d != numdims; ++d)
+        {
+            key.push_back(des_spans[d].start_);
+            key.push_back(des_spans[d].stop_);
+        }
+        for (auto const& tile : arr_localities.tiles_)
+        {
+            for (std::size_t d = 0; d != numdims; ++d)
+            {
+                key.push_back(tile.spans_[span_indices[d]].start_);
+                key.push_back(tile.spans_[span_indices[d]].stop_);
+            }
+        }
+
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(plans_mtx_);
+            auto it = plans_.find(key);
+            if (it != plans_.end())
+            {
+                return it->second;
+            }
+        }
+
+        auto plan = std::make_shared<detail::retile_plan const>(
+            detail::make_retile_plan(
+                arr_localities, numdims, span_indices, des_spans));
+
+        std::lock_guard<hpx::lcos::local::spinlock> l(plans_mtx_);
+
+        // a primitive is expected to see only a few different tilings
+        constexpr std::size_t max_cached_plans = 16;
+        if (plans_.size() >= max_cached_plans)
+        {
+            plans_.clear();
+        }
+        return plans_.emplace(std::move(key), std::move(plan)).first->second;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     execution_tree::primitive_argument_type retile_annotations::retile1d(
@@ -344,7 +591,6 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             arr_localities.tiles_[loc_id], name_, codename_);
 
         std::int64_t cur_start = tile_info.span_.start_;
-        std::int64_t cur_stop = tile_info.span_.stop_;
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
@@ -405,52 +651,35 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         util::distributed_vector<T> v_data(
             arr_localities.annotation_.name_, v, num_localities, loc_id);
 
-        // relative start
-        std::int64_t rel_start = des_start - cur_start;
-        if (rel_start < 0 || des_stop > cur_stop)
-        {
-            // there is a need to fetch some part
-
-            // copying the local part
-            if (des_start < cur_stop && des_stop > cur_start)
-            {
-                auto indices = util::index_calculation_1d(
-                    des_start, des_stop, cur_start, cur_stop);
-                blaze::subvector(result, indices.projected_start_,
-                    indices.intersection_size_) = blaze::subvector(v,
-                        indices.local_start_, indices.intersection_size_);
-            }
+        auto plan = get_retile_plan(arr_localities, 1, {span_index, 0, 0},
+            {tiling_span(des_start, des_stop), tiling_span(), tiling_span()});
 
-            // collecting other parts from remote localities
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
+        if (!plan->subset_)
+        {
+            // there is a need to fetch some part, all remote parts are
+            // requested at once
+            detail::fetch_remote_blocks(*plan,
+                [&](detail::retile_block const& b)
                 {
-                    continue;
-                }
-
-                // the array span in for loc-th locality
-                tiling_span loc_span =
-                    arr_localities.tiles_[loc].spans_[span_index];
-
-                auto indices =
-                    util::retile_calculation_1d(loc_span, des_start, des_stop);
-                if (indices.intersection_size_ > 0)
+                    return v_data.fetch(b.locality_, b.local_start_[0],
+                        b.local_start_[0] + b.size_[0]);
+                },
+                [&](detail::retile_block const& b)
                 {
-                    // loc_span has the part of result that we need
-                    blaze::subvector(result, indices.projected_start_,
-                        indices.intersection_size_) =
-                        v_data
-                        .fetch(loc, indices.local_start_,
-                            indices.local_start_ +
-                            indices.intersection_size_)
-                        .get();
-                }
-            }
+                    blaze::subvector(result, b.projected_start_[0],
+                        b.size_[0]) =
+                        blaze::subvector(v, b.local_start_[0], b.size_[0]);
+                },
+                [&](detail::retile_block const& b,
+                    blaze::DynamicVector<T> const& data)
+                {
+                    blaze::subvector(result, b.projected_start_[0],
+                        b.size_[0]) = data;
+                });
         }
         else // the new array is a subset of the original array
         {
-            result = blaze::subvector(v, rel_start, des_size);
+            result = blaze::subvector(v, des_start - cur_start, des_size);
         }
 
         // updating the tile information
@@ -542,9 +771,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             arr_localities.tiles_[loc_id], name_, codename_);
 
         std::int64_t cur_row_start = tile_info.spans_[0].start_;
-        std::int64_t cur_row_stop = tile_info.spans_[0].stop_;
         std::int64_t cur_col_start = tile_info.spans_[1].start_;
-        std::int64_t cur_col_stop = tile_info.spans_[1].stop_;
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
@@ -604,69 +831,39 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         util::distributed_matrix<T> m_data(
             arr_localities.annotation_.name_, m, num_localities, loc_id);
 
-        // relative starts
-        std::int64_t rel_row_start = des_row_start - cur_row_start;
-        std::int64_t rel_col_start = des_col_start - cur_col_start;
-        if ((rel_row_start < 0 || des_row_stop > cur_row_stop) ||
-            (rel_col_start < 0 || des_col_stop > cur_col_stop))
-        {
-            // copying the local part
-            if ((des_row_start < cur_row_stop &&
-                    des_row_stop > cur_row_start) &&
-                (des_col_start < cur_col_stop && des_col_stop > cur_col_start))
-            {
-                auto row_indices = util::index_calculation_1d(
-                    des_row_start, des_row_stop, cur_row_start, cur_row_stop);
-                auto col_indices = util::index_calculation_1d(
-                    des_col_start, des_col_stop, cur_col_start, cur_col_stop);
-
-                blaze::submatrix(result, row_indices.projected_start_,
-                    col_indices.projected_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_) = blaze::submatrix(m,
-                    row_indices.local_start_, col_indices.local_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_);
-            }
+        auto plan = get_retile_plan(arr_localities, 2, {0, 1, 0},
+            {tiling_span(des_row_start, des_row_stop),
+                tiling_span(des_col_start, des_col_stop), tiling_span()});
 
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
+        if (!plan->subset_)
+        {
+            // there is a need to fetch some blocks, all remote blocks are
+            // requested at once
+            detail::fetch_remote_blocks(*plan,
+                [&](detail::retile_block const& b)
                 {
-                    continue;
-                }
-
-                // the array span in locality loc
-                tiling_span loc_row_span = arr_localities.tiles_[loc].spans_[0];
-                tiling_span loc_col_span = arr_localities.tiles_[loc].spans_[1];
-
-                auto row_indices = util::retile_calculation_1d(
-                    loc_row_span, des_row_start, des_row_stop);
-                auto col_indices = util::retile_calculation_1d(
-                    loc_col_span, des_col_start, des_col_stop);
-                if (row_indices.intersection_size_ > 0 &&
-                    col_indices.intersection_size_ > 0)
+                    return m_data.fetch(b.locality_, b.local_start_[0],
+                        b.local_start_[1], b.local_start_[0] + b.size_[0],
+                        b.local_start_[1] + b.size_[1]);
+                },
+                [&](detail::retile_block const& b)
                 {
-                    // loc_span has the block of result that we need
-                    blaze::submatrix(result, row_indices.projected_start_,
-                        col_indices.projected_start_,
-                        row_indices.intersection_size_,
-                        col_indices.intersection_size_) =
-                        m_data
-                            .fetch(loc, row_indices.local_start_,
-                                col_indices.local_start_,
-                                row_indices.local_start_ +
-                                    row_indices.intersection_size_,
-                                col_indices.local_start_ +
-                                    col_indices.intersection_size_)
-                            .get();
-                }
-            }
+                    blaze::submatrix(result, b.projected_start_[0],
+                        b.projected_start_[1], b.size_[0], b.size_[1]) =
+                        blaze::submatrix(m, b.local_start_[0],
+                            b.local_start_[1], b.size_[0], b.size_[1]);
+                },
+                [&](detail::retile_block const& b,
+                    blaze::DynamicMatrix<T> const& data)
+                {
+                    blaze::submatrix(result, b.projected_start_[0],
+                        b.projected_start_[1], b.size_[0], b.size_[1]) = data;
+                });
         }
         else // the new array is a subset of the original array
         {
-            result = blaze::submatrix(
-                m, rel_row_start, rel_col_start, des_row_size, des_col_size);
+            result = blaze::submatrix(m, des_row_start - cur_row_start,
+                des_col_start - cur_col_start, des_row_size, des_col_size);
         }
 
         // updating the tile information
@@ -751,11 +948,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             arr_localities.tiles_[loc_id], name_, codename_);
 
         std::int64_t cur_page_start = tile_info.spans_[0].start_;
-        std::int64_t cur_page_stop = tile_info.spans_[0].stop_;
         std::int64_t cur_row_start = tile_info.spans_[1].start_;
-        std::int64_t cur_row_stop = tile_info.spans_[1].stop_;
         std::int64_t cur_col_start = tile_info.spans_[2].start_;
-        std::int64_t cur_col_stop = tile_info.spans_[2].stop_;
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
@@ -829,86 +1023,46 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         util::distributed_tensor<T> t_data(
             arr_localities.annotation_.name_, t, num_localities, loc_id);
 
-        // relative starts
-        std::int64_t rel_page_start = des_page_start - cur_page_start;
-        std::int64_t rel_row_start = des_row_start - cur_row_start;
-        std::int64_t rel_col_start = des_col_start - cur_col_start;
-        if ((rel_page_start < 0 || des_page_stop > cur_page_stop) ||
-            (rel_row_start < 0 || des_row_stop > cur_row_stop) ||
-            (rel_col_start < 0 || des_col_stop > cur_col_stop))
-        {
-            // copying the local part
-            if ((des_page_start < cur_page_stop &&
-                    des_page_stop > cur_page_start) &&
-                (des_row_start < cur_row_stop &&
-                    des_row_stop > cur_row_start) &&
-                (des_col_start < cur_col_stop && des_col_stop > cur_col_start))
-            {
-                auto page_indices = util::index_calculation_1d(des_page_start,
-                    des_page_stop, cur_page_start, cur_page_stop);
-                auto row_indices = util::index_calculation_1d(
-                    des_row_start, des_row_stop, cur_row_start, cur_row_stop);
-                auto col_indices = util::index_calculation_1d(
-                    des_col_start, des_col_stop, cur_col_start, cur_col_stop);
-
-                blaze::subtensor(result, page_indices.projected_start_,
-                    row_indices.projected_start_, col_indices.projected_start_,
-                    page_indices.intersection_size_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_) = blaze::subtensor(t,
-                    page_indices.local_start_, row_indices.local_start_,
-                    col_indices.local_start_, page_indices.intersection_size_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_);
-            }
+        auto plan = get_retile_plan(arr_localities, 3, {0, 1, 2},
+            {tiling_span(des_page_start, des_page_stop),
+                tiling_span(des_row_start, des_row_stop),
+                tiling_span(des_col_start, des_col_stop)});
 
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
+        if (!plan->subset_)
+        {
+            // there is a need to fetch some blocks, all remote blocks are
+            // requested at once
+            detail::fetch_remote_blocks(*plan,
+                [&](detail::retile_block const& b)
                 {
-                    continue;
-                }
-
-                // the array span in locality loc
-                tiling_span loc_page_span = arr_localities.tiles_[loc].spans_[0];
-                tiling_span loc_row_span = arr_localities.tiles_[loc].spans_[1];
-                tiling_span loc_col_span = arr_localities.tiles_[loc].spans_[2];
-
-                auto page_indices = util::retile_calculation_1d(
-                    loc_page_span, des_page_start, des_page_stop);
-                auto row_indices = util::retile_calculation_1d(
-                    loc_row_span, des_row_start, des_row_stop);
-                auto col_indices = util::retile_calculation_1d(
-                    loc_col_span, des_col_start, des_col_stop);
-                if (page_indices.intersection_size_ > 0 &&
-                    row_indices.intersection_size_ > 0 &&
-                    col_indices.intersection_size_ > 0)
+                    return t_data.fetch(b.locality_, b.local_start_[0],
+                        b.local_start_[1], b.local_start_[2],
+                        b.local_start_[0] + b.size_[0],
+                        b.local_start_[1] + b.size_[1],
+                        b.local_start_[2] + b.size_[2]);
+                },
+                [&](detail::retile_block const& b)
                 {
-                    // loc_span has the block of result that we need
-                    blaze::subtensor(result, page_indices.projected_start_,
-                        row_indices.projected_start_,
-                        col_indices.projected_start_,
-                        page_indices.intersection_size_,
-                        row_indices.intersection_size_,
-                        col_indices.intersection_size_) =
-                        t_data
-                            .fetch(loc, page_indices.local_start_,
-                                row_indices.local_start_,
-                                col_indices.local_start_,
-                                page_indices.local_start_ +
-                                    page_indices.intersection_size_,
-                                row_indices.local_start_ +
-                                    row_indices.intersection_size_,
-                                col_indices.local_start_ +
-                                    col_indices.intersection_size_)
-                            .get();
-                }
-            }
+                    blaze::subtensor(result, b.projected_start_[0],
+                        b.projected_start_[1], b.projected_start_[2],
+                        b.size_[0], b.size_[1], b.size_[2]) =
+                        blaze::subtensor(t, b.local_start_[0],
+                            b.local_start_[1], b.local_start_[2], b.size_[0],
+                            b.size_[1], b.size_[2]);
+                },
+                [&](detail::retile_block const& b,
+                    blaze::DynamicTensor<T> const& data)
+                {
+                    blaze::subtensor(result, b.projected_start_[0],
+                        b.projected_start_[1], b.projected_start_[2],
+                        b.size_[0], b.size_[1], b.size_[2]) = data;
+                });
         }
         else // the new array is a subset of the original array
         {
-            result = blaze::subtensor(t, rel_page_start, rel_row_start,
-                rel_col_start, des_page_size, des_row_size, des_col_size);
+            result = blaze::subtensor(t, des_page_start - cur_page_start,
+                des_row_start - cur_row_start, des_col_start - cur_col_start,
+                des_page_size, des_row_size, des_col_size);
         }
 
         // updating the tile information
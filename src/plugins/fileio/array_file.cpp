@@ -0,0 +1,795 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/array_file.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+#if defined(HPX_HAVE_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        constexpr char array_file_magic[8] = {
+            'P', 'H', 'Y', 'L', 'A', 'N', 'X', 'A'};
+        constexpr std::uint32_t array_file_version = 1;
+
+        // data offset and row length (in bytes) are multiples of this, which
+        // is sufficient for all SIMD instruction sets supported by blaze
+        constexpr std::uint32_t array_file_alignment = 64;
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct array_file_dtype_of;
+
+        template <>
+        struct array_file_dtype_of<std::uint8_t>
+        {
+            static constexpr array_file_dtype value = array_file_dtype::bool_;
+        };
+
+        template <>
+        struct array_file_dtype_of<std::int64_t>
+        {
+            static constexpr array_file_dtype value = array_file_dtype::int64;
+        };
+
+        template <>
+        struct array_file_dtype_of<double>
+        {
+            static constexpr array_file_dtype value =
+                array_file_dtype::float64;
+        };
+
+        inline std::size_t array_file_element_size(std::uint32_t dtype)
+        {
+            switch (static_cast<array_file_dtype>(dtype))
+            {
+            case array_file_dtype::bool_:
+                return sizeof(std::uint8_t);
+            case array_file_dtype::int64:
+                return sizeof(std::int64_t);
+            case array_file_dtype::float64:
+                return sizeof(double);
+            default:
+                break;
+            }
+            return 0;
+        }
+
+        // number of elements a row of the given length is padded to
+        inline std::uint64_t array_file_spacing(
+            std::uint64_t columns, std::size_t element_size)
+        {
+            std::uint64_t n = array_file_alignment / element_size;
+            return (columns + n - 1) / n * n;
+        }
+
+        // number of rows, i.e. the product of all but the last dimension
+        inline std::uint64_t array_file_rows(array_file_header const& h)
+        {
+            std::uint64_t rows = 1;
+            for (std::uint32_t i = 0; i + 1 < h.rank; ++i)
+            {
+                rows *= h.shape[i];
+            }
+            return rows;
+        }
+
+        inline std::uint64_t array_file_columns(array_file_header const& h)
+        {
+            return h.rank == 0 ? 1 : h.shape[h.rank - 1];
+        }
+
+        inline std::uint64_t array_file_data_size(array_file_header const& h)
+        {
+            return array_file_rows(h) * h.spacing *
+                array_file_element_size(h.dtype);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        array_file_header make_array_file_header(ir::node_data<T> const& data)
+        {
+            array_file_header h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, array_file_magic, sizeof(h.magic));
+
+            h.version = array_file_version;
+            h.dtype = static_cast<std::uint32_t>(array_file_dtype_of<T>::value);
+            h.rank = static_cast<std::uint32_t>(data.num_dimensions());
+            h.alignment = array_file_alignment;
+
+            auto dims = data.dimensions();
+            for (std::uint32_t i = 0; i != h.rank; ++i)
+            {
+                h.shape[i] = dims[i];
+            }
+
+            h.spacing = array_file_spacing(array_file_columns(h), sizeof(T));
+            h.data_offset = sizeof(array_file_header);
+            return h;
+        }
+
+        inline void check_array_file_header(array_file_header const& h,
+            std::uint64_t file_size, std::string const& filename,
+            std::string const& name, std::string const& codename)
+        {
+            std::string error;
+            if (std::memcmp(h.magic, array_file_magic, sizeof(h.magic)) != 0)
+            {
+                error = "not a phylanx array file: ";
+            }
+            else if (h.version != array_file_version)
+            {
+                error = "unsupported version (or byte order) of array file: ";
+            }
+            else if (array_file_element_size(h.dtype) == 0 || h.rank > 4 ||
+                h.alignment == 0 || h.data_offset % h.alignment != 0 ||
+                h.spacing < array_file_columns(h))
+            {
+                error = "invalid header in array file: ";
+            }
+            else if (h.data_offset + array_file_data_size(h) > file_size)
+            {
+                error = "unexpected end of array file: ";
+            }
+
+            if (!error.empty())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::"
+                    "check_array_file_header",
+                    util::generate_error_message(
+                        error + filename, name, codename));
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Invoke f for a pointer to each of the rows of the given array
+        template <typename T, typename F>
+        void for_each_array_row(ir::node_data<T> const& data, F&& f)
+        {
+            switch (data.num_dimensions())
+            {
+            case 0:
+                {
+                    T value = data.scalar();
+                    f(&value);
+                }
+                break;
+
+            case 1:
+                f(data.vector().data());
+                break;
+
+            case 2:
+                {
+                    auto m = data.matrix();
+                    for (std::size_t i = 0; i != m.rows(); ++i)
+                    {
+                        f(m.data(i));
+                    }
+                }
+                break;
+
+            case 3:
+                {
+                    auto t = data.tensor();
+                    for (std::size_t k = 0; k != t.pages(); ++k)
+                    {
+                        for (std::size_t i = 0; i != t.rows(); ++i)
+                        {
+                            f(t.data(i, k));
+                        }
+                    }
+                }
+                break;
+
+            case 4:
+                {
+                    auto q = data.quatern();
+                    std::vector<T> row(q.columns());
+                    for (std::size_t l = 0; l != q.quats(); ++l)
+                    {
+                        for (std::size_t k = 0; k != q.pages(); ++k)
+                        {
+                            for (std::size_t i = 0; i != q.rows(); ++i)
+                            {
+                                for (std::size_t j = 0; j != q.columns(); ++j)
+                                {
+                                    row[j] = q(l, k, i, j);
+                                }
+                                f(row.data());
+                            }
+                        }
+                    }
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        template <typename T>
+        void write_array_rows(std::ostream& os, ir::node_data<T> const& data,
+            std::size_t columns, std::size_t spacing)
+        {
+            std::vector<T> const padding(spacing - columns, T(0));
+            for_each_array_row(data, [&](T const* row) {
+                os.write(reinterpret_cast<char const*>(row),
+                    columns * sizeof(T));
+                os.write(reinterpret_cast<char const*>(padding.data()),
+                    padding.size() * sizeof(T));
+            });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        void append_array_file(std::fstream& file,
+            array_file_header const& new_header, ir::node_data<T> const& data,
+            std::string const& filename, std::string const& name,
+            std::string const& codename)
+        {
+            file.seekg(0, std::ios::end);
+            std::uint64_t file_size = file.tellg();
+
+            array_file_header h;
+            file.seekg(0);
+            if (!file.read(reinterpret_cast<char*>(&h), sizeof(h)))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::append_array_file",
+                    util::generate_error_message(
+                        "unexpected end of array file: " + filename, name,
+                        codename));
+            }
+            check_array_file_header(h, file_size, filename, name, codename);
+
+            bool compatible = h.dtype == new_header.dtype &&
+                h.rank == new_header.rank && h.rank != 0;
+            for (std::uint32_t i = 1; compatible && i < h.rank; ++i)
+            {
+                compatible = h.shape[i] == new_header.shape[i];
+            }
+            if (!compatible)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::append_array_file",
+                    util::generate_error_message(
+                        "the appended array must have the same data type, "
+                        "the same number of dimensions (at least one), and "
+                        "the same extents (except for the first dimension) "
+                        "as the array stored in the file: " + filename,
+                        name, codename));
+            }
+
+            if (h.rank == 1)
+            {
+                // overwrite the padding at the end of the existing vector
+                std::uint64_t size = h.shape[0] + new_header.shape[0];
+                std::uint64_t spacing = array_file_spacing(size, sizeof(T));
+
+                file.seekp(h.data_offset + h.shape[0] * sizeof(T));
+                write_array_rows(file, data, new_header.shape[0],
+                    spacing - h.shape[0]);
+
+                h.shape[0] = size;
+                h.spacing = spacing;
+            }
+            else
+            {
+                file.seekp(h.data_offset + array_file_data_size(h));
+                write_array_rows(file, data, new_header.shape[h.rank - 1],
+                    h.spacing);
+
+                h.shape[0] += new_header.shape[0];
+            }
+
+            // update the header only after all data was written
+            file.flush();
+            file.seekp(0);
+            file.write(reinterpret_cast<char const*>(&h), sizeof(h));
+        }
+
+#if defined(HPX_HAVE_UNISTD_H)
+        // Create a new file next to the given one that is used to write the
+        // data before moving it into place. Arrays read from the existing
+        // file may still refer to its (mapped) content, which must not
+        // change underneath them.
+        inline std::string create_temporary_array_file(
+            std::string const& filename, std::string const& name,
+            std::string const& codename)
+        {
+            static std::atomic<std::uint64_t> count(0);
+
+            int fd = -1;
+            std::string tmpname;
+            for (int retry = 0; fd == -1 && retry != 100; ++retry)
+            {
+                tmpname = filename + "." + std::to_string(::getpid()) + "." +
+                    std::to_string(++count) + ".tmp";
+                fd = ::open(tmpname.c_str(), O_WRONLY | O_CREAT | O_EXCL,
+                    0666);
+                if (fd == -1 && errno != EEXIST)
+                {
+                    break;
+                }
+            }
+
+            if (fd == -1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::"
+                    "create_temporary_array_file",
+                    util::generate_error_message(
+                        "couldn't create temporary file for: " + filename,
+                        name, codename));
+            }
+            ::close(fd);
+            return tmpname;
+        }
+#endif
+
+        template <typename T>
+        void write_array_file(std::string const& filename,
+            ir::node_data<T> const& data, bool append, std::string const& name,
+            std::string const& codename)
+        {
+            array_file_header h = make_array_file_header(data);
+
+            // Appending leaves the existing array data in place (only the
+            // header and the padding following the data are modified), thus
+            // it doesn't affect arrays that were read from the file before.
+            if (append)
+            {
+                std::fstream file(filename.c_str(),
+                    std::ios::binary | std::ios::in | std::ios::out);
+                if (file.is_open())
+                {
+                    append_array_file(file, h, data, filename, name, codename);
+
+                    file.flush();
+                    if (!file)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "phylanx::execution_tree::primitives::"
+                            "write_array_file",
+                            util::generate_error_message(
+                                "couldn't write array data to file: " +
+                                    filename,
+                                name, codename));
+                    }
+                    return;
+                }
+            }
+
+            // A new file is written under a temporary name and renamed over
+            // the target afterwards. Truncating the existing file instead
+            // would modify (or cut short) the mappings of arrays that were
+            // read from it.
+#if defined(HPX_HAVE_UNISTD_H)
+            std::string const tmpname =
+                create_temporary_array_file(filename, name, codename);
+#else
+            std::string const& tmpname = filename;
+#endif
+            std::ofstream file(tmpname.c_str(),
+                std::ios::binary | std::ios::out | std::ios::trunc);
+            if (!file.is_open())
+            {
+                std::remove(tmpname.c_str());
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::write_array_file",
+                    util::generate_error_message(
+                        "couldn't open file: " + filename, name, codename));
+            }
+
+            file.write(reinterpret_cast<char const*>(&h), sizeof(h));
+            write_array_rows(file, data, array_file_columns(h), h.spacing);
+
+            file.close();
+            if (!file)
+            {
+                std::remove(tmpname.c_str());
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::write_array_file",
+                    util::generate_error_message(
+                        "couldn't write array data to file: " + filename, name,
+                        codename));
+            }
+
+#if defined(HPX_HAVE_UNISTD_H)
+            if (std::rename(tmpname.c_str(), filename.c_str()) != 0)
+            {
+                std::remove(tmpname.c_str());
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::write_array_file",
+                    util::generate_error_message(
+                        "couldn't replace file: " + filename, name, codename));
+            }
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Read the array data from the given stream into newly allocated
+        // storage
+        template <typename T>
+        primitive_argument_type read_array_copy(std::istream& is,
+            array_file_header const& h)
+        {
+            std::size_t const columns = array_file_columns(h);
+            std::size_t const padding = (h.spacing - columns) * sizeof(T);
+
+            is.seekg(h.data_offset);
+            auto read_row = [&](T* row) {
+                is.read(reinterpret_cast<char*>(row), columns * sizeof(T));
+                is.ignore(padding);
+            };
+
+            switch (h.rank)
+            {
+            case 0:
+                {
+                    T value = T();
+                    read_row(&value);
+                    return primitive_argument_type{ir::node_data<T>{value}};
+                }
+
+            case 1:
+                {
+                    blaze::DynamicVector<T> v(h.shape[0]);
+                    read_row(v.data());
+                    return primitive_argument_type{
+                        ir::node_data<T>{std::move(v)}};
+                }
+
+            case 2:
+                {
+                    blaze::DynamicMatrix<T> m(h.shape[0], h.shape[1]);
+                    for (std::size_t i = 0; i != m.rows(); ++i)
+                    {
+                        read_row(m.data(i));
+                    }
+                    return primitive_argument_type{
+                        ir::node_data<T>{std::move(m)}};
+                }
+
+            case 3:
+                {
+                    blaze::DynamicTensor<T> t(
+                        h.shape[0], h.shape[1], h.shape[2]);
+                    for (std::size_t k = 0; k != t.pages(); ++k)
+                    {
+                        for (std::size_t i = 0; i != t.rows(); ++i)
+                        {
+                            read_row(t.data(i, k));
+                        }
+                    }
+                    return primitive_argument_type{
+                        ir::node_data<T>{std::move(t)}};
+                }
+
+            default:
+                break;
+            }
+
+            blaze::DynamicArray<4UL, T> q(
+                h.shape[0], h.shape[1], h.shape[2], h.shape[3]);
+            std::vector<T> row(columns);
+            for (std::size_t l = 0; l != q.quats(); ++l)
+            {
+                for (std::size_t k = 0; k != q.pages(); ++k)
+                {
+                    for (std::size_t i = 0; i != q.rows(); ++i)
+                    {
+                        read_row(row.data());
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            q(l, k, i, j) = row[j];
+                        }
+                    }
+                }
+            }
+            return primitive_argument_type{ir::node_data<T>{std::move(q)}};
+        }
+
+        inline primitive_argument_type read_array_copy(
+            std::string const& filename, std::string const& name,
+            std::string const& codename)
+        {
+            std::ifstream file(
+                filename.c_str(), std::ios::binary | std::ios::in);
+            if (!file.is_open())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::read_array_file",
+                    util::generate_error_message(
+                        "couldn't open file: " + filename, name, codename));
+            }
+
+            file.seekg(0, std::ios::end);
+            std::uint64_t file_size = file.tellg();
+            file.seekg(0);
+
+            array_file_header h;
+            std::memset(&h, 0, sizeof(h));
+            file.read(reinterpret_cast<char*>(&h), sizeof(h));
+            check_array_file_header(h, file_size, filename, name, codename);
+
+            primitive_argument_type result;
+            switch (static_cast<array_file_dtype>(h.dtype))
+            {
+            case array_file_dtype::bool_:
+                result = read_array_copy<std::uint8_t>(file, h);
+                break;
+
+            case array_file_dtype::int64:
+                result = read_array_copy<std::int64_t>(file, h);
+                break;
+
+            default:
+                result = read_array_copy<double>(file, h);
+                break;
+            }
+
+            if (!file)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::read_array_file",
+                    util::generate_error_message(
+                        "couldn't read array data from file: " + filename,
+                        name, codename));
+            }
+            return result;
+        }
+
+#if defined(HPX_HAVE_UNISTD_H)
+        ///////////////////////////////////////////////////////////////////////
+        // The arrays returned by read_array_file refer to the mapped memory,
+        // the mapping is released once the last array referring to it goes
+        // away.
+        struct mapped_array_file
+        {
+            mapped_array_file(void* base, std::size_t size)
+              : base_(base)
+              , size_(size)
+            {
+            }
+
+            mapped_array_file(mapped_array_file const&) = delete;
+            mapped_array_file& operator=(mapped_array_file const&) = delete;
+
+            ~mapped_array_file()
+            {
+                ::munmap(base_, size_);
+            }
+
+            void* base_;
+            std::size_t size_;
+        };
+
+        // Create an array referring to the given mapped data, the shared
+        // storage of the array keeps the mapping alive.
+        template <typename T, typename Storage>
+        primitive_argument_type make_mapped_array(Storage&& data,
+            std::shared_ptr<mapped_array_file> const& mapping)
+        {
+            using storage = ir::node_data<T>;
+            std::shared_ptr<storage> shared(
+                new storage{std::forward<Storage>(data)},
+                [mapping](storage* p) { delete p; });
+            return primitive_argument_type{storage{std::move(shared)}};
+        }
+
+        // wrap the mapped data without copying it
+        template <typename T>
+        primitive_argument_type wrap_array(T* data, array_file_header const& h,
+            std::shared_ptr<mapped_array_file> const& mapping)
+        {
+            using storage = ir::node_data<T>;
+            switch (h.rank)
+            {
+            case 0:
+                return primitive_argument_type{storage{*data}};
+
+            case 1:
+                return make_mapped_array<T>(
+                    typename storage::custom_storage1d_type(data, h.shape[0]),
+                    mapping);
+
+            case 2:
+                return make_mapped_array<T>(
+                    typename storage::custom_storage2d_type(
+                        data, h.shape[0], h.shape[1], h.spacing),
+                    mapping);
+
+            case 3:
+                return make_mapped_array<T>(
+                    typename storage::custom_storage3d_type(data,
+                        h.shape[0], h.shape[1], h.shape[2], h.spacing),
+                    mapping);
+
+            default:
+                break;
+            }
+
+            return make_mapped_array<T>(
+                typename storage::custom_storage4d_type(data, h.shape[0],
+                    h.shape[1], h.shape[2], h.shape[3], h.spacing),
+                mapping);
+        }
+
+        // the blaze custom types require the elements to be naturally
+        // aligned only
+        template <typename T>
+        bool can_wrap_array(array_file_header const& h)
+        {
+            return h.data_offset % alignof(T) == 0;
+        }
+
+        inline bool can_wrap_array(array_file_header const& h)
+        {
+            switch (static_cast<array_file_dtype>(h.dtype))
+            {
+            case array_file_dtype::bool_:
+                return can_wrap_array<std::uint8_t>(h);
+
+            case array_file_dtype::int64:
+                return can_wrap_array<std::int64_t>(h);
+
+            default:
+                break;
+            }
+            return can_wrap_array<double>(h);
+        }
+
+        inline primitive_argument_type read_array_mapped(
+            std::string const& filename, std::string const& name,
+            std::string const& codename)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::read_array_file",
+                    util::generate_error_message(
+                        "couldn't open file: " + filename, name, codename));
+            }
+
+            struct stat st;
+            void* base = MAP_FAILED;
+            std::size_t size = 0;
+            if (::fstat(fd, &st) == 0 && st.st_size != 0)
+            {
+                size = static_cast<std::size_t>(st.st_size);
+
+                // private (copy-on-write) mapping, modifications of the
+                // returned array never make it back into the file
+                base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+
+            if (base == MAP_FAILED)
+            {
+                return read_array_copy(filename, name, codename);
+            }
+
+            auto mapping = std::make_shared<mapped_array_file>(base, size);
+
+            array_file_header h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(&h, base, (std::min)(size, sizeof(h)));
+            check_array_file_header(h, size, filename, name, codename);
+
+            if (!can_wrap_array(h))
+            {
+                return read_array_copy(filename, name, codename);
+            }
+
+            char* data = static_cast<char*>(base) + h.data_offset;
+
+            primitive_argument_type result;
+            switch (static_cast<array_file_dtype>(h.dtype))
+            {
+            case array_file_dtype::bool_:
+                result = wrap_array(
+                    reinterpret_cast<std::uint8_t*>(data), h, mapping);
+                break;
+
+            case array_file_dtype::int64:
+                result = wrap_array(
+                    reinterpret_cast<std::int64_t*>(data), h, mapping);
+                break;
+
+            default:
+                result = wrap_array(
+                    reinterpret_cast<double*>(data), h, mapping);
+                break;
+            }
+
+            return result;
+        }
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void write_array_file(std::string const& filename,
+        primitive_argument_type const& data, bool append,
+        std::string const& name, std::string const& codename)
+    {
+        switch (extract_common_type(data))
+        {
+        case node_data_type_bool:
+            detail::write_array_file(filename,
+                extract_boolean_value_strict(data, name, codename), append,
+                name, codename);
+            return;
+
+        case node_data_type_int64:
+            detail::write_array_file(filename,
+                extract_integer_value_strict(data, name, codename), append,
+                name, codename);
+            return;
+
+        case node_data_type_unknown:
+            HPX_FALLTHROUGH;
+        case node_data_type_double:
+            detail::write_array_file(filename,
+                extract_numeric_value(data, name, codename), append, name,
+                codename);
+            return;
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::execution_tree::primitives::write_array_file",
+            util::generate_error_message(
+                "array files can hold numeric data only", name, codename));
+    }
+
+    primitive_argument_type read_array_file(std::string const& filename,
+        bool copy, std::string const& name, std::string const& codename)
+    {
+#if defined(HPX_HAVE_UNISTD_H)
+        if (!copy)
+        {
+            return detail::read_array_mapped(filename, name, codename);
+        }
+#endif
+        return detail::read_array_copy(filename, name, codename);
+    }
+}}}
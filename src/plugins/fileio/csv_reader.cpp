@@ -0,0 +1,487 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/fileio/csv_reader.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+
+#include <boost/spirit/include/qi_no_case.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+#include <boost/spirit/include/qi_real.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(HPX_HAVE_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        // files are split into chunks of at least this size (in bytes)
+        constexpr std::size_t csv_min_chunk_size = 1024 * 1024;
+
+        ///////////////////////////////////////////////////////////////////////
+        inline char const* find_eol(char const* it, char const* end)
+        {
+            void const* p = std::memchr(it, '\n', end - it);
+            return p != nullptr ? static_cast<char const*>(p) : end;
+        }
+
+        inline char const* next_line(char const* it, char const* end)
+        {
+            it = find_eol(it, end);
+            return it != end ? it + 1 : end;
+        }
+
+        inline bool is_blank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline void skip_blanks(char const*& it, char const* end)
+        {
+            while (it != end && is_blank(*it))
+                ++it;
+        }
+
+        // strip trailing blanks (including the '\r' of Windows line endings)
+        inline char const* trim_line(char const* begin, char const* end)
+        {
+            while (end != begin && is_blank(end[-1]))
+                --end;
+            return end;
+        }
+
+        inline bool is_empty_line(char const* begin, char const* end)
+        {
+            return trim_line(begin, end) == begin;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline bool parse_field(char const*& it, char const* end, double& value)
+        {
+            return boost::spirit::qi::parse(
+                it, end, boost::spirit::qi::double_, value);
+        }
+
+        inline bool parse_field(
+            char const*& it, char const* end, std::int64_t& value)
+        {
+            return boost::spirit::qi::parse(
+                it, end, boost::spirit::qi::long_long, value);
+        }
+
+        // boolean values are given as true/false or as numbers
+        inline bool parse_field(
+            char const*& it, char const* end, std::uint8_t& value)
+        {
+            namespace qi = boost::spirit::qi;
+            using boost::spirit::ascii::no_case;
+
+            if (qi::parse(it, end, no_case[qi::lit("true")]))
+            {
+                value = 1;
+                return true;
+            }
+            if (qi::parse(it, end, no_case[qi::lit("false")]))
+            {
+                value = 0;
+                return true;
+            }
+
+            double v = 0.0;
+            if (!qi::parse(it, end, qi::double_, v))
+            {
+                return false;
+            }
+            value = v != 0.0 ? 1 : 0;
+            return true;
+        }
+
+        // Parse one line, targets holds for each column of the file the
+        // position of the value in the output (or -1 if the column should
+        // be skipped).
+        template <typename T>
+        bool parse_row(char const* it, char const* end, T* row,
+            std::vector<std::ptrdiff_t> const& targets)
+        {
+            std::size_t const num_columns = targets.size();
+            for (std::size_t col = 0; col != num_columns; ++col)
+            {
+                if (targets[col] >= 0)
+                {
+                    skip_blanks(it, end);
+                    if (!parse_field(it, end, row[targets[col]]))
+                    {
+                        return false;
+                    }
+                    skip_blanks(it, end);
+                }
+                else
+                {
+                    it = std::find(it, end, ',');
+                }
+
+                if (col + 1 != num_columns)
+                {
+                    if (it == end || *it != ',')
+                    {
+                        return false;    // not enough columns
+                    }
+                    ++it;
+                }
+            }
+            return it == end;
+        }
+
+        // Return whether the given line consists of numbers (or boolean
+        // values) only, return the number of columns
+        inline bool is_numeric_line(
+            char const* it, char const* end, std::size_t& num_columns)
+        {
+            num_columns = 0;
+            while (true)
+            {
+                std::uint8_t value = 0;
+                skip_blanks(it, end);
+                if (!parse_field(it, end, value))
+                {
+                    return false;
+                }
+                skip_blanks(it, end);
+                ++num_columns;
+
+                if (it == end)
+                {
+                    return true;
+                }
+                if (*it++ != ',')
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    csv_reader::csv_reader(std::string const& filename, std::int64_t skip_rows,
+            std::string const& name, std::string const& codename)
+      : filename_(filename)
+      , name_(name)
+      , codename_(codename)
+      , data_(nullptr)
+      , size_(0)
+      , mapped_(false)
+      , num_rows_(0)
+      , num_columns_(0)
+    {
+        map_file();
+
+        char const* it = data_;
+        char const* end = data_ + size_;
+
+        // skip the header lines
+        if (skip_rows >= 0)
+        {
+            for (std::int64_t i = 0; i != skip_rows && it != end; ++i)
+            {
+                it = detail::next_line(it, end);
+            }
+        }
+
+        // the first non-empty line determines the number of columns
+        while (it != end)
+        {
+            char const* eol = detail::find_eol(it, end);
+            char const* last = detail::trim_line(it, eol);
+            if (last != it)
+            {
+                if (skip_rows >= 0)
+                {
+                    num_columns_ = std::count(it, last, ',') + 1;
+                    break;
+                }
+                if (detail::is_numeric_line(it, last, num_columns_))
+                {
+                    break;
+                }
+                num_columns_ = 0;
+            }
+            it = eol != end ? eol + 1 : end;
+        }
+
+        find_chunks(it, end);
+    }
+
+    csv_reader::~csv_reader()
+    {
+#if defined(HPX_HAVE_UNISTD_H)
+        if (mapped_)
+        {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    void csv_reader::map_file()
+    {
+#if defined(HPX_HAVE_UNISTD_H)
+        int fd = ::open(filename_.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "csv_reader::map_file",
+                util::generate_error_message(
+                    "couldn't open file: " + filename_, name_, codename_));
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            ::close(fd);
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "csv_reader::map_file",
+                util::generate_error_message(
+                    "couldn't determine size of file: " + filename_, name_,
+                    codename_));
+        }
+
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ != 0)
+        {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<char const*>(p);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+
+        if (mapped_ || size_ == 0)
+        {
+            return;
+        }
+#endif
+        // memory mapping is not available, read the whole file instead
+        std::ifstream infile(
+            filename_.c_str(), std::ios::in | std::ios::binary);
+        if (!infile.is_open())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "csv_reader::map_file",
+                util::generate_error_message(
+                    "couldn't open file: " + filename_, name_, codename_));
+        }
+
+        buffer_.assign(std::istreambuf_iterator<char>(infile),
+            std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    // Split the data into chunks of whole lines and count the (non-empty)
+    // rows in each of the chunks.
+    void csv_reader::find_chunks(char const* begin, char const* end)
+    {
+        std::size_t const size = end - begin;
+        std::size_t const num_chunks = (std::max)(std::size_t(1),
+            (std::min)(size / detail::csv_min_chunk_size,
+                std::size_t(4 * hpx::get_os_thread_count())));
+
+        chunks_.resize(num_chunks);
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+            [&](std::size_t i) {
+                // each chunk starts after the first line break at or after
+                // its nominal beginning
+                auto boundary = [&](std::size_t k) -> char const* {
+                    if (k == 0)
+                        return begin;
+                    if (k == num_chunks)
+                        return end;
+                    return detail::next_line(begin + k * size / num_chunks - 1,
+                        end);
+                };
+
+                chunk& c = chunks_[i];
+                c.begin = boundary(i);
+                c.end = (std::max)(c.begin, boundary(i + 1));
+                c.num_rows = 0;
+
+                for (char const* it = c.begin; it < c.end;)
+                {
+                    char const* eol = detail::find_eol(it, c.end);
+                    if (!detail::is_empty_line(it, eol))
+                    {
+                        ++c.num_rows;
+                    }
+                    it = eol != c.end ? eol + 1 : c.end;
+                }
+            });
+
+        for (chunk& c : chunks_)
+        {
+            c.first_row = num_rows_;
+            num_rows_ += c.num_rows;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void csv_reader::check_columns(
+        std::vector<std::size_t> const& columns) const
+    {
+        std::vector<bool> used(num_columns_, false);
+        for (std::size_t col : columns)
+        {
+            if (col >= num_columns_)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "csv_reader::check_columns",
+                    util::generate_error_message(
+                        "column index " + std::to_string(col) +
+                            " is out of bounds for file " + filename_ +
+                            " holding " + std::to_string(num_columns_) +
+                            " columns",
+                        name_, codename_));
+            }
+            if (used[col])
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "csv_reader::check_columns",
+                    util::generate_error_message(
+                        "column index " + std::to_string(col) +
+                            " was selected more than once",
+                        name_, codename_));
+            }
+            used[col] = true;
+        }
+    }
+
+    template <typename T>
+    void csv_reader::read_rows(T* data, std::size_t spacing,
+        std::size_t row_start, std::size_t num_rows,
+        std::vector<std::size_t> const& columns) const
+    {
+        if (num_rows == 0)
+        {
+            return;
+        }
+
+        if (row_start + num_rows > num_rows_)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "csv_reader::read",
+                util::generate_error_message(
+                    "requested rows are out of bounds for file " + filename_,
+                    name_, codename_));
+        }
+
+        std::vector<std::ptrdiff_t> targets(num_columns_, -1);
+        if (columns.empty())
+        {
+            for (std::size_t col = 0; col != num_columns_; ++col)
+            {
+                targets[col] = col;
+            }
+        }
+        else
+        {
+            check_columns(columns);
+            for (std::size_t i = 0; i != columns.size(); ++i)
+            {
+                targets[columns[i]] = i;
+            }
+        }
+
+        std::size_t const row_end = row_start + num_rows;
+
+        // chunks overlapping with the requested rows
+        auto first = std::upper_bound(chunks_.begin(), chunks_.end(),
+            row_start, [](std::size_t row, chunk const& c) {
+                return row < c.first_row + c.num_rows;
+            });
+        auto last = std::lower_bound(first, chunks_.end(), row_end,
+            [](chunk const& c, std::size_t row) { return c.first_row < row; });
+
+        std::size_t const first_chunk = first - chunks_.begin();
+        std::size_t const num_chunks = last - first;
+
+        // the first row (if any) that could not be parsed by each chunk
+        std::vector<std::size_t> errors(num_chunks, num_rows_);
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_chunks,
+            [&](std::size_t i) {
+                chunk const& c = chunks_[first_chunk + i];
+
+                std::size_t row = c.first_row;
+                for (char const* it = c.begin; it < c.end && row < row_end;)
+                {
+                    char const* eol = detail::find_eol(it, c.end);
+                    char const* line_end = detail::trim_line(it, eol);
+                    if (line_end != it)
+                    {
+                        if (row >= row_start &&
+                            !detail::parse_row(it, line_end,
+                                data + (row - row_start) * spacing, targets))
+                        {
+                            errors[i] = row;
+                            return;
+                        }
+                        ++row;
+                    }
+                    it = eol != c.end ? eol + 1 : c.end;
+                }
+            });
+
+        auto error = std::min_element(errors.begin(), errors.end());
+        if (error != errors.end() && *error != num_rows_)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "csv_reader::read",
+                util::generate_error_message(
+                    "wrong data format, unexpected value or different number "
+                    "of elements in this row " +
+                        filename_ + ':' + std::to_string(*error),
+                    name_, codename_));
+        }
+    }
+
+    void csv_reader::read(double* data, std::size_t spacing,
+        std::size_t row_start, std::size_t num_rows,
+        std::vector<std::size_t> const& columns) const
+    {
+        read_rows(data, spacing, row_start, num_rows, columns);
+    }
+
+    void csv_reader::read(std::int64_t* data, std::size_t spacing,
+        std::size_t row_start, std::size_t num_rows,
+        std::vector<std::size_t> const& columns) const
+    {
+        read_rows(data, spacing, row_start, num_rows, columns);
+    }
+
+    void csv_reader::read(std::uint8_t* data, std::size_t spacing,
+        std::size_t row_start, std::size_t num_rows,
+        std::vector<std::size_t> const& columns) const
+    {
+        read_rows(data, spacing, row_start, num_rows, columns);
+    }
+}}}
@@ -14,8 +14,8 @@
 #include <phylanx/execution_tree/tiling_annotations.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
+#include <phylanx/plugins/fileio/csv_reader.hpp>
 #include <phylanx/plugins/fileio/dist_file_read_csv.hpp>
-#include <phylanx/plugins/fileio/file_read_csv_impl.hpp>
 #include <phylanx/util/detail/range_dimension.hpp>
 
 #include <hpx/include/lcos.hpp>
@@ -27,10 +27,8 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
-#include <iomanip>
 #include <memory>
-#include <stdexcept>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -109,19 +107,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             return std::move(given_name);
         }
+
+        // the columns to read, none if all of them are needed
+        std::vector<std::size_t> csv_columns(std::int64_t column_start,
+            std::size_t column_size, std::size_t n_cols)
+        {
+            std::vector<std::size_t> columns;
+            if (column_size != n_cols)
+            {
+                columns.resize(column_size);
+                std::iota(columns.begin(), columns.end(), column_start);
+            }
+            return columns;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type dist_file_read_csv::dist_read_2d(
-        std::ifstream&& infile, std::string const& filename,
-        std::string const& tiling_type,
+        csv_reader const& reader, std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
         std::string&& given_name, std::uint32_t numtiles) const
     {
-        std::vector<double> data;
-        std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::size_t n_rows = reader.rows();
+        std::size_t n_cols = reader.columns();
 
         std::int64_t row_start, column_start;
         std::size_t row_size, column_size;
@@ -164,25 +172,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 tile_info.as_annotation(name_, codename_), ann_info, name_,
                 codename_));
 
-        blaze::DynamicMatrix<double> whole_data(n_rows, n_cols, data.data());
-        blaze::DynamicMatrix<double> result =
-            blaze::submatrix(std::move(whole_data), row_start, column_start,
-                row_size, column_size);
+        // parse only the part of the file that belongs to this tile
+        blaze::DynamicMatrix<double> result(row_size, column_size);
+        reader.read(result.data(), result.spacing(), row_start, row_size,
+            detail::csv_columns(column_start, column_size, n_cols));
 
         return primitive_argument_type(result, attached_annotation);
     }
 
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type dist_file_read_csv::dist_read_3d(
-        std::ifstream&& infile, std::string const& filename,
-        std::int64_t given_nrows, std::string const& tiling_type,
+        csv_reader const& reader, std::int64_t given_nrows,
+        std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
         std::string&& given_name, std::uint32_t numtiles) const
     {
-        std::vector<double> data;
-        std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::size_t n_rows = reader.rows();
+        std::size_t n_cols = reader.columns();
         std::size_t n_pages = static_cast<std::size_t>(n_rows / given_nrows);
 
         if (n_rows % given_nrows != 0)
@@ -241,11 +247,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 tile_info.as_annotation(name_, codename_), ann_info, name_,
                 codename_));
 
-        blaze::DynamicTensor<double> whole_data(
-            n_pages, given_nrows, n_cols, data.data());
-        blaze::DynamicTensor<double> result =
-            blaze::subtensor(std::move(whole_data), page_start, row_start,
-                column_start, page_size, row_size, column_size);
+        // parse only the part of the file that belongs to this tile
+        blaze::DynamicTensor<double> result(page_size, row_size, column_size);
+        auto columns = detail::csv_columns(column_start, column_size, n_cols);
+
+        if (row_size == static_cast<std::size_t>(given_nrows))
+        {
+            // the rows of all pages of the tile are stored back to back
+            reader.read(result.data(), result.spacing(),
+                page_start * given_nrows, page_size * given_nrows, columns);
+        }
+        else
+        {
+            for (std::size_t k = 0; k != page_size; ++k)
+            {
+                reader.read(result.data(0, k), result.spacing(),
+                    (page_start + k) * given_nrows + row_start, row_size,
+                    columns);
+            }
+        }
 
         return primitive_argument_type(result, attached_annotation);
     }
@@ -384,26 +404,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             std::move(args[6]), this_->name_, this_->codename_);
                     }
 
-                    std::ifstream infile(filename.c_str(), std::ios::in);
-
-                    if (!infile.is_open())
-                    {
-                        throw std::runtime_error(this_->generate_error_message(
-                            "couldn't open file: " + filename));
-                    }
+                    csv_reader reader(
+                        filename, -1, this_->name_, this_->codename_);
 
                     if (mode3d)
                     {
-                        return this_->dist_read_3d(std::move(infile), filename,
-                            page_nrows, tiling_type, intersections,
-                            std::move(given_name), numtiles);
+                        return this_->dist_read_3d(reader, page_nrows,
+                            tiling_type, intersections, std::move(given_name),
+                            numtiles);
                     }
 
                     // dist_file_read_csv never considers 1d arrays. It is a
                     // dataframe ether representing a matrix or a tensor
-                    return this_->dist_read_2d(std::move(infile), filename,
-                             tiling_type, intersections,
-                            std::move(given_name), numtiles);
+                    return this_->dist_read_2d(reader, tiling_type,
+                        intersections, std::move(given_name), numtiles);
                 }),
             detail::map_operands(operands, functional::value_operand{}, args,
                 name_, codename_, std::move(ctx)));
@@ -0,0 +1,96 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/array_file.hpp>
+#include <phylanx/plugins/fileio/file_read_array.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const file_read_array::match_data =
+    {
+        hpx::make_tuple("file_read_array",
+            std::vector<std::string>{
+                "file_read_array(_1_filename, __arg(_2_copy, false))"},
+            &create_file_read_array, &create_primitive<file_read_array>,
+            R"(filename, copy
+            Args:
+
+                filename (string) : the binary array file to read
+                copy (bool, optional) : if false (default), the file is
+                    mapped into memory and the returned array refers to the
+                    mapped data without copying it. Otherwise the data is
+                    read into a newly allocated array.
+
+            Returns:
+
+            The array stored in the given binary array file (as written by
+            file_write_array).)"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_read_array::file_read_array(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    hpx::future<primitive_argument_type> file_read_array::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.empty() || operands.size() > 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::file_read_array::eval",
+                generate_error_message(
+                    "the file_read_array primitive requires one or two "
+                    "operands"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::file_read_array::eval",
+                generate_error_message(
+                    "the file_read_array primitive requires that the given "
+                    "filename is valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_arguments_type&& args)
+            ->  primitive_argument_type
+            {
+                std::string filename = extract_string_value_strict(
+                    std::move(args[0]), this_->name_, this_->codename_);
+
+                bool copy = false;
+                if (args.size() > 1 && valid(args[1]))
+                {
+                    copy = extract_scalar_boolean_value(
+                        std::move(args[1]), this_->name_, this_->codename_);
+                }
+
+                return read_array_file(
+                    filename, copy, this_->name_, this_->codename_);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -4,9 +4,10 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/csv_reader.hpp>
 #include <phylanx/plugins/fileio/file_read_csv.hpp>
-#include <phylanx/plugins/fileio/file_read_csv_impl.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -15,12 +16,8 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <fstream>
-#include <iomanip>
 #include <memory>
-#include <stdexcept>
 #include <string>
-#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -38,11 +35,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 file_read_csv(
                     _1_filename,
                     __arg(_2_mode3d, false),
-                    __arg(_3_page_nrows, 1)
+                    __arg(_3_page_nrows, 1),
+                    __arg(_4_dtype, nil),
+                    __arg(_5_skip_rows, nil),
+                    __arg(_6_usecols, nil)
                 )
             )"},
             &create_file_read_csv, &create_primitive<file_read_csv>,
-            R"(filename, mode3d, page_nrows
+            R"(filename, mode3d, page_nrows, dtype, skip_rows, usecols
             Args:
 
                 filename (string) : file name
@@ -52,6 +52,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 page_nrows (int, optional) : it is used only whenmode3d is true.
                     It determines the number of rows in each page of the
                     resulted array.
+                dtype (string, optional) : the data-type of the returned array,
+                    one of 'float' (default), 'int', or 'bool'.
+                skip_rows (int, optional) : the number of lines to skip at the
+                    beginning of the file. If not given, all leading lines
+                    that don't consist of numbers only (e.g. column headers)
+                    are skipped.
+                usecols (int or list of ints, optional) : the columns to read,
+                    in the given order. All columns are read if not given.
 
             Returns:
 
@@ -68,45 +76,48 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {}
 
     ///////////////////////////////////////////////////////////////////////////
-    inline primitive_argument_type file_read_csv::read(
-        std::ifstream&& infile, std::string const& filename) const
+    template <typename T>
+    primitive_argument_type file_read_csv::read(csv_reader const& reader,
+        std::vector<std::size_t> const& columns) const
     {
-        std::vector<double> data;
-        std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::size_t n_rows = reader.rows();
+        std::size_t n_cols =
+            columns.empty() ? reader.columns() : columns.size();
 
         if (n_rows == 1)
         {
             if (n_cols == 1)
             {
                 // scalar value
-                return primitive_argument_type{
-                    ir::node_data<double>{data[0]}};
+                T value = T();
+                reader.read(&value, 1, 0, 1, columns);
+
+                return primitive_argument_type{ir::node_data<T>{value}};
             }
 
             // vector
-            blaze::DynamicVector<double> vector(n_cols, data.data());
+            blaze::DynamicVector<T> vector(n_cols);
+            reader.read(vector.data(), n_cols, 0, 1, columns);
 
             return primitive_argument_type{
-                ir::node_data<double>{std::move(vector)}};
+                ir::node_data<T>{std::move(vector)}};
         }
 
-        // matrix
-        blaze::DynamicMatrix<double> matrix(n_rows, n_cols, data.data());
+        // matrix, the values are parsed directly into the result
+        blaze::DynamicMatrix<T> matrix(n_rows, n_cols);
+        reader.read(matrix.data(), matrix.spacing(), 0, n_rows, columns);
 
-        return primitive_argument_type{
-            ir::node_data<double>{std::move(matrix)}};
+        return primitive_argument_type{ir::node_data<T>{std::move(matrix)}};
     }
 
-    inline primitive_argument_type file_read_csv::read_3d(
-        std::ifstream&& infile, std::string const& filename,
+    template <typename T>
+    primitive_argument_type file_read_csv::read_3d(csv_reader const& reader,
+        std::vector<std::size_t> const& columns,
         std::int64_t given_nrows) const
     {
-        std::vector<double> data;
-        std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::size_t n_rows = reader.rows();
+        std::size_t n_cols =
+            columns.empty() ? reader.columns() : columns.size();
 
         if (n_rows % given_nrows != 0)
         {
@@ -116,13 +127,75 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the given number of rows in a page"));
         }
 
-        // tensor
-        blaze::DynamicTensor<double> result(
-            static_cast<std::size_t>(n_rows / given_nrows), given_nrows, n_cols,
-            data.data());
+        // tensor, all pages are stored back to back with the same row
+        // spacing, which allows to parse all rows in one go
+        blaze::DynamicTensor<T> result(
+            static_cast<std::size_t>(n_rows / given_nrows), given_nrows,
+            n_cols);
+        reader.read(result.data(), result.spacing(), 0, n_rows, columns);
 
-        return primitive_argument_type{
-            ir::node_data<double>{std::move(result)}};
+        return primitive_argument_type{ir::node_data<T>{std::move(result)}};
+    }
+
+    primitive_argument_type file_read_csv::read(csv_reader const& reader,
+        std::vector<std::size_t> const& columns, node_data_type dtype,
+        bool mode3d, std::int64_t given_nrows) const
+    {
+        switch (dtype)
+        {
+        case node_data_type_bool:
+            return mode3d ?
+                read_3d<std::uint8_t>(reader, columns, given_nrows) :
+                read<std::uint8_t>(reader, columns);
+
+        case node_data_type_int64:
+            return mode3d ?
+                read_3d<std::int64_t>(reader, columns, given_nrows) :
+                read<std::int64_t>(reader, columns);
+
+        case node_data_type_unknown:
+            HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return mode3d ? read_3d<double>(reader, columns, given_nrows) :
+                            read<double>(reader, columns);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "file_read_csv::read",
+            generate_error_message(
+                "the file_read_csv primitive supports reading float, int, "
+                "and bool data only"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::vector<std::size_t> extract_csv_columns(
+            primitive_argument_type&& arg, std::string const& name,
+            std::string const& codename)
+        {
+            std::vector<std::size_t> columns;
+            if (is_list_operand_strict(arg))
+            {
+                ir::range&& cols =
+                    extract_list_value_strict(std::move(arg), name, codename);
+
+                columns.reserve(cols.size());
+                for (auto&& col : cols)
+                {
+                    columns.push_back(
+                        extract_scalar_nonneg_integer_value_strict(
+                            std::move(col), name, codename));
+                }
+                return columns;
+            }
+
+            columns.push_back(extract_scalar_nonneg_integer_value_strict(
+                std::move(arg), name, codename));
+            return columns;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -130,12 +203,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 3)
+        if (operands.empty() || operands.size() > 6)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_read_csv::eval",
                 generate_error_message("the file_read_csv primitive requires "
-                                       "at least one and at most 3 operands."));
+                                       "at least one and at most 6 operands."));
         }
 
         if (!valid(operands[0]))
@@ -164,28 +237,40 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         std::move(args[1]), this_->name_, this_->codename_);
                 }
 
-                std::int64_t page_nrows;
+                std::int64_t page_nrows = 1;
                 if (args.size() > 2 && valid(args[2]))
                 {
                     page_nrows = extract_scalar_positive_integer_value_strict(
                         std::move(args[2]), this_->name_, this_->codename_);
                 }
 
-                std::ifstream infile(filename.c_str(), std::ios::in);
+                node_data_type dtype = node_data_type_double;
+                if (args.size() > 3 && valid(args[3]))
+                {
+                    dtype = map_dtype(extract_string_value_strict(
+                        std::move(args[3]), this_->name_, this_->codename_));
+                }
 
-                if (!infile.is_open())
+                std::int64_t skip_rows = -1;
+                if (args.size() > 4 && valid(args[4]))
                 {
-                    throw std::runtime_error(this_->generate_error_message(
-                        "couldn't open file: " + filename));
+                    skip_rows = extract_scalar_nonneg_integer_value_strict(
+                        std::move(args[4]), this_->name_, this_->codename_);
                 }
 
-                if (mode3d)
+                std::vector<std::size_t> columns;
+                if (args.size() > 5 && valid(args[5]))
                 {
-                    return this_->read_3d(
-                        std::move(infile), filename, page_nrows);
+                    columns = detail::extract_csv_columns(std::move(args[5]),
+                        this_->name_, this_->codename_);
                 }
-                return this_->read(std::move(infile), filename);
 
+                csv_reader reader(
+                    filename, skip_rows, this_->name_, this_->codename_);
+                reader.check_columns(columns);
+
+                return this_->read(
+                    reader, columns, dtype, mode3d, page_nrows);
                 }),
             detail::map_operands(operands, functional::value_operand{}, args,
                 name_, codename_, std::move(ctx)));
@@ -0,0 +1,99 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/array_file.hpp>
+#include <phylanx/plugins/fileio/file_write_array.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const file_write_array::match_data =
+    {
+        hpx::make_tuple("file_write_array",
+            std::vector<std::string>{
+                "file_write_array(_1_filename, _2_data, __arg(_3_append, "
+                "false))"},
+            &create_file_write_array, &create_primitive<file_write_array>,
+            R"(filename, data, append
+            Args:
+
+                filename (string) : the file in which to save the data
+                data (array) : the numeric array to save
+                append (bool, optional) : if true and the file exists, the
+                    data is appended along the first dimension to the array
+                    stored in the file. This allows to write large arrays
+                    (e.g. checkpoints) in chunks. Defaults to false.
+
+            Returns:
+
+            The array that was written.)"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_write_array::file_write_array(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    hpx::future<primitive_argument_type> file_write_array::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::file_write_array::eval",
+                generate_error_message(
+                    "the file_write_array primitive requires two or three "
+                    "operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::file_write_array::eval",
+                generate_error_message(
+                    "the file_write_array primitive requires that the "
+                    "given operands are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_arguments_type&& args)
+            ->  primitive_argument_type
+            {
+                std::string filename = extract_string_value_strict(
+                    std::move(args[0]), this_->name_, this_->codename_);
+
+                bool append = false;
+                if (args.size() > 2 && valid(args[2]))
+                {
+                    append = extract_scalar_boolean_value(
+                        std::move(args[2]), this_->name_, this_->codename_);
+                }
+
+                write_array_file(filename, args[1], append, this_->name_,
+                    this_->codename_);
+
+                return std::move(args[1]);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
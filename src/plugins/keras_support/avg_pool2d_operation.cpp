@@ -8,7 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/avg_pool2d_operation.hpp>
-#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+#include <phylanx/plugins/keras_support/pool_engine.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -63,227 +63,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type avg_pool2d_operation::avg_pool2d(
         ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t result_height = q.pages() - filter_height + 1;
-        std::size_t result_width  = q.rows() - filter_width + 1;
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(
-                            slice, r, c, filter_height, filter_width));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type avg_pool2d_operation::avg_pool2d(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(q.pages() - filter_height + 1) / stride_height);
-        std::size_t result_width =
-            blaze::ceil(static_cast<double>(q.rows() - filter_width + 1) /
-                stride_width);
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::mean)(
-                            blaze::submatrix(slice, r * stride_height,
-                                c * stride_width, filter_height, filter_width));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool2d_operation::avg_pool2d_same(
-        ir::node_data<double>&& arg,
-         std::size_t filter_height, std::size_t filter_width) const
-    {
-        auto q = arg.quatern();
-
-        std::int64_t pad_top = (filter_height - 1) / 2;
-        std::int64_t pad_left = (filter_width - 1) / 2;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, nrows, ncolumns, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != nrows; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r - pad_top);
-                    for (std::size_t c = 0; c != ncolumns; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(
-                            ncolumns, filter_width, c - pad_left);
-
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type avg_pool2d_operation::avg_pool2d_same(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
+        std::size_t filter_width, std::string const& padding,
+        std::size_t stride_height, std::size_t stride_width) const
     {
         auto q = arg.quatern();
 
-        std::size_t pad_height;
-        std::size_t pad_width;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        if (nrows % stride_height == 0)
-            pad_height = filter_height > stride_height ?
-                filter_height - stride_height :
-                static_cast<std::size_t>(0);
-        else
-            pad_height = filter_height > (nrows % stride_height) ?
-                filter_height - (nrows % stride_height) :
-                static_cast<std::size_t>(0);
-
-        if (ncolumns % stride_width == 0)
-            pad_width = filter_width > stride_width ?
-                filter_width - stride_width :
-                static_cast<std::size_t>(0);
-        else
-            pad_width = filter_width > (ncolumns % stride_width) ?
-                filter_width - (ncolumns % stride_width) :
-                static_cast<std::size_t>(0);
-
-        std::size_t pad_top  = pad_height / 2;
-        std::size_t pad_left = pad_width  / 2;
-
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(nrows + pad_height - filter_height + 1) /
-            stride_height);
-        std::size_t result_width = blaze::ceil(
-            static_cast<double>(ncolumns + pad_width - filter_width + 1) /
-            stride_width);
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r * stride_height - pad_top);
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(ncolumns,
-                            filter_width, c * stride_width - pad_left);
-
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
+        bool const same = padding == "same";
+        auto const height = detail::make_pool_dimension(
+            q.pages(), filter_height, stride_height, same);
+        auto const width = detail::make_pool_dimension(
+            q.rows(), filter_width, stride_width, same);
 
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool2d_operation::avg_pool_any_pad(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::string&& padding) const
-    {
-        if (padding == "valid")
-            return avg_pool2d(std::move(arg), filter_height, filter_width);
-
-        // padding == "same"
-        return avg_pool2d_same(std::move(arg), filter_height, filter_width);
-    }
-
-    primitive_argument_type avg_pool2d_operation::avg_pool_any_pad(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::string&& padding,
-        std::size_t stride_height, std::size_t stride_width) const
-    {
-        if (padding == "valid")
-            return avg_pool2d(std::move(arg), filter_height, filter_width,
-                stride_height, stride_width);
-
-        // padding == "same"
-        return avg_pool2d_same(std::move(arg), filter_height, filter_width,
-            stride_height, stride_width);
+        return primitive_argument_type{
+            detail::avg_pool2d(q, height, width)};
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -367,12 +159,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     }
                 }
 
-                ir::range strides(0); // an empty range
-                std::size_t stride_height;
-                std::size_t stride_width;
+                std::size_t stride_height = 1;
+                std::size_t stride_width = 1;
                 if (args.size() > 3)
                 {
-                    strides = extract_list_value_strict(
+                    ir::range strides = extract_list_value_strict(
                         args[3], this_->name_, this_->codename_);
                     if (strides.size() != 2)
                     {
@@ -388,28 +179,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         extract_scalar_positive_integer_value_strict(*it_s);
                     stride_width =
                         extract_scalar_positive_integer_value_strict(*++it_s);
-
-                    if (stride_height == 1 && stride_width == 1)
-                    {
-                        strides = ir::range(0);
-                    }
                 }
 
-                if (strides.empty()) // strides contain only 1s
-                {
-                    return this_->avg_pool_any_pad(
-                        extract_numeric_value(
-                            std::move(args[0]), this_->name_, this_->codename_),
-                        filter_height, filter_width, std::move(padding));
-                }
-
-                // non-default strides
-                return this_->avg_pool_any_pad(
+                return this_->avg_pool2d(
                     extract_numeric_value(
                         std::move(args[0]), this_->name_, this_->codename_),
-                    filter_height, filter_width, std::move(padding),
-                    stride_height, stride_width);
-
+                    filter_height, filter_width, padding, stride_height,
+                    stride_width);
             }),
             detail::map_operands(
                 operands, functional::value_operand{}, args, name_, codename_));
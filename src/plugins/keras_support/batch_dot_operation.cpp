@@ -7,6 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/common/gemm_engine.hpp>
 #include <phylanx/plugins/keras_support/batch_dot_operation.hpp>
 
 #include <hpx/include/lcos.hpp>
@@ -334,10 +335,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::pageslice(t2, i);
+        common::gemm_for_each(t1.pages(), t1.rows(), t1.columns(),
+            t2.columns(), [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::pageslice(t1, i),
+                    blaze::pageslice(t2, i), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -351,10 +354,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t1, i)) * blaze::pageslice(t2, i);
+        common::gemm_for_each(t1.pages(), t1.columns(), t1.rows(),
+            t2.columns(), [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::trans(blaze::pageslice(t1, i)),
+                    blaze::pageslice(t2, i), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -368,10 +373,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::trans(blaze::pageslice(t2, i));
+        common::gemm_for_each(t1.pages(), t1.rows(), t1.columns(), t2.rows(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::pageslice(t1, i),
+                    blaze::trans(blaze::pageslice(t2, i)), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -385,10 +392,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t2, i) * blaze::pageslice(t1, i));
+        // trans(t2_i * t1_i) == trans(t1_i) * trans(t2_i)
+        common::gemm_for_each(t1.pages(), t1.columns(), t1.rows(), t2.rows(),
+            [&](std::size_t i, bool nested) {
+                auto page = blaze::pageslice(result, i);
+                common::gemm_assign(blaze::trans(blaze::pageslice(t1, i)),
+                    blaze::trans(blaze::pageslice(t2, i)), page, nested);
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -7,8 +7,8 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/common/conv2d_engine.hpp>
 #include <phylanx/plugins/keras_support/conv2d_operation.hpp>
-#include <phylanx/plugins/keras_support/conv_indices_helper.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -76,43 +76,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         auto q = arg.quatern();
         auto k = kernel.quatern();
-        std::size_t batch = q.quats();
-        std::size_t in_height = q.pages();
-        std::size_t in_width = q.rows();
-        std::size_t in_channels = q.columns();
-        std::size_t filter_height = k.quats();
-        std::size_t filter_width = k.pages();
-        std::size_t out_channels = k.columns();
 
-        std::size_t res_height = in_height - filter_height + 1;
-        std::size_t res_width = in_width - filter_width + 1;
-        blaze::DynamicArray<4UL, double> result(
-            batch, res_height, res_width, out_channels);
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != res_height; ++i)
-                {
-                    for (std::size_t j = 0; j != res_width; ++j)
-                    {
-                        auto schur_product =
-                            blaze::subtensor(a_tensor, i, j, 0, filter_height,
-                                filter_width, in_channels) %
-                            k_tensor;
+        common::conv2d_parameters params;
+        params.out_height = q.pages() - k.quats() + 1;
+        params.out_width = q.rows() - k.pages() + 1;
 
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     primitive_argument_type conv2d_operation::conv2d_valid(
@@ -121,47 +91,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         auto q = arg.quatern();
         auto k = kernel.quatern();
-        std::size_t batch = q.quats();
         std::size_t in_height = q.pages();
         std::size_t in_width = q.rows();
-        std::size_t in_channels = q.columns();
         std::size_t filter_height = k.quats();
         std::size_t filter_width = k.pages();
-        std::size_t out_channels = k.columns();
 
-        std::size_t res_height = blaze::ceil(
+        common::conv2d_parameters params;
+        params.stride_height = stride_height;
+        params.stride_width = stride_width;
+        params.out_height = blaze::ceil(
             static_cast<double>(in_height - filter_height + 1) / stride_height);
-        std::size_t res_width = blaze::ceil(
+        params.out_width = blaze::ceil(
             static_cast<double>(in_width - filter_width + 1) / stride_width);
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, res_height, res_width, out_channels);
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != res_height; ++i)
-                {
-                    for (std::size_t j = 0; j != res_width; ++j)
-                    {
-                        auto schur_product =
-                            blaze::subtensor(a_tensor, i * stride_height,
-                                j * stride_width, 0, filter_height,
-                                filter_width, in_channels) %
-                            k_tensor;
-
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     primitive_argument_type conv2d_operation::conv2d_valid_dilation(
@@ -174,9 +118,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto filter_width= static_cast<std::int64_t>(k.pages());
         auto in_height = static_cast<std::int64_t>(q.pages());
         auto in_width  = static_cast<std::int64_t>(q.rows());
-        std::size_t batch = q.quats();
-        std::size_t in_channels = q.columns();
-        std::size_t out_channels = k.columns();
 
         std::int64_t res_height =
             in_height - dilation_height * (filter_height - 1);
@@ -188,34 +129,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 generate_error_message("this dilation_rate causes non-positive "
                                        "result_length where padding is valid"));
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, res_height, res_width, out_channels);
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != res_height; ++i)
-                {
-                    for (std::size_t j = 0; j != res_width; ++j)
-                    {
-                        auto schur_product =
-                            blaze::dilatedsubtensor(a_tensor, i, j, 0,
-                                filter_height, filter_width, in_channels,
-                                dilation_height, dilation_width, 1) %
-                            k_tensor;
+        common::conv2d_parameters params;
+        params.dilation_height = dilation_height;
+        params.dilation_width = dilation_width;
+        params.out_height = res_height;
+        params.out_width = res_width;
 
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -226,49 +147,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto k = kernel.quatern();
         auto filter_height = static_cast<std::int64_t>(k.quats());
         auto filter_width= static_cast<std::int64_t>(k.pages());
-        auto in_height = static_cast<std::int64_t>(q.pages());
-        auto in_width  = static_cast<std::int64_t>(q.rows());
-        std::size_t batch = q.quats();
-        std::size_t in_channels = q.columns();
-        std::size_t out_channels = k.columns();
 
-        std::int64_t pad_top = (filter_height - 1) / 2;
-        std::int64_t pad_left = (filter_width - 1) / 2;
+        common::conv2d_parameters params;
+        params.pad_top = (filter_height - 1) / 2;
+        params.pad_left = (filter_width - 1) / 2;
+        params.out_height = q.pages();
+        params.out_width = q.rows();
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, in_height, in_width, out_channels);
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != in_height; ++i)
-                {
-                    auto sub_height = conv_indices::get_subsizes(
-                        in_height, filter_height, i - pad_top);
-                    for (std::size_t j = 0; j != in_width; ++j)
-                    {
-                        auto sub_width = conv_indices::get_subsizes(
-                            in_width, filter_width, j - pad_left);
-                        auto schur_product =
-                            blaze::subtensor(a_tensor, sub_height.image_beg_,
-                                sub_width.image_beg_, 0, sub_height.size_,
-                                sub_width.size_, in_channels) %
-                            blaze::subtensor(k_tensor, sub_height.kernel_beg_,
-                                sub_width.kernel_beg_, 0, sub_height.size_,
-                                sub_width.size_, in_channels);
-
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     primitive_argument_type conv2d_operation::conv2d_same(
@@ -281,9 +168,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto filter_width= static_cast<std::int64_t>(k.pages());
         auto in_height = static_cast<std::int64_t>(q.pages());
         auto in_width  = static_cast<std::int64_t>(q.rows());
-        std::size_t batch = q.quats();
-        std::size_t in_channels = q.columns();
-        std::size_t out_channels = k.columns();
         std::int64_t pad_height;
         std::int64_t pad_width;
 
@@ -313,49 +197,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 static_cast<std::int64_t>(0);
         }
 
-        std::size_t res_width = blaze::ceil(
+        common::conv2d_parameters params;
+        params.stride_height = stride_height;
+        params.stride_width = stride_width;
+        params.pad_top = pad_height / 2;
+        params.pad_left = pad_width / 2;
+        params.out_width = blaze::ceil(
             static_cast<double>(in_width + pad_width - filter_width + 1) /
             stride_width);
-        std::size_t res_height = blaze::ceil(
+        params.out_height = blaze::ceil(
             static_cast<double>(in_height + pad_height - filter_height + 1) /
             stride_height);
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, res_height, res_width, out_channels);
-        std::int64_t pad_top  = pad_height / 2;
-        std::int64_t pad_left = pad_width / 2;
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != res_height; ++i)
-                {
-                    auto sub_height = conv_indices::get_subsizes(
-                        in_height, filter_height, i * stride_height - pad_top);
-                    for (std::size_t j = 0; j != res_width; ++j)
-                    {
-                        auto sub_width = conv_indices::get_subsizes(in_width,
-                            filter_width, j * stride_width - pad_left);
-                        auto schur_product =
-                            blaze::subtensor(a_tensor, sub_height.image_beg_,
-                                sub_width.image_beg_, 0, sub_height.size_,
-                                sub_width.size_, in_channels) %
-                            blaze::subtensor(k_tensor, sub_height.kernel_beg_,
-                                sub_width.kernel_beg_, 0, sub_height.size_,
-                                sub_width.size_, in_channels);
-
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     primitive_argument_type conv2d_operation::conv2d_same_dilation(
@@ -366,54 +221,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto k = kernel.quatern();
         auto filter_height = static_cast<std::int64_t>(k.quats());
         auto filter_width= static_cast<std::int64_t>(k.pages());
-        auto in_height = static_cast<std::int64_t>(q.pages());
-        auto in_width  = static_cast<std::int64_t>(q.rows());
-        std::size_t batch = q.quats();
-        std::size_t in_channels = q.columns();
-        std::size_t out_channels = k.columns();
 
-        std::int64_t pad_top = (dilation_height * (filter_height - 1)) / 2;
-        std::int64_t pad_left = (dilation_width * (filter_width - 1)) / 2;
+        common::conv2d_parameters params;
+        params.dilation_height = dilation_height;
+        params.dilation_width = dilation_width;
+        params.pad_top = (dilation_height * (filter_height - 1)) / 2;
+        params.pad_left = (dilation_width * (filter_width - 1)) / 2;
+        params.out_height = q.pages();
+        params.out_width = q.rows();
 
-        blaze::DynamicArray<4UL, double> result(blaze::init_from_value, 0.0,
-            batch, in_height, in_width, out_channels);
-
-        for (std::size_t c = 0; c != out_channels; ++c)
-        {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
-            auto res_tensor =
-                blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
-            for (std::size_t l = 0; l != batch; ++l)
-            {
-                auto a_tensor = blaze::quatslice(q, l);
-                auto res_slice = blaze::pageslice(res_tensor, l);
-                for (std::size_t i = 0; i != in_height; ++i)
-                {
-                    auto sub_height = conv_indices::get_subsizes_dilated(
-                        in_height, filter_height, i - pad_top, dilation_height);
-                    for (std::size_t j = 0; j != in_width; ++j)
-                    {
-                        auto sub_width =
-                            conv_indices::get_subsizes_dilated(in_width,
-                                filter_width, j - pad_left, dilation_width);
-                        if (sub_height.size_ == 0 || sub_width.size_ == 0)
-                            continue;
-
-                        auto schur_product =
-                            blaze::dilatedsubtensor(a_tensor,
-                                sub_height.image_beg_, sub_width.image_beg_, 0,
-                                sub_height.size_, sub_width.size_, in_channels,
-                                dilation_height, dilation_width, 1) %
-                            blaze::subtensor(k_tensor, sub_height.kernel_beg_,
-                                sub_width.kernel_beg_, 0, sub_height.size_,
-                                sub_width.size_, in_channels);
-
-                        res_slice(i, j) = blaze::sum(schur_product);
-                    }
-                }
-            }
-        }
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{
+            common::conv2d_compute(arg, kernel, params)};
     }
 
     ///////////////////////////////////////////////////////////////////////////
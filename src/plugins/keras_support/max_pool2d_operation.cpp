@@ -8,7 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/max_pool2d_operation.hpp>
-#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+#include <phylanx/plugins/keras_support/pool_engine.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -36,9 +36,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::vector<std::string>{R"(
             max_pool2d(_1,_2_pool_size,
             __arg(_3_padding, "valid"),
-            __arg(_4_strides, list(1,1))))"},
+            __arg(_4_strides, list(1,1)),
+            __arg(_5_return_indices, false)))"},
         &create_max_pool2d_operation, &create_primitive<max_pool2d_operation>,
-        R"(x, pool_size, padding, strides
+        R"(x, pool_size, padding, strides, return_indices
         Args:
 
             x (array) : a 4d array
@@ -48,10 +49,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 or `valid`. `valid` by default.
             strides (optional, a tuple of two integers) : the step to apply
                 pooling over the 2nd and the 3rd dimensions. `(1, 1)` by default.
+            return_indices (optional, boolean) : also return the positions
+                of the maxima. `false` by default.
 
         Returns:
 
-        The result of 2d max pooling with `pool_size` filters)")};
+        The result of 2d max pooling with `pool_size` filters. If
+        return_indices is set, a list of the result and an array of the same
+        shape holding the position of each maximum inside of its (height,
+        width) plane as row * width + column)")};
 
     ///////////////////////////////////////////////////////////////////////////
     max_pool2d_operation::max_pool2d_operation(primitive_arguments_type&& operands,
@@ -62,227 +68,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type max_pool2d_operation::max_pool2d(
         ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width) const
+        std::size_t filter_width, std::string const& padding,
+        std::size_t stride_height, std::size_t stride_width,
+        bool return_indices) const
     {
         auto q = arg.quatern();
 
-        std::size_t result_height = q.pages() - filter_height + 1;
-        std::size_t result_width  = q.rows() - filter_width + 1;
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
+        bool const same = padding == "same";
+        auto const height = detail::make_pool_dimension(
+            q.pages(), filter_height, stride_height, same);
+        auto const width = detail::make_pool_dimension(
+            q.rows(), filter_width, stride_width, same);
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
+        if (!return_indices)
         {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::max)(blaze::submatrix(
-                            slice, r, c, filter_height, filter_width));
-                    }
-                }
-            }
+            return primitive_argument_type{
+                detail::max_pool2d(q, height, width)};
         }
 
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type max_pool2d_operation::max_pool2d(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(q.pages() - filter_height + 1) / stride_height);
-        std::size_t result_width =
-            blaze::ceil(static_cast<double>(q.rows() - filter_width + 1) /
-                stride_width);
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::max)(
-                            blaze::submatrix(slice, r * stride_height,
-                                c * stride_width, filter_height, filter_width));
-                    }
-                }
-            }
-        }
+        blaze::DynamicArray<4UL, std::int64_t> indices;
+        auto result = detail::max_pool2d(q, height, width, &indices);
 
-        return primitive_argument_type{std::move(result)};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type max_pool2d_operation::max_pool2d_same(
-        ir::node_data<double>&& arg,
-         std::size_t filter_height, std::size_t filter_width) const
-    {
-        auto q = arg.quatern();
-
-        std::int64_t pad_top = (filter_height - 1) / 2;
-        std::int64_t pad_left = (filter_width - 1) / 2;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, nrows, ncolumns, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != nrows; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r - pad_top);
-                    for (std::size_t c = 0; c != ncolumns; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(
-                            ncolumns, filter_width, c - pad_left);
-
-                        res_slice(r, c) = (blaze::max)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type max_pool2d_operation::max_pool2d_same(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t pad_height;
-        std::size_t pad_width;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        if (nrows % stride_height == 0)
-            pad_height = filter_height > stride_height ?
-                filter_height - stride_height :
-                static_cast<std::size_t>(0);
-        else
-            pad_height = filter_height > (nrows % stride_height) ?
-                filter_height - (nrows % stride_height) :
-                static_cast<std::size_t>(0);
-
-        if (ncolumns % stride_width == 0)
-            pad_width = filter_width > stride_width ?
-                filter_width - stride_width :
-                static_cast<std::size_t>(0);
-        else
-            pad_width = filter_width > (ncolumns % stride_width) ?
-                filter_width - (ncolumns % stride_width) :
-                static_cast<std::size_t>(0);
-
-        std::size_t pad_top  = pad_height / 2;
-        std::size_t pad_left = pad_width  / 2;
-
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(nrows + pad_height - filter_height + 1) /
-            stride_height);
-        std::size_t result_width = blaze::ceil(
-            static_cast<double>(ncolumns + pad_width - filter_width + 1) /
-            stride_width);
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r * stride_height - pad_top);
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(ncolumns,
-                            filter_width, c * stride_width - pad_left);
-
-                        res_slice(r, c) = (blaze::max)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type max_pool2d_operation::max_pool_any_pad(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::string&& padding) const
-    {
-        if (padding == "valid")
-            return max_pool2d(std::move(arg), filter_height, filter_width);
-
-        // padding == "same"
-        return max_pool2d_same(std::move(arg), filter_height, filter_width);
-    }
-
-    primitive_argument_type max_pool2d_operation::max_pool_any_pad(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::string&& padding,
-        std::size_t stride_height, std::size_t stride_width) const
-    {
-        if (padding == "valid")
-            return max_pool2d(std::move(arg), filter_height, filter_width,
-                stride_height, stride_width);
-
-        // padding == "same"
-        return max_pool2d_same(std::move(arg), filter_height, filter_width,
-            stride_height, stride_width);
+        return primitive_argument_type{primitive_arguments_type{
+            primitive_argument_type{std::move(result)},
+            primitive_argument_type{
+                ir::node_data<std::int64_t>{std::move(indices)}}}};
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -290,12 +100,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() < 2 || operands.size() > 4)
+        if (operands.size() < 2 || operands.size() > 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "max_pool2d_operation::eval",
                 generate_error_message("the max_pool2d_operation primitive "
-                                       "requires between 2 and 4 operands"));
+                                       "requires between 2 and 5 operands"));
         }
 
         for (auto const& i : operands)
@@ -366,12 +176,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     }
                 }
 
-                ir::range strides(0); // an empty range
-                std::size_t stride_height;
-                std::size_t stride_width;
+                std::size_t stride_height = 1;
+                std::size_t stride_width = 1;
                 if (args.size() > 3)
                 {
-                    strides = extract_list_value_strict(
+                    ir::range strides = extract_list_value_strict(
                         args[3], this_->name_, this_->codename_);
                     if (strides.size() != 2)
                     {
@@ -387,28 +196,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         extract_scalar_positive_integer_value_strict(*it_s);
                     stride_width =
                         extract_scalar_positive_integer_value_strict(*++it_s);
-
-                    if (stride_height == 1 && stride_width == 1)
-                    {
-                        strides = ir::range(0);
-                    }
                 }
 
-                if (strides.empty()) // strides contain only 1s
+                bool return_indices = false;
+                if (args.size() > 4 && valid(args[4]))
                 {
-                    return this_->max_pool_any_pad(
-                        extract_numeric_value(
-                            std::move(args[0]), this_->name_, this_->codename_),
-                        filter_height, filter_width, std::move(padding));
+                    return_indices = extract_scalar_boolean_value(
+                        args[4], this_->name_, this_->codename_) != 0;
                 }
 
-                // non-default strides
-                return this_->max_pool_any_pad(
+                return this_->max_pool2d(
                     extract_numeric_value(
                         std::move(args[0]), this_->name_, this_->codename_),
-                    filter_height, filter_width, std::move(padding),
-                    stride_height, stride_width);
-
+                    filter_height, filter_width, padding, stride_height,
+                    stride_width, return_indices);
             }),
             detail::map_operands(
                 operands, functional::value_operand{}, args, name_, codename_));
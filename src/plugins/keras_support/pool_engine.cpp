@@ -0,0 +1,680 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/pool_engine.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    pool_dimension make_pool_dimension(std::size_t size,
+        std::size_t filter, std::size_t stride, bool same)
+    {
+        if (!same)
+        {
+            return pool_dimension{
+                size, filter, stride, 0, (size - filter) / stride + 1};
+        }
+
+        std::size_t const step =
+            size % stride == 0 ? stride : size % stride;
+        std::size_t const pad = filter > step ? filter - step : 0;
+
+        return pool_dimension{size, filter, stride, pad / 2,
+            (size + pad - filter) / stride + 1};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // windows of at least this size with unit stride are reduced using
+        // running maxima and sums
+        constexpr std::size_t pool_running_filter = 8;
+
+        // number of results along the pooled dimension computed by one task
+        constexpr std::size_t pool_chunk_size = 64;
+
+        ///////////////////////////////////////////////////////////////////////
+        // All passes reduce the middle dimension of a compact array of the
+        // shape (outer, dim.size_, inner) to (outer, dim.result_, inner).
+        //
+        // The running reductions use virtual coordinates v = i + dim.pad_
+        // in which the window of result o is [o, o + filter), positions
+        // outside of the input count as padding.
+        class pool_pass
+        {
+        public:
+            pool_pass(std::vector<double> const& in, std::size_t outer,
+                    std::size_t inner, pool_dimension const& dim)
+              : in_(in)
+              , outer_(outer)
+              , inner_(inner)
+              , dim_(dim)
+            {
+            }
+
+            // Call f(p, first, last) for all chunks [first, last) of the
+            // results of all p in [0, outer), concurrently
+            template <typename F>
+            void for_each_chunk(F&& f) const
+            {
+                std::size_t const chunks =
+                    (dim_.result_ + pool_chunk_size - 1) / pool_chunk_size;
+
+                hpx::for_loop(hpx::execution::par, std::size_t(0),
+                    outer_ * chunks, [&](std::size_t task) {
+                        std::size_t const p = task / chunks;
+                        std::size_t const first =
+                            (task % chunks) * pool_chunk_size;
+                        f(p, first,
+                            (std::min)(dim_.result_, first + pool_chunk_size));
+                    });
+            }
+
+            bool running() const
+            {
+                return dim_.stride_ == 1 && dim_.filter_ >= pool_running_filter;
+            }
+
+            // input row i of p
+            double const* row(std::size_t p, std::size_t i) const
+            {
+                return in_.data() + (p * dim_.size_ + i) * inner_;
+            }
+
+            // input row at virtual position v of p, nullptr for padding
+            double const* virtual_row(std::size_t p, std::size_t v) const
+            {
+                if (v < dim_.pad_ || v - dim_.pad_ >= dim_.size_)
+                {
+                    return nullptr;
+                }
+                return row(p, v - dim_.pad_);
+            }
+
+            // input row of virtual position v clamped to the input
+            std::size_t clamp(std::size_t v) const
+            {
+                if (v < dim_.pad_)
+                {
+                    return 0;
+                }
+                return (std::min)(v - dim_.pad_, dim_.size_ - 1);
+            }
+
+            std::size_t offset(std::size_t p, std::size_t o) const
+            {
+                return (p * dim_.result_ + o) * inner_;
+            }
+
+        protected:
+            std::vector<double> const& in_;
+            std::size_t outer_;
+            std::size_t inner_;
+            pool_dimension const& dim_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Maxima, in_indices holds the positions of the maxima of the
+        // previous passes (nullptr for the first one), the position along
+        // this dimension is added scaled by index_stride. No positions are
+        // tracked if out_indices is nullptr.
+        class pool_max_pass : public pool_pass
+        {
+        public:
+            pool_max_pass(std::vector<double> const& in,
+                    std::vector<std::int64_t> const* in_indices,
+                    std::size_t outer, std::size_t inner,
+                    pool_dimension const& dim, std::int64_t index_stride)
+              : pool_pass(in, outer, inner, dim)
+              , in_indices_(in_indices)
+              , index_stride_(index_stride)
+            {
+            }
+
+            void operator()(std::vector<double>& out,
+                std::vector<std::int64_t>* out_indices) const
+            {
+                out.resize(outer_ * dim_.result_ * inner_);
+                if (out_indices != nullptr)
+                {
+                    out_indices->resize(out.size());
+                }
+
+                for_each_chunk([&](std::size_t p, std::size_t first,
+                                   std::size_t last) {
+                    std::int64_t* indices = out_indices != nullptr ?
+                        out_indices->data() :
+                        nullptr;
+                    if (running())
+                    {
+                        running_max(p, first, last, out.data(), indices);
+                    }
+                    else
+                    {
+                        direct_max(p, first, last, out.data(), indices);
+                    }
+                });
+            }
+
+        private:
+            void set_indices(std::size_t p, std::size_t i,
+                std::int64_t* indices) const
+            {
+                std::int64_t const base = std::int64_t(i) * index_stride_;
+                if (in_indices_ == nullptr)
+                {
+                    std::fill_n(indices, inner_, base);
+                    return;
+                }
+
+                std::int64_t const* prev =
+                    in_indices_->data() + (p * dim_.size_ + i) * inner_;
+                for (std::size_t j = 0; j != inner_; ++j)
+                {
+                    indices[j] = base + prev[j];
+                }
+            }
+
+            std::int64_t index(std::size_t p, std::size_t i,
+                std::size_t j) const
+            {
+                std::int64_t result = std::int64_t(i) * index_stride_;
+                if (in_indices_ != nullptr)
+                {
+                    result += (*in_indices_)[(p * dim_.size_ + i) * inner_ + j];
+                }
+                return result;
+            }
+
+            void direct_max(std::size_t p, std::size_t first,
+                std::size_t last, double* out, std::int64_t* out_indices) const
+            {
+                for (std::size_t o = first; o != last; ++o)
+                {
+                    double* dst = out + offset(p, o);
+                    std::size_t const b = dim_.begin(o);
+                    std::size_t const e = dim_.end(o);
+
+                    std::copy_n(row(p, b), inner_, dst);
+                    if (out_indices == nullptr)
+                    {
+                        for (std::size_t i = b + 1; i < e; ++i)
+                        {
+                            double const* src = row(p, i);
+                            for (std::size_t j = 0; j != inner_; ++j)
+                            {
+                                dst[j] = (std::max)(dst[j], src[j]);
+                            }
+                        }
+                        continue;
+                    }
+
+                    std::int64_t* dst_indices = out_indices + offset(p, o);
+                    set_indices(p, b, dst_indices);
+                    for (std::size_t i = b + 1; i < e; ++i)
+                    {
+                        double const* src = row(p, i);
+                        for (std::size_t j = 0; j != inner_; ++j)
+                        {
+                            if (src[j] > dst[j])
+                            {
+                                dst[j] = src[j];
+                                dst_indices[j] = index(p, i, j);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // van Herk/Gil-Werman: split the virtual positions into blocks
+            // of the size of the filter, each window is covered by the
+            // suffix of one block and the prefix of the next
+            void running_max(std::size_t p, std::size_t first,
+                std::size_t last, double* out, std::int64_t* out_indices) const
+            {
+                std::size_t const k = dim_.filter_;
+                std::size_t const lo = (first / k) * k;
+                std::size_t const hi = ((last + k - 2) / k + 1) * k;
+                std::size_t const size = (hi - lo) * inner_;
+
+                std::vector<double> prefix(size), suffix(size);
+                std::vector<std::int64_t> prefix_indices, suffix_indices;
+                if (out_indices != nullptr)
+                {
+                    prefix_indices.resize(size);
+                    suffix_indices.resize(size);
+                }
+
+                constexpr double padding =
+                    -std::numeric_limits<double>::infinity();
+
+                // load the value of virtual position v into dst
+                auto load = [&](std::size_t v, double* dst,
+                                std::int64_t* dst_indices) {
+                    double const* src = virtual_row(p, v);
+                    if (src != nullptr)
+                    {
+                        std::copy_n(src, inner_, dst);
+                    }
+                    else
+                    {
+                        std::fill_n(dst, inner_, padding);
+                    }
+                    if (dst_indices != nullptr)
+                    {
+                        set_indices(p, clamp(v), dst_indices);
+                    }
+                };
+
+                for (std::size_t block = lo; block != hi; block += k)
+                {
+                    // prefix maxima, the first one wins
+                    for (std::size_t v = block; v != block + k; ++v)
+                    {
+                        std::size_t const pos = (v - lo) * inner_;
+                        std::int64_t* indices = out_indices != nullptr ?
+                            prefix_indices.data() + pos :
+                            nullptr;
+
+                        load(v, prefix.data() + pos, indices);
+                        if (v == block)
+                        {
+                            continue;
+                        }
+
+                        double* dst = prefix.data() + pos;
+                        double const* prev = dst - inner_;
+                        for (std::size_t j = 0; j != inner_; ++j)
+                        {
+                            if (!(dst[j] > prev[j]))
+                            {
+                                dst[j] = prev[j];
+                                if (indices != nullptr)
+                                {
+                                    indices[j] = (indices - inner_)[j];
+                                }
+                            }
+                        }
+                    }
+
+                    // suffix maxima, the first one wins
+                    for (std::size_t v = block + k; v-- != block;)
+                    {
+                        std::size_t const pos = (v - lo) * inner_;
+                        std::int64_t* indices = out_indices != nullptr ?
+                            suffix_indices.data() + pos :
+                            nullptr;
+
+                        load(v, suffix.data() + pos, indices);
+                        if (v == block + k - 1)
+                        {
+                            continue;
+                        }
+
+                        double* dst = suffix.data() + pos;
+                        double const* next = dst + inner_;
+                        for (std::size_t j = 0; j != inner_; ++j)
+                        {
+                            if (!(dst[j] >= next[j]))
+                            {
+                                dst[j] = next[j];
+                                if (indices != nullptr)
+                                {
+                                    indices[j] = indices[j + inner_];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (std::size_t o = first; o != last; ++o)
+                {
+                    std::size_t const left = (o - lo) * inner_;
+                    std::size_t const right = (o + k - 1 - lo) * inner_;
+
+                    double* dst = out + offset(p, o);
+                    std::int64_t* dst_indices = out_indices != nullptr ?
+                        out_indices + offset(p, o) :
+                        nullptr;
+
+                    for (std::size_t j = 0; j != inner_; ++j)
+                    {
+                        bool const use_prefix =
+                            prefix[right + j] > suffix[left + j];
+                        dst[j] = use_prefix ? prefix[right + j] :
+                                              suffix[left + j];
+                        if (dst_indices != nullptr)
+                        {
+                            dst_indices[j] = use_prefix ?
+                                prefix_indices[right + j] :
+                                suffix_indices[left + j];
+                        }
+                    }
+                }
+            }
+
+            std::vector<std::int64_t> const* in_indices_;
+            std::int64_t index_stride_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Sums, the averages are formed once all dimensions were reduced
+        class pool_sum_pass : public pool_pass
+        {
+        public:
+            pool_sum_pass(std::vector<double> const& in, std::size_t outer,
+                    std::size_t inner, pool_dimension const& dim)
+              : pool_pass(in, outer, inner, dim)
+            {
+            }
+
+            void operator()(std::vector<double>& out) const
+            {
+                out.resize(outer_ * dim_.result_ * inner_);
+
+                for_each_chunk([&](std::size_t p, std::size_t first,
+                                   std::size_t last) {
+                    if (running())
+                    {
+                        running_sum(p, first, last, out.data());
+                    }
+                    else
+                    {
+                        for (std::size_t o = first; o != last; ++o)
+                        {
+                            direct_sum(p, o, out.data() + offset(p, o));
+                        }
+                    }
+                });
+            }
+
+        private:
+            void direct_sum(std::size_t p, std::size_t o, double* dst) const
+            {
+                std::size_t const b = dim_.begin(o);
+                std::size_t const e = dim_.end(o);
+
+                std::copy_n(row(p, b), inner_, dst);
+                for (std::size_t i = b + 1; i < e; ++i)
+                {
+                    double const* src = row(p, i);
+                    for (std::size_t j = 0; j != inner_; ++j)
+                    {
+                        dst[j] += src[j];
+                    }
+                }
+            }
+
+            // add the entering and subtract the leaving row
+            void running_sum(std::size_t p, std::size_t first,
+                std::size_t last, double* out) const
+            {
+                direct_sum(p, first, out + offset(p, first));
+
+                for (std::size_t o = first + 1; o < last; ++o)
+                {
+                    double* dst = out + offset(p, o);
+                    std::copy_n(dst - inner_, inner_, dst);
+
+                    if (double const* src =
+                            virtual_row(p, o + dim_.filter_ - 1))
+                    {
+                        for (std::size_t j = 0; j != inner_; ++j)
+                        {
+                            dst[j] += src[j];
+                        }
+                    }
+                    if (double const* src = virtual_row(p, o - 1))
+                    {
+                        for (std::size_t j = 0; j != inner_; ++j)
+                        {
+                            dst[j] -= src[j];
+                        }
+                    }
+                }
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        std::vector<double> pool_copy_in(
+            ir::node_data<double>::custom_storage4d_type const& x)
+        {
+            std::size_t const rows = x.pages();
+            std::size_t const columns = x.rows();
+            std::size_t const channels = x.columns();
+
+            std::vector<double> result(x.quats() * rows * columns * channels);
+            hpx::for_loop(hpx::execution::par, std::size_t(0),
+                x.quats() * rows, [&](std::size_t n) {
+                    std::size_t const l = n / rows;
+                    std::size_t const r = n % rows;
+                    double* dst = result.data() + n * columns * channels;
+                    for (std::size_t c = 0; c != columns; ++c)
+                    {
+                        for (std::size_t j = 0; j != channels; ++j)
+                        {
+                            *dst++ = x(l, r, c, j);
+                        }
+                    }
+                });
+            return result;
+        }
+
+        std::vector<double> pool_copy_in(
+            ir::node_data<double>::custom_storage3d_type const& x)
+        {
+            std::size_t const rows = x.rows();
+            std::size_t const columns = x.columns();
+
+            std::vector<double> result(x.pages() * rows * columns);
+            hpx::for_loop(hpx::execution::par, std::size_t(0),
+                x.pages() * rows, [&](std::size_t n) {
+                    std::size_t const p = n / rows;
+                    std::size_t const r = n % rows;
+                    double* dst = result.data() + n * columns;
+                    for (std::size_t c = 0; c != columns; ++c)
+                    {
+                        dst[c] = x(p, r, c);
+                    }
+                });
+            return result;
+        }
+
+        // copy the compact data into the result, f(value, r, c) returns
+        // the value to store for an element of row r and column c (of page
+        // p for tensors)
+        template <typename T, typename Data, typename F>
+        void pool_copy_out(Data const& data,
+            blaze::DynamicArray<4UL, T>& result, F&& f)
+        {
+            std::size_t const rows = result.pages();
+            std::size_t const columns = result.rows();
+            std::size_t const channels = result.columns();
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0),
+                result.quats() * rows, [&](std::size_t n) {
+                    std::size_t const l = n / rows;
+                    std::size_t const r = n % rows;
+                    std::size_t k = n * columns * channels;
+                    for (std::size_t c = 0; c != columns; ++c)
+                    {
+                        for (std::size_t j = 0; j != channels; ++j, ++k)
+                        {
+                            result(l, r, c, j) = f(data[k], r, c);
+                        }
+                    }
+                });
+        }
+
+        template <typename T, typename Data, typename F>
+        void pool_copy_out(Data const& data, blaze::DynamicTensor<T>& result,
+            F&& f)
+        {
+            std::size_t const rows = result.rows();
+            std::size_t const columns = result.columns();
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0),
+                result.pages() * rows, [&](std::size_t n) {
+                    std::size_t const p = n / rows;
+                    std::size_t const r = n % rows;
+                    std::size_t k = n * columns;
+                    for (std::size_t c = 0; c != columns; ++c, ++k)
+                    {
+                        result(p, r, c) = f(data[k], p, r, c);
+                    }
+                });
+        }
+
+        // number of input elements pooled by the window of result o
+        double pool_count(pool_dimension const& dim, std::size_t o)
+        {
+            return double(dim.end(o) - dim.begin(o));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicArray<4UL, double> max_pool2d(
+        ir::node_data<double>::custom_storage4d_type const& x,
+        pool_dimension const& height, pool_dimension const& width,
+        blaze::DynamicArray<4UL, std::int64_t>* indices)
+    {
+        std::size_t const batch = x.quats();
+        std::size_t const channels = x.columns();
+
+        std::vector<double> data = pool_copy_in(x);
+        std::vector<double> reduced;
+        std::vector<std::int64_t> reduced_indices;
+        std::vector<std::int64_t> result_indices;
+
+        std::vector<std::int64_t>* tracked =
+            indices != nullptr ? &reduced_indices : nullptr;
+
+        pool_max_pass(data, nullptr, batch * height.size_, channels, width,
+            1)(reduced, tracked);
+        pool_max_pass(reduced, tracked, batch, width.result_ * channels,
+            height, std::int64_t(width.size_))(
+            data, indices != nullptr ? &result_indices : nullptr);
+
+        blaze::DynamicArray<4UL, double> result(
+            batch, height.result_, width.result_, channels);
+        pool_copy_out(data, result,
+            [](double value, std::size_t, std::size_t) { return value; });
+
+        if (indices != nullptr)
+        {
+            *indices = blaze::DynamicArray<4UL, std::int64_t>(
+                batch, height.result_, width.result_, channels);
+            pool_copy_out(result_indices, *indices,
+                [](std::int64_t value, std::size_t, std::size_t) {
+                    return value;
+                });
+        }
+        return result;
+    }
+
+    blaze::DynamicArray<4UL, double> avg_pool2d(
+        ir::node_data<double>::custom_storage4d_type const& x,
+        pool_dimension const& height, pool_dimension const& width)
+    {
+        std::size_t const batch = x.quats();
+        std::size_t const channels = x.columns();
+
+        std::vector<double> data = pool_copy_in(x);
+        std::vector<double> reduced;
+
+        pool_sum_pass(data, batch * height.size_, channels, width)(reduced);
+        pool_sum_pass(reduced, batch, width.result_ * channels, height)(data);
+
+        blaze::DynamicArray<4UL, double> result(
+            batch, height.result_, width.result_, channels);
+        pool_copy_out(data, result,
+            [&](double value, std::size_t r, std::size_t c) {
+                return value /
+                    (pool_count(height, r) * pool_count(width, c));
+            });
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicTensor<double> max_pool3d(
+        ir::node_data<double>::custom_storage3d_type const& x,
+        pool_dimension const& depth, pool_dimension const& height,
+        pool_dimension const& width,
+        blaze::DynamicTensor<std::int64_t>* indices)
+    {
+        std::vector<double> data = pool_copy_in(x);
+        std::vector<double> reduced;
+        std::vector<std::int64_t> data_indices;
+        std::vector<std::int64_t> reduced_indices;
+
+        bool const tracked = indices != nullptr;
+
+        pool_max_pass(data, nullptr, depth.size_ * height.size_, 1, width,
+            1)(reduced, tracked ? &reduced_indices : nullptr);
+        pool_max_pass(reduced, tracked ? &reduced_indices : nullptr,
+            depth.size_, width.result_, height, std::int64_t(width.size_))(
+            data, tracked ? &data_indices : nullptr);
+        pool_max_pass(data, tracked ? &data_indices : nullptr, 1,
+            height.result_ * width.result_, depth,
+            std::int64_t(height.size_ * width.size_))(
+            reduced, tracked ? &reduced_indices : nullptr);
+
+        blaze::DynamicTensor<double> result(
+            depth.result_, height.result_, width.result_);
+        pool_copy_out(reduced, result,
+            [](double value, std::size_t, std::size_t, std::size_t) {
+                return value;
+            });
+
+        if (tracked)
+        {
+            *indices = blaze::DynamicTensor<std::int64_t>(
+                depth.result_, height.result_, width.result_);
+            pool_copy_out(reduced_indices, *indices,
+                [](std::int64_t value, std::size_t, std::size_t,
+                    std::size_t) { return value; });
+        }
+        return result;
+    }
+
+    blaze::DynamicTensor<double> avg_pool3d(
+        ir::node_data<double>::custom_storage3d_type const& x,
+        pool_dimension const& depth, pool_dimension const& height,
+        pool_dimension const& width)
+    {
+        std::vector<double> data = pool_copy_in(x);
+        std::vector<double> reduced;
+
+        pool_sum_pass(data, depth.size_ * height.size_, 1, width)(reduced);
+        pool_sum_pass(reduced, depth.size_, width.result_, height)(data);
+        pool_sum_pass(data, 1, height.result_ * width.result_, depth)(
+            reduced);
+
+        blaze::DynamicTensor<double> result(
+            depth.result_, height.result_, width.result_);
+        pool_copy_out(reduced, result,
+            [&](double value, std::size_t p, std::size_t r, std::size_t c) {
+                return value /
+                    (pool_count(depth, p) * pool_count(height, r) *
+                        pool_count(width, c));
+            });
+        return result;
+    }
+}}}}
@@ -70,7 +70,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 for (auto&& arg : std::move(args))
                 {
-                    result.push_back(extract_copy_value(
+                    result.push_back(extract_shared_value(
                         std::move(arg), this_->name_, this_->codename_));
                 }
 
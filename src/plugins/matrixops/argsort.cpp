@@ -8,6 +8,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/argsort.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_sort.hpp>
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
@@ -86,7 +87,7 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
         auto flatten = blaze::ravel(mat);
         blaze::DynamicVector<std::int64_t> idx(mat.rows() * mat.columns());
         std::iota(idx.begin(), idx.end(), 0);
-        std::sort(idx.begin(), idx.end(),
+        util::parallel_sort(idx.begin(), idx.end(),
             [&flatten](size_t a, size_t b) { return flatten[a] < flatten[b]; });
         return primitive_argument_type{std::move(idx)};
     }
@@ -100,7 +101,7 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
         blaze::DynamicVector<std::int64_t> idx(
             tensor.pages() * tensor.rows() * tensor.columns());
         std::iota(idx.begin(), idx.end(), 0);
-        std::sort(idx.begin(), idx.end(),
+        util::parallel_sort(idx.begin(), idx.end(),
             [&flatten](size_t a, size_t b) { return flatten[a] < flatten[b]; });
         return primitive_argument_type{std::move(idx)};
     }
@@ -178,7 +179,7 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
             auto vec = in_array.vector();
             blaze::DynamicVector<std::int64_t> idx(vec.size());
             std::iota(idx.begin(), idx.end(), 0);
-            std::sort(idx.begin(), idx.end(),
+            util::parallel_sort(idx.begin(), idx.end(),
                 [&vec](size_t a, size_t b) { return vec[a] < vec[b]; });
             return primitive_argument_type{std::move(idx)};
         }
@@ -192,24 +193,19 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
     primitive_argument_type argsort::argsort2d_axis0(
         ir::node_data<T>&& in_array, std::string kind, std::string order) const
     {
-        using phylanx::util::matrix_column_iterator;
         auto mat = in_array.matrix();
         blaze::DynamicMatrix<std::int64_t> idx(mat.rows(), mat.columns());
 
-        matrix_column_iterator<decltype(mat)> mat_cols_begin(mat);
-        matrix_column_iterator<decltype(mat)> mat_cols_end(mat, mat.columns());
+        util::for_each_slice(mat.columns(), mat.rows(), [&](std::size_t j) {
+            auto mat_col = blaze::column(mat, j);
+            auto idx_col = blaze::column(idx, j);
 
-        matrix_column_iterator<decltype(idx)> idx_cols_it(idx);
-
-        for (auto mat_col = mat_cols_begin; mat_col != mat_cols_end;
-             ++mat_col, ++idx_cols_it)
-        {
-            std::iota(idx_cols_it->begin(), idx_cols_it->end(), 0);
-            std::sort(idx_cols_it->begin(), idx_cols_it->end(),
-                [mat_col](size_t a, size_t b) {
-                    return *(mat_col->begin() + a) < *(mat_col->begin() + b);
+            std::iota(idx_col.begin(), idx_col.end(), 0);
+            std::sort(idx_col.begin(), idx_col.end(),
+                [&mat_col](size_t a, size_t b) {
+                    return mat_col[a] < mat_col[b];
                 });
-        }
+        });
 
         return primitive_argument_type{std::move(idx)};
     }
@@ -218,24 +214,19 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
     primitive_argument_type argsort::argsort2d_axis1(
         ir::node_data<T>&& in_array, std::string kind, std::string order) const
     {
-        using phylanx::util::matrix_row_iterator;
         auto mat = in_array.matrix();
         blaze::DynamicMatrix<std::int64_t> idx(mat.rows(), mat.columns());
 
-        matrix_row_iterator<decltype(mat)> mat_rows_begin(mat);
-        matrix_row_iterator<decltype(mat)> mat_rows_end(mat, mat.rows());
+        util::for_each_slice(mat.rows(), mat.columns(), [&](std::size_t i) {
+            auto mat_row = blaze::row(mat, i);
+            auto idx_row = blaze::row(idx, i);
 
-        matrix_row_iterator<decltype(idx)> idx_rows_it(idx);
-
-        for (auto mat_row = mat_rows_begin; mat_row != mat_rows_end;
-             ++mat_row, ++idx_rows_it)
-        {
-            std::iota(idx_rows_it->begin(), idx_rows_it->end(), 0);
-            std::sort(idx_rows_it->begin(), idx_rows_it->end(),
-                [mat_row](size_t a, size_t b) {
-                    return *(mat_row->begin() + a) < *(mat_row->begin() + b);
+            std::iota(idx_row.begin(), idx_row.end(), 0);
+            util::parallel_sort(idx_row.begin(), idx_row.end(),
+                [&mat_row](size_t a, size_t b) {
+                    return mat_row[a] < mat_row[b];
                 });
-        }
+        });
 
         return primitive_argument_type{std::move(idx)};
     }
@@ -271,30 +262,31 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
         blaze::DynamicTensor<std::int64_t> idx(
             tensor.pages(), tensor.rows(), tensor.columns());
 
-        for (size_t row = 0; row < tensor.rows(); ++row)
-        {
-            auto tensor_row_slice = blaze::rowslice(tensor, row);
-            matrix_row_iterator<decltype(tensor_row_slice)> const
-                mat_slice_rows_begin(tensor_row_slice);
-            matrix_row_iterator<decltype(tensor_row_slice)> const
-                mat_slice_rows_end(tensor_row_slice, tensor_row_slice.rows());
-
-            auto idx_row_slice = blaze::rowslice(idx, row);
-            matrix_row_iterator<decltype(idx_row_slice)> const
-                idx_slice_rows_begin(idx_row_slice);
-
-            auto idx_row = idx_slice_rows_begin;
-            for (auto mat_row = mat_slice_rows_begin;
-                 mat_row != mat_slice_rows_end; ++mat_row, ++idx_row)
-            {
-                std::iota(idx_row->begin(), idx_row->end(), 0);
-                std::sort(idx_row->begin(), idx_row->end(),
-                    [mat_row](size_t a, size_t b) {
-                        return *(mat_row->begin() + a) <
-                            *(mat_row->begin() + b);
-                    });
-            }
-        }
+        util::for_each_slice(tensor.rows(), tensor.pages() * tensor.columns(),
+            [&](std::size_t row) {
+                auto tensor_row_slice = blaze::rowslice(tensor, row);
+                matrix_row_iterator<decltype(tensor_row_slice)> const
+                    mat_slice_rows_begin(tensor_row_slice);
+                matrix_row_iterator<decltype(tensor_row_slice)> const
+                    mat_slice_rows_end(
+                        tensor_row_slice, tensor_row_slice.rows());
+
+                auto idx_row_slice = blaze::rowslice(idx, row);
+                matrix_row_iterator<decltype(idx_row_slice)> const
+                    idx_slice_rows_begin(idx_row_slice);
+
+                auto idx_row = idx_slice_rows_begin;
+                for (auto mat_row = mat_slice_rows_begin;
+                     mat_row != mat_slice_rows_end; ++mat_row, ++idx_row)
+                {
+                    std::iota(idx_row->begin(), idx_row->end(), 0);
+                    std::sort(idx_row->begin(), idx_row->end(),
+                        [mat_row](size_t a, size_t b) {
+                            return *(mat_row->begin() + a) <
+                                *(mat_row->begin() + b);
+                        });
+                }
+            });
         return primitive_argument_type{std::move(idx)};
     }
 
@@ -307,31 +299,31 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
         blaze::DynamicTensor<std::int64_t> idx(
             tensor.pages(), tensor.rows(), tensor.columns());
 
-        for (size_t page = 0; page < tensor.columns(); ++page)
-        {
-            auto tensor_col_slice = blaze::columnslice(tensor, page);
-            matrix_row_iterator<decltype(tensor_col_slice)> const
-                mat_slice_rows_begin(tensor_col_slice);
-            matrix_row_iterator<decltype(tensor_col_slice)> const
-                mat_slice_rows_end(
-                    tensor_col_slice, tensor_col_slice.columns());
-
-            auto idx_col_slice = blaze::columnslice(idx, page);
-            matrix_row_iterator<decltype(idx_col_slice)> const
-                idx_slice_rows_begin(idx_col_slice);
-
-            auto idx_row = idx_slice_rows_begin;
-            for (auto mat_row = mat_slice_rows_begin;
-                 mat_row != mat_slice_rows_end; ++mat_row, ++idx_row)
-            {
-                std::iota(idx_row->begin(), idx_row->end(), 0);
-                std::sort(idx_row->begin(), idx_row->end(),
-                    [mat_row](size_t a, size_t b) {
-                        return *(mat_row->begin() + a) <
-                            *(mat_row->begin() + b);
-                    });
-            }
-        }
+        util::for_each_slice(tensor.columns(), tensor.pages() * tensor.rows(),
+            [&](std::size_t page) {
+                auto tensor_col_slice = blaze::columnslice(tensor, page);
+                matrix_row_iterator<decltype(tensor_col_slice)> const
+                    mat_slice_rows_begin(tensor_col_slice);
+                matrix_row_iterator<decltype(tensor_col_slice)> const
+                    mat_slice_rows_end(
+                        tensor_col_slice, tensor_col_slice.columns());
+
+                auto idx_col_slice = blaze::columnslice(idx, page);
+                matrix_row_iterator<decltype(idx_col_slice)> const
+                    idx_slice_rows_begin(idx_col_slice);
+
+                auto idx_row = idx_slice_rows_begin;
+                for (auto mat_row = mat_slice_rows_begin;
+                     mat_row != mat_slice_rows_end; ++mat_row, ++idx_row)
+                {
+                    std::iota(idx_row->begin(), idx_row->end(), 0);
+                    std::sort(idx_row->begin(), idx_row->end(),
+                        [mat_row](size_t a, size_t b) {
+                            return *(mat_row->begin() + a) <
+                                *(mat_row->begin() + b);
+                        });
+                }
+            });
         return primitive_argument_type{std::move(idx)};
     }
 
@@ -344,32 +336,32 @@ https://docs.scipy.org/doc/numpy/reference/generated/numpy.argsort.html#numpy.ar
         blaze::DynamicTensor<std::int64_t> idx(
             tensor.pages(), tensor.rows(), tensor.columns());
 
-        for (size_t page = 0; page < tensor.pages(); ++page)
-        {
-            auto tensor_page_slice = blaze::pageslice(tensor, page);
-
-            matrix_row_iterator<decltype(tensor_page_slice)> const
-                mat_slice_pages_begin(tensor_page_slice);
-            matrix_row_iterator<decltype(tensor_page_slice)> const
-                mat_slice_pages_end(
-                    tensor_page_slice, tensor_page_slice.rows());
-
-            auto idx_page_slice = blaze::pageslice(idx, page);
-            matrix_row_iterator<decltype(idx_page_slice)> const
-                idx_slice_pages_begin(idx_page_slice);
-
-            auto idx_page = idx_slice_pages_begin;
-            for (auto mat_page = mat_slice_pages_begin;
-                 mat_page != mat_slice_pages_end; ++mat_page, ++idx_page)
-            {
-                std::iota(idx_page->begin(), idx_page->end(), 0);
-                std::sort(idx_page->begin(), idx_page->end(),
-                    [mat_page](size_t a, size_t b) {
-                        return *(mat_page->begin() + a) <
-                            *(mat_page->begin() + b);
-                    });
-            }
-        }
+        util::for_each_slice(tensor.pages(), tensor.rows() * tensor.columns(),
+            [&](std::size_t page) {
+                auto tensor_page_slice = blaze::pageslice(tensor, page);
+
+                matrix_row_iterator<decltype(tensor_page_slice)> const
+                    mat_slice_pages_begin(tensor_page_slice);
+                matrix_row_iterator<decltype(tensor_page_slice)> const
+                    mat_slice_pages_end(
+                        tensor_page_slice, tensor_page_slice.rows());
+
+                auto idx_page_slice = blaze::pageslice(idx, page);
+                matrix_row_iterator<decltype(idx_page_slice)> const
+                    idx_slice_pages_begin(idx_page_slice);
+
+                auto idx_page = idx_slice_pages_begin;
+                for (auto mat_page = mat_slice_pages_begin;
+                     mat_page != mat_slice_pages_end; ++mat_page, ++idx_page)
+                {
+                    std::iota(idx_page->begin(), idx_page->end(), 0);
+                    std::sort(idx_page->begin(), idx_page->end(),
+                        [mat_page](size_t a, size_t b) {
+                            return *(mat_page->begin() + a) <
+                                *(mat_page->begin() + b);
+                        });
+                }
+            });
         return primitive_argument_type{std::move(idx)};
     }
 
@@ -380,89 +380,92 @@ namespace phylanx { namespace execution_tree { namespace primitives
     namespace detail
     {
         ///////////////////////////////////////////////////////////////////////
+        // All elements are generated from the counter based generator using
+        // a fresh stream for each invocation of the primitive and their (row
+        // major) offset inside the array, which allows for filling large
+        // arrays in parallel while still producing the same values for a
+        // given seed.
         template <typename Dist, typename T>
-        ir::node_data<T> randomize(Dist& dist, T& d)
+        ir::node_data<T> randomize(Dist& dist, T& d, std::uint64_t stream)
         {
-            d = dist(util::rng_);
+            d = util::random_value(dist, util::get_seed(), stream, 0);
             return ir::node_data<T>{d};
         }
 
         template <typename Dist, typename T>
         ir::node_data<T> randomize(
-            Dist& dist, blaze::DynamicVector<T>& v)
+            Dist& dist, blaze::DynamicVector<T>& v, std::uint64_t stream)
         {
-            std::size_t const size = v.size();
+            std::uint32_t const seed = util::get_seed();
 
-            for (std::size_t i = 0; i != size; ++i)
-            {
-                v[i] = dist(util::rng_);
-            }
+            util::parallel_random_fill(dist, v.size(),
+                [&](Dist& d, std::size_t i)
+                {
+                    v[i] = util::random_value(d, seed, stream, i);
+                });
 
             return ir::node_data<T>{std::move(v)};
         }
 
         template <typename Dist, typename T>
         ir::node_data<T> randomize(
-            Dist& dist, blaze::DynamicMatrix<T>& m)
+            Dist& dist, blaze::DynamicMatrix<T>& m, std::uint64_t stream)
         {
-            std::size_t const rows = m.rows();
+            std::uint32_t const seed = util::get_seed();
+
             std::size_t const columns = m.columns();
 
-            for (std::size_t i = 0; i != rows; ++i)
-            {
-                for (std::size_t j = 0; j != columns; ++j)
+            util::parallel_random_fill(dist, m.rows() * columns,
+                [&](Dist& d, std::size_t i)
                 {
-                    m(i, j) = dist(util::rng_);
-                }
-            }
+                    m(i / columns, i % columns) =
+                        util::random_value(d, seed, stream, i);
+                });
 
             return ir::node_data<T>{std::move(m)};
         }
 
         template <typename Dist, typename T>
         ir::node_data<T> randomize(
-            Dist& dist, blaze::DynamicTensor<T>& t)
+            Dist& dist, blaze::DynamicTensor<T>& t, std::uint64_t stream)
         {
-            std::size_t const pages = t.pages();
+            std::uint32_t const seed = util::get_seed();
+
             std::size_t const rows = t.rows();
             std::size_t const columns = t.columns();
 
-            for (std::size_t k = 0; k != pages; ++k)
-            {
-                for (std::size_t i = 0; i != rows; ++i)
+            util::parallel_random_fill(dist, t.pages() * rows * columns,
+                [&](Dist& d, std::size_t i)
                 {
-                    for (std::size_t j = 0; j != columns; ++j)
-                    {
-                        t(k, i, j) = dist(util::rng_);
-                    }
-                }
-            }
+                    std::size_t const j = i % columns;
+                    std::size_t const k = i / columns;
+                    t(k / rows, k % rows, j) =
+                        util::random_value(d, seed, stream, i);
+                });
 
             return ir::node_data<T>{std::move(t)};
         }
 
         template <typename Dist, typename T>
         ir::node_data<T> randomize(
-            Dist& dist, blaze::DynamicArray<4UL, T>& q)
+            Dist& dist, blaze::DynamicArray<4UL, T>& q, std::uint64_t stream)
         {
-            std::size_t const quats = q.quats();
+            std::uint32_t const seed = util::get_seed();
+
             std::size_t const pages = q.pages();
             std::size_t const rows  = q.rows();
             std::size_t const columns = q.columns();
 
-            for (std::size_t l = 0; l != quats; ++l)
-            {
-                for (std::size_t k = 0; k != pages; ++k)
+            util::parallel_random_fill(dist,
+                q.quats() * pages * rows * columns,
+                [&](Dist& d, std::size_t i)
                 {
-                    for (std::size_t i = 0; i != rows; ++i)
-                    {
-                        for (std::size_t j = 0; j != columns; ++j)
-                        {
-                            q(l, k, i, j) = dist(util::rng_);
-                        }
-                    }
-                }
-            }
+                    std::size_t const j = i % columns;
+                    std::size_t const k = (i / columns) % rows;
+                    std::size_t const l = i / (columns * rows);
+                    q(l / pages, l % pages, k, j) =
+                        util::random_value(d, seed, stream, i);
+                });
 
             return ir::node_data<T>{std::move(q)};
         }
@@ -513,7 +516,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::string const& name, std::string const& codename,
             eval_context ctx)
         {
-            ir::node_data<T> result = randomize(dist, data);
+            ir::node_data<T> result =
+                randomize(dist, data, util::next_random_stream(name));
             switch (dtype)
             {
             case node_data_type_int64:
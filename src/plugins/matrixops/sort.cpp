@@ -9,6 +9,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/sort.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_sort.hpp>
 #include <phylanx/util/tensor_iterators.hpp>
 
 #include <hpx/include/lcos.hpp>
@@ -65,7 +66,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicVector<T> result(m.rows() * m.columns());
 
         std::copy(r.begin(), r.end(), result.begin());
-        std::sort(result.begin(), result.begin() + result.size());
+        util::sort_values(result.data(), result.data() + result.size());
         return primitive_argument_type{std::move(result)};
     }
 
@@ -78,7 +79,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicVector<T> result(t.pages() * t.rows() * t.columns());
 
         std::copy(r.begin(), r.end(), result.begin());
-        std::sort(result.begin(), result.begin() + result.size());
+        util::sort_values(result.data(), result.data() + result.size());
         return primitive_argument_type{std::move(result)};
     }
 
@@ -152,7 +153,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             auto v = arg.vector();
 
-            std::sort(v.begin(), v.begin() + v.size());
+            util::sort_values(v.data(), v.data() + v.size());
             return primitive_argument_type{std::move(arg)};
         }
         HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -165,16 +166,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type sort::sort2d_axis0(ir::node_data<T>&& arg,
         std::string kind) const
     {
-        using phylanx::util::matrix_column_iterator;
         auto m = arg.matrix();
 
-        matrix_column_iterator<decltype(m)> m_begin(m);
-        const matrix_column_iterator<decltype(m)> m_end(m, m.columns());
-
-        for (auto it = m_begin; it != m_end; ++it)
-        {
-            std::sort(it->begin(), it->end());
-        }
+        // columns are independent of each other, sort them concurrently
+        util::for_each_slice(m.columns(), m.rows(), [&](std::size_t j) {
+            auto c = blaze::column(m, j);
+            std::sort(c.begin(), c.end());
+        });
 
         return primitive_argument_type{std::move(arg)};
     }
@@ -184,15 +182,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string kind) const
     {
         auto m = arg.matrix();
-        using phylanx::util::matrix_row_iterator;
-
-        matrix_row_iterator<decltype(m)> m_begin(m);
-        const matrix_row_iterator<decltype(m)> m_end(m, m.rows());
 
-        for (auto it = m_begin; it != m_end; ++it)
-        {
-            std::sort(it->begin(), it->end());
-        }
+        // rows are stored contiguously, a single large row is sorted in
+        // parallel, many rows are sorted concurrently
+        util::for_each_slice(m.rows(), m.columns(), [&](std::size_t i) {
+            util::sort_values(m.data(i), m.data(i) + m.columns());
+        });
 
         return primitive_argument_type{std::move(arg)};
     }
@@ -228,16 +223,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using phylanx::util::matrix_row_iterator;
         auto t = arg.tensor();
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-        {
-            auto slice = blaze::rowslice(t, i);
-            matrix_row_iterator<decltype(slice)> const a_begin(slice);
-            matrix_row_iterator<decltype(slice)> const a_end(
-                slice, slice.rows());
+        util::for_each_slice(
+            t.rows(), t.pages() * t.columns(), [&](std::size_t i) {
+                auto slice = blaze::rowslice(t, i);
+                matrix_row_iterator<decltype(slice)> const a_begin(slice);
+                matrix_row_iterator<decltype(slice)> const a_end(
+                    slice, slice.rows());
 
-            for (auto it = a_begin; it != a_end; ++it)
-                std::sort(it->begin(), it->end());
-        }
+                for (auto it = a_begin; it != a_end; ++it)
+                    std::sort(it->begin(), it->end());
+            });
         return primitive_argument_type{std::move(arg)};
     }
 
@@ -248,16 +243,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using phylanx::util::matrix_row_iterator;
         auto t = arg.tensor();
 
-        for (std::size_t i = 0; i != t.columns(); ++i)
-        {
-            auto slice = blaze::columnslice(t, i);
-            matrix_row_iterator<decltype(slice)> const a_begin(slice);
-            matrix_row_iterator<decltype(slice)> const a_end(
-                slice, slice.rows());
+        util::for_each_slice(
+            t.columns(), t.pages() * t.rows(), [&](std::size_t i) {
+                auto slice = blaze::columnslice(t, i);
+                matrix_row_iterator<decltype(slice)> const a_begin(slice);
+                matrix_row_iterator<decltype(slice)> const a_end(
+                    slice, slice.rows());
 
-            for (auto it = a_begin; it != a_end; ++it)
-                std::sort(it->begin(), it->end());
-        }
+                for (auto it = a_begin; it != a_end; ++it)
+                    std::sort(it->begin(), it->end());
+            });
         return primitive_argument_type{std::move(arg)};
     }
 
@@ -268,16 +263,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using phylanx::util::matrix_column_iterator;
         auto t = arg.tensor();
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-        {
-            auto slice = blaze::rowslice(t, i);
-            matrix_column_iterator<decltype(slice)> const a_begin(slice);
-            matrix_column_iterator<decltype(slice)> const a_end(
-                slice, slice.columns());
+        util::for_each_slice(
+            t.rows(), t.pages() * t.columns(), [&](std::size_t i) {
+                auto slice = blaze::rowslice(t, i);
+                matrix_column_iterator<decltype(slice)> const a_begin(slice);
+                matrix_column_iterator<decltype(slice)> const a_end(
+                    slice, slice.columns());
 
-            for (auto it = a_begin; it != a_end; ++it)
-                std::sort(it->begin(), it->end());
-        }
+                for (auto it = a_begin; it != a_end; ++it)
+                    std::sort(it->begin(), it->end());
+            });
         return primitive_argument_type{std::move(arg)};
     }
 
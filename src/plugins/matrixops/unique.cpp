@@ -10,6 +10,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/unique.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_sort.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -105,7 +106,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         blaze::DynamicVector<T> a = arg.vector();
         // Sorting the vector
-        std::sort(a.begin(), a.end());
+        util::sort_values(a.data(), a.data() + a.size());
 
         // Use std::unique to remove duplicacy
         auto ip = std::unique(a.begin(), a.end());
@@ -183,7 +184,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
 
         // Sorting the vector
-        std::sort(result.begin(), result.end());
+        util::sort_values(result.data(), result.data() + result.size());
 
         // Use std::unique to remove duplicacy
         auto ip = std::unique(result.begin(), result.end());
@@ -209,7 +210,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             a.rows(), a_begin);
         std::iota(indices.begin(), indices.end(), a_begin);
 
-        std::sort(indices.begin(), indices.end(),
+        util::parallel_sort(indices.begin(), indices.end(),
             [&](const auto& lhs, const auto& rhs) {
                 return std::lexicographical_compare(
                     lhs->begin(), lhs->end(), rhs->begin(), rhs->end());
@@ -238,7 +239,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             a.columns(), a_begin);
         std::iota(indices.begin(), indices.end(), a_begin);
 
-        std::sort(indices.begin(), indices.end(),
+        util::parallel_sort(indices.begin(), indices.end(),
             [&](const auto& lhs, const auto& rhs) {
                 return std::lexicographical_compare(
                     lhs->begin(), lhs->end(), rhs->begin(), rhs->end());
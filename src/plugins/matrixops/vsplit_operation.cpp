@@ -163,7 +163,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             if (ranges[i].second > ranges[i].first)
             {
-                blaze::CustomMatrix<T, blaze::aligned, blaze::padded> block(
+                typename ir::node_data<T>::custom_storage2d_type block(
                     &m(ranges[i].first, 0), ranges[i].second - ranges[i].first,
                     num_cols, m.spacing());
 
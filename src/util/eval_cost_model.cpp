@@ -0,0 +1,155 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/eval_cost_model.hpp>
+
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // weight of the existing samples whenever a new sample is added
+        constexpr double eval_cost_model_decay = 0.9;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    eval_cost_model::eval_cost_model()
+      : sum_weights_(0.0)
+      , sum_n_(0.0)
+      , sum_nn_(0.0)
+      , sum_t_(0.0)
+      , sum_nt_(0.0)
+      , num_samples_(0)
+      , eval_count_(0)
+      , last_work_size_(0)
+      , result_size_(0)
+      , has_prediction_(false)
+    {
+    }
+
+    bool eval_cost_model::enabled()
+    {
+        static bool enabled =
+            hpx::get_config_entry("phylanx.eval_cost_model", "1") == "1";
+        return enabled;
+    }
+
+    std::size_t eval_cost_model::min_samples()
+    {
+        static std::size_t min_samples = std::stoul(
+            hpx::get_config_entry("phylanx.eval_count_threshold", "5"));
+        return min_samples;
+    }
+
+    std::size_t eval_cost_model::sample_interval()
+    {
+        static std::size_t sample_interval = (std::max)(std::size_t(1),
+            std::stoul(hpx::get_config_entry(
+                "phylanx.eval_sample_interval", "16")));
+        return sample_interval;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool eval_cost_model::sample_eval(std::size_t work_size)
+    {
+        std::size_t count = ++eval_count_;
+
+        // measure all evaluations until the model has enough data
+        if (!has_prediction_.load(std::memory_order_relaxed))
+        {
+            last_work_size_.store(work_size, std::memory_order_relaxed);
+            return true;
+        }
+
+        // measure whenever the amount of work changes significantly
+        std::size_t last_work_size =
+            last_work_size_.load(std::memory_order_relaxed);
+        if (work_size > 2 * last_work_size || last_work_size > 2 * work_size)
+        {
+            last_work_size_.store(work_size, std::memory_order_relaxed);
+            return true;
+        }
+
+        return (count % sample_interval()) == 0;
+    }
+
+    void eval_cost_model::add_sample(std::size_t work_size,
+        std::size_t result_size, std::int64_t duration)
+    {
+        double const n =
+            static_cast<double>((std::max)(work_size, result_size));
+        double const t = static_cast<double>(duration);
+
+        result_size_.store(result_size, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+
+            double const decay = detail::eval_cost_model_decay;
+
+            sum_weights_ = decay * sum_weights_ + 1.0;
+            sum_n_ = decay * sum_n_ + n;
+            sum_nn_ = decay * sum_nn_ + n * n;
+            sum_t_ = decay * sum_t_ + t;
+            sum_nt_ = decay * sum_nt_ + n * t;
+
+            if (++num_samples_ < min_samples())
+            {
+                return;
+            }
+        }
+
+        has_prediction_.store(true, std::memory_order_relaxed);
+    }
+
+    std::int64_t eval_cost_model::predicted_duration(std::size_t n) const
+    {
+        if (!has_prediction_.load(std::memory_order_relaxed))
+        {
+            return -1;
+        }
+
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        return predict(static_cast<double>(n));
+    }
+
+    // this is called with the lock held
+    std::int64_t eval_cost_model::predict(double n) const
+    {
+        double const mean_t = sum_t_ / sum_weights_;
+
+        // if all samples were taken for (almost) the same number of elements
+        // the model degenerates to the (weighted) mean duration
+        double const denominator = sum_weights_ * sum_nn_ - sum_n_ * sum_n_;
+        if (denominator <= 1e-9 * sum_weights_ * sum_nn_)
+        {
+            return static_cast<std::int64_t>(mean_t);
+        }
+
+        double cost_per_element =
+            (sum_weights_ * sum_nt_ - sum_n_ * sum_t_) / denominator;
+        if (cost_per_element < 0.0)
+        {
+            // larger data should never be cheaper, ignore the noise
+            return static_cast<std::int64_t>(mean_t);
+        }
+
+        double const fixed_cost =
+            (sum_t_ - cost_per_element * sum_n_) / sum_weights_;
+
+        return static_cast<std::int64_t>(
+            (std::max)(0.0, fixed_cost + cost_per_element * n));
+    }
+}}
@@ -0,0 +1,55 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/memory_tracker.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    static std::atomic<std::int64_t> live_bytes_(0);
+    static std::atomic<std::int64_t> high_water_mark_(0);
+
+    void memory_tracker::allocate(std::size_t bytes)
+    {
+        std::int64_t live =
+            live_bytes_.fetch_add(static_cast<std::int64_t>(bytes),
+                std::memory_order_relaxed) +
+            static_cast<std::int64_t>(bytes);
+
+        std::int64_t mark = high_water_mark_.load(std::memory_order_relaxed);
+        while (mark < live &&
+            !high_water_mark_.compare_exchange_weak(
+                mark, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void memory_tracker::deallocate(std::size_t bytes)
+    {
+        live_bytes_.fetch_sub(
+            static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    std::int64_t memory_tracker::live_bytes(bool)
+    {
+        return live_bytes_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t memory_tracker::high_water_mark(bool reset)
+    {
+        if (reset)
+        {
+            return high_water_mark_.exchange(
+                live_bytes_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+        return high_water_mark_.load(std::memory_order_relaxed);
+    }
+}}
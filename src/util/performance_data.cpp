@@ -274,7 +274,8 @@ namespace phylanx { namespace util {
         hpx::naming::id_type const& locality_id)
     {
         std::vector<std::string> const counter_names{
-            "count/eval", "time/eval", "eval_direct"};
+            "count/eval", "time/eval", "eval_direct", "memory/result_bytes",
+            "memory/live_bytes"};
 
         return retrieve_counter_data(
             primitive_instances, counter_names, locality_id);
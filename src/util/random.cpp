@@ -1,18 +1,22 @@
 // Copyright (c) 2018 Parsa Amini
-// Copyright (c) 2018 Hartmut Kaiser
+// Copyright (c) 2018-2020 Hartmut Kaiser
 //
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/util/random.hpp>
 
+#include <hpx/synchronization/spinlock.hpp>
+
 #include <cstdint>
+#include <map>
+#include <mutex>
 #include <random>
+#include <string>
 
 namespace phylanx { namespace util
 {
-    std::uint32_t seed_ = 0;     // The current seed for the generator.
-
     std::uint32_t default_seed()
     {
         static const std::uint32_t seed =
@@ -20,16 +24,121 @@ namespace phylanx { namespace util
         return seed;
     }
 
+    // The current seed for the generator.
+    std::uint32_t seed_ = default_seed();
+
     std::mt19937 rng_{default_seed()};    // The Mersenne twister generator.
 
+    namespace detail
+    {
+        // The number of streams handed out for each name since the seed was
+        // set last.
+        struct random_stream_invocations
+        {
+            std::uint64_t next(std::string const& name)
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+                return invocations_[name]++;
+            }
+
+            void reset()
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+                invocations_.clear();
+            }
+
+            hpx::lcos::local::spinlock mtx_;
+            std::map<std::string, std::uint64_t> invocations_;
+        };
+
+        random_stream_invocations& get_random_stream_invocations()
+        {
+            static random_stream_invocations invocations;
+            return invocations;
+        }
+
+        // FNV-1a
+        std::uint64_t random_stream_hash(
+            std::string const& name, std::uint64_t hash)
+        {
+            for (char c : name)
+            {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        constexpr std::uint64_t random_stream_basis = 14695981039346656037ULL;
+    }
+
     void set_seed(std::uint32_t seed)
     {
         seed_ = seed;
         rng_.seed(seed_);
+        detail::get_random_stream_invocations().reset();
     }
 
     std::uint32_t get_seed()
     {
         return seed_;
     }
+
+    namespace detail
+    {
+        // the names of primitives include the locality they were created on,
+        // which must not affect the generated values
+        std::string random_stream_key(std::string const& name)
+        {
+            execution_tree::compiler::primitive_name_parts parts;
+            if (!execution_tree::compiler::parse_primitive_name(name, parts))
+            {
+                return name;
+            }
+            parts.locality = 0;
+            return execution_tree::compiler::compose_primitive_name(parts);
+        }
+
+        std::uint64_t random_stream_of(
+            std::string const& key, std::uint64_t invocation)
+        {
+            std::uint64_t hash =
+                random_stream_hash(key, random_stream_basis);
+            for (int i = 0; i != 8; ++i)
+            {
+                hash ^= (invocation >> (8 * i)) & 0xff;
+                hash *= 1099511628211ULL;
+            }
+
+            // streams of invocations have the most significant bit cleared
+            return hash & ~(std::uint64_t(1) << 63);
+        }
+    }
+
+    std::uint64_t next_random_invocation(std::string const& name)
+    {
+        return detail::get_random_stream_invocations().next(
+            detail::random_stream_key(name));
+    }
+
+    std::uint64_t next_random_stream(std::string const& name)
+    {
+        std::string const key = detail::random_stream_key(name);
+        return detail::random_stream_of(
+            key, detail::get_random_stream_invocations().next(key));
+    }
+
+    std::uint64_t random_stream(
+        std::string const& name, std::uint64_t invocation)
+    {
+        return detail::random_stream_of(
+            detail::random_stream_key(name), invocation);
+    }
+
+    std::uint64_t random_stream(std::string const& name)
+    {
+        // named streams have the most significant bit set
+        return detail::random_stream_hash(name, detail::random_stream_basis) |
+            (std::uint64_t(1) << 63);
+    }
 }}
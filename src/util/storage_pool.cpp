@@ -0,0 +1,365 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/storage_pool.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    static std::atomic<std::int64_t> hits_(0);
+    static std::atomic<std::int64_t> misses_(0);
+    static std::atomic<std::int64_t> cached_bytes_(0);
+
+    bool storage_pool_enabled()
+    {
+        // the configuration is not available before the runtime was started
+        if (hpx::get_runtime_ptr() == nullptr)
+        {
+            return false;
+        }
+
+        static bool enabled =
+            hpx::get_config_entry("phylanx.allocator", "default") == "pooled";
+        return enabled;
+    }
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t max_cached_bytes()
+        {
+            static std::size_t max_bytes = std::stoull(hpx::get_config_entry(
+                "phylanx.allocator.max_cached_bytes", "67108864"));
+            return max_bytes;
+        }
+
+        // limit the number of containers a lookup has to go through
+        constexpr std::size_t max_cached_containers = 64;
+
+        ///////////////////////////////////////////////////////////////////////
+        // The caches of all container types of a worker share the limit for
+        // the number of cached bytes.
+        class storage_cache_base
+        {
+        public:
+            virtual ~storage_cache_base() = default;
+
+            // Return the release sequence number of the least recently
+            // released container, or the maximal value if the cache is empty
+            virtual std::uint64_t oldest() const = 0;
+
+            // Free the least recently released container
+            virtual void evict_oldest() = 0;
+        };
+
+        class storage_budget
+        {
+        public:
+            storage_budget() = default;
+
+            storage_budget(storage_budget const&) = delete;
+            storage_budget& operator=(storage_budget const&) = delete;
+
+            void add_cache(storage_cache_base* cache)
+            {
+                caches_.push_back(cache);
+            }
+
+            void remove_cache(storage_cache_base* cache)
+            {
+                caches_.erase(
+                    std::remove(caches_.begin(), caches_.end(), cache),
+                    caches_.end());
+            }
+
+            // Free the least recently released containers of all caches
+            // until the given number of bytes fits into the limit
+            void make_room(std::size_t bytes, std::size_t max_bytes)
+            {
+                while (bytes_ + bytes > max_bytes)
+                {
+                    storage_cache_base* lru = nullptr;
+                    std::uint64_t oldest = (std::numeric_limits<
+                        std::uint64_t>::max)();
+                    for (storage_cache_base* cache : caches_)
+                    {
+                        std::uint64_t const sequence = cache->oldest();
+                        if (sequence < oldest)
+                        {
+                            oldest = sequence;
+                            lru = cache;
+                        }
+                    }
+
+                    if (lru == nullptr)
+                    {
+                        break;
+                    }
+                    lru->evict_oldest();
+                }
+            }
+
+            std::uint64_t next_sequence()
+            {
+                return ++sequence_;
+            }
+
+            void add_bytes(std::size_t bytes)
+            {
+                bytes_ += bytes;
+                cached_bytes_.fetch_add(static_cast<std::int64_t>(bytes),
+                    std::memory_order_relaxed);
+            }
+
+            void remove_bytes(std::size_t bytes)
+            {
+                bytes_ -= bytes;
+                cached_bytes_.fetch_sub(static_cast<std::int64_t>(bytes),
+                    std::memory_order_relaxed);
+            }
+
+        private:
+            std::vector<storage_cache_base*> caches_;
+            std::size_t bytes_ = 0;
+            std::uint64_t sequence_ = 0;
+        };
+
+        storage_budget& get_storage_budget()
+        {
+            static thread_local storage_budget budget;
+            return budget;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Container>
+        class storage_cache : public storage_cache_base
+        {
+        public:
+            using shape_type = std::array<std::size_t, 3>;
+
+            // the budget is constructed first, thus it outlives the cache
+            storage_cache()
+              : budget_(get_storage_budget())
+            {
+                budget_.add_cache(this);
+            }
+
+            storage_cache(storage_cache const&) = delete;
+            storage_cache& operator=(storage_cache const&) = delete;
+
+            ~storage_cache()
+            {
+                budget_.remove_bytes(bytes_);
+                budget_.remove_cache(this);
+            }
+
+            bool acquire(shape_type const& shape, Container& c)
+            {
+                // prefer the most recently released container, its memory
+                // is most likely still in the caches
+                for (auto it = entries_.rbegin(); it != entries_.rend(); ++it)
+                {
+                    if (it->shape_ == shape)
+                    {
+                        c = std::move(it->data_);
+                        remove_bytes(it->bytes_);
+                        entries_.erase(std::next(it).base());
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void release(shape_type const& shape, Container&& c)
+            {
+                std::size_t const bytes = c.capacity() *
+                    sizeof(typename Container::ElementType);
+
+                std::size_t const max_bytes = max_cached_bytes();
+                if (bytes == 0 || bytes > max_bytes)
+                {
+                    return;
+                }
+
+                if (entries_.size() >= max_cached_containers)
+                {
+                    evict_oldest();
+                }
+
+                // free the least recently released containers first,
+                // regardless of their type
+                budget_.make_room(bytes, max_bytes);
+
+                entries_.push_back(entry{
+                    shape, bytes, budget_.next_sequence(), std::move(c)});
+
+                bytes_ += bytes;
+                budget_.add_bytes(bytes);
+            }
+
+            std::uint64_t oldest() const override
+            {
+                return entries_.empty() ?
+                    (std::numeric_limits<std::uint64_t>::max)() :
+                    entries_.front().sequence_;
+            }
+
+            void evict_oldest() override
+            {
+                std::size_t const bytes = entries_.front().bytes_;
+                entries_.erase(entries_.begin());
+                remove_bytes(bytes);
+            }
+
+        private:
+            void remove_bytes(std::size_t bytes)
+            {
+                bytes_ -= bytes;
+                budget_.remove_bytes(bytes);
+            }
+
+            struct entry
+            {
+                shape_type shape_;
+                std::size_t bytes_;
+                std::uint64_t sequence_;
+                Container data_;
+            };
+
+            storage_budget& budget_;
+            std::vector<entry> entries_;
+            std::size_t bytes_ = 0;
+        };
+
+        // HPX threads are not suspended while accessing the cache, which
+        // makes it safe to use the cache of the current worker (OS-thread)
+        template <typename Container>
+        storage_cache<Container>& get_storage_cache()
+        {
+            static thread_local storage_cache<Container> cache;
+            return cache;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Container, typename... Ts>
+        Container acquire(std::array<std::size_t, 3> const& shape, Ts... sizes)
+        {
+            if (storage_pool_enabled())
+            {
+                Container c;
+                if (get_storage_cache<Container>().acquire(shape, c))
+                {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return c;
+                }
+                misses_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return Container(sizes...);
+        }
+
+        template <typename Container>
+        void release(std::array<std::size_t, 3> const& shape, Container&& c)
+        {
+            if (storage_pool_enabled())
+            {
+                get_storage_cache<Container>().release(shape, std::move(c));
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    blaze::DynamicVector<T> storage_pool<T>::vector(std::size_t size)
+    {
+        return detail::acquire<blaze::DynamicVector<T>>(
+            std::array<std::size_t, 3>{0, 0, size}, size);
+    }
+
+    template <typename T>
+    blaze::DynamicMatrix<T> storage_pool<T>::matrix(
+        std::size_t rows, std::size_t columns)
+    {
+        return detail::acquire<blaze::DynamicMatrix<T>>(
+            std::array<std::size_t, 3>{0, rows, columns}, rows, columns);
+    }
+
+    template <typename T>
+    blaze::DynamicTensor<T> storage_pool<T>::tensor(
+        std::size_t pages, std::size_t rows, std::size_t columns)
+    {
+        return detail::acquire<blaze::DynamicTensor<T>>(
+            std::array<std::size_t, 3>{pages, rows, columns}, pages, rows,
+            columns);
+    }
+
+    template <typename T>
+    void storage_pool<T>::release(blaze::DynamicVector<T>&& v)
+    {
+        detail::release(
+            std::array<std::size_t, 3>{0, 0, v.size()}, std::move(v));
+    }
+
+    template <typename T>
+    void storage_pool<T>::release(blaze::DynamicMatrix<T>&& m)
+    {
+        detail::release(std::array<std::size_t, 3>{0, m.rows(), m.columns()},
+            std::move(m));
+    }
+
+    template <typename T>
+    void storage_pool<T>::release(blaze::DynamicTensor<T>&& t)
+    {
+        detail::release(
+            std::array<std::size_t, 3>{t.pages(), t.rows(), t.columns()},
+            std::move(t));
+    }
+
+    template struct PHYLANX_EXPORT storage_pool<double>;
+    template struct PHYLANX_EXPORT storage_pool<std::int64_t>;
+    template struct PHYLANX_EXPORT storage_pool<std::uint8_t>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t storage_pool_statistics::hits(bool reset)
+    {
+        return hpx::util::get_and_reset_value(hits_, reset);
+    }
+
+    std::int64_t storage_pool_statistics::misses(bool reset)
+    {
+        return hpx::util::get_and_reset_value(misses_, reset);
+    }
+
+    std::int64_t storage_pool_statistics::hit_rate(bool)
+    {
+        std::int64_t const hits = hits_.load(std::memory_order_relaxed);
+        std::int64_t const requests =
+            hits + misses_.load(std::memory_order_relaxed);
+        return requests != 0 ? (100 * hits) / requests : 0;
+    }
+
+    std::int64_t storage_pool_statistics::cached_bytes(bool)
+    {
+        return cached_bytes_.load(std::memory_order_relaxed);
+    }
+}}
@@ -0,0 +1,43 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/summa_statistics.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    static std::atomic<std::int64_t> bytes_moved_(0);
+    static std::atomic<std::int64_t> wait_time_(0);
+    static std::atomic<std::int64_t> compute_time_(0);
+
+    void summa_statistics::add(std::int64_t bytes_moved,
+        std::int64_t wait_time, std::int64_t compute_time)
+    {
+        bytes_moved_.fetch_add(bytes_moved, std::memory_order_relaxed);
+        wait_time_.fetch_add(wait_time, std::memory_order_relaxed);
+        compute_time_.fetch_add(compute_time, std::memory_order_relaxed);
+    }
+
+    std::int64_t summa_statistics::bytes_moved(bool reset)
+    {
+        return hpx::util::get_and_reset_value(bytes_moved_, reset);
+    }
+
+    std::int64_t summa_statistics::wait_time(bool reset)
+    {
+        return hpx::util::get_and_reset_value(wait_time_, reset);
+    }
+
+    std::int64_t summa_statistics::compute_time(bool reset)
+    {
+        return hpx::util::get_and_reset_value(compute_time_, reset);
+    }
+}}
@@ -0,0 +1,135 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the backends available for computing 2D convolutions
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/plugins/common/conv2d_engine.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+struct conv2d_shape
+{
+    std::size_t batch;
+    std::size_t size;
+    std::size_t in_channels;
+    std::size_t out_channels;
+    std::size_t filter;
+};
+
+phylanx::ir::node_data<double> random_array(std::size_t n0, std::size_t n1,
+    std::size_t n2, std::size_t n3, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    blaze::DynamicArray<4UL, double> result(n0, n1, n2, n3);
+    for (std::size_t l = 0; l != n0; ++l)
+        for (std::size_t k = 0; k != n1; ++k)
+            for (std::size_t i = 0; i != n2; ++i)
+                for (std::size_t j = 0; j != n3; ++j)
+                    result(l, k, i, j) = dist(gen);
+
+    return phylanx::ir::node_data<double>(std::move(result));
+}
+
+double max_difference(blaze::DynamicArray<4UL, double> const& lhs,
+    blaze::DynamicArray<4UL, double> const& rhs)
+{
+    double result = 0.0;
+    for (std::size_t l = 0; l != lhs.quats(); ++l)
+        for (std::size_t k = 0; k != lhs.pages(); ++k)
+            for (std::size_t i = 0; i != lhs.rows(); ++i)
+                for (std::size_t j = 0; j != lhs.columns(); ++j)
+                    result = (std::max)(result,
+                        std::abs(lhs(l, k, i, j) - rhs(l, k, i, j)));
+    return result;
+}
+
+void benchmark(conv2d_shape const& shape, std::size_t iterations)
+{
+    using phylanx::common::conv2d_backend;
+
+    std::mt19937 gen(42);
+    auto x = random_array(
+        shape.batch, shape.size, shape.size, shape.in_channels, gen);
+    auto kernel = random_array(shape.filter, shape.filter, shape.in_channels,
+        shape.out_channels, gen);
+
+    // 'same' padding, unit strides
+    phylanx::common::conv2d_parameters params;
+    params.pad_top = (shape.filter - 1) / 2;
+    params.pad_left = (shape.filter - 1) / 2;
+    params.out_height = shape.size;
+    params.out_width = shape.size;
+
+    std::cout << "\nbatch: " << shape.batch << ", image: " << shape.size
+              << "x" << shape.size << ", channels: " << shape.in_channels
+              << " -> " << shape.out_channels << ", kernel: " << shape.filter
+              << "x" << shape.filter << " (auto selects '"
+              << phylanx::common::conv2d_backend_name(
+                     phylanx::common::select_conv2d_backend(
+                         shape.filter, shape.filter, params))
+              << "')\n";
+
+    auto reference = phylanx::common::conv2d_compute(
+        x, kernel, params, conv2d_backend::direct);
+
+    for (auto backend : {conv2d_backend::direct, conv2d_backend::im2col,
+             conv2d_backend::winograd})
+    {
+        if (phylanx::common::select_conv2d_backend(
+                shape.filter, shape.filter, params, backend) != backend)
+        {
+            continue;    // backend is not applicable
+        }
+
+        std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+        blaze::DynamicArray<4UL, double> result;
+        for (std::size_t i = 0; i != iterations; ++i)
+        {
+            result = phylanx::common::conv2d_compute(
+                x, kernel, params, backend);
+        }
+        t = hpx::chrono::high_resolution_clock::now() - t;
+
+        std::cout << "  " << phylanx::common::conv2d_backend_name(backend)
+                  << ":\t" << (t / 1e3 / iterations) << " microseconds"
+                  << " (max. difference: " << max_difference(reference, result)
+                  << ")\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<conv2d_shape> shapes = {
+        {1, 32, 3, 16, 3},
+        {8, 32, 16, 32, 3},
+        {32, 28, 32, 64, 3},
+        {8, 32, 16, 32, 5},
+        {1, 64, 64, 64, 3},
+        {16, 14, 128, 128, 1},
+    };
+
+    for (auto const& shape : shapes)
+    {
+        benchmark(shape, 5);
+    }
+
+    return 0;
+}
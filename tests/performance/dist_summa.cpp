@@ -0,0 +1,89 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The tiles of both matrices form a (possibly rectangular) grid of localities
+char const* const summa_product_code = R"(block(
+    define(summa, dim_size, prefetch_depth,
+        block(
+            define(array1,
+                random_d(list(dim_size, dim_size), find_here(), num_localities())),
+            define(array2,
+                random_d(list(dim_size, dim_size), find_here(), num_localities())),
+            summa_product_d(array1, array2, prefetch_depth)
+        )
+    ),
+    summa
+))";
+
+////////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    using namespace phylanx::execution_tree;
+
+    // compile the given code
+    compiler::function_list snippets;
+    auto const& code_product = compile("summa", summa_product_code, snippets);
+    auto summa = code_product.run();
+
+    std::vector<std::int64_t> dim_sizes = {
+        12, 120, 240, 480, 960, 4800, 9600};
+    std::vector<std::int64_t> prefetch_depths = {1, 2, 4};
+
+    std::cout << "Having "
+        << hpx::get_num_localities(hpx::launch::sync)
+        << " localities:\n";
+
+    for (std::int64_t const& dim_size : dim_sizes)
+    {
+        for (std::int64_t const& prefetch_depth : prefetch_depths)
+        {
+            // discard the statistics collected by the previous run
+            phylanx::util::summa_statistics::bytes_moved(true);
+            phylanx::util::summa_statistics::wait_time(true);
+            phylanx::util::summa_statistics::compute_time(true);
+
+            hpx::chrono::high_resolution_timer t;
+
+            auto result = summa(dim_size, prefetch_depth);
+            auto elapsed = t.elapsed();
+
+            std::cout << "Result of SUMMA product for two square matrices of "
+                << "size " << dim_size << " (prefetch depth "
+                << prefetch_depth << ")\n on locality "
+                << hpx::get_locality_id()
+                << " is calculated in: " << elapsed << " seconds\n"
+                << " bytes moved: "
+                << phylanx::util::summa_statistics::bytes_moved(false)
+                << ", waiting: "
+                << phylanx::util::summa_statistics::wait_time(false) * 1e-9
+                << " seconds, computing: "
+                << phylanx::util::summa_statistics::compute_time(false) * 1e-9
+                << " seconds" << std::endl;
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {"hpx.run_hpx_main!=1"};
+
+    return hpx::init(argc, argv, cfg);
+}
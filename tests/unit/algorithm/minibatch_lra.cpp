@@ -0,0 +1,87 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// two linearly separable classes, the first column is the intercept
+char const* const data = R"(
+    define(x, [[1.0, 2.0], [1.0, 3.0], [1.0, 1.5], [1.0, -2.0],
+               [1.0, -3.0], [1.0, -1.0], [1.0, 2.5], [1.0, -2.5]])
+    define(y, [1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0])
+    define(gd, alpha, iterations,
+        block(
+            define(weights, constant(0.0, shape(x, 1))),
+            define(step, 0),
+            while(
+                step < iterations,
+                block(
+                    store(weights, weights - alpha * dot(transpose(x),
+                        1.0 / (1.0 + exp(-dot(x, weights))) - y)),
+                    store(step, step + 1)
+                )
+            ),
+            weights
+        )
+    )
+    define(difference, a, b, amax(absolute(a - b)))
+    define(classifies, weights, all((dot(x, weights) > 0.0) == (y > 0.5)))
+)";
+
+bool test_lra(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(data + code, snippets);
+    return phylanx::execution_tree::extract_scalar_boolean_value(f.run().arg_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_minibatch_lra()
+{
+    // the default is gradient descent over all rows
+    HPX_TEST(test_lra(R"(
+        difference(lra(x, y, 0.01, 100), gd(0.01, 100)) < 1e-12
+    )"));
+    HPX_TEST(test_lra(R"(
+        difference(lra(x, y, 0.01, 100, __arg(batch_size, 8)),
+            lra(x, y, 0.01, 100)) == 0.0
+    )"));
+
+    // mini-batches with all update rules, reproducible for a given seed
+    HPX_TEST(test_lra(R"(
+        classifies(lra(x, y, 0.1, 50, __arg(batch_size, 2), __arg(seed, 1)))
+    )"));
+    HPX_TEST(test_lra(R"(
+        classifies(lra(x, y, 0.1, 50, __arg(batch_size, 2),
+            __arg(optimizer, "momentum"), __arg(seed, 1)))
+    )"));
+    HPX_TEST(test_lra(R"(
+        classifies(lra(x, y, 0.1, 50, __arg(batch_size, 3),
+            __arg(optimizer, "adam"), __arg(seed, 1)))
+    )"));
+    HPX_TEST(test_lra(R"(
+        difference(
+            lra(x, y, 0.1, 50, __arg(batch_size, 3), __arg(seed, 1)),
+            lra(x, y, 0.1, 50, __arg(batch_size, 3), __arg(seed, 1))) == 0.0
+    )"));
+
+    // all weights change by less than the tolerance after one iteration
+    HPX_TEST(test_lra(R"(
+        difference(lra(x, y, 0.01, 100, __arg(tolerance, 10.0)),
+            lra(x, y, 0.01, 1)) == 0.0
+    )"));
+}
+
+int main(int argc, char* argv[])
+{
+    test_minibatch_lra();
+    return hpx::util::report_errors();
+}
@@ -4,12 +4,20 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/phylanx.hpp>
+#include <phylanx/util/random.hpp>
 
 #include <hpx/hpx_main.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
 #include <blaze/Math.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -62,9 +70,8 @@ char const* const als_test = R"(
                            [0.81527, 0.477525, -1.02618],
                            [-0.731458, 1.2927, 0.989476]]),
                 if(random_input, block(
-                        set_seed(0),
-                        store(X, random(list(num_users, num_factors))),
-                        store(Y, random(list(num_items, num_factors)))
+                        store(X, X_init),
+                        store(Y, Y_init)
                         )
                 ),
                 define(I_f, identity(num_factors)),
@@ -156,10 +163,42 @@ char const* const als_test = R"(
     if(physl_cpp_match && physl_expected_match, true, false)
 )";
 
+// als() draws its initial factors from the streams of the counter based
+// generator that are associated with the names 'als$X' and 'als$Y'
+std::string initial_factors(char const* name, std::size_t rows,
+    std::size_t columns)
+{
+    std::uint64_t const stream = phylanx::util::random_stream(name);
+    std::normal_distribution<double> dist;
+
+    std::ostringstream strm;
+    strm << std::setprecision(17) << "[";
+    for (std::size_t row = 0; row != rows; ++row)
+    {
+        strm << (row == 0 ? "[" : ", [");
+        for (std::size_t column = 0; column != columns; ++column)
+        {
+            if (column != 0)
+            {
+                strm << ", ";
+            }
+            strm << phylanx::util::random_value(
+                dist, 0, stream, row * columns + column);
+        }
+        strm << "]";
+    }
+    strm << "]";
+    return strm.str();
+}
+
 void test_als_physl()
 {
+    std::string const code_str = "define(X_init, " +
+        initial_factors("als$X", 10, 3) + ")\ndefine(Y_init, " +
+        initial_factors("als$Y", 5, 3) + ")\n" + als_test;
+
     phylanx::execution_tree::compiler::function_list snippets;
-    auto const& code = phylanx::execution_tree::compile(als_test, snippets);
+    auto const& code = phylanx::execution_tree::compile(code_str, snippets);
     auto als = code.run();
 
     HPX_TEST_EQ(phylanx::execution_tree::extract_boolean_value(als()),
@@ -11,6 +11,7 @@
 #include <hpx/include/util.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -152,10 +153,83 @@ void test_kmeans_cpp_physl()
         phylanx::ir::node_data<uint8_t>{1});
 }
 
+///////////////////////////////////////////////////////////////////////////////
+char const* const kmeans_3d_test = R"(
+    define(points, [[ 0.  ,  0.5 ,  1.  ], [ 0.5 ,  0.  ,  1.  ],
+                    [ 0.  ,  0.  ,  0.5 ], [ 0.5 ,  0.5 ,  0.5 ],
+                    [10.  , 10.5 ,  0.  ], [10.5 , 10.  ,  0.  ],
+                    [10.  , 10.  ,  0.5 ], [10.5 , 10.5 ,  0.5 ],
+                    [ 0.  , 10.  , 10.5 ], [ 0.5 , 10.5 , 10.  ],
+                    [ 0.  , 10.5 , 10.5 ], [ 0.5 , 10.  , 10.  ]])
+    define(initial_centroids, [[1., 1., 1.], [9., 9., 1.], [1., 9., 9.]])
+    kmeans(points, 3, 20, false, nil, initial_centroids, 1e-6)
+)";
+
+char const* const kmeans_pp_test = R"(
+    define(points, [[ 0.  ,  0.5 ,  1.  ], [ 0.5 ,  0.  ,  1.  ],
+                    [ 0.  ,  0.  ,  0.5 ], [ 0.5 ,  0.5 ,  0.5 ],
+                    [10.  , 10.5 ,  0.  ], [10.5 , 10.  ,  0.  ],
+                    [10.  , 10.  ,  0.5 ], [10.5 , 10.5 ,  0.5 ],
+                    [ 0.  , 10.  , 10.5 ], [ 0.5 , 10.5 , 10.  ],
+                    [ 0.  , 10.5 , 10.5 ], [ 0.5 , 10.  , 10.  ]])
+    kmeans(points, 3, 20, false, 7, nil, 0.0, "kmeans++")
+)";
+
+void test_kmeans_3d()
+{
+    blaze::DynamicMatrix<double> expected{{0.25, 0.25, 0.75},
+        {10.25, 10.25, 0.25}, {0.25, 10.25, 10.25}};
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code =
+        phylanx::execution_tree::compile(kmeans_3d_test, snippets);
+    auto result =
+        phylanx::execution_tree::extract_numeric_value(code.run().arg_);
+
+    HPX_TEST(
+        allclose(phylanx::ir::node_data<double>(std::move(expected)), result));
+}
+
+void test_kmeans_pp()
+{
+    blaze::DynamicMatrix<double> expected{{0.25, 0.25, 0.75},
+        {10.25, 10.25, 0.25}, {0.25, 10.25, 10.25}};
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code =
+        phylanx::execution_tree::compile(kmeans_pp_test, snippets);
+    auto result =
+        phylanx::execution_tree::extract_numeric_value(code.run().arg_);
+
+    // k-means++ seeding separates well-spread clusters, however the order
+    // of the resulting centroids depends on the chosen seeds
+    HPX_TEST_EQ(result.num_dimensions(), std::size_t(2));
+    auto centroids = result.matrix();
+    HPX_TEST_EQ(centroids.rows(), expected.rows());
+    HPX_TEST_EQ(centroids.columns(), expected.columns());
+
+    for (std::size_t i = 0; i != expected.rows(); ++i)
+    {
+        bool found = false;
+        for (std::size_t j = 0; j != centroids.rows(); ++j)
+        {
+            if (blaze::sqrNorm(blaze::row(expected, i) -
+                    blaze::row(centroids, j)) < 1e-12)
+            {
+                found = true;
+                break;
+            }
+        }
+        HPX_TEST(found);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
     test_kmeans_as_primitive();
     test_kmeans_cpp_physl();
+    test_kmeans_3d();
+    test_kmeans_pp();
     return hpx::util::report_errors();
 }
@@ -0,0 +1,93 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// the ratings of simple_als, given as a dense matrix and in sparse form
+char const* const ratings = R"(
+    define(ratings, [[0.0,4.0,0.0,0.0,0.0],
+                     [1.0,0.0,4.0,0.0,5.0],
+                     [0.0,0.0,0.0,2.0,0.0],
+                     [0.0,8.0,0.0,0.0,0.0],
+                     [0.0,0.0,4.0,0.0,0.0],
+                     [0.0,0.0,0.0,0.0,0.0],
+                     [0.0,0.0,0.0,0.0,2.0],
+                     [1.0,0.0,0.0,0.0,0.0],
+                     [0.0,0.0,0.0,5.0,0.0],
+                     [1.0,0.0,0.0,2.0,0.0]])
+    define(coo, list(
+        [0, 1, 1, 1, 2, 3, 4, 6, 7, 8, 9, 9],
+        [1, 0, 2, 4, 3, 1, 2, 4, 0, 3, 0, 3],
+        [4.0, 1.0, 4.0, 5.0, 2.0, 8.0, 4.0, 2.0, 1.0, 5.0, 1.0, 2.0],
+        list(10, 5)))
+    define(csr, list(
+        [0, 1, 4, 5, 6, 7, 7, 8, 9, 10, 12],
+        [1, 0, 2, 4, 3, 1, 2, 4, 0, 3, 0, 3],
+        [4.0, 1.0, 4.0, 5.0, 2.0, 8.0, 4.0, 2.0, 1.0, 5.0, 1.0, 2.0]))
+    define(difference, a, b,
+        amax(absolute(slice(a, 0) - slice(b, 0))) +
+        amax(absolute(slice(a, 1) - slice(b, 1))))
+)";
+
+bool test_als(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f =
+        phylanx::execution_tree::compile(ratings + code, snippets);
+    return phylanx::execution_tree::extract_scalar_boolean_value(f.run().arg_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sparse_als()
+{
+    // solving directly gives the same factors as for the dense ratings
+    HPX_TEST(test_als(R"(
+        difference(als(ratings, 0.1, 3, 10, 40),
+            als(coo, 0.1, 3, 10, 40, __arg(cg_steps, 0))) < 1e-8
+    )"));
+    HPX_TEST(test_als(R"(
+        difference(als(ratings, 0.1, 3, 10, 40),
+            als(csr, 0.1, 3, 10, 40, __arg(cg_steps, 0),
+                __arg(format, "csr"))) < 1e-8
+    )"));
+
+    // the conjugate gradient steps converge to the same factors
+    HPX_TEST(test_als(R"(
+        difference(als(ratings, 0.1, 3, 10, 40),
+            als(coo, 0.1, 3, 10, 40, __arg(cg_steps, 10))) < 1e-6
+    )"));
+    HPX_TEST(test_als(R"(
+        difference(als(coo, 0.1, 3, 10, 40, __arg(cg_steps, 3)),
+            als(ratings, 0.1, 3, 10, 40, __arg(cg_steps, 3))) < 1e-8
+    )"));
+}
+
+void test_dist_als()
+{
+    // all ratings are held by the only locality
+    HPX_TEST(test_als(R"(
+        difference(als_d(coo, 0.1, 3, 10, 40, __arg(cg_steps, 0)),
+            als(ratings, 0.1, 3, 10, 40)) < 1e-8
+    )"));
+    HPX_TEST(test_als(R"(
+        difference(als_d(coo, 0.1, 3, 10, 40),
+            als(coo, 0.1, 3, 10, 40)) < 1e-8
+    )"));
+}
+
+int main(int argc, char* argv[])
+{
+    test_sparse_als();
+    test_dist_als();
+
+    return hpx::util::report_errors();
+}
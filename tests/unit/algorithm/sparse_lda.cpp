@@ -0,0 +1,106 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// word counts of six documents (rows) over five words (columns), given as a
+// dense matrix and in sparse form
+char const* const corpus = R"(
+    define(docs, [[2.0, 1.0, 0.0, 0.0, 0.0],
+                  [3.0, 0.0, 1.0, 0.0, 0.0],
+                  [0.0, 2.0, 2.0, 0.0, 0.0],
+                  [0.0, 0.0, 0.0, 4.0, 1.0],
+                  [0.0, 0.0, 1.0, 2.0, 3.0],
+                  [0.0, 0.0, 0.0, 0.0, 0.0]])
+    define(coo, list(
+        [0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4],
+        [0, 1, 0, 2, 1, 2, 3, 4, 2, 3, 4],
+        [2.0, 1.0, 3.0, 1.0, 2.0, 2.0, 4.0, 1.0, 1.0, 2.0, 3.0],
+        list(6, 5)))
+    define(csr, list(
+        [0, 2, 4, 6, 8, 11, 11],
+        [0, 1, 0, 2, 1, 2, 3, 4, 2, 3, 4],
+        [2.0, 1.0, 3.0, 1.0, 2.0, 2.0, 4.0, 1.0, 1.0, 2.0, 3.0],
+        list(6, 5)))
+    define(difference, a, b,
+        amax(absolute(slice(a, 0) - slice(b, 0))) +
+        amax(absolute(slice(a, 1) - slice(b, 1))))
+)";
+
+bool test_lda(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f =
+        phylanx::execution_tree::compile(corpus + code, snippets);
+    return phylanx::execution_tree::extract_scalar_boolean_value(f.run().arg_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sparse_lda()
+{
+    // the topics depend on the seed only, not on the format of the corpus
+    HPX_TEST(test_lda(R"(
+        difference(lda_trainer(3, 0.1, 0.01, 20, docs, __arg(seed, 42)),
+            lda_trainer(3, 0.1, 0.01, 20, coo, __arg(seed, 42))) == 0
+    )"));
+    HPX_TEST(test_lda(R"(
+        difference(lda_trainer(3, 0.1, 0.01, 20, docs, __arg(seed, 42)),
+            lda_trainer(3, 0.1, 0.01, 20, csr, __arg(seed, 42),
+                __arg(format, "csr"))) == 0
+    )"));
+
+    // the documents are sampled in several shards (see main), still the
+    // results are reproducible for a given seed
+    HPX_TEST(test_lda(R"(
+        difference(lda_trainer(3, 0.1, 0.01, 20, coo, __arg(seed, 42)),
+            lda_trainer(3, 0.1, 0.01, 20, coo, __arg(seed, 42))) == 0
+    )"));
+
+    // every token is assigned to exactly one topic
+    HPX_TEST(test_lda(R"(
+        define(result, lda_trainer(3, 0.1, 0.01, 20, coo, __arg(seed, 7)))
+        amax(absolute(sum(slice(result, 0), 1) - sum(docs, 0))) +
+            amax(absolute(sum(slice(result, 1), 1) - sum(docs, 1))) == 0
+    )"));
+
+    // after merging the changes of all shards the word-topic and the
+    // doc-topic counts agree on the number of tokens of each topic, and no
+    // count has wrapped around (exceeds the number of tokens)
+    HPX_TEST(test_lda(R"(
+        define(result, lda_trainer(3, 0.1, 0.01, 20, coo, __arg(seed, 7)))
+        amax(absolute(sum(slice(result, 0), 0) - sum(slice(result, 1), 0)))
+            == 0 &&
+        amax(slice(result, 0)) <= sum(docs) &&
+        amax(slice(result, 1)) <= sum(docs)
+    )"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_sparse_lda();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    // the corpus has 22 tokens, sample it in several shards
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.lda.shard_tokens!=4"
+    };
+
+    return hpx::init(argc, argv, cfg);
+}
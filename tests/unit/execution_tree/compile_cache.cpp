@@ -0,0 +1,88 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(fact, n,
+        if(n <= 1, 1, n * fact(n - 1))
+    ),
+    fact(10)
+))";
+
+char const* const other_code = R"(block(
+    define(fact, n,
+        if(n <= 1, 1, n * fact(n - 2))
+    ),
+    fact(10)
+))";
+
+///////////////////////////////////////////////////////////////////////////////
+void test_compile_cache_key()
+{
+    using phylanx::execution_tree::compile_cache_key;
+
+    HPX_TEST_EQ(compile_cache_key(code), compile_cache_key(code));
+    HPX_TEST_NEQ(compile_cache_key(code), compile_cache_key(other_code));
+}
+
+void test_compile_cache(std::string const& directory)
+{
+    using phylanx::execution_tree::compile_cache_key;
+    using phylanx::execution_tree::generate_ast_cached;
+
+    std::vector<phylanx::ast::expression> expected =
+        phylanx::ast::generate_ast(code);
+
+    hpx::filesystem::path entry(directory);
+    entry /= compile_cache_key(code) + ".physl-ast";
+
+    // cold start populates the cache
+    HPX_TEST(generate_ast_cached(code, directory) == expected);
+    HPX_TEST(hpx::filesystem::exists(entry));
+
+    // warm start reads the cache
+    HPX_TEST(generate_ast_cached(code, directory) == expected);
+
+    // corrupted entries are ignored and replaced
+    {
+        std::ofstream os(entry.string(), std::ios::out | std::ios::binary);
+        os << "garbage";
+    }
+    HPX_TEST(generate_ast_cached(code, directory) == expected);
+    HPX_TEST(generate_ast_cached(code, directory) == expected);
+
+    // the cached expressions compile and run as expected
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(
+        generate_ast_cached(code, directory), snippets);
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_scalar_integer_value(f.run().arg_),
+        std::int64_t(3628800));
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::filesystem::path directory =
+        hpx::filesystem::temp_directory_path() / "phylanx_compile_cache_test";
+
+    test_compile_cache_key();
+    test_compile_cache(directory.string());
+
+    hpx::filesystem::error_code ec;
+    hpx::filesystem::remove_all(directory, ec);
+
+    return hpx::util::report_errors();
+}
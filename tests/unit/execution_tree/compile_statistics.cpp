@@ -0,0 +1,95 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_compile_statistics()
+{
+    using phylanx::execution_tree::compile_statistics;
+
+    // reset all values
+    compile_statistics::parse_time(true);
+    compile_statistics::match_time(true);
+    compile_statistics::generate_time(true);
+    compile_statistics::lookups(true);
+    compile_statistics::candidates(true);
+
+    HPX_TEST_EQ(compile_and_run("1 + 2 * 3"),
+        phylanx::execution_tree::primitive_argument_type(std::int64_t(7)));
+
+    HPX_TEST_LT(std::int64_t(0), compile_statistics::parse_time(false));
+    HPX_TEST_LT(std::int64_t(0), compile_statistics::generate_time(false));
+    HPX_TEST_LT(std::int64_t(0), compile_statistics::lookups(false));
+    HPX_TEST_LT(std::int64_t(0), compile_statistics::candidates(false));
+    HPX_TEST_LTE(compile_statistics::match_time(false),
+        compile_statistics::generate_time(false));
+
+    // the index is built once for all compilations
+    compile_statistics::index_time(true);
+    compile_and_run("add(1, 2)");
+    HPX_TEST_EQ(std::int64_t(0), compile_statistics::index_time(false));
+
+    // reading a value resets it, if requested
+    compile_statistics::lookups(true);
+    HPX_TEST_EQ(std::int64_t(0), compile_statistics::lookups(false));
+}
+
+// only the patterns with a matching number of arguments are tried
+void test_function_call_candidates()
+{
+    using phylanx::execution_tree::compile_statistics;
+
+    compile_statistics::lookups(true);
+    compile_statistics::candidates(true);
+
+    compile_and_run("add(1, 2)");
+
+    std::int64_t lookups = compile_statistics::lookups(true);
+    std::int64_t candidates = compile_statistics::candidates(true);
+    HPX_TEST_LT(std::int64_t(0), lookups);
+    HPX_TEST_LT(candidates,
+        std::int64_t(phylanx::execution_tree::compiler::generate_patterns()
+                         .size()));
+}
+
+// default values and keyword arguments are handled as before
+void test_default_and_keyword_arguments()
+{
+    HPX_TEST_EQ(compile_and_run("cumsum([1, 2, 3])"),
+        compile_and_run("[1, 3, 6]"));
+    HPX_TEST_EQ(compile_and_run("cumsum([[1, 2], [3, 4]], __arg(axis, 0))"),
+        compile_and_run("[[1, 2], [4, 6]]"));
+    HPX_TEST_EQ(
+        compile_and_run(R"(cumsum([1, 2, 3], __arg(dtype, "float")))"),
+        compile_and_run("[1., 3., 6.]"));
+}
+
+int main(int argc, char* argv[])
+{
+    test_compile_statistics();
+    test_function_call_candidates();
+    test_default_and_keyword_arguments();
+
+    return hpx::util::report_errors();
+}
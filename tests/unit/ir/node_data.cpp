@@ -241,5 +241,101 @@ int main(int argc, char* argv[])
         test_serialization(array_value);
     }
 
+    // memory accounting
+    {
+        std::int64_t live = phylanx::util::memory_tracker::live_bytes(false);
+        phylanx::util::memory_tracker::high_water_mark(true);
+
+        {
+            phylanx::ir::node_data<double> array_value(
+                blaze::DynamicMatrix<double>(100UL, 100UL, 1.0));
+
+            HPX_TEST_LTE(std::size_t(100UL * 100UL * sizeof(double)),
+                array_value.allocated_bytes());
+            HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false),
+                live + std::int64_t(array_value.allocated_bytes()));
+
+            // references do not own any memory
+            phylanx::ir::node_data<double> ref_value = array_value.ref();
+            HPX_TEST_EQ(ref_value.allocated_bytes(), std::size_t(0));
+
+            // a copy owns a memory block of its own
+            phylanx::ir::node_data<double> copy_value = array_value.copy();
+            HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false),
+                live + std::int64_t(array_value.allocated_bytes() +
+                    copy_value.allocated_bytes()));
+
+            // growing the storage in place is accounted for
+            copy_value.matrix_non_ref().resize(200UL, 200UL, false);
+            HPX_TEST_LTE(std::size_t(200UL * 200UL * sizeof(double)),
+                copy_value.allocated_bytes());
+
+            copy_value.matrix_non_ref()(0, 0) = 42.0;
+            HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false),
+                live + std::int64_t(array_value.allocated_bytes() +
+                    copy_value.allocated_bytes()));
+        }
+
+        HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false), live);
+        HPX_TEST_LTE(std::int64_t(2 * 100UL * 100UL * sizeof(double)),
+            phylanx::util::memory_tracker::high_water_mark(false) - live);
+    }
+
+    // shared (copy on write) storage
+    {
+        blaze::DynamicMatrix<double> m(10UL, 10UL, 1.0);
+
+        std::int64_t const live_before =
+            phylanx::util::memory_tracker::live_bytes(false);
+        phylanx::ir::node_data<double> array_value(m);
+
+        double const* data = array_value.matrix().data();
+        std::int64_t live = phylanx::util::memory_tracker::live_bytes(false);
+
+        // sharing neither copies the data nor changes the accounting
+        array_value.share();
+        HPX_TEST(array_value.is_shared());
+        HPX_TEST(array_value.is_ref());
+        HPX_TEST_EQ(array_value.matrix().data(), data);
+        HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false), live);
+
+        // copies refer to the same storage
+        phylanx::ir::node_data<double> copy_value = array_value.copy();
+        HPX_TEST(copy_value.is_shared());
+        HPX_TEST_EQ(copy_value.matrix().data(), data);
+
+        test_serialization(copy_value);
+
+        phylanx::ir::node_data<double> copy_value2 = copy_value;
+        HPX_TEST_EQ(copy_value2.matrix().data(), data);
+        HPX_TEST_EQ(phylanx::util::memory_tracker::live_bytes(false), live);
+
+        // the shared storage is accounted for only once by all instances
+        // referring to it
+        std::size_t const shared_bytes = array_value.allocated_bytes() +
+            copy_value.allocated_bytes() + copy_value2.allocated_bytes();
+        HPX_TEST_LTE(shared_bytes, std::size_t(live - live_before));
+        HPX_TEST_LTE(std::size_t(live - live_before), shared_bytes + 2);
+
+        // modifying a copy creates a private copy of the data
+        copy_value2.unshare();
+        HPX_TEST(!copy_value2.is_shared());
+        HPX_TEST(!copy_value2.is_ref());
+        HPX_TEST_NEQ(copy_value2.matrix().data(), data);
+
+        copy_value2.matrix_non_ref()(0, 0) = 42.0;
+        HPX_TEST_EQ(array_value.matrix()(0, 0), 1.0);
+        HPX_TEST_EQ(copy_value.matrix()(0, 0), 1.0);
+
+        // moving the last instance referring to the shared storage takes
+        // over the data
+        copy_value = phylanx::ir::node_data<double>{};
+        phylanx::ir::node_data<double> moved_value(std::move(array_value));
+        HPX_TEST(!moved_value.is_shared());
+        HPX_TEST(!moved_value.is_ref());
+        HPX_TEST_EQ(moved_value.matrix().data(), data);
+        HPX_TEST_EQ(moved_value, phylanx::ir::node_data<double>(m));
+    }
+
     return hpx::util::report_errors();
 }
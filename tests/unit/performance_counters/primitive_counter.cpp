@@ -6,7 +6,7 @@
 
 #include <phylanx/phylanx.hpp>
 
-#include <hpx/hpx_main.hpp>
+#include <hpx/hpx_init.hpp>
 #include <hpx/include/agas.hpp>
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/modules/testing.hpp>
@@ -14,7 +14,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <numeric>
 #include <string>
+#include <vector>
 
 #include <blaze/Math.h>
 
@@ -77,7 +79,80 @@ std::map<std::string, std::size_t> expected_counts =
     { "while", 1 },
 };
 
-int main()
+// number of results of element-wise operations computed while running lra
+std::map<std::string, std::int64_t> expected_results =
+{
+    { "__sub", 20 },
+    { "__div", 10 },
+    { "exp", 10 },
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// The intermediate results of the chain are handed to the next operation,
+// which writes its result into their storage
+char const* const rvalue_chain_code = R"(block(
+    define(rvalue_chain, x, y, (x + y) * (x - y) * (x + y)),
+    rvalue_chain
+))";
+
+// The variables are handed to the operation as references, thus the result
+// has to be written into newly allocated storage
+char const* const ref_operands_code = R"(block(
+    define(ref_operands, x, y,
+        block(
+            define(a, x),
+            define(b, y),
+            a * b
+        )
+    ),
+    ref_operands
+))";
+
+// Sum of the given result storage counter over all instances of the given
+// primitive
+std::int64_t result_storage_count(std::string const& name, char const* kind)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#0/total}/primitives/" + name + "/count/" + kind);
+
+    auto const values = pc.get_counter_values_array(hpx::launch::sync, false);
+    return std::accumulate(
+        values.values_.begin(), values.values_.end(), std::int64_t(0));
+}
+
+void test_result_storage(char const* code_str, bool donated)
+{
+    std::int64_t const donated_before =
+        result_storage_count("__mul", "result_donated");
+    std::int64_t const fresh_before =
+        result_storage_count("__mul", "result_fresh");
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(code_str, snippets);
+    auto f = code.run();
+
+    blaze::DynamicVector<double> x{1.0, 2.0, 3.0, 4.0};
+    blaze::DynamicVector<double> y{4.0, 3.0, 2.0, 1.0};
+    f(phylanx::ir::node_data<double>{x}, phylanx::ir::node_data<double>{y});
+
+    std::int64_t const donated_results =
+        result_storage_count("__mul", "result_donated") - donated_before;
+    std::int64_t const fresh_results =
+        result_storage_count("__mul", "result_fresh") - fresh_before;
+
+    if (donated)
+    {
+        HPX_TEST(donated_results > 0);
+    }
+    else
+    {
+        HPX_TEST_EQ(donated_results, std::int64_t(0));
+        HPX_TEST(fresh_results > 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
 {
     blaze::DynamicMatrix<double> const v1{{15.04, 16.74}, {13.82, 24.49},
         {12.54, 16.32}, {23.09, 19.83}, {9.268, 12.87}, {9.676, 13.14},
@@ -189,7 +264,59 @@ int main()
                     values.values_[i] == 1);
             }
         }
+
+        // Result storage performance counters
+        {
+            std::string const donated_pc_name(
+                "/phylanx{locality#0/total}/primitives/" + name +
+                "/count/result_donated");
+            hpx::performance_counters::performance_counter donated_pc(
+                donated_pc_name);
+
+            std::string const fresh_pc_name(
+                "/phylanx{locality#0/total}/primitives/" + name +
+                "/count/result_fresh");
+            hpx::performance_counters::performance_counter fresh_pc(
+                fresh_pc_name);
+
+            auto const donated_values =
+                donated_pc.get_counter_values_array(hpx::launch::sync, false);
+            auto const fresh_values =
+                fresh_pc.get_counter_values_array(hpx::launch::sync, false);
+
+            HPX_TEST_EQ(donated_values.values_.size(), entries.size());
+            HPX_TEST_EQ(fresh_values.values_.size(), entries.size());
+
+            // every result was either written into an operand or into newly
+            // allocated storage
+            auto it = expected_results.find(name);
+            if (it != expected_results.end())
+            {
+                std::int64_t results = 0;
+                for (std::size_t i = 0; i != entries.size(); ++i)
+                {
+                    results +=
+                        donated_values.values_[i] + fresh_values.values_[i];
+                }
+                HPX_TEST_EQ(results, it->second);
+            }
+        }
     }
 
+    test_result_storage(rvalue_chain_code, true);
+    test_result_storage(ref_operands_code, false);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // the element-wise operations are counted only if they are not fused
+    std::vector<std::string> cfg = {
+        "phylanx.fuse_elementwise_operations!=0"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
     return hpx::util::report_errors();
 }
@@ -9,6 +9,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cmath>
 #include <cstddef>
 #include <iostream>
 #include <string>
@@ -215,6 +216,37 @@ void test_cumsum_3d()
         "[[[1., 3., 6.], [4., 9., 15.]]]");
 }
 
+// the inputs are large enough to be scanned concurrently
+void test_cumsum_large()
+{
+    test_cumsum("cumsum(constant(1, 200000))", "arange(1, 200001)");
+
+    // scans along the columns and along the rows have to agree
+    test_cumsum(
+        "cumsum(reshape(arange(0, 200000), make_list(100000, 2)), 0)",
+        "transpose(cumsum(transpose("
+            "reshape(arange(0, 200000), make_list(100000, 2))), 1))");
+    test_cumsum(
+        "cumsum(reshape(arange(0, 200000), make_list(2, 100000)), 1)",
+        "transpose(cumsum(transpose("
+            "reshape(arange(0, 200000), make_list(2, 100000))), 0))");
+    test_cumsum(
+        "cumsum(reshape(arange(0, 200000), make_list(2, 1000, 100)))",
+        "cumsum(arange(0, 200000))");
+}
+
+void test_cumsum_compensated()
+{
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        compile_and_run(
+            "cumsum(constant(0.1, 1000000), __arg(compensated, true))"));
+
+    auto v = result.vector();
+    HPX_TEST_EQ(v.size(), std::size_t(1000000));
+    HPX_TEST(std::abs(v[999] - 100.0) < 1e-12);
+    HPX_TEST(std::abs(v[999999] - 100000.0) < 1e-9);
+}
+
 int main(int argc, char* argv[])
 {
     test_cumsum_0d();
@@ -222,5 +254,8 @@ int main(int argc, char* argv[])
     test_cumsum_2d();
     test_cumsum_3d();
 
+    test_cumsum_large();
+    test_cumsum_compensated();
+
     return hpx::util::report_errors();
 }
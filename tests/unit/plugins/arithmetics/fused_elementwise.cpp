@@ -0,0 +1,121 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+// the function call forms are fused, the operator forms are not
+void test_fused_operation(std::string const& code,
+    std::string const& expected_str)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_fused_0d()
+{
+    test_fused_operation(
+        "__add(__mul(3., 4.), 5.)", "3. * 4. + 5.");
+    test_fused_operation(
+        "sqrt(__add(__mul(3., 3.), __mul(4., 4.)))", "5.");
+    test_fused_operation(
+        "__minus(__div(__sub(10., 4.), 3.))", "-((10. - 4.) / 3.)");
+}
+
+void test_fused_1d()
+{
+    test_fused_operation(
+        "__add(__mul([1., 2., 3.], [4., 5., 6.]), [1., 1., 1.])",
+        "[1., 2., 3.] * [4., 5., 6.] + [1., 1., 1.]");
+    test_fused_operation(
+        "__add(__mul([1., 2., 3.], 2.), 1.)",
+        "[1., 2., 3.] * 2. + 1.");
+    test_fused_operation(
+        "__add([1., 2., 3.], [4., 5., 6.], [7., 8., 9.], 1.)",
+        "[1., 2., 3.] + [4., 5., 6.] + [7., 8., 9.] + 1.");
+    test_fused_operation(
+        "maximum(__sub([1., 5., 3.], 2.), minimum([0., 7., 2.], 2.))",
+        "[0., 3., 2.]");
+    test_fused_operation(
+        "absolute(__minus(square([1., -2., 3.])))", "[1., 4., 9.]");
+    test_fused_operation(
+        "floor(__div([3., 6., 9.], 2.))", "[1., 3., 4.]");
+}
+
+void test_fused_2d()
+{
+    test_fused_operation(
+        "__sub(__mul([[1., 2.], [3., 4.]], [[5., 6.], [7., 8.]]), 1.)",
+        "[[1., 2.], [3., 4.]] * [[5., 6.], [7., 8.]] - 1.");
+    test_fused_operation(
+        "__div(__add(1., [[1., 3.], [5., 7.]]), 2.)",
+        "[[1., 2.], [3., 4.]]");
+}
+
+void test_fused_3d()
+{
+    test_fused_operation(
+        "__add(__mul([[[1., 2.], [3., 4.]], [[5., 6.], [7., 8.]]], 2.), "
+            "[[[1., 1.], [1., 1.]], [[1., 1.], [1., 1.]]])",
+        "[[[3., 5.], [7., 9.]], [[11., 13.], [15., 17.]]]");
+}
+
+// all of these fall back to the unfused evaluation
+void test_fused_fallback()
+{
+    // integer and boolean data
+    test_fused_operation(
+        "__add(__mul([1, 2, 3], [4, 5, 6]), 1)",
+        "[1, 2, 3] * [4, 5, 6] + 1");
+    test_fused_operation(
+        "__minus(__add([1, 2, 3], 1))", "-([1, 2, 3] + 1)");
+    test_fused_operation(
+        "__add(__mul(true, 2), false)", "true * 2 + false");
+
+    // broadcasting
+    test_fused_operation(
+        "__add(__mul([[1., 2.], [3., 4.]], [1., 2.]), 1.)",
+        "[[1., 2.], [3., 4.]] * [1., 2.] + 1.");
+}
+
+void test_fused_variables()
+{
+    test_fused_operation(
+        R"(block(
+            define(a, [1., 2., 3.]),
+            define(b, [4., 5., 6.]),
+            define(f, x, y, __add(__mul(x, y), __mul(x, 2.))),
+            f(a, b)
+        ))",
+        "[6., 14., 24.]");
+}
+
+int main(int argc, char* argv[])
+{
+    test_fused_0d();
+    test_fused_1d();
+    test_fused_2d();
+    test_fused_3d();
+    test_fused_fallback();
+    test_fused_variables();
+
+    return hpx::util::report_errors();
+}
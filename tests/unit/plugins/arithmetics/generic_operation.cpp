@@ -19,11 +19,11 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 using custom_vector_type =
-    blaze::CustomVector<double, blaze::aligned, blaze::padded>;
+    blaze::CustomVector<double, blaze::unaligned, blaze::unpadded>;
 using custom_matrix_type =
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded>;
+    blaze::CustomMatrix<double, blaze::unaligned, blaze::unpadded>;
 using custom_tensor_type =
-    blaze::CustomTensor<double, blaze::aligned, blaze::padded>;
+    blaze::CustomTensor<double, blaze::unaligned, blaze::unpadded>;
 
 ///////////////////////////////////////////////////////////////////////////////
 void test_generic_operation_0d(std::string const& func_name,
@@ -70,7 +70,7 @@ void test_generic_operation_1d(std::string const& func_name,
 {
     blaze::Rand<blaze::DynamicVector<double>> gen{};
     blaze::DynamicVector<double> n = gen.generate(22UL);
-    custom_vector_type m(n.data(), n.size(), n.spacing());
+    custom_vector_type m(n.data(), n.size());
 
     phylanx::execution_tree::primitive lhs =
         phylanx::execution_tree::primitives::create_variable(
@@ -94,7 +94,7 @@ void test_generic_operation_1d(std::string const& func_name,
 {
     blaze::Rand<blaze::DynamicVector<double>> gen{};
     blaze::DynamicVector<double> n = gen.generate(22UL);
-    custom_vector_type m(n.data(), n.size(), n.spacing());
+    custom_vector_type m(n.data(), n.size());
 
     phylanx::execution_tree::primitive lhs =
         phylanx::execution_tree::primitives::create_variable(
@@ -118,7 +118,7 @@ void test_generic_operation_1d_greater1(std::string const& func_name,
 {
     blaze::Rand<blaze::DynamicVector<double>> gen{};
     blaze::DynamicVector<double> n = gen.generate(22UL, 1, 5);
-    custom_vector_type m(n.data(), n.size(), n.spacing());
+    custom_vector_type m(n.data(), n.size());
 
     phylanx::execution_tree::primitive lhs =
         phylanx::execution_tree::primitives::create_variable(
@@ -0,0 +1,83 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_scan(std::string const& code, std::string const& expected_str)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_scan_1d()
+{
+    test_scan(R"(scan("add", [1, 2, 3, 4]))", "[1, 3, 6, 10]");
+    test_scan(R"(scan("multiply", [1, 2, 3, 4]))", "[1, 2, 6, 24]");
+    test_scan(R"(scan("maximum", [1, 3, 2, 5, 4]))", "[1, 3, 3, 5, 5]");
+    test_scan(R"(scan("minimum", [4, 5, 2, 3, 1]))", "[4, 4, 2, 2, 1]");
+
+    test_scan(
+        R"(scan("maximum", [-1.0, -3.0, -0.5], 0))", "[-1.0, -1.0, -0.5]");
+    test_scan(
+        R"(scan("add", [1, 2, 3], __arg(dtype, "float")))", "[1., 3., 6.]");
+}
+
+void test_scan_2d()
+{
+    test_scan(
+        R"(scan("maximum", [[1, 5, 2], [4, 3, 6]]))", "[1, 5, 5, 5, 5, 6]");
+    test_scan(R"(scan("maximum", [[1, 5, 2], [4, 3, 6]], 0))",
+        "[[1, 5, 2], [4, 5, 6]]");
+    test_scan(R"(scan("minimum", [[1, 5, 2], [4, 3, 6]], 1))",
+        "[[1, 1, 1], [4, 3, 3]]");
+}
+
+void test_scan_3d()
+{
+    test_scan(R"(scan("maximum", [[[1, 5], [4, 3]], [[2, 6], [0, 7]]], 0))",
+        "[[[1, 5], [4, 3]], [[2, 6], [4, 7]]]");
+    test_scan(R"(scan("maximum", [[[1, 5], [4, 3]], [[2, 6], [0, 7]]], 1))",
+        "[[[1, 5], [4, 5]], [[2, 6], [2, 7]]]");
+    test_scan(R"(scan("maximum", [[[1, 5], [4, 3]], [[2, 6], [0, 7]]], 2))",
+        "[[[1, 5], [4, 4]], [[2, 6], [0, 7]]]");
+}
+
+// the inputs are large enough to be scanned concurrently
+void test_scan_large()
+{
+    test_scan(R"(scan("maximum", arange(0, 200000)))", "arange(0, 200000)");
+    test_scan(
+        R"(scan("minimum", arange(200000, 0, -1)))", "arange(200000, 0, -1)");
+    test_scan(R"(scan("add", constant(1, 200000)))", "arange(1, 200001)");
+}
+
+int main(int argc, char* argv[])
+{
+    test_scan_1d();
+    test_scan_2d();
+    test_scan_3d();
+    test_scan_large();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,276 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_lu_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    using namespace phylanx::execution_tree;
+
+    primitive_argument_type result = compile_and_run(name, code);
+    primitive_argument_type comparison = compile_and_run(name, expected_str);
+
+    auto result_list = extract_list_value(result);
+    auto comparison_list = extract_list_value(comparison);
+    HPX_TEST_EQ(result_list.size(), std::size_t(2));
+    HPX_TEST_EQ(comparison_list.size(), std::size_t(2));
+
+    auto result_it = result_list.begin();
+    auto comparison_it = comparison_list.begin();
+
+    // the factors
+    primitive_argument_type result_lu = *result_it;
+    primitive_argument_type comparison_lu = *comparison_it;
+
+    HPX_TEST(phylanx::ir::allclose(extract_numeric_value(result_lu),
+        extract_numeric_value(comparison_lu)));
+    HPX_TEST(result_lu.has_annotation() && comparison_lu.has_annotation());
+    if (result_lu.has_annotation() && comparison_lu.has_annotation())
+    {
+        HPX_TEST(*result_lu.annotation() == *comparison_lu.annotation());
+    }
+
+    // the pivots
+    HPX_TEST_EQ(extract_integer_value(*++result_it),
+        extract_integer_value(*++comparison_it));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//    | 4  7 |   ->   | 4    7   |  pivots: [0, 1]
+//    | 2  6 |        | 0.5  2.5 |
+void test_lu_d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_lu_d_operation("test_lu_d_0", R"(
+            lu_d(
+                annotate_d([[4.0], [2.0]], "test_lu_d_0",
+                    list("tile", list("columns", 0, 1), list("rows", 0, 2)))
+            )
+        )", R"(
+            list(
+                annotate_d([[4.0], [0.5]], "test_lu_d_0/1",
+                    list("tile", list("columns", 0, 1), list("rows", 0, 2))),
+                [0, 1]
+            )
+        )");
+    }
+    else
+    {
+        test_lu_d_operation("test_lu_d_0", R"(
+            lu_d(
+                annotate_d([[7.0], [6.0]], "test_lu_d_0",
+                    list("tile", list("columns", 1, 2), list("rows", 0, 2)))
+            )
+        )", R"(
+            list(
+                annotate_d([[7.0], [2.5]], "test_lu_d_0/1",
+                    list("tile", list("columns", 1, 2), list("rows", 0, 2))),
+                [0, 1]
+            )
+        )");
+    }
+}
+
+//   | 0.0 1.0 1.0 0.0 |        | 2.0  3.0  1.0  0.0 |
+//   | 0.0 3.0 1.0 2.0 |   ->   | 0.0  3.0  1.0  2.0 |  pivots: [2, 1, 3, 3]
+//   | 2.0 3.0 1.0 0.0 |        | 0.5 -0.5  2.0  2.0 |
+//   | 1.0 0.0 2.0 1.0 |        | 0.0  1/3  1/3 -4/3 |
+void test_lu_d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_lu_d_operation("test_lu_d_1", R"(
+            lu_d(
+                annotate_d([[0.0, 1.0], [0.0, 3.0], [2.0, 3.0], [1.0, 0.0]],
+                    "test_lu_d_1",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 4)))
+            )
+        )", R"(
+            list(
+                annotate_d([[2.0, 3.0], [0.0, 3.0], [0.5, -0.5],
+                        [0.0, 0.3333333333333333]],
+                    "test_lu_d_1/1",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 4))),
+                [2, 1, 3, 3]
+            )
+        )");
+    }
+    else
+    {
+        test_lu_d_operation("test_lu_d_1", R"(
+            lu_d(
+                annotate_d([[1.0, 0.0], [1.0, 2.0], [1.0, 0.0], [2.0, 1.0]],
+                    "test_lu_d_1",
+                    list("tile", list("columns", 2, 4), list("rows", 0, 4)))
+            )
+        )", R"(
+            list(
+                annotate_d([[1.0, 0.0], [1.0, 2.0], [2.0, 2.0],
+                        [0.3333333333333333, -1.3333333333333333]],
+                    "test_lu_d_1/1",
+                    list("tile", list("columns", 2, 4), list("rows", 0, 4))),
+                [2, 1, 3, 3]
+            )
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A diagonally dominant matrix with its rows reversed, the factorization
+// interchanges rows in every panel
+blaze::DynamicMatrix<double> pivoting_matrix(std::size_t n)
+{
+    blaze::DynamicMatrix<double> a(n, n);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        std::size_t const row = n - 1 - i;
+        for (std::size_t j = 0; j != n; ++j)
+        {
+            a(i, j) = row == j ? 8.0 + j : ((row + 2 * j) % 5) * 0.25;
+        }
+    }
+    return a;
+}
+
+// Return the given range of values as a PhySL literal
+template <typename Iterator>
+std::string literal(Iterator begin, Iterator end)
+{
+    std::ostringstream strm;
+    strm << std::showpoint << std::setprecision(17) << '[';
+    for (Iterator it = begin; it != end; ++it)
+    {
+        strm << (it != begin ? ", " : "") << *it;
+    }
+    strm << ']';
+    return strm.str();
+}
+
+// Return the given columns of the matrix as a PhySL literal
+std::string columns_literal(blaze::DynamicMatrix<double> const& m,
+    std::size_t first, std::size_t last)
+{
+    std::string result("[");
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        auto row = blaze::subvector(blaze::row(m, i), first, last - first);
+        result += (i != 0 ? ", " : "") + literal(row.begin(), row.end());
+    }
+    return result + "]";
+}
+
+std::string tile_annotation(
+    std::size_t first, std::size_t last, std::size_t rows)
+{
+    return hpx::util::format(
+        R"(list("tile", list("columns", {}, {}), list("rows", 0, {})))",
+        first, last, rows);
+}
+
+// LU decomposition with partial pivoting as computed by LAPACK's getrf, row k
+// was interchanged with row pivots[k]
+std::vector<std::int64_t> reference_lu(blaze::DynamicMatrix<double>& lu)
+{
+    std::size_t const n = lu.rows();
+    std::vector<std::int64_t> pivots(n);
+    for (std::size_t k = 0; k != n; ++k)
+    {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i != n; ++i)
+        {
+            if (std::abs(lu(i, k)) > std::abs(lu(pivot, k)))
+            {
+                pivot = i;
+            }
+        }
+        pivots[k] = static_cast<std::int64_t>(pivot);
+        blaze::DynamicVector<double, blaze::rowVector> tmp = blaze::row(lu, k);
+        blaze::row(lu, k) = blaze::row(lu, pivot);
+        blaze::row(lu, pivot) = tmp;
+
+        for (std::size_t i = k + 1; i != n; ++i)
+        {
+            lu(i, k) /= lu(k, k);
+            for (std::size_t j = k + 1; j != n; ++j)
+            {
+                lu(i, j) -= lu(i, k) * lu(k, j);
+            }
+        }
+    }
+    return pivots;
+}
+
+// 8x8 matrix factored in panels of two columns (see main), half of the
+// panels are owned by the other locality
+void test_lu_d_2()
+{
+    std::size_t const n = 8;
+    blaze::DynamicMatrix<double> a = pivoting_matrix(n);
+    blaze::DynamicMatrix<double> lu = a;
+    std::vector<std::int64_t> pivots = reference_lu(lu);
+    HPX_TEST_NEQ(pivots[0], std::int64_t(0));
+
+    std::size_t const first = hpx::get_locality_id() == 0 ? 0 : n / 2;
+    std::size_t const last = first + n / 2;
+
+    test_lu_d_operation("test_lu_d_2",
+        hpx::util::format(R"(lu_d(annotate_d({}, "test_lu_d_2", {})))",
+            columns_literal(a, first, last), tile_annotation(first, last, n)),
+        hpx::util::format(R"(list(annotate_d({}, "test_lu_d_2/1", {}), {}))",
+            columns_literal(lu, first, last), tile_annotation(first, last, n),
+            literal(pivots.begin(), pivots.end())));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_lu_d_0();
+    test_lu_d_1();
+    test_lu_d_2();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    // small panels exercise the blocked factorization on small matrices
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.dist_lu.block_size!=2"
+    };
+
+    return hpx::init(argc, argv, cfg);
+}
@@ -12,10 +12,13 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <blaze/Math.h>
+
 ///////////////////////////////////////////////////////////////////////////////
 phylanx::execution_tree::primitive_argument_type compile_and_run(
     std::string const& name, std::string const& codestr)
@@ -303,6 +306,33 @@ void test_random_3d_1()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// the tiles of a random array are the same as the corresponding parts of
+// the array generated as a whole
+void test_random_2d_tiles_reproducible()
+{
+    std::uint32_t const loc = hpx::get_locality_id();
+
+    phylanx::execution_tree::primitive_argument_type tile = compile_and_run(
+        "test_random_2loc2d_tiles", R"(block(
+            set_seed(42),
+            random_d(list(6, 5), )" + std::to_string(loc) + R"(, 2,
+                "rand_reproducible", "row")
+        ))");
+    phylanx::execution_tree::primitive_argument_type whole = compile_and_run(
+        "test_random_2loc2d_whole", R"(block(
+            set_seed(42),
+            random_d(list(6, 5), 0, 1, "rand_reproducible")
+        ))");
+
+    blaze::DynamicMatrix<double> expected = blaze::submatrix(
+        phylanx::execution_tree::extract_numeric_value(whole).matrix(),
+        3 * loc, 0, 3, 5);
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(tile));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -319,6 +349,8 @@ int hpx_main(int argc, char* argv[])
     test_random_3d_0();
     test_random_3d_1();
 
+    test_random_2d_tiles_reproducible();
+
     hpx::finalize();
     return hpx::util::report_errors();
 }
@@ -0,0 +1,234 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_solve_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    HPX_TEST(phylanx::ir::allclose(
+        phylanx::execution_tree::extract_numeric_value(
+            compile_and_run(name, code)),
+        phylanx::execution_tree::extract_numeric_value(
+            compile_and_run(name, expected_str))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//   | 0.0 1.0 1.0 0.0 |
+//   | 0.0 3.0 1.0 2.0 |
+//   | 2.0 3.0 1.0 0.0 |
+//   | 1.0 0.0 2.0 1.0 |
+void test_solve_d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_solve_d_operation("test_solve_d_0", R"(
+            solve_d(
+                annotate_d([[0.0, 1.0], [0.0, 3.0], [2.0, 3.0], [1.0, 0.0]],
+                    "test_solve_d_0",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 4))),
+                [1.0, 2.0, 3.0, 4.0]
+            )
+        )", "[1.125, -0.125, 1.125, 0.625]");
+    }
+    else
+    {
+        test_solve_d_operation("test_solve_d_0", R"(
+            solve_d(
+                annotate_d([[1.0, 0.0], [1.0, 2.0], [1.0, 0.0], [2.0, 1.0]],
+                    "test_solve_d_0",
+                    list("tile", list("columns", 2, 4), list("rows", 0, 4))),
+                [1.0, 2.0, 3.0, 4.0]
+            )
+        )", "[1.125, -0.125, 1.125, 0.625]");
+    }
+}
+
+void test_solve_d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_solve_d_operation("test_solve_d_1", R"(
+            solve_d(
+                annotate_d([[0.0, 1.0], [0.0, 3.0], [2.0, 3.0], [1.0, 0.0]],
+                    "test_solve_d_1",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 4))),
+                [[1.0, 0.0], [0.0, 1.0], [1.0, 1.0], [2.0, 0.0]]
+            )
+        )", R"(
+            [[0.125, 0.25], [-0.125, 0.25], [1.125, -0.25], [-0.375, 0.25]]
+        )");
+    }
+    else
+    {
+        test_solve_d_operation("test_solve_d_1", R"(
+            solve_d(
+                annotate_d([[1.0, 0.0], [1.0, 2.0], [1.0, 0.0], [2.0, 1.0]],
+                    "test_solve_d_1",
+                    list("tile", list("columns", 2, 4), list("rows", 0, 4))),
+                [[1.0, 0.0], [0.0, 1.0], [1.0, 1.0], [2.0, 0.0]]
+            )
+        )", R"(
+            [[0.125, 0.25], [-0.125, 0.25], [1.125, -0.25], [-0.375, 0.25]]
+        )");
+    }
+}
+
+// repeated solves using the same matrix
+void test_solve_d_2()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_solve_d_operation("test_solve_d_2", R"(
+            block(
+                define(a, annotate_d(
+                    [[0.0, 1.0], [0.0, 3.0], [2.0, 3.0], [1.0, 0.0]],
+                    "test_solve_d_2",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 4)))),
+                define(x1, solve_d(a, [1.0, 2.0, 3.0, 4.0])),
+                define(x2, solve_d(a, [2.0, 4.0, 6.0, 8.0])),
+                x2 - x1
+            )
+        )", "[1.125, -0.125, 1.125, 0.625]");
+    }
+    else
+    {
+        test_solve_d_operation("test_solve_d_2", R"(
+            block(
+                define(a, annotate_d(
+                    [[1.0, 0.0], [1.0, 2.0], [1.0, 0.0], [2.0, 1.0]],
+                    "test_solve_d_2",
+                    list("tile", list("columns", 2, 4), list("rows", 0, 4)))),
+                define(x1, solve_d(a, [1.0, 2.0, 3.0, 4.0])),
+                define(x2, solve_d(a, [2.0, 4.0, 6.0, 8.0])),
+                x2 - x1
+            )
+        )", "[1.125, -0.125, 1.125, 0.625]");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A diagonally dominant matrix with its rows reversed, the factorization
+// interchanges rows in every panel
+blaze::DynamicMatrix<double> pivoting_matrix(std::size_t n)
+{
+    blaze::DynamicMatrix<double> a(n, n);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        std::size_t const row = n - 1 - i;
+        for (std::size_t j = 0; j != n; ++j)
+        {
+            a(i, j) = row == j ? 8.0 + j : ((row + 2 * j) % 5) * 0.25;
+        }
+    }
+    return a;
+}
+
+// Return the given range of values as a PhySL literal
+template <typename Iterator>
+std::string literal(Iterator begin, Iterator end)
+{
+    std::ostringstream strm;
+    strm << std::showpoint << std::setprecision(17) << '[';
+    for (Iterator it = begin; it != end; ++it)
+    {
+        strm << (it != begin ? ", " : "") << *it;
+    }
+    strm << ']';
+    return strm.str();
+}
+
+// Return the given columns of the matrix as a PhySL literal
+std::string columns_literal(blaze::DynamicMatrix<double> const& m,
+    std::size_t first, std::size_t last)
+{
+    std::string result("[");
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        auto row = blaze::subvector(blaze::row(m, i), first, last - first);
+        result += (i != 0 ? ", " : "") + literal(row.begin(), row.end());
+    }
+    return result + "]";
+}
+
+std::string tile_annotation(
+    std::size_t first, std::size_t last, std::size_t rows)
+{
+    return hpx::util::format(
+        R"(list("tile", list("columns", {}, {}), list("rows", 0, {})))",
+        first, last, rows);
+}
+
+// 8x8 system that needs row interchanges, factored in panels of two columns
+void test_solve_d_3()
+{
+    std::size_t const n = 8;
+    blaze::DynamicMatrix<double> a = pivoting_matrix(n);
+    blaze::DynamicVector<double> b(n);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        b[i] = i + 1.0;
+    }
+    blaze::DynamicVector<double> x = blaze::inv(a) * b;
+
+    std::size_t const first = hpx::get_locality_id() == 0 ? 0 : n / 2;
+    std::size_t const last = first + n / 2;
+
+    test_solve_d_operation("test_solve_d_3",
+        hpx::util::format(
+            R"(solve_d(annotate_d({}, "test_solve_d_3", {}), {}))",
+            columns_literal(a, first, last), tile_annotation(first, last, n),
+            literal(b.begin(), b.end())),
+        literal(x.begin(), x.end()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_solve_d_0();
+    test_solve_d_1();
+    test_solve_d_2();
+    test_solve_d_3();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    // small panels exercise the blocked factorization on small matrices
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.dist_lu.block_size!=2"
+    };
+
+    return hpx::init(argc, argv, cfg);
+}
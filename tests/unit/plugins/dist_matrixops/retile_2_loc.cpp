@@ -679,6 +679,62 @@ void test_retile_2loc_3d_2()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// retiling the same array repeatedly reuses the cached retile plan
+void test_retile_2loc_2d_repeated()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_retile_d_operation("test_retile_2loc2d_repeated", R"(
+            block(
+                define(retile, a,
+                    retile_d(a, "user", nil, nil,
+                        list("tile", list("rows", 0, 2), list("columns", 0, 4))
+                    )
+                ),
+                define(a,
+                    annotate_d([[1, 2, 3], [-1, -2, -3]], "tiled_array_2d_r",
+                        list("tile", list("columns", 0, 3), list("rows", 0, 2))
+                    )
+                ),
+                retile(a),
+                retile(a)
+            )
+        )", R"(
+            annotate_d([[1, 2, 3, 4], [-1, -2, -3, -4]],
+                "tiled_array_2d_r_retiled/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 2), list("columns", 0, 4))))
+        )");
+    }
+    else
+    {
+        test_retile_d_operation("test_retile_2loc2d_repeated", R"(
+            block(
+                define(retile, a,
+                    retile_d(a, "user", nil, nil,
+                        list("tile", list("rows", 0, 2), list("columns", 2, 6))
+                    )
+                ),
+                define(a,
+                    annotate_d([[4, 5, 6], [-4, -5, -6]], "tiled_array_2d_r",
+                        list("tile", list("rows", 0, 2), list("columns", 3, 6))
+                    )
+                ),
+                retile(a),
+                retile(a)
+            )
+        )", R"(
+            annotate_d([[3, 4, 5, 6], [-3, -4, -5, -6]],
+                "tiled_array_2d_r_retiled/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 0, 2), list("columns", 2, 6))))
+        )");
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -696,6 +752,7 @@ int hpx_main(int argc, char* argv[])
     test_retile_2loc_2d_1();
     test_retile_2loc_2d_2();
     test_retile_2loc_2d_3();
+    test_retile_2loc_2d_repeated();
 
     test_retile_2loc_3d_0();
     test_retile_2loc_3d_1();
@@ -0,0 +1,152 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+using phylanx::execution_tree::primitive_argument_type;
+using phylanx::execution_tree::primitive_arguments_type;
+
+primitive_argument_type write_array(std::string const& filename,
+    primitive_argument_type const& data, bool append = false)
+{
+    phylanx::execution_tree::primitive outfile =
+        phylanx::execution_tree::primitives::create_file_write_array(
+            hpx::find_here(),
+            primitive_arguments_type{primitive_argument_type{filename}, data,
+                primitive_argument_type{append}});
+
+    return outfile.eval().get();
+}
+
+primitive_argument_type read_array(std::string const& filename, bool copy)
+{
+    phylanx::execution_tree::primitive infile =
+        phylanx::execution_tree::primitives::create_file_read_array(
+            hpx::find_here(),
+            primitive_arguments_type{primitive_argument_type{filename},
+                primitive_argument_type{copy}});
+
+    return infile.eval().get();
+}
+
+void test_file_array(primitive_argument_type const& data)
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    write_array(filename, data);
+
+    HPX_TEST_EQ(read_array(filename, false), data);
+    HPX_TEST_EQ(read_array(filename, true), data);
+
+    std::remove(filename.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_file_array_append()
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> first = gen.generate(17UL, 13UL);
+    blaze::DynamicMatrix<double> second = gen.generate(5UL, 13UL);
+
+    write_array(filename,
+        primitive_argument_type{phylanx::ir::node_data<double>{first}});
+    write_array(filename,
+        primitive_argument_type{phylanx::ir::node_data<double>{second}}, true);
+
+    blaze::DynamicMatrix<double> expected(22UL, 13UL);
+    blaze::submatrix(expected, 0, 0, 17, 13) = first;
+    blaze::submatrix(expected, 17, 0, 5, 13) = second;
+
+    HPX_TEST_EQ(read_array(filename, false),
+        primitive_argument_type{phylanx::ir::node_data<double>{expected}});
+
+    // vectors grow in place
+    std::remove(filename.c_str());
+
+    blaze::DynamicVector<std::int64_t> v1{1, 2, 3};
+    blaze::DynamicVector<std::int64_t> v2{4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    write_array(filename,
+        primitive_argument_type{phylanx::ir::node_data<std::int64_t>{v1}});
+    write_array(filename,
+        primitive_argument_type{phylanx::ir::node_data<std::int64_t>{v2}},
+        true);
+
+    HPX_TEST_EQ(read_array(filename, false),
+        primitive_argument_type{phylanx::ir::node_data<std::int64_t>{
+            blaze::DynamicVector<std::int64_t>{
+                1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}}});
+
+    std::remove(filename.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_file_array_overwrite()
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    primitive_argument_type first{
+        phylanx::ir::node_data<double>{gen.generate(64UL, 33UL)}};
+    primitive_argument_type second{
+        phylanx::ir::node_data<double>{gen.generate(3UL, 2UL)}};
+
+    write_array(filename, first);
+    primitive_argument_type mapped = read_array(filename, false);
+
+    // replacing the file must not modify the arrays mapped from it
+    write_array(filename, second);
+
+    HPX_TEST_EQ(mapped, first);
+    HPX_TEST_EQ(read_array(filename, false), second);
+
+    std::remove(filename.c_str());
+
+    // the mapping stays valid after the file was removed
+    HPX_TEST_EQ(mapped, first);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_file_array(
+        primitive_argument_type{phylanx::ir::node_data<double>{42.0}});
+
+    blaze::Rand<blaze::DynamicVector<double>> gen{};
+    test_file_array(primitive_argument_type{
+        phylanx::ir::node_data<double>{gen.generate(1007UL)}});
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen2{};
+    test_file_array(primitive_argument_type{
+        phylanx::ir::node_data<double>{gen2.generate(101UL, 33UL)}});
+
+    blaze::Rand<blaze::DynamicTensor<std::int64_t>> gen3{};
+    test_file_array(primitive_argument_type{
+        phylanx::ir::node_data<std::int64_t>{gen3.generate(3UL, 7UL, 5UL)}});
+
+    test_file_array(primitive_argument_type{
+        phylanx::ir::node_data<std::uint8_t>{blaze::DynamicMatrix<std::uint8_t>{
+            {1, 0, 1}, {0, 0, 1}}}});
+
+    test_file_array_append();
+    test_file_array_overwrite();
+
+    return hpx::util::report_errors();
+}
@@ -10,7 +10,9 @@
 #include <hpx/modules/testing.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <fstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,6 +93,59 @@ void test_file_io(phylanx::ir::node_data<double> const& in)
     test_file_io_primitive(in);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type read_csv(
+    phylanx::execution_tree::primitive_arguments_type&& args)
+{
+    phylanx::execution_tree::primitive infile =
+        phylanx::execution_tree::primitives::create_file_read_csv(
+            hpx::find_here(), std::move(args));
+
+    return infile.eval().get();
+}
+
+void test_file_read_csv_options()
+{
+    std::string filename = std::tmpnam(nullptr);
+    {
+        std::ofstream outfile(filename.c_str());
+        outfile << "a, b, c\r\n1, 2, 0\r\n\r\n-3, 4, 1\r\n5, -6, 0\r\n";
+    }
+
+    using phylanx::execution_tree::primitive_argument_type;
+
+    // header is skipped automatically
+    HPX_TEST_EQ(read_csv({primitive_argument_type{filename}}),
+        primitive_argument_type{phylanx::ir::node_data<double>{
+            blaze::DynamicMatrix<double>{
+                {1.0, 2.0, 0.0}, {-3.0, 4.0, 1.0}, {5.0, -6.0, 0.0}}}});
+
+    // typed data, explicit header skipping, column selection
+    HPX_TEST_EQ(read_csv({primitive_argument_type{filename},
+                    primitive_argument_type{false},
+                    primitive_argument_type{std::int64_t(1)},
+                    primitive_argument_type{std::string("int")},
+                    primitive_argument_type{std::int64_t(1)},
+                    primitive_argument_type{phylanx::ir::range(
+                        phylanx::execution_tree::primitive_arguments_type{
+                            primitive_argument_type{std::int64_t(1)},
+                            primitive_argument_type{std::int64_t(0)}})}}),
+        primitive_argument_type{phylanx::ir::node_data<std::int64_t>{
+            blaze::DynamicMatrix<std::int64_t>{{2, 1}, {4, -3}, {-6, 5}}}});
+
+    HPX_TEST_EQ(read_csv({primitive_argument_type{filename},
+                    primitive_argument_type{false},
+                    primitive_argument_type{std::int64_t(1)},
+                    primitive_argument_type{std::string("bool")},
+                    primitive_argument_type{},
+                    primitive_argument_type{std::int64_t(2)}}),
+        primitive_argument_type{phylanx::ir::node_data<std::uint8_t>{
+            blaze::DynamicMatrix<std::uint8_t>{{0}, {1}, {0}}}});
+
+    std::remove(filename.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
     blaze::Rand<blaze::DynamicVector<double>> gen{};
@@ -109,5 +164,7 @@ int main(int argc, char* argv[])
     blaze::DynamicMatrix<double> m = gen2.generate(101UL, 101UL);
     test_file_io(phylanx::ir::node_data<double>(std::move(m)));
 
+    test_file_read_csv_options();
+
     return hpx::util::report_errors();
 }
@@ -103,6 +103,24 @@ int main(int argc, char* argv[])
         "[[[   0.,    0.,    0.,    0.],[   0.,  -35.,  -69., -251.]],"
         "[[   0.,    0.,    0.,    0.],[  27.,  -31.,  -85., -294.]],"
         "[[   0.,    0.,    0.,    0.],[  35.,   16.,    0.,   17.]]]]");
+    // 3x3 kernel, unit strides (Winograd)
+    test_conv2d_operation(R"(conv2d(
+                      [[[[-3, -2], [-1,  0], [ 1,  2], [ 3, -3], [-2, -1]],
+                        [[ 0,  1], [ 2,  3], [-3, -2], [-1,  0], [ 1,  2]],
+                        [[ 3, -3], [-2, -1], [ 0,  1], [ 2,  3], [-3, -2]],
+                        [[-1,  0], [ 1,  2], [ 3, -3], [-2, -1], [ 0,  1]],
+                        [[ 2,  3], [-3, -2], [-1,  0], [ 1,  2], [ 3, -3]]]],
+                      [[[[ 1,  0], [ 2, -1]], [[ 0,  1], [-1,  1]],
+                        [[ 1,  1], [ 0,  2]]],
+                       [[[ 0, -2], [ 1,  0]], [[ 3,  1], [ 0, -1]],
+                        [[ 1,  0], [ 1,  1]]],
+                       [[[-1,  1], [ 0,  0]], [[ 2,  0], [ 1,  1]],
+                        [[ 0,  1], [-2,  0]]]], "same"))",
+        "[[[[-15.,  2.], [  9.,  7.], [ -7., -3.], [  5.,  1.], [ -4., -6.]],"
+        "[[ 11., -9.], [-14.,  5.], [-10., -4.], [ 15.,  1.], [ -9.,  1.]],"
+        "[[  1., 15.], [ -1., -5.], [ 17., -7.], [-14.,  5.], [ -6., -3.]],"
+        "[[ 12., -3.], [ -9., -1.], [  2., 11.], [ -1., -5.], [ 11., -7.]],"
+        "[[  2.,  1.], [ -7., -5.], [  4.,  1.], [  1.,  0.], [  6.,  6.]]]]");
 
     return hpx::util::report_errors();
 }
@@ -113,6 +113,14 @@ int main(int argc, char* argv[])
         make_list(1,2), "same", make_list(2,3)))",
         "[[[[ 4.,  5.,  6.,  7.]], [[28., 29., 30., 31.]]],"
         "[[[40., 41., 42., 43.]], [[64., 61., 62., 67.]]]]");
+    test_max_pool2d_operation(
+        R"(max_pool2d(
+        [[[[ 1.,  7.], [ 4.,  2.], [ 0.,  5.]],
+        [[ 3.,  8.], [ 2.,  6.], [ 9.,  1.]]]],
+        make_list(2,2), "valid", make_list(1,1), true))",
+        R"(make_list(
+        [[[[ 4.,  8.], [ 9.,  6.]]]],
+        [[[[ 1,  3], [ 5,  4]]]]))");
 
     return hpx::util::report_errors();
 }
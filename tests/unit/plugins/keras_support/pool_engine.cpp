@@ -0,0 +1,464 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the pooling primitives against direct reductions over each window,
+// covering the running (van Herk/Gil-Werman) maxima and running sums used for
+// larger unit-stride windows, windows crossing the boundaries of the chunks
+// the engine splits the results into, ties and infinite values.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::compiler::function compile(
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The windows along one dimension as defined by Keras
+struct window
+{
+    window(std::size_t size, std::size_t filter, std::size_t stride,
+            bool same)
+      : size_(size)
+      , filter_(filter)
+      , stride_(stride)
+      , pad_(0)
+      , result_(0)
+    {
+        if (same)
+        {
+            result_ = (size + stride - 1) / stride;
+            std::size_t const covered = (result_ - 1) * stride + filter;
+            pad_ = covered > size ? (covered - size) / 2 : 0;
+        }
+        else
+        {
+            result_ = (size - filter) / stride + 1;
+        }
+    }
+
+    std::size_t begin(std::size_t o) const
+    {
+        return o * stride_ > pad_ ? o * stride_ - pad_ : 0;
+    }
+    std::size_t end(std::size_t o) const
+    {
+        return (std::min)(o * stride_ + filter_ - pad_, size_);
+    }
+
+    std::size_t size_;
+    std::size_t filter_;
+    std::size_t stride_;
+    std::size_t pad_;
+    std::size_t result_;
+};
+
+std::string pool_code(std::string const& name, std::size_t filter0,
+    std::size_t filter1, std::size_t stride0, std::size_t stride1,
+    std::string const& padding, bool return_indices = false)
+{
+    return "define(pool, x, " + name + "(x, make_list(" +
+        std::to_string(filter0) + ", " + std::to_string(filter1) + "), \"" +
+        padding + "\", make_list(" + std::to_string(stride0) + ", " +
+        std::to_string(stride1) + ")" + (return_indices ? ", true" : "") +
+        "))\npool";
+}
+
+std::string pool_code(std::string const& name, std::size_t filter0,
+    std::size_t filter1, std::size_t filter2, std::size_t stride0,
+    std::size_t stride1, std::size_t stride2, std::string const& padding,
+    bool return_indices = false)
+{
+    return "define(pool, x, " + name + "(x, make_list(" +
+        std::to_string(filter0) + ", " + std::to_string(filter1) + ", " +
+        std::to_string(filter2) + "), \"" + padding + "\", make_list(" +
+        std::to_string(stride0) + ", " + std::to_string(stride1) + ", " +
+        std::to_string(stride2) + ")" + (return_indices ? ", true" : "") +
+        "))\npool";
+}
+
+bool close(double actual, double expected)
+{
+    return std::abs(actual - expected) <=
+        1e-10 * (std::max)(1.0, std::abs(expected));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Small integers produce many ties, a fraction of the elements and a block
+// at the start of the first batch/page are set to -inf if requested.
+blaze::DynamicArray<4UL, double> generate4d(std::size_t batch,
+    std::size_t rows, std::size_t columns, std::size_t channels,
+    bool infinities)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 4);
+    std::uniform_int_distribution<int> inf_dist(0, 9);
+
+    blaze::DynamicArray<4UL, double> x(batch, rows, columns, channels);
+    for (std::size_t b = 0; b != batch; ++b)
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                for (std::size_t c = 0; c != channels; ++c)
+                {
+                    bool const inf = infinities &&
+                        ((b == 0 && i < 12 && j < 20) || inf_dist(gen) == 0);
+                    x(b, i, j, c) = inf ?
+                        -std::numeric_limits<double>::infinity() :
+                        double(dist(gen));
+                }
+            }
+        }
+    }
+    return x;
+}
+
+blaze::DynamicTensor<double> generate3d(std::size_t pages,
+    std::size_t rows, std::size_t columns, bool infinities)
+{
+    std::mt19937 gen(43);
+    std::uniform_int_distribution<int> dist(0, 4);
+    std::uniform_int_distribution<int> inf_dist(0, 9);
+
+    blaze::DynamicTensor<double> x(pages, rows, columns);
+    for (std::size_t k = 0; k != pages; ++k)
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                bool const inf = infinities &&
+                    ((k < 3 && i < 12 && j < 20) || inf_dist(gen) == 0);
+                x(k, i, j) = inf ?
+                    -std::numeric_limits<double>::infinity() :
+                    double(dist(gen));
+            }
+        }
+    }
+    return x;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_max_pool2d(std::size_t rows, std::size_t columns,
+    std::size_t filter_height, std::size_t filter_width,
+    std::size_t stride_height, std::size_t stride_width,
+    std::string const& padding)
+{
+    blaze::DynamicArray<4UL, double> x =
+        generate4d(2, rows, columns, 3, true);
+
+    window const height(rows, filter_height, stride_height, padding == "same");
+    window const width(
+        columns, filter_width, stride_width, padding == "same");
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto pool = compile(snippets,
+        pool_code("max_pool2d", filter_height, filter_width, stride_height,
+            stride_width, padding, true));
+    auto result = phylanx::execution_tree::extract_list_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    auto it = result.begin();
+    auto values = phylanx::execution_tree::extract_numeric_value(*it);
+    auto indices = phylanx::execution_tree::extract_integer_value(*++it);
+
+    auto v = values.quatern();
+    auto idx = indices.quatern();
+
+    HPX_TEST_EQ(v.pages(), height.result_);
+    HPX_TEST_EQ(v.rows(), width.result_);
+    HPX_TEST_EQ(idx.pages(), height.result_);
+    HPX_TEST_EQ(idx.rows(), width.result_);
+
+    std::size_t errors = 0;
+    for (std::size_t b = 0; b != x.quats(); ++b)
+    {
+        for (std::size_t r = 0; r != height.result_; ++r)
+        {
+            for (std::size_t q = 0; q != width.result_; ++q)
+            {
+                for (std::size_t c = 0; c != x.columns(); ++c)
+                {
+                    // the first maximum in row major order wins
+                    std::size_t i0 = height.begin(r);
+                    std::size_t j0 = width.begin(q);
+                    double expected = x(b, i0, j0, c);
+                    std::int64_t expected_index = i0 * columns + j0;
+                    for (std::size_t i = i0; i != height.end(r); ++i)
+                    {
+                        for (std::size_t j = j0; j != width.end(q); ++j)
+                        {
+                            if (x(b, i, j, c) > expected)
+                            {
+                                expected = x(b, i, j, c);
+                                expected_index = i * columns + j;
+                            }
+                        }
+                    }
+
+                    if (v(b, r, q, c) != expected ||
+                        idx(b, r, q, c) != expected_index)
+                    {
+                        ++errors;
+                    }
+                }
+            }
+        }
+    }
+    HPX_TEST_EQ(errors, std::size_t(0));
+}
+
+void test_avg_pool2d(std::size_t rows, std::size_t columns,
+    std::size_t filter_height, std::size_t filter_width,
+    std::size_t stride_height, std::size_t stride_width,
+    std::string const& padding)
+{
+    blaze::DynamicArray<4UL, double> x =
+        generate4d(2, rows, columns, 3, false);
+
+    window const height(rows, filter_height, stride_height, padding == "same");
+    window const width(
+        columns, filter_width, stride_width, padding == "same");
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto pool = compile(snippets,
+        pool_code("avg_pool2d", filter_height, filter_width, stride_height,
+            stride_width, padding));
+    auto values = phylanx::execution_tree::extract_numeric_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    auto v = values.quatern();
+
+    HPX_TEST_EQ(v.pages(), height.result_);
+    HPX_TEST_EQ(v.rows(), width.result_);
+
+    std::size_t errors = 0;
+    for (std::size_t b = 0; b != x.quats(); ++b)
+    {
+        for (std::size_t r = 0; r != height.result_; ++r)
+        {
+            for (std::size_t q = 0; q != width.result_; ++q)
+            {
+                for (std::size_t c = 0; c != x.columns(); ++c)
+                {
+                    // padding does not count towards the average
+                    double sum = 0.0;
+                    std::size_t count = 0;
+                    for (std::size_t i = height.begin(r); i != height.end(r);
+                         ++i)
+                    {
+                        for (std::size_t j = width.begin(q); j != width.end(q);
+                             ++j)
+                        {
+                            sum += x(b, i, j, c);
+                            ++count;
+                        }
+                    }
+
+                    if (!close(v(b, r, q, c), sum / count))
+                    {
+                        ++errors;
+                    }
+                }
+            }
+        }
+    }
+    HPX_TEST_EQ(errors, std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_max_pool3d(std::size_t pages, std::size_t rows, std::size_t columns,
+    std::size_t filter_depth, std::size_t filter_height,
+    std::size_t filter_width, std::size_t stride_depth,
+    std::size_t stride_height, std::size_t stride_width,
+    std::string const& padding)
+{
+    blaze::DynamicTensor<double> x = generate3d(pages, rows, columns, true);
+
+    window const depth(pages, filter_depth, stride_depth, padding == "same");
+    window const height(rows, filter_height, stride_height, padding == "same");
+    window const width(
+        columns, filter_width, stride_width, padding == "same");
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto pool = compile(snippets,
+        pool_code("max_pool3d", filter_depth, filter_height, filter_width,
+            stride_depth, stride_height, stride_width, padding, true));
+    auto result = phylanx::execution_tree::extract_list_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    auto it = result.begin();
+    auto values = phylanx::execution_tree::extract_numeric_value(*it);
+    auto indices = phylanx::execution_tree::extract_integer_value(*++it);
+
+    auto v = values.tensor();
+    auto idx = indices.tensor();
+
+    HPX_TEST_EQ(v.pages(), depth.result_);
+    HPX_TEST_EQ(v.rows(), height.result_);
+    HPX_TEST_EQ(v.columns(), width.result_);
+    HPX_TEST_EQ(idx.pages(), depth.result_);
+    HPX_TEST_EQ(idx.rows(), height.result_);
+    HPX_TEST_EQ(idx.columns(), width.result_);
+
+    std::size_t errors = 0;
+    for (std::size_t p = 0; p != depth.result_; ++p)
+    {
+        for (std::size_t r = 0; r != height.result_; ++r)
+        {
+            for (std::size_t q = 0; q != width.result_; ++q)
+            {
+                // the first maximum in row major order wins
+                std::size_t k0 = depth.begin(p);
+                std::size_t i0 = height.begin(r);
+                std::size_t j0 = width.begin(q);
+                double expected = x(k0, i0, j0);
+                std::int64_t expected_index = (k0 * rows + i0) * columns + j0;
+                for (std::size_t k = k0; k != depth.end(p); ++k)
+                {
+                    for (std::size_t i = i0; i != height.end(r); ++i)
+                    {
+                        for (std::size_t j = j0; j != width.end(q); ++j)
+                        {
+                            if (x(k, i, j) > expected)
+                            {
+                                expected = x(k, i, j);
+                                expected_index = (k * rows + i) * columns + j;
+                            }
+                        }
+                    }
+                }
+
+                if (v(p, r, q) != expected || idx(p, r, q) != expected_index)
+                {
+                    ++errors;
+                }
+            }
+        }
+    }
+    HPX_TEST_EQ(errors, std::size_t(0));
+}
+
+void test_avg_pool3d(std::size_t pages, std::size_t rows, std::size_t columns,
+    std::size_t filter_depth, std::size_t filter_height,
+    std::size_t filter_width, std::size_t stride_depth,
+    std::size_t stride_height, std::size_t stride_width,
+    std::string const& padding)
+{
+    blaze::DynamicTensor<double> x = generate3d(pages, rows, columns, false);
+
+    window const depth(pages, filter_depth, stride_depth, padding == "same");
+    window const height(rows, filter_height, stride_height, padding == "same");
+    window const width(
+        columns, filter_width, stride_width, padding == "same");
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto pool = compile(snippets,
+        pool_code("avg_pool3d", filter_depth, filter_height, filter_width,
+            stride_depth, stride_height, stride_width, padding));
+    auto values = phylanx::execution_tree::extract_numeric_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    auto v = values.tensor();
+
+    HPX_TEST_EQ(v.pages(), depth.result_);
+    HPX_TEST_EQ(v.rows(), height.result_);
+    HPX_TEST_EQ(v.columns(), width.result_);
+
+    std::size_t errors = 0;
+    for (std::size_t p = 0; p != depth.result_; ++p)
+    {
+        for (std::size_t r = 0; r != height.result_; ++r)
+        {
+            for (std::size_t q = 0; q != width.result_; ++q)
+            {
+                // padding does not count towards the average
+                double sum = 0.0;
+                std::size_t count = 0;
+                for (std::size_t k = depth.begin(p); k != depth.end(p); ++k)
+                {
+                    for (std::size_t i = height.begin(r); i != height.end(r);
+                         ++i)
+                    {
+                        for (std::size_t j = width.begin(q); j != width.end(q);
+                             ++j)
+                        {
+                            sum += x(k, i, j);
+                            ++count;
+                        }
+                    }
+                }
+
+                if (!close(v(p, r, q), sum / count))
+                {
+                    ++errors;
+                }
+            }
+        }
+    }
+    HPX_TEST_EQ(errors, std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // running maxima in both dimensions, more than one chunk of results
+    test_max_pool2d(70, 150, 9, 12, 1, 1, "valid");
+    test_max_pool2d(70, 150, 9, 12, 1, 1, "same");
+    test_max_pool2d(70, 150, 8, 8, 1, 1, "same");
+
+    // running maxima along one dimension only
+    test_max_pool2d(70, 150, 9, 10, 2, 1, "same");
+    test_max_pool2d(70, 150, 3, 16, 1, 1, "same");
+
+    // direct maxima
+    test_max_pool2d(31, 67, 3, 5, 2, 3, "same");
+    test_max_pool2d(31, 67, 3, 5, 2, 3, "valid");
+
+    // running sums
+    test_avg_pool2d(70, 150, 9, 12, 1, 1, "valid");
+    test_avg_pool2d(70, 150, 9, 12, 1, 1, "same");
+    test_avg_pool2d(70, 150, 9, 10, 2, 1, "same");
+
+    // direct sums
+    test_avg_pool2d(31, 67, 3, 5, 2, 3, "same");
+
+    // running maxima and sums along all dimensions of a tensor
+    test_max_pool3d(20, 30, 140, 8, 8, 10, 1, 1, 1, "same");
+    test_max_pool3d(20, 30, 140, 3, 8, 10, 1, 1, 1, "valid");
+    test_avg_pool3d(20, 30, 140, 8, 8, 10, 1, 1, 1, "same");
+
+    // 'same' padding with strides larger than one
+    test_max_pool3d(20, 30, 70, 3, 4, 5, 2, 3, 2, "same");
+    test_max_pool3d(7, 11, 13, 2, 3, 4, 3, 2, 3, "same");
+    test_avg_pool3d(20, 30, 70, 3, 4, 5, 2, 3, 2, "same");
+    test_avg_pool3d(7, 11, 13, 2, 3, 4, 3, 2, 3, "same");
+
+    return hpx::util::report_errors();
+}
@@ -746,6 +746,28 @@ void test_dot_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// the products are large enough to be partitioned, the integer products are
+// computed by the packed kernel and compared to the Blaze results
+void test_dot_operation_large()
+{
+    std::string const operands = R"(
+        define(a, reshape(arange(0, 60000) % 7, make_list(200, 300))),
+        define(b, reshape(arange(0, 45000) % 5, make_list(300, 150))),
+        define(v, arange(0, 1000) % 3),
+        define(m, reshape(arange(0, 1000000) % 11, make_list(1000, 1000))),
+        define(t, reshape(arange(0, 480000) % 13, make_list(16, 100, 300))),
+    )";
+
+    test_dot_operation("block(" + operands + "dot(a, b))",
+        "block(" + operands +
+            R"(astype(dot(astype(a, "float"), astype(b, "float")), "int")))");
+    test_dot_operation("block(" + operands + "dot(v, m))",
+        "block(" + operands + "dot(transpose(m), v))");
+    test_dot_operation("block(" + operands + "dot(t, b))",
+        "block(" + operands +
+            R"(astype(dot(astype(t, "float"), astype(b, "float")), "int")))");
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -999,6 +1021,8 @@ int main(int argc, char* argv[])
         "[[[ 14,  10],[ 32,  28]],[[  4,   4],[ 38, 118]],"
         "[[ 14,  14],[-14, -14]],[[ 20,  20],[ 34,  34]]]");
 
+    test_dot_operation_large();
+
     return hpx::util::report_errors();
 }
 
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <random>
 #include <string>
 #include <utility>
@@ -54,6 +55,56 @@ void set_seed(std::uint32_t seed)
 
     call(static_cast<std::int64_t>(seed));
 }
+///////////////////////////////////////////////////////////////////////////////
+// The name of the most recently compiled random primitive
+std::string random_primitive_name()
+{
+    auto entries =
+        hpx::agas::find_symbols(hpx::launch::sync, "/phylanx$0/random$*");
+
+    std::string name;
+    std::int64_t compile_id = -1;
+    for (auto const& entry : entries)
+    {
+        auto parts =
+            phylanx::execution_tree::compiler::parse_primitive_name(
+                entry.first);
+        if (parts.compile_id > compile_id)
+        {
+            compile_id = parts.compile_id;
+            name = entry.first;
+        }
+    }
+    return name;
+}
+
+// Every evaluation of a random primitive uses the next stream associated
+// with the primitive, each element is generated based on its (row major)
+// offset inside the generated array.
+struct reference_generator
+{
+    explicit reference_generator(std::uint32_t seed)
+      : seed_(seed)
+    {
+    }
+
+    std::uint64_t next_stream()
+    {
+        std::string const name = random_primitive_name();
+        return phylanx::util::random_stream(name, invocations_[name]++);
+    }
+
+    template <typename Dist>
+    typename Dist::result_type operator()(
+        Dist& dist, std::uint64_t stream, std::uint64_t offset) const
+    {
+        return phylanx::util::random_value(dist, seed_, stream, offset);
+    }
+
+    std::uint32_t seed_;
+    std::map<std::string, std::uint64_t> invocations_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // generate single random double value
 template <typename T, typename Gen, typename Dist>
@@ -67,7 +118,7 @@ void generate_0d(phylanx::execution_tree::compiler::function const& call,
     auto result = call(dims);
 
     HPX_TEST_EQ(
-        static_cast<T>(dist(gen)),
+        static_cast<T>(gen(dist, gen.next_stream(), 0)),
         static_cast<T>(
             phylanx::execution_tree::extract_node_data<T>(result)[0]));
 }
@@ -84,10 +135,13 @@ void generate_1d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    std::uint64_t const stream = gen.next_stream();
+    std::uint64_t offset = 0;
+
     blaze::DynamicVector<T> v(32);
     for (auto& val : v)
     {
-        val = dist(gen);
+        val = gen(dist, stream, offset++);
     }
 
     HPX_TEST_EQ(phylanx::ir::node_data<T>(std::move(v)),
@@ -106,12 +160,15 @@ void generate_2d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    std::uint64_t const stream = gen.next_stream();
+    std::uint64_t offset = 0;
+
     blaze::DynamicMatrix<T> m(32, 16);
     for (std::size_t row = 0; row != blaze::rows(m); ++row)
     {
         for (auto& val : blaze::row(m, row))
         {
-            val = dist(gen);
+            val = gen(dist, stream, offset++);
         }
     }
 
@@ -132,6 +189,9 @@ void generate_3d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    std::uint64_t const stream = gen.next_stream();
+    std::uint64_t offset = 0;
+
     blaze::DynamicTensor<T> t(3, 32, 16);
     for (std::size_t page = 0; page != blaze::pages(t); ++page)
     {
@@ -139,7 +199,7 @@ void generate_3d(phylanx::execution_tree::compiler::function const& call,
         {
             for (auto& val : blaze::row(blaze::pageslice(t, page), row))
             {
-                val = dist(gen);
+                val = gen(dist, stream, offset++);
             }
         }
     }
@@ -162,6 +222,9 @@ void generate_4d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    std::uint64_t const stream = gen.next_stream();
+    std::uint64_t offset = 0;
+
     blaze::DynamicArray<4UL, T> q(3UL, 32UL, 16UL, 13UL);
     for (std::size_t quat = 0; quat != blaze::quats(q); ++quat)
     {
@@ -173,7 +236,7 @@ void generate_4d(phylanx::execution_tree::compiler::function const& call,
                     blaze::row(
                         blaze::pageslice(blaze::quatslice(q, quat), page), row))
                 {
-                    val = dist(gen);
+                    val = gen(dist, stream, offset++);
                 }
             }
         }
@@ -184,7 +247,7 @@ void generate_4d(phylanx::execution_tree::compiler::function const& call,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution_implicit(std::mt19937& gen)
+void test_normal_distribution_implicit(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size)),
@@ -215,7 +278,7 @@ void test_normal_distribution_implicit(std::mt19937& gen)
     }
 }
 
-void test_uniform_distribution_explicit(std::mt19937& gen)
+void test_uniform_distribution_explicit(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "uniform")),
@@ -246,7 +309,7 @@ void test_uniform_distribution_explicit(std::mt19937& gen)
     }
 }
 
-void test_uniform_distribution_explicit_params(std::mt19937& gen)
+void test_uniform_distribution_explicit_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("uniform", 2.0, 4.0))),
@@ -278,7 +341,7 @@ void test_uniform_distribution_explicit_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_uniform_int_distribution_explicit(std::mt19937& gen)
+void test_uniform_int_distribution_explicit(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "uniform_int", __arg(dtype, "int"))),
@@ -309,7 +372,7 @@ void test_uniform_int_distribution_explicit(std::mt19937& gen)
     }
 }
 
-void test_uniform_int_distribution_explicit_params(std::mt19937& gen)
+void test_uniform_int_distribution_explicit_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size,
@@ -343,7 +406,7 @@ void test_uniform_int_distribution_explicit_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_bernoulli_distribution(std::mt19937& gen)
+void test_bernoulli_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "bernoulli", __arg(dtype, "bool"))),
@@ -374,7 +437,7 @@ void test_bernoulli_distribution(std::mt19937& gen)
     }
 }
 
-void test_bernoulli_distribution_params(std::mt19937& gen)
+void test_bernoulli_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size,
@@ -408,7 +471,7 @@ void test_bernoulli_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_binomial_distribution(std::mt19937& gen)
+void test_binomial_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("binomial", 1.0, 0.5))),
@@ -439,7 +502,7 @@ void test_binomial_distribution(std::mt19937& gen)
     }
 }
 
-void test_binomial_distribution_params(std::mt19937& gen)
+void test_binomial_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("binomial", 10, 0.8))),
@@ -471,7 +534,7 @@ void test_binomial_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_negative_binomial_distribution(std::mt19937& gen)
+void test_negative_binomial_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("negative_binomial", 1.0, 0.5))),
@@ -502,7 +565,7 @@ void test_negative_binomial_distribution(std::mt19937& gen)
     }
 }
 
-void test_negative_binomial_distribution_params(std::mt19937& gen)
+void test_negative_binomial_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("negative_binomial", 10, 0.8))),
@@ -534,7 +597,7 @@ void test_negative_binomial_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_geometric_distribution(std::mt19937& gen)
+void test_geometric_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("geometric", 0.5))),
@@ -565,7 +628,7 @@ void test_geometric_distribution(std::mt19937& gen)
     }
 }
 
-void test_geometric_distribution_params(std::mt19937& gen)
+void test_geometric_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("geometric", 0.8))),
@@ -597,7 +660,7 @@ void test_geometric_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_poisson_distribution(std::mt19937& gen)
+void test_poisson_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("poisson", 1.0))),
@@ -628,7 +691,7 @@ void test_poisson_distribution(std::mt19937& gen)
     }
 }
 
-void test_poisson_distribution_params(std::mt19937& gen)
+void test_poisson_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("poisson", 4))),
@@ -660,7 +723,7 @@ void test_poisson_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_exponential_distribution(std::mt19937& gen)
+void test_exponential_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("exponential", 1.0))),
@@ -691,7 +754,7 @@ void test_exponential_distribution(std::mt19937& gen)
     }
 }
 
-void test_exponential_distribution_params(std::mt19937& gen)
+void test_exponential_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("exponential", 2.0))),
@@ -723,7 +786,7 @@ void test_exponential_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_gamma_distribution(std::mt19937& gen)
+void test_gamma_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("gamma", 1.0))),
@@ -754,7 +817,7 @@ void test_gamma_distribution(std::mt19937& gen)
     }
 }
 
-void test_gamma_distribution_params(std::mt19937& gen)
+void test_gamma_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("gamma", 0.8, 1.2))),
@@ -786,7 +849,7 @@ void test_gamma_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_weibull_distribution(std::mt19937& gen)
+void test_weibull_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("weibull", 1.0))),
@@ -817,7 +880,7 @@ void test_weibull_distribution(std::mt19937& gen)
     }
 }
 
-void test_weibull_distribution_params(std::mt19937& gen)
+void test_weibull_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("weibull", 0.8, 1.2))),
@@ -849,7 +912,7 @@ void test_weibull_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_extreme_value_distribution(std::mt19937& gen)
+void test_extreme_value_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "extreme_value")),
@@ -880,7 +943,7 @@ void test_extreme_value_distribution(std::mt19937& gen)
     }
 }
 
-void test_extreme_value_distribution_params(std::mt19937& gen)
+void test_extreme_value_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("extreme_value", 0.8, 1.2))),
@@ -912,7 +975,7 @@ void test_extreme_value_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution(std::mt19937& gen)
+void test_normal_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "normal")),
@@ -943,7 +1006,7 @@ void test_normal_distribution(std::mt19937& gen)
     }
 }
 
-void test_normal_distribution_params(std::mt19937& gen)
+void test_normal_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("normal", 0.8, 1.2))),
@@ -975,7 +1038,7 @@ void test_normal_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_truncated_normal_distribution(std::mt19937& gen)
+void test_truncated_normal_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "truncated_normal")),
@@ -1006,7 +1069,7 @@ void test_truncated_normal_distribution(std::mt19937& gen)
     }
 }
 
-void test_truncated_normal_distribution_params(std::mt19937& gen)
+void test_truncated_normal_distribution_params(reference_generator& gen)
 {
     using namespace phylanx::execution_tree::primitives;
 
@@ -1042,7 +1105,7 @@ void test_truncated_normal_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_lognormal_distribution(std::mt19937& gen)
+void test_lognormal_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "lognormal")),
@@ -1073,7 +1136,7 @@ void test_lognormal_distribution(std::mt19937& gen)
     }
 }
 
-void test_lognormal_distribution_params(std::mt19937& gen)
+void test_lognormal_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("lognormal", 0.8, 1.2))),
@@ -1105,7 +1168,7 @@ void test_lognormal_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_chi_squared_distribution(std::mt19937& gen)
+void test_chi_squared_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("chi_squared", 1.0))),
@@ -1136,7 +1199,7 @@ void test_chi_squared_distribution(std::mt19937& gen)
     }
 }
 
-void test_chi_squared_distribution_params(std::mt19937& gen)
+void test_chi_squared_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("chi_squared", 0.8))),
@@ -1168,7 +1231,7 @@ void test_chi_squared_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_cauchy_distribution(std::mt19937& gen)
+void test_cauchy_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "cauchy")),
@@ -1199,7 +1262,7 @@ void test_cauchy_distribution(std::mt19937& gen)
     }
 }
 
-void test_cauchy_distribution_params(std::mt19937& gen)
+void test_cauchy_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("cauchy", 0.6, 0.8))),
@@ -1231,7 +1294,7 @@ void test_cauchy_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_fisher_f_distribution(std::mt19937& gen)
+void test_fisher_f_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("fisher_f", 1.0))),
@@ -1262,7 +1325,7 @@ void test_fisher_f_distribution(std::mt19937& gen)
     }
 }
 
-void test_fisher_f_distribution_params(std::mt19937& gen)
+void test_fisher_f_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("fisher_f", 0.6, 0.8))),
@@ -1294,7 +1357,7 @@ void test_fisher_f_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_student_t_distribution(std::mt19937& gen)
+void test_student_t_distribution(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("student_t", 1.0))),
@@ -1325,7 +1388,7 @@ void test_student_t_distribution(std::mt19937& gen)
     }
 }
 
-void test_student_t_distribution_params(std::mt19937& gen)
+void test_student_t_distribution_params(reference_generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("student_t", 0.8))),
@@ -1364,7 +1427,7 @@ int main(int argc, char* argv[])
     set_seed(seed);
     HPX_TEST_EQ(get_seed(), seed);
 
-    std::mt19937 gen(seed);
+    reference_generator gen(seed);
 
     test_normal_distribution_implicit(gen);
 
@@ -9,10 +9,15 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <random>
 #include <string>
 #include <utility>
 
+#include <blaze/Math.h>
+
 ///////////////////////////////////////////////////////////////////////////////
 phylanx::execution_tree::primitive_argument_type compile_and_run(
     std::string const& codestr)
@@ -31,6 +36,63 @@ void test_sort(std::string const& code, std::string const& expected_str)
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// inputs large enough to be sorted in parallel
+template <typename T, typename Dist>
+void test_sort_large(Dist dist)
+{
+    std::mt19937 gen(42);
+
+    blaze::DynamicVector<T> v(200000);
+    for (auto& e : v)
+    {
+        e = static_cast<T>(dist(gen));
+    }
+
+    blaze::DynamicVector<T> expected = v;
+    std::sort(expected.begin(), expected.end());
+
+    phylanx::execution_tree::primitive p =
+        phylanx::execution_tree::primitives::create_sort(hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<T>(std::move(v))});
+
+    HPX_TEST_EQ(phylanx::execution_tree::primitive_argument_type{
+                    phylanx::ir::node_data<T>(std::move(expected))},
+        p.eval().get());
+}
+
+void test_sort_large_rows()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::int64_t> dist(-1000000, 1000000);
+
+    blaze::DynamicMatrix<std::int64_t> m(256, 1024);
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != m.columns(); ++j)
+        {
+            m(i, j) = dist(gen);
+        }
+    }
+
+    blaze::DynamicMatrix<std::int64_t> expected = m;
+    for (std::size_t i = 0; i != expected.rows(); ++i)
+    {
+        auto r = blaze::row(expected, i);
+        std::sort(r.begin(), r.end());
+    }
+
+    phylanx::execution_tree::primitive p =
+        phylanx::execution_tree::primitives::create_sort(hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<std::int64_t>(std::move(m))});
+
+    HPX_TEST_EQ(phylanx::execution_tree::primitive_argument_type{
+                    phylanx::ir::node_data<std::int64_t>(std::move(expected))},
+        p.eval().get());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -92,5 +154,11 @@ int main(int argc, char* argv[])
         "[-24., -14., -8., 1., 1., 2., 3., 4., 5., 6., 7., 9., 12., 12., 14., "
         "15., 16., 17., 19., 22.]");
 
+    test_sort_large<double>(std::uniform_real_distribution<double>(-1.0, 1.0));
+    test_sort_large<std::int64_t>(
+        std::uniform_int_distribution<std::int64_t>(-1000000000, 1000000000));
+    test_sort_large<std::uint8_t>(std::uniform_int_distribution<int>(0, 1));
+    test_sort_large_rows();
+
     return hpx::util::report_errors();
 }
@@ -14,6 +14,9 @@
 #include <utility>
 #include <vector>
 
+using custom_matrix_type =
+    phylanx::ir::node_data<double>::custom_storage2d_type;
+
 void vsplit_operation_scalar_blocks()
 {
     blaze::DynamicMatrix<double> m1{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0},
@@ -40,12 +43,9 @@ void vsplit_operation_scalar_blocks()
     hpx::future<phylanx::execution_tree::primitive_argument_type> f =
         vsplit.eval();
 
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_first(
-        &(m1(0, 0)), 1, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_second(
-        &(m1(1, 0)), 1, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_third(
-        &(m1(2, 0)), 1, 3, m1.spacing());
+    custom_matrix_type expected_first(&(m1(0, 0)), 1, 3, m1.spacing());
+    custom_matrix_type expected_second(&(m1(1, 0)), 1, 3, m1.spacing());
+    custom_matrix_type expected_third(&(m1(2, 0)), 1, 3, m1.spacing());
 
     phylanx::ir::node_data<double> data_expected_first(
         std::move(expected_first));
@@ -99,18 +99,12 @@ void vsplit_operation_range_blocks()
     hpx::future<phylanx::execution_tree::primitive_argument_type> f =
         vsplit.eval();
 
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_zero(
-        &(m1(0, 0)), 0, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_first(
-        &(m1(0, 0)), 1, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_second(
-        &(m1(1, 0)), 3, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_third(
-        &(m1(0, 0)), 0, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_fourth(
-        &(m1(2, 0)), 3, 3, m1.spacing());
-    blaze::CustomMatrix<double, blaze::aligned, blaze::padded> expected_fifth(
-        &(m1(0, 0)), 0, 3, m1.spacing());
+    custom_matrix_type expected_zero(&(m1(0, 0)), 0, 3, m1.spacing());
+    custom_matrix_type expected_first(&(m1(0, 0)), 1, 3, m1.spacing());
+    custom_matrix_type expected_second(&(m1(1, 0)), 3, 3, m1.spacing());
+    custom_matrix_type expected_third(&(m1(0, 0)), 0, 3, m1.spacing());
+    custom_matrix_type expected_fourth(&(m1(2, 0)), 3, 3, m1.spacing());
+    custom_matrix_type expected_fifth(&(m1(0, 0)), 0, 3, m1.spacing());
 
     phylanx::ir::node_data<double> data_expected_zero(std::move(expected_zero));
     phylanx::ir::node_data<double> data_expected_first(
@@ -9,6 +9,8 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -32,6 +34,50 @@ void test_count_var_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// the inputs are large enough to be reduced concurrently, all elements of
+// the result are expected to be equal
+bool equal_var(double value, double expected)
+{
+    return std::abs(value - expected) <= 1e-9 * expected;
+}
+
+void test_large_var_operation(std::string const& code, double expected)
+{
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        compile_and_run(code));
+
+    switch (result.num_dimensions())
+    {
+    case 0:
+        HPX_TEST(equal_var(result.scalar(), expected));
+        break;
+
+    case 1:
+        for (double value : result.vector())
+        {
+            HPX_TEST(equal_var(value, expected));
+        }
+        break;
+
+    case 2:
+        {
+            auto m = result.matrix();
+            for (std::size_t i = 0; i != m.rows(); ++i)
+            {
+                for (std::size_t j = 0; j != m.columns(); ++j)
+                {
+                    HPX_TEST(equal_var(m(i, j), expected));
+                }
+            }
+        }
+        break;
+
+    default:
+        HPX_TEST(false);
+        break;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -125,5 +171,28 @@ int main(int argc, char* argv[])
         "var([[[1.0, 2.0], [3.0, 4.0]], [[4.0, 3.0], [2.0, 1.0]]], 2, true)",
         "[[[0.25], [0.25]], [[0.25], [0.25]]]");
 
+    // large inputs
+    test_large_var_operation("var(arange(0, 200000, 1.0))", 3333333333.25);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(400, 500)))",
+        3333333333.25);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(400, 500)), 0)",
+        3333312500.0);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(400, 500)), 1)",
+        20833.25);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(40, 50, 100)), 0)",
+        3331250000.0);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(40, 50, 100)), "
+        "list(0, 1))",
+        3333332500.0);
+    test_large_var_operation(
+        "var(reshape(arange(0, 200000, 1.0), make_list(40, 50, 100)), "
+        "list(0, 2))",
+        3331250833.25);
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,70 @@
+#  Copyright (c) 2020 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Numpy arrays passed to eval are referenced instead of copied whenever they
+# are C-contiguous and their element type is float64 or int64. Verify that the
+# results are the same for all kinds of arrays and that the arguments are not
+# modified unless the evaluation stores to them.
+
+import phylanx
+from phylanx import Phylanx, PhylanxSession
+import numpy as np
+
+PhylanxSession.init(1)
+
+et = phylanx.execution_tree
+cs = et.compiler_state('global', __name__)
+
+
+def aligned_array(shape, dtype, alignment=64):
+    size = int(np.prod(shape)) * np.dtype(dtype).itemsize
+    buf = np.zeros(size + alignment, dtype=np.uint8)
+    offset = (-buf.ctypes.data) % alignment
+    a = buf[offset:offset + size].view(dtype).reshape(shape)
+    a[...] = np.arange(a.size).reshape(shape)
+    return a
+
+
+add_one = "block(define(add_one, x, x + 1), add_one)"
+total = "block(define(total, x, sum(x)), total)"
+
+for dtype in (np.float64, np.int64, np.float32, np.int32):
+    for shape in ((16,), (3, 8), (2, 3, 8), (3, 5), (2, 3, 5)):
+        a = aligned_array(shape, dtype)
+        expected = a.copy()
+
+        assert (et.eval(cs, add_one, a) == expected + 1).all()
+        assert et.eval(cs, total, a) == expected.sum()
+        assert (a == expected).all()
+
+        # non-contiguous arrays are copied
+        t = a.T
+        assert (et.eval(cs, add_one, t) == expected.T + 1).all()
+        assert (a == expected).all()
+
+# the argument is returned unchanged
+identity = "block(define(identity, x, x), identity)"
+
+a = aligned_array((4, 8), np.float64)
+r = et.eval(cs, identity, a)
+assert (r == a).all()
+a[0, 0] = 42.0
+assert r[0, 0] == 0.0
+
+
+# numpy doesn't align or pad rows, yet arrays of any shape are referenced:
+# storing to an argument inside the evaluation modifies the numpy array
+@Phylanx
+def poke(x):
+    x[0, 0] = 42
+    return x[0, 0]
+
+
+for dtype in (np.float64, np.int64):
+    for shape in ((5, 3), (3, 7), (1, 1)):
+        a = np.ones(shape, dtype=dtype)
+        assert poke.lazy().eval(a) == 42
+        assert a[0, 0] == 42
+        assert (a.flat[1:] == 1).all()
@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/eval_cost_model.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_no_prediction()
+{
+    phylanx::util::eval_cost_model model;
+
+    // all evaluations are measured until the model has enough data
+    for (std::size_t i = 0;
+         i + 1 < phylanx::util::eval_cost_model::min_samples(); ++i)
+    {
+        HPX_TEST(model.sample_eval(100));
+        model.add_sample(100, 100, 1000);
+        HPX_TEST_EQ(model.predicted_duration(), std::int64_t(-1));
+    }
+
+    HPX_TEST(model.sample_eval(100));
+    model.add_sample(100, 100, 1000);
+    HPX_TEST_EQ(model.predicted_duration(), std::int64_t(1000));
+    HPX_TEST_EQ(model.work_size(), std::size_t(100));
+}
+
+void test_sampling()
+{
+    phylanx::util::eval_cost_model model;
+
+    for (std::size_t i = 0;
+         i != phylanx::util::eval_cost_model::min_samples(); ++i)
+    {
+        HPX_TEST(model.sample_eval(100));
+        model.add_sample(100, 100, 1000);
+    }
+
+    // afterwards, evaluations are measured only periodically
+    std::size_t sampled = 0;
+    std::size_t const interval =
+        phylanx::util::eval_cost_model::sample_interval();
+    for (std::size_t i = 0; i != 4 * interval; ++i)
+    {
+        if (model.sample_eval(100))
+        {
+            ++sampled;
+        }
+    }
+    HPX_TEST_EQ(sampled, std::size_t(4));
+
+    // ... or whenever the amount of work changes significantly
+    HPX_TEST(model.sample_eval(1000));
+    HPX_TEST(model.sample_eval(10));
+
+    // ... including a change of the size of the result alone
+    model.set_result_size(100);
+    HPX_TEST(model.sample_eval((std::max)(std::size_t(10), model.work_size())));
+}
+
+void test_linear_model()
+{
+    phylanx::util::eval_cost_model model;
+
+    // duration = 500 + 2 * n
+    std::size_t const sizes[] = {10, 100, 1000, 10000, 100000};
+    for (std::size_t i = 0;
+         i != phylanx::util::eval_cost_model::min_samples(); ++i)
+    {
+        std::size_t n = sizes[i % 5];
+        model.sample_eval(n);
+        model.add_sample(n, n, std::int64_t(500 + 2 * n));
+    }
+
+    // the prediction is made for the size of the last result
+    std::size_t n = model.work_size();
+    std::int64_t expected = std::int64_t(500 + 2 * n);
+    HPX_TEST(model.predicted_duration() >= expected - 10 &&
+        model.predicted_duration() <= expected + 10);
+
+    // ... or for any other number of elements
+    HPX_TEST(model.predicted_duration(50000) >= 100490 &&
+        model.predicted_duration(50000) <= 100510);
+
+    // the next evaluation is expected to work on the result of the latest
+    // one, even if that was not measured
+    model.set_result_size(2 * n);
+    HPX_TEST_EQ(model.work_size(), 2 * n);
+
+    // the model follows growing sizes
+    model.sample_eval(1000000);
+    model.add_sample(1000000, 1000000, 2000500);
+    HPX_TEST(model.predicted_duration() >= 2000000 &&
+        model.predicted_duration() <= 2001000);
+}
+
+int main(int argc, char* argv[])
+{
+    test_no_prediction();
+    test_sampling();
+    test_linear_model();
+
+    return hpx::util::report_errors();
+}
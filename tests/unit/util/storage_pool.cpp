@@ -0,0 +1,133 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+using pool = phylanx::util::storage_pool<double>;
+using statistics = phylanx::util::storage_pool_statistics;
+
+void test_recycle_vector()
+{
+    statistics::hits(true);
+    statistics::misses(true);
+
+    blaze::DynamicVector<double> v = pool::vector(42);
+    HPX_TEST_EQ(v.size(), std::size_t(42));
+    HPX_TEST_EQ(statistics::misses(false), std::int64_t(1));
+
+    double const* data = v.data();
+    pool::release(std::move(v));
+    HPX_TEST(statistics::cached_bytes(false) != 0);
+
+    // the same shape is satisfied from the pool
+    blaze::DynamicVector<double> v1 = pool::vector(42);
+    HPX_TEST_EQ(v1.size(), std::size_t(42));
+    HPX_TEST_EQ(v1.data(), data);
+    HPX_TEST_EQ(statistics::hits(false), std::int64_t(1));
+
+    // a different shape requires a new allocation
+    blaze::DynamicVector<double> v2 = pool::vector(43);
+    HPX_TEST_EQ(v2.size(), std::size_t(43));
+    HPX_TEST_EQ(statistics::misses(false), std::int64_t(2));
+    HPX_TEST_EQ(statistics::hit_rate(false), std::int64_t(33));
+}
+
+void test_recycle_matrix()
+{
+    statistics::hits(true);
+
+    blaze::DynamicMatrix<double> m = pool::matrix(3, 4);
+    double const* data = m.data();
+    pool::release(std::move(m));
+
+    // matrices are matched by their shape, not by their size
+    blaze::DynamicMatrix<double> m1 = pool::matrix(4, 3);
+    HPX_TEST_EQ(statistics::hits(false), std::int64_t(0));
+
+    blaze::DynamicMatrix<double> m2 = pool::matrix(3, 4);
+    HPX_TEST_EQ(m2.rows(), std::size_t(3));
+    HPX_TEST_EQ(m2.columns(), std::size_t(4));
+    HPX_TEST_EQ(m2.data(), data);
+    HPX_TEST_EQ(statistics::hits(false), std::int64_t(1));
+}
+
+void test_recycle_node_data()
+{
+    using dimensions_type = phylanx::ir::node_data<double>::dimensions_type;
+
+    double const* data = nullptr;
+    {
+        phylanx::ir::node_data<double> d(dimensions_type{5, 6}, 1.0);
+        data = d.matrix().data();
+    }
+
+    // the storage released by the destructor is reused for the same shape
+    phylanx::ir::node_data<double> d(dimensions_type{5, 6}, 2.0);
+    HPX_TEST_EQ(d.matrix().data(), data);
+    HPX_TEST_EQ(d.matrix(), blaze::DynamicMatrix<double>(5, 6, 2.0));
+}
+
+void test_shared_limit()
+{
+    // the limit applies to the containers of all types cached by a worker
+    blaze::DynamicVector<double> v1 = pool::vector(256);
+    blaze::DynamicVector<std::int64_t> v2 =
+        phylanx::util::storage_pool<std::int64_t>::vector(256);
+    blaze::DynamicVector<std::uint8_t> v3 =
+        phylanx::util::storage_pool<std::uint8_t>::vector(2048);
+
+    pool::release(std::move(v1));
+    phylanx::util::storage_pool<std::int64_t>::release(std::move(v2));
+    phylanx::util::storage_pool<std::uint8_t>::release(std::move(v3));
+    HPX_TEST(statistics::cached_bytes(false) <= std::int64_t(4096));
+
+    // the least recently released container was freed
+    statistics::hits(true);
+    statistics::misses(true);
+
+    blaze::DynamicVector<double> v4 = pool::vector(256);
+    HPX_TEST_EQ(statistics::misses(false), std::int64_t(1));
+
+    blaze::DynamicVector<std::int64_t> v5 =
+        phylanx::util::storage_pool<std::int64_t>::vector(256);
+    HPX_TEST_EQ(statistics::hits(false), std::int64_t(1));
+}
+
+int hpx_main()
+{
+    HPX_TEST(phylanx::util::storage_pool_enabled());
+
+    test_recycle_vector();
+    test_recycle_matrix();
+    test_recycle_node_data();
+    test_shared_limit();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "phylanx.allocator!=pooled",
+        "phylanx.allocator.max_cached_bytes!=4096"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}